@@ -22,6 +22,7 @@
 #endif
 
 #include <glib/gi18n-lib.h>
+#include <string.h>
 #include <gtk/gtk.h>
 
 #ifdef ENABLE_X11
@@ -36,6 +37,10 @@
 #include "xfw-wnck-icon.h"
 #endif
 
+#ifdef ENABLE_WAYLAND
+#include "xfw-wl-raster-icon.h"
+#endif
+
 static gboolean inited = FALSE;
 
 void
@@ -99,66 +104,255 @@ _xfw_wnck_object_get_gicon(GObject *wnck_object,
 }
 #endif
 
+typedef struct {
+    // desktop id -> GDesktopAppInfo
+    GHashTable *apps;
+    // Lookup keys -> desktop id, checked in this order
+    GHashTable *by_id;
+    GHashTable *by_id_lower;
+    GHashTable *by_wm_class;
+    GHashTable *by_exec;
+    // App ids we had to search for -> desktop id (or NULL if the search
+    // found nothing), so each one is only searched once
+    GHashTable *searched;
+} DesktopAppIndex;
+
+static DesktopAppIndex *desktop_app_index = NULL;
+static gulong app_info_monitor_changed_id = 0;
+
+static void
+desktop_app_index_free(DesktopAppIndex *index) {
+    g_hash_table_destroy(index->by_id);
+    g_hash_table_destroy(index->by_id_lower);
+    g_hash_table_destroy(index->by_wm_class);
+    g_hash_table_destroy(index->by_exec);
+    g_hash_table_destroy(index->searched);
+    g_hash_table_destroy(index->apps);
+    g_free(index);
+}
+
+static void
+app_info_monitor_changed(GAppInfoMonitor *monitor, gpointer data) {
+    if (desktop_app_index != NULL) {
+        desktop_app_index_free(desktop_app_index);
+        desktop_app_index = NULL;
+    }
+}
+
+static void
+desktop_app_index_insert(GHashTable *table, const gchar *key, const gchar *desktop_id, gboolean lowercase) {
+    if (key != NULL && key[0] != '\0') {
+        gchar *table_key = lowercase ? g_ascii_strdown(key, -1) : g_strdup(key);
+        // First one wins, like the XDG_DATA_DIRS order g_app_info_get_all() gives us
+        if (!g_hash_table_contains(table, table_key)) {
+            g_hash_table_insert(table, table_key, (gpointer)desktop_id);
+        } else {
+            g_free(table_key);
+        }
+    }
+}
+
+static DesktopAppIndex *
+desktop_app_index_get(void) {
+    if (desktop_app_index == NULL) {
+        DesktopAppIndex *index = g_new0(DesktopAppIndex, 1);
+        GList *app_infos;
+
+        if (app_info_monitor_changed_id == 0) {
+            app_info_monitor_changed_id = g_signal_connect(g_app_info_monitor_get(),
+                                                           "changed",
+                                                           G_CALLBACK(app_info_monitor_changed),
+                                                           NULL);
+        }
+
+        // The lookup tables borrow their values from the desktop id keys of 'apps'
+        index->apps = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+        index->by_id = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        index->by_id_lower = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        index->by_wm_class = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        index->by_exec = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        index->searched = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+        app_infos = g_app_info_get_all();
+        for (GList *l = app_infos; l != NULL; l = l->next) {
+            GAppInfo *app_info = G_APP_INFO(l->data);
+            const gchar *id = g_app_info_get_id(app_info);
+
+            if (G_IS_DESKTOP_APP_INFO(app_info) && id != NULL && !g_hash_table_contains(index->apps, id)) {
+                gchar *desktop_id = g_strdup(id);
+                gchar *bare_id = g_str_has_suffix(id, ".desktop")
+                                     ? g_strndup(id, strlen(id) - strlen(".desktop"))
+                                     : g_strdup(id);
+                const gchar *executable = g_app_info_get_executable(app_info);
+
+                g_hash_table_insert(index->apps, desktop_id, g_object_ref(app_info));
+                desktop_app_index_insert(index->by_id, bare_id, desktop_id, FALSE);
+                desktop_app_index_insert(index->by_id_lower, bare_id, desktop_id, TRUE);
+                desktop_app_index_insert(index->by_wm_class,
+                                         g_desktop_app_info_get_startup_wm_class(G_DESKTOP_APP_INFO(app_info)),
+                                         desktop_id,
+                                         TRUE);
+                if (executable != NULL) {
+                    gchar *basename = g_path_get_basename(executable);
+                    desktop_app_index_insert(index->by_exec, basename, desktop_id, TRUE);
+                    g_free(basename);
+                }
+
+                g_free(bare_id);
+            }
+        }
+        g_list_free_full(app_infos, g_object_unref);
+
+        desktop_app_index = index;
+    }
+
+    return desktop_app_index;
+}
+
+static GDesktopAppInfo *
+desktop_app_index_lookup(DesktopAppIndex *index, GHashTable *table, const gchar *key) {
+    const gchar *desktop_id = g_hash_table_lookup(table, key);
+    if (desktop_id != NULL) {
+        return g_object_ref(g_hash_table_lookup(index->apps, desktop_id));
+    } else {
+        return NULL;
+    }
+}
+
 /**
  * _xfw_g_desktop_app_info_get:
  * @app_id: an application ID
  *
  * Attempts to find a #GDesktopAppInfo instance for the provided application
- * ID.
+ * ID.  The ID is matched, in order, against desktop file IDs (with and
+ * without case folding), StartupWMClass keys, and executable names, using
+ * an index that is built on first use and dropped whenever the installed
+ * applications change.  Only if none of those match is a full search done,
+ * and its result is remembered until the index is rebuilt.
  *
  * Return value: (nullable) (transfer full): a #GDesktopAppInfo instance,
  * with the reference owned by the caller, or %NULL.
  **/
 GDesktopAppInfo *
 _xfw_g_desktop_app_info_get(const gchar *app_id) {
+    DesktopAppIndex *index;
     GDesktopAppInfo *app_info;
-    gchar *desktop_id;
+    gchar *lower;
+
+    g_return_val_if_fail(app_id != NULL, NULL);
 
-    desktop_id = g_strdup_printf("%s.desktop", app_id);
-    app_info = g_desktop_app_info_new(desktop_id);
-    g_free(desktop_id);
+    index = desktop_app_index_get();
+
+    app_info = desktop_app_index_lookup(index, index->by_id, app_id);
+    if (app_info != NULL) {
+        return app_info;
+    }
+
+    lower = g_ascii_strdown(app_id, -1);
+    app_info = desktop_app_index_lookup(index, index->by_id_lower, lower);
     if (app_info == NULL) {
-        gchar *lower = g_ascii_strdown(app_id, -1);
-        if (g_strcmp0(lower, app_id) != 0) {
-            desktop_id = g_strdup_printf("%s.desktop", lower);
-            app_info = g_desktop_app_info_new(desktop_id);
-            g_free(desktop_id);
-        }
-        g_free(lower);
+        app_info = desktop_app_index_lookup(index, index->by_wm_class, lower);
+    }
+    if (app_info == NULL) {
+        app_info = desktop_app_index_lookup(index, index->by_exec, lower);
+    }
+    g_free(lower);
+
+    if (app_info == NULL) {
+        const gchar *desktop_id = NULL;
 
-        if (app_info == NULL) {
+        if (!g_hash_table_lookup_extended(index->searched, app_id, NULL, (gpointer *)&desktop_id)) {
             gchar ***desktop_ids = g_desktop_app_info_search(app_id);
-            if (desktop_ids[0] != NULL) {
-                app_info = g_desktop_app_info_new(desktop_ids[0][0]);
+            if (desktop_ids[0] != NULL
+                && !g_hash_table_lookup_extended(index->apps, desktop_ids[0][0], (gpointer *)&desktop_id, NULL))
+            {
+                // Search can find things g_app_info_get_all() skips (e.g. Hidden=true)
+                GDesktopAppInfo *found = g_desktop_app_info_new(desktop_ids[0][0]);
+                if (found != NULL) {
+                    desktop_id = g_strdup(desktop_ids[0][0]);
+                    g_hash_table_insert(index->apps, (gpointer)desktop_id, found);
+                }
             }
             for (gchar ***p = desktop_ids; *p != NULL; p++) {
                 g_strfreev(*p);
             }
             g_free(desktop_ids);
+
+            g_hash_table_insert(index->searched, g_strdup(app_id), (gpointer)desktop_id);
+        }
+
+        if (desktop_id != NULL) {
+            app_info = g_object_ref(g_hash_table_lookup(index->apps, desktop_id));
         }
     }
 
     return app_info;
 }
 
+// Raster icons share their scaled pixbufs between every window that has the
+// same icon, so skip the icon theme (and the BMP round trip) for those.
 GdkPixbuf *
 _xfw_gicon_load(GIcon *gicon, gint size, gint scale) {
-    GtkIconInfo *icon_info;
     GdkPixbuf *icon = NULL;
 
-    icon_info = gtk_icon_theme_lookup_by_gicon_for_scale(gtk_icon_theme_get_default(),
-                                                         gicon,
-                                                         size,
-                                                         scale,
-                                                         GTK_ICON_LOOKUP_FORCE_SIZE);
-    if (G_LIKELY(icon_info != NULL)) {
-        icon = gtk_icon_info_load_icon(icon_info, NULL);
-        g_object_unref(icon_info);
+#ifdef ENABLE_X11
+    if (XFW_IS_WNCK_ICON(gicon)) {
+        icon = _xfw_wnck_icon_get_pixbuf(XFW_WNCK_ICON(gicon), size, scale);
+    }
+#endif
+#ifdef ENABLE_WAYLAND
+    if (XFW_IS_WL_RASTER_ICON(gicon)) {
+        icon = _xfw_wl_raster_icon_get_pixbuf(XFW_WL_RASTER_ICON(gicon), size, scale);
+    }
+#endif
+
+    if (icon == NULL) {
+        GtkIconInfo *icon_info = gtk_icon_theme_lookup_by_gicon_for_scale(gtk_icon_theme_get_default(),
+                                                                          gicon,
+                                                                          size,
+                                                                          scale,
+                                                                          GTK_ICON_LOOKUP_FORCE_SIZE);
+        if (G_LIKELY(icon_info != NULL)) {
+            icon = gtk_icon_info_load_icon(icon_info, NULL);
+            g_object_unref(icon_info);
+        }
     }
 
     return icon;
 }
 
+// Raster icons we create ourselves are rendered straight from their ARGB data;
+// everything else goes through the icon theme.
+cairo_surface_t *
+_xfw_gicon_load_surface(GIcon *gicon, gint size, gint scale) {
+    cairo_surface_t *surface = NULL;
+
+#ifdef ENABLE_X11
+    if (XFW_IS_WNCK_ICON(gicon)) {
+        surface = _xfw_wnck_icon_get_surface(XFW_WNCK_ICON(gicon), size, scale);
+    }
+#endif
+#ifdef ENABLE_WAYLAND
+    if (XFW_IS_WL_RASTER_ICON(gicon)) {
+        surface = _xfw_wl_raster_icon_get_surface(XFW_WL_RASTER_ICON(gicon), size, scale);
+    }
+#endif
+
+    if (surface == NULL) {
+        GtkIconInfo *icon_info = gtk_icon_theme_lookup_by_gicon_for_scale(gtk_icon_theme_get_default(),
+                                                                          gicon,
+                                                                          size,
+                                                                          scale,
+                                                                          GTK_ICON_LOOKUP_FORCE_SIZE);
+        if (G_LIKELY(icon_info != NULL)) {
+            surface = gtk_icon_info_load_surface(icon_info, NULL, NULL);
+            g_object_unref(icon_info);
+        }
+    }
+
+    return surface;
+}
+
 GIcon *
 _xfw_g_icon_new(const gchar *icon_name) {
     if (icon_name != NULL) {
@@ -186,3 +380,47 @@ _xfw_g_icon_new(const gchar *icon_name) {
 
     return NULL;
 }
+
+// Makes @store hold @items, in order, with a single items-changed emission
+// covering only the run between the unchanged head and tail.  That's exact
+// for the common cases of one item being added, removed, or moved to either
+// end.
+void
+_xfw_list_store_sync(GListStore *store, GList *items) {
+    guint n_old = g_list_model_get_n_items(G_LIST_MODEL(store));
+    guint n_new = g_list_length(items);
+    guint prefix = 0;
+    guint suffix = 0;
+    GList *l = items;
+
+    for (; l != NULL && prefix < n_old; l = l->next, ++prefix) {
+        gpointer item = g_list_model_get_item(G_LIST_MODEL(store), prefix);
+        g_object_unref(item);
+        if (item != l->data) {
+            break;
+        }
+    }
+
+    if (prefix == n_old && prefix == n_new) {
+        return;
+    }
+
+    GList *tail = g_list_last(items);
+    while (suffix < n_old - prefix && suffix < n_new - prefix) {
+        gpointer item = g_list_model_get_item(G_LIST_MODEL(store), n_old - suffix - 1);
+        g_object_unref(item);
+        if (item != tail->data) {
+            break;
+        }
+        tail = tail->prev;
+        ++suffix;
+    }
+
+    guint n_added = n_new - prefix - suffix;
+    gpointer *additions = g_new(gpointer, n_added);
+    for (guint i = 0; i < n_added; ++i, l = l->next) {
+        additions[i] = l->data;
+    }
+    g_list_store_splice(store, prefix, n_old - prefix - suffix, additions, n_added);
+    g_free(additions);
+}
@@ -112,6 +112,7 @@ enum {
     WORKSPACE_GROUP_PROP_WORKSPACES,
     WORKSPACE_GROUP_PROP_ACTIVE_WORKSPACE,
     WORKSPACE_GROUP_PROP_MONITORS,
+    WORKSPACE_GROUP_PROP_LAST,
 };
 
 enum {
@@ -124,14 +125,18 @@ enum {
     WORKSPACE_PROP_LAYOUT_ROW,
     WORKSPACE_PROP_LAYOUT_COLUMN,
     WORKSPACE_PROP_GEOMETRY,
+    WORKSPACE_PROP_LAST,
 };
 
 void _libxfce4windowing_init(void);
 
 GDesktopAppInfo *_xfw_g_desktop_app_info_get(const gchar *app_id);
 GdkPixbuf *_xfw_gicon_load(GIcon *gicon, gint size, gint scale);
+cairo_surface_t *_xfw_gicon_load_surface(GIcon *gicon, gint size, gint scale);
 GIcon *_xfw_g_icon_new(const gchar *icon_name);
 
+void _xfw_list_store_sync(GListStore *store, GList *items);
+
 void _xfw_workspace_manager_install_properties(GObjectClass *gklass);
 void _xfw_workspace_group_install_properties(GObjectClass *gklass);
 void _xfw_workspace_install_properties(GObjectClass *gklass);
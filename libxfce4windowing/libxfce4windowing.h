@@ -24,8 +24,11 @@
 
 #include <libxfce4windowing/libxfce4windowing-config.h>
 #include <libxfce4windowing/xfw-monitor.h>
+#include <libxfce4windowing/xfw-screen-snapshot.h>
 #include <libxfce4windowing/xfw-screen.h>
 #include <libxfce4windowing/xfw-util.h>
+#include <libxfce4windowing/xfw-window-batch.h>
+#include <libxfce4windowing/xfw-window-list-view.h>
 #include <libxfce4windowing/xfw-window.h>
 #include <libxfce4windowing/xfw-workspace-group.h>
 #include <libxfce4windowing/xfw-workspace-manager.h>
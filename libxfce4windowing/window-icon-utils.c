@@ -21,27 +21,74 @@
 #include "config.h"
 #endif
 
+#include <gdk/gdk.h>
+#include <string.h>
+
 #include "window-icon-utils.h"
 
+// Straight (non-premultiplied) ARGB -> premultiplied ARGB, as cairo wants it
+static inline guint32
+premultiply(guint32 argb) {
+    guint32 a = (argb >> 24) & 0xff;
+
+    if (a == 0xff) {
+        return argb;
+    } else if (a == 0) {
+        return 0;
+    } else {
+        guint32 r = (argb >> 16) & 0xff;
+        guint32 g = (argb >> 8) & 0xff;
+        guint32 b = argb & 0xff;
+        // Exact division by 255 with rounding
+        r = r * a + 0x80;
+        r = (r + (r >> 8)) >> 8;
+        g = g * a + 0x80;
+        g = (g + (g >> 8)) >> 8;
+        b = b * a + 0x80;
+        b = (b + (b >> 8)) >> 8;
+        return (a << 24) | (r << 16) | (g << 8) | b;
+    }
+}
+
+static cairo_surface_t *
+create_surface(gint width, gint height, guint32 **data_out, gint *stride_out) {
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(surface);
+        return NULL;
+    } else {
+        cairo_surface_flush(surface);
+        *data_out = (guint32 *)(gpointer)cairo_image_surface_get_data(surface);
+        *stride_out = cairo_image_surface_get_stride(surface) / 4;
+        return surface;
+    }
+}
+
 // gdk-pixbuf's BMP writer does not write with the header type that supports
 // an alpha channel, so we have to do it ourselves here.
 static guchar *
-window_icon_argb_to_bmp(const guint32 *image_data,
-                        gint width,
-                        gint height,
-                        gboolean is_premultiplied,
-                        gsize *bmp_len) {
+window_icon_surface_to_bmp(cairo_surface_t *surface, gsize *bmp_len) {
     guint image_data_len;
     guchar *data;
     const guint32 header_bytes = 108;
     const guint32 pixel_data_start = 14 + header_bytes;
     guint32 data_size;
     guchar *cp;
-    const guint32 *lp;
+    const guint32 *image_data;
+    gint width, height, stride;
+
+    g_return_val_if_fail(surface != NULL, NULL);
+    g_return_val_if_fail(bmp_len != NULL, NULL);
+
+    cairo_surface_flush(surface);
+    image_data = (const guint32 *)(gconstpointer)cairo_image_surface_get_data(surface);
+    width = cairo_image_surface_get_width(surface);
+    height = cairo_image_surface_get_height(surface);
+    stride = cairo_image_surface_get_stride(surface) / 4;
 
     g_return_val_if_fail(image_data != NULL, NULL);
     g_return_val_if_fail(width > 0 && height > 0, NULL);
-    g_return_val_if_fail(bmp_len != NULL, NULL);
 
     image_data_len = width * 4 * height;
     data_size = pixel_data_start + image_data_len;
@@ -81,31 +128,33 @@ window_icon_argb_to_bmp(const guint32 *image_data,
     PACK_U32(62, 0x00ff0000);  // blue mask
     PACK_U32(66, 0xff000000);  // alpha mask
     // image data
-    for (cp = data + pixel_data_start, lp = image_data; cp < data + data_size; cp += 4, ++lp) {
-        guint argb = *lp;
+    cp = data + pixel_data_start;
+    for (gint y = 0; y < height; ++y) {
+        const guint32 *lp = image_data + y * stride;
+        for (gint x = 0; x < width; ++x, cp += 4, ++lp) {
+            guint argb = *lp;
 
-        gulong a = (argb >> 24) & 0xff;
-        gulong r = (argb >> 16) & 0xff;
-        gulong g = (argb >> 8) & 0xff;
-        gulong b = argb & 0xff;
+            gulong a = (argb >> 24) & 0xff;
+            gulong r = (argb >> 16) & 0xff;
+            gulong g = (argb >> 8) & 0xff;
+            gulong b = argb & 0xff;
 
-        if (is_premultiplied && a != 255) {
             if (a == 0) {
                 cp[0] = 0;
                 cp[1] = 0;
                 cp[2] = 0;
                 cp[3] = 0;
-            } else {
+            } else if (a != 255) {
                 cp[0] = MIN((r * 255 + a / 2) / a, 255);
                 cp[1] = MIN((g * 255 + a / 2) / a, 255);
                 cp[2] = MIN((b * 255 + a / 2) / a, 255);
                 cp[3] = a;
+            } else {
+                cp[0] = r;
+                cp[1] = g;
+                cp[2] = b;
+                cp[3] = a;
             }
-        } else {
-            cp[0] = r;
-            cp[1] = g;
-            cp[2] = b;
-            cp[3] = a;
         }
     }
 
@@ -116,42 +165,474 @@ window_icon_argb_to_bmp(const guint32 *image_data,
 #undef PACK_U32
 }
 
+// Lots of windows tend to have identical icons (every terminal, every
+// browser window), so icons are interned in a process-wide table keyed by a
+// hash of their pixel data, and shared between everyone who asks for the same
+// pixels.  Scaled copies, pixbufs, and BMP data derived from an icon are
+// cached alongside it, and are dropped, least-recently-used first, once they
+// and the icons themselves take up more than ICON_BYTES_BUDGET.  The icons'
+// own pixels can't be dropped while anyone holds a reference, so they only
+// count towards the budget, leaving less room for derived data.
+//
+// GTK may load GLoadableIcons from a worker thread, so all of this is
+// protected by a single lock.
+
+#define ICON_BYTES_BUDGET (16 * 1024 * 1024)
+
+typedef struct {
+    const guint32 *argb32;
+    const gulong *cardinals;
+    gint stride;  // in pixels
+    gboolean premultiplied;
+} PixelSource;
+
+typedef struct {
+    WindowIcon *window_icon;
+    // 0 for the BMP entry
+    gint size;
+    gint scale;
+
+    cairo_surface_t *surface;
+    GdkPixbuf *pixbuf;
+    GBytes *bmp;
+    gsize n_bytes;
+
+    GList lru_link;
+} DerivedEntry;
+
+G_LOCK_DEFINE_STATIC(window_icon_cache);
+// hash -> GSList of WindowIcon
+static GHashTable *interned_icons = NULL;
+// DerivedEntry, most recently used first
+static GQueue derived_lru = G_QUEUE_INIT;
+static gsize derived_bytes = 0;
+// Pixels of the interned icons themselves
+static gsize source_bytes = 0;
+
+static inline guint32
+pixel_source_get(const PixelSource *src, gint x, gint y) {
+    if (src->argb32 != NULL) {
+        return src->argb32[y * src->stride + x];
+    } else {
+        // Xlib returns format-32 properties as long[]
+        return (guint32)src->cardinals[y * src->stride + x];
+    }
+}
+
+// FNV-1a, a 32-bit word at a time
+static guint
+pixel_source_hash(const PixelSource *src, gint width, gint height) {
+    guint32 hash = 2166136261u;
+
+#define HASH_WORD(word) \
+    G_STMT_START { \
+        hash ^= (word); \
+        hash *= 16777619u; \
+    } \
+    G_STMT_END
+
+    HASH_WORD((guint32)width);
+    HASH_WORD((guint32)height);
+    HASH_WORD((guint32)src->premultiplied);
+    for (gint y = 0; y < height; ++y) {
+        for (gint x = 0; x < width; ++x) {
+            HASH_WORD(pixel_source_get(src, x, y));
+        }
+    }
+
+#undef HASH_WORD
+
+    return hash;
+}
+
+// Compares after premultiplying, so two sources only match if they'd draw
+// identically.
+static gboolean
+pixel_source_matches(const PixelSource *src, gint width, gint height, WindowIcon *window_icon) {
+    const guint32 *data;
+    gint stride;
+
+    if (window_icon->width != width || window_icon->height != height || window_icon->premultiplied != src->premultiplied) {
+        return FALSE;
+    }
+
+    data = (const guint32 *)(gconstpointer)cairo_image_surface_get_data(window_icon->surface);
+    stride = cairo_image_surface_get_stride(window_icon->surface) / 4;
+    for (gint y = 0; y < height; ++y) {
+        const guint32 *row = data + y * stride;
+        for (gint x = 0; x < width; ++x) {
+            guint32 pixel = pixel_source_get(src, x, y);
+            if (row[x] != (src->premultiplied ? pixel : premultiply(pixel))) {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+static void
+derived_entry_free(DerivedEntry *entry) {
+    if (entry->surface != NULL) {
+        cairo_surface_destroy(entry->surface);
+    }
+    if (entry->pixbuf != NULL) {
+        g_object_unref(entry->pixbuf);
+    }
+    if (entry->bmp != NULL) {
+        g_bytes_unref(entry->bmp);
+    }
+    g_free(entry);
+}
+
+// Must be called with the lock held
+static void
+derived_entry_remove(DerivedEntry *entry) {
+    WindowIcon *window_icon = entry->window_icon;
+    window_icon->derived = g_list_remove(window_icon->derived, entry);
+    g_queue_unlink(&derived_lru, &entry->lru_link);
+    derived_bytes -= entry->n_bytes;
+    derived_entry_free(entry);
+}
+
+// Must be called with the lock held
+static DerivedEntry *
+derived_entry_get(WindowIcon *window_icon, gint size, gint scale) {
+    DerivedEntry *entry = NULL;
+
+    for (GList *l = window_icon->derived; l != NULL; l = l->next) {
+        DerivedEntry *cur = l->data;
+        if (cur->size == size && cur->scale == scale) {
+            entry = cur;
+            g_queue_unlink(&derived_lru, &entry->lru_link);
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        entry = g_new0(DerivedEntry, 1);
+        entry->window_icon = window_icon;
+        entry->size = size;
+        entry->scale = scale;
+        entry->lru_link.data = entry;
+        window_icon->derived = g_list_prepend(window_icon->derived, entry);
+    }
+
+    g_queue_push_head_link(&derived_lru, &entry->lru_link);
+
+    return entry;
+}
+
+// Must be called with the lock held.  Never evicts @keep, which may be NULL.
+static void
+derived_trim(DerivedEntry *keep) {
+    while (derived_bytes + source_bytes > ICON_BYTES_BUDGET
+           && derived_lru.tail != NULL
+           && (keep == NULL || derived_lru.tail != &keep->lru_link))
+    {
+        derived_entry_remove(derived_lru.tail->data);
+    }
+}
+
+// Must be called with the lock held
+static void
+derived_entry_add_bytes(DerivedEntry *entry, gsize n_bytes) {
+    entry->n_bytes += n_bytes;
+    derived_bytes += n_bytes;
+
+    // Never evict the entry we're about to hand out from
+    derived_trim(entry);
+}
+
+static gsize
+surface_get_n_bytes(cairo_surface_t *surface) {
+    return (gsize)cairo_image_surface_get_stride(surface) * cairo_image_surface_get_height(surface);
+}
+
+// Must be called with the lock held.  If @surface is non-NULL, @src points
+// into its data, and the returned icon takes ownership of it.
+static WindowIcon *
+window_icon_intern(const PixelSource *src, gint width, gint height, cairo_surface_t *surface) {
+    guint hash = pixel_source_hash(src, width, height);
+    GSList *bucket;
+    WindowIcon *window_icon;
+
+    if (interned_icons == NULL) {
+        interned_icons = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+
+    bucket = g_hash_table_lookup(interned_icons, GUINT_TO_POINTER(hash));
+    for (GSList *l = bucket; l != NULL; l = l->next) {
+        window_icon = l->data;
+        if (pixel_source_matches(src, width, height, window_icon)) {
+            window_icon->ref_count++;
+            if (surface != NULL) {
+                cairo_surface_destroy(surface);
+            }
+            return window_icon;
+        }
+    }
+
+    if (surface == NULL) {
+        guint32 *data;
+        gint stride;
+
+        surface = create_surface(width, height, &data, &stride);
+        if (surface == NULL) {
+            return NULL;
+        }
+
+        for (gint y = 0; y < height; ++y) {
+            guint32 *dest = data + y * stride;
+            if (src->premultiplied && src->argb32 != NULL) {
+                memcpy(dest, src->argb32 + y * src->stride, width * 4);
+            } else {
+                for (gint x = 0; x < width; ++x) {
+                    guint32 pixel = pixel_source_get(src, x, y);
+                    dest[x] = src->premultiplied ? pixel : premultiply(pixel);
+                }
+            }
+        }
+        cairo_surface_mark_dirty(surface);
+    }
+
+    window_icon = g_new0(WindowIcon, 1);
+    window_icon->width = width;
+    window_icon->height = height;
+    window_icon->surface = surface;
+    window_icon->ref_count = 1;
+    window_icon->hash = hash;
+    window_icon->premultiplied = src->premultiplied;
+
+    g_hash_table_insert(interned_icons, GUINT_TO_POINTER(hash), g_slist_prepend(bucket, window_icon));
+    source_bytes += surface_get_n_bytes(surface);
+    derived_trim(NULL);
+
+    return window_icon;
+}
+
 WindowIcon *
 _window_icon_new(const guint32 *raw_argb32, gint width, gint height, gboolean is_premultiplied) {
-    gsize bmp_len = 0;
-    guchar *bmp_data = window_icon_argb_to_bmp(raw_argb32, width, height, is_premultiplied, &bmp_len);
-
-    if (bmp_data != NULL) {
-        WindowIcon *window_icon = g_new0(WindowIcon, 1);
-        window_icon->width = width;
-        window_icon->height = height;
-        window_icon->bmp = bmp_data;
-        window_icon->bmp_len = bmp_len;
-        return window_icon;
-    } else {
-        return NULL;
+    PixelSource src = {
+        .argb32 = raw_argb32,
+        .stride = width,
+        .premultiplied = is_premultiplied,
+    };
+    WindowIcon *window_icon;
+
+    g_return_val_if_fail(raw_argb32 != NULL, NULL);
+    g_return_val_if_fail(width > 0 && height > 0, NULL);
+
+    G_LOCK(window_icon_cache);
+    window_icon = window_icon_intern(&src, width, height, NULL);
+    G_UNLOCK(window_icon_cache);
+
+    return window_icon;
+}
+
+// The pixels are narrowed to packed 32-bit and premultiplied in the same pass.
+WindowIcon *
+_window_icon_new_from_cardinals(const gulong *cardinals, gint width, gint height) {
+    PixelSource src = {
+        .cardinals = cardinals,
+        .stride = width,
+        .premultiplied = FALSE,
+    };
+    WindowIcon *window_icon;
+
+    g_return_val_if_fail(cardinals != NULL, NULL);
+    g_return_val_if_fail(width > 0 && height > 0, NULL);
+
+    G_LOCK(window_icon_cache);
+    window_icon = window_icon_intern(&src, width, height, NULL);
+    G_UNLOCK(window_icon_cache);
+
+    return window_icon;
+}
+
+// Takes ownership of @surface, which must be a CAIRO_FORMAT_ARGB32 image
+// surface.  If an identical icon already exists, @surface is destroyed and
+// the existing icon is returned instead.
+WindowIcon *
+_window_icon_new_for_surface(cairo_surface_t *surface) {
+    PixelSource src = { 0, };
+    WindowIcon *window_icon;
+
+    g_return_val_if_fail(surface != NULL, NULL);
+    g_return_val_if_fail(cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_IMAGE, NULL);
+    g_return_val_if_fail(cairo_image_surface_get_format(surface) == CAIRO_FORMAT_ARGB32, NULL);
+
+    cairo_surface_flush(surface);
+    src.argb32 = (const guint32 *)(gconstpointer)cairo_image_surface_get_data(surface);
+    src.stride = cairo_image_surface_get_stride(surface) / 4;
+    src.premultiplied = TRUE;
+
+    G_LOCK(window_icon_cache);
+    window_icon = window_icon_intern(&src,
+                                     cairo_image_surface_get_width(surface),
+                                     cairo_image_surface_get_height(surface),
+                                     surface);
+    G_UNLOCK(window_icon_cache);
+
+    return window_icon;
+}
+
+WindowIcon *
+_window_icon_ref(WindowIcon *window_icon) {
+    g_return_val_if_fail(window_icon != NULL, NULL);
+
+    G_LOCK(window_icon_cache);
+    window_icon->ref_count++;
+    G_UNLOCK(window_icon_cache);
+
+    return window_icon;
+}
+
+void
+_window_icon_unref(WindowIcon *window_icon) {
+    gboolean destroy;
+
+    g_return_if_fail(window_icon != NULL);
+
+    G_LOCK(window_icon_cache);
+    destroy = --window_icon->ref_count == 0;
+    if (destroy) {
+        GSList *bucket = g_hash_table_lookup(interned_icons, GUINT_TO_POINTER(window_icon->hash));
+        bucket = g_slist_remove(bucket, window_icon);
+        if (bucket != NULL) {
+            g_hash_table_insert(interned_icons, GUINT_TO_POINTER(window_icon->hash), bucket);
+        } else {
+            g_hash_table_remove(interned_icons, GUINT_TO_POINTER(window_icon->hash));
+        }
+
+        while (window_icon->derived != NULL) {
+            derived_entry_remove(window_icon->derived->data);
+        }
+        source_bytes -= surface_get_n_bytes(window_icon->surface);
+    }
+    G_UNLOCK(window_icon_cache);
+
+    if (destroy) {
+        cairo_surface_destroy(window_icon->surface);
+        g_free(window_icon);
     }
 }
 
-gint
-_window_icon_compare(gconstpointer a,
-                     gconstpointer b) {
-    const WindowIcon *wa = a;
-    const WindowIcon *wb = b;
+GBytes *
+_window_icon_get_bmp(WindowIcon *window_icon) {
+    DerivedEntry *entry;
+    GBytes *bmp = NULL;
 
-    if (wa == NULL && wb == NULL) {
-        return 0;
-    } else if (wa == NULL) {
-        return -1;
-    } else if (wb == NULL) {
-        return 1;
+    g_return_val_if_fail(window_icon != NULL, NULL);
+
+    G_LOCK(window_icon_cache);
+    entry = derived_entry_get(window_icon, 0, 0);
+    if (entry->bmp == NULL) {
+        gsize bmp_len = 0;
+        guchar *bmp_data = window_icon_surface_to_bmp(window_icon->surface, &bmp_len);
+        if (bmp_data != NULL) {
+            entry->bmp = g_bytes_new_take(bmp_data, bmp_len);
+            derived_entry_add_bytes(entry, bmp_len);
+        }
+    }
+    if (entry->bmp != NULL) {
+        bmp = g_bytes_ref(entry->bmp);
+    }
+    G_UNLOCK(window_icon_cache);
+
+    return bmp;
+}
+
+// Must be called with the lock held
+static cairo_surface_t *
+window_icon_get_scaled_surface(WindowIcon *window_icon, gint size, gint scale) {
+    gint pixel_size, width, height;
+    DerivedEntry *entry;
+    cairo_surface_t *surface;
+    cairo_t *cr;
+
+    pixel_size = size * scale;
+    if (MAX(window_icon->width, window_icon->height) == pixel_size && scale == 1) {
+        return window_icon->surface;
+    }
+
+    entry = derived_entry_get(window_icon, size, scale);
+    if (entry->surface != NULL) {
+        return entry->surface;
+    }
+
+    if (window_icon->width >= window_icon->height) {
+        width = pixel_size;
+        height = MAX(1, window_icon->height * pixel_size / window_icon->width);
     } else {
-        return MAX(wa->width, wa->height) - MAX(wb->width, wb->height);
+        width = MAX(1, window_icon->width * pixel_size / window_icon->height);
+        height = pixel_size;
     }
+
+    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cr = cairo_create(surface);
+    cairo_scale(cr, (gdouble)width / window_icon->width, (gdouble)height / window_icon->height);
+    cairo_set_source_surface(cr, window_icon->surface, 0, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+
+    cairo_surface_set_device_scale(surface, scale, scale);
+
+    entry->surface = surface;
+    derived_entry_add_bytes(entry, surface_get_n_bytes(surface));
+
+    return surface;
 }
 
-void
-_window_icon_free(WindowIcon *window_icon) {
-    g_free(window_icon->bmp);
-    g_free(window_icon);
+/*
+ * Returns a surface that fits in a @size x @size box at @scale, with its
+ * device scale set to @scale, like GTK_ICON_LOOKUP_FORCE_SIZE would.  When the
+ * icon already has the right dimensions, the icon's own surface is returned
+ * without copying.  Scaled surfaces are shared by everyone using the same
+ * icon, so they must not be drawn on.
+ */
+cairo_surface_t *
+_window_icon_get_surface_for_size(WindowIcon *window_icon, gint size, gint scale) {
+    cairo_surface_t *surface;
+
+    g_return_val_if_fail(window_icon != NULL, NULL);
+    g_return_val_if_fail(size > 0 && scale > 0, NULL);
+
+    G_LOCK(window_icon_cache);
+    surface = cairo_surface_reference(window_icon_get_scaled_surface(window_icon, size, scale));
+    G_UNLOCK(window_icon_cache);
+
+    return surface;
+}
+
+// Like _window_icon_get_surface_for_size(), but as a (shared, so don't
+// modify it) GdkPixbuf at the full pixel size.
+GdkPixbuf *
+_window_icon_get_pixbuf_for_size(WindowIcon *window_icon, gint size, gint scale) {
+    DerivedEntry *entry;
+    GdkPixbuf *pixbuf = NULL;
+
+    g_return_val_if_fail(window_icon != NULL, NULL);
+    g_return_val_if_fail(size > 0 && scale > 0, NULL);
+
+    G_LOCK(window_icon_cache);
+    cairo_surface_t *surface = window_icon_get_scaled_surface(window_icon, size, scale);
+    entry = derived_entry_get(window_icon, size, scale);
+    if (entry->pixbuf == NULL) {
+        entry->pixbuf = gdk_pixbuf_get_from_surface(surface,
+                                                    0,
+                                                    0,
+                                                    cairo_image_surface_get_width(surface),
+                                                    cairo_image_surface_get_height(surface));
+        if (entry->pixbuf != NULL) {
+            derived_entry_add_bytes(entry, gdk_pixbuf_get_byte_length(entry->pixbuf));
+        }
+    }
+    if (entry->pixbuf != NULL) {
+        pixbuf = g_object_ref(entry->pixbuf);
+    }
+    G_UNLOCK(window_icon_cache);
+
+    return pixbuf;
 }
@@ -20,21 +20,33 @@
 #ifndef __XFW_WINDOW_ICON_UTILS_H__
 #define __XFW_WINDOW_ICON_UTILS_H__
 
-#include <glib.h>
+#include <cairo.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
 
 G_BEGIN_DECLS
 
 typedef struct _WindowIcon {
     gint width;
     gint height;
-    guchar *bmp;
-    gsize bmp_len;
+    // Premultiplied CAIRO_FORMAT_ARGB32
+    cairo_surface_t *surface;
+
+    // Private to window-icon-utils.c
+    gint ref_count;
+    guint hash;
+    gboolean premultiplied;
+    GList *derived;
 } WindowIcon;
 
 WindowIcon *_window_icon_new(const guint32 *raw_argb32, gint width, gint height, gboolean is_premultiplied);
-void _window_icon_free(WindowIcon *window_icon);
-
-gint _window_icon_compare(gconstpointer a, gconstpointer b);
+WindowIcon *_window_icon_new_from_cardinals(const gulong *cardinals, gint width, gint height);
+WindowIcon *_window_icon_new_for_surface(cairo_surface_t *surface);
+WindowIcon *_window_icon_ref(WindowIcon *window_icon);
+void _window_icon_unref(WindowIcon *window_icon);
+
+GBytes *_window_icon_get_bmp(WindowIcon *window_icon);
+cairo_surface_t *_window_icon_get_surface_for_size(WindowIcon *window_icon, gint size, gint scale);
+GdkPixbuf *_window_icon_get_pixbuf_for_size(WindowIcon *window_icon, gint size, gint scale);
 
 G_END_DECLS
 
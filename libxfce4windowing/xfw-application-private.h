@@ -31,6 +31,24 @@
 
 G_BEGIN_DECLS
 
+enum {
+    APPLICATION_SIGNAL_ICON_CHANGED,
+    N_APPLICATION_SIGNALS,
+};
+
+enum {
+    APPLICATION_PROP_0,
+    APPLICATION_PROP_CLASS_ID,
+    APPLICATION_PROP_NAME,
+    APPLICATION_PROP_WINDOWS,
+    APPLICATION_PROP_INSTANCES,
+    APPLICATION_PROP_GICON,
+    N_APPLICATION_PROPERTIES,
+};
+
+// Signal ids, indexed by APPLICATION_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_application_signals[N_APPLICATION_SIGNALS];
+
 struct _XfwApplicationClass {
     /*< private >*/
     GObjectClass parent_class;
@@ -56,6 +74,7 @@ struct _XfwApplicationInstance {
     GList *windows;
 };
 
+void _xfw_application_notify(XfwApplication *app, guint prop_id);
 void _xfw_application_invalidate_icon(XfwApplication *app);
 
 G_END_DECLS
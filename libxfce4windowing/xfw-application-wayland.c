@@ -104,17 +104,17 @@ xfw_application_wayland_constructed(GObject *obj) {
         gchar *icon_name = g_desktop_app_info_get_string(app_info, G_KEY_FILE_DESKTOP_KEY_ICON);
         if (name != NULL) {
             priv->name = name;
-            g_object_notify(obj, "name");
+            _xfw_application_notify(XFW_APPLICATION(obj), APPLICATION_PROP_NAME);
         }
         if (icon_name != NULL) {
             priv->icon_name = icon_name;
-            g_signal_emit_by_name(obj, "icon-changed");
+            g_signal_emit(obj, _xfw_application_signals[APPLICATION_SIGNAL_ICON_CHANGED], 0);
         }
         g_object_unref(app_info);
     }
     if (priv->name == NULL) {
         priv->name = g_strdup_printf("%c%s", g_unichar_totitle(*priv->app_id), priv->app_id + 1);
-        g_object_notify(obj, "name");
+        _xfw_application_notify(XFW_APPLICATION(obj), APPLICATION_PROP_NAME);
     }
 
     G_OBJECT_CLASS(xfw_application_wayland_parent_class)->constructed(obj);
@@ -209,7 +209,7 @@ static void
 window_closed(XfwWindowWayland *window, XfwApplicationWayland *app) {
     g_signal_handlers_disconnect_by_data(window, app);
     app->priv->windows = g_list_remove(app->priv->windows, window);
-    g_object_notify(G_OBJECT(app), "windows");
+    _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_WINDOWS);
 }
 
 static void
@@ -217,7 +217,7 @@ window_application_changed(XfwWindowWayland *window, GParamSpec *pspec, XfwAppli
     if (XFW_APPLICATION(app) != xfw_window_get_application(XFW_WINDOW(window))) {
         g_signal_handlers_disconnect_by_data(window, app);
         app->priv->windows = g_list_remove(app->priv->windows, window);
-        g_object_notify(G_OBJECT(app), "windows");
+        _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_WINDOWS);
     }
 }
 
@@ -258,7 +258,7 @@ _xfw_application_wayland_get(XfwWindowWayland *window, const gchar *app_id) {
     app->priv->windows = g_list_prepend(app->priv->windows, window);
     g_signal_connect(window, "closed", G_CALLBACK(window_closed), app);
     g_signal_connect(window, "notify::application", G_CALLBACK(window_application_changed), app);
-    g_object_notify(G_OBJECT(app), "windows");
+    _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_WINDOWS);
 
     return app;
 }
@@ -199,7 +199,7 @@ xfw_application_x11_get_instance(XfwApplication *app, XfwWindow *window) {
 static void
 icon_changed(WnckClassGroup *wnck_group, XfwApplicationX11 *app) {
     _xfw_application_invalidate_icon(XFW_APPLICATION(app));
-    g_signal_emit_by_name(app, "icon-changed");
+    g_signal_emit(app, _xfw_application_signals[APPLICATION_SIGNAL_ICON_CHANGED], 0);
 }
 
 static void
@@ -215,11 +215,11 @@ name_changed(WnckClassGroup *wnck_group, XfwApplicationX11 *app) {
         g_free(app->priv->icon_name);
         app->priv->icon_name = icon_name;
         _xfw_application_invalidate_icon(XFW_APPLICATION(app));
-        g_signal_emit_by_name(app, "icon-changed");
+        g_signal_emit(app, _xfw_application_signals[APPLICATION_SIGNAL_ICON_CHANGED], 0);
     } else {
         g_free(icon_name);
     }
-    g_object_notify(G_OBJECT(app), "name");
+    _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_NAME);
 }
 
 static gboolean
@@ -235,13 +235,13 @@ window_closed(XfwWindowX11 *window, XfwApplicationX11 *app) {
     g_signal_handlers_disconnect_by_data(window, app);
 
     app->priv->windows = g_list_remove(app->priv->windows, window);
-    g_object_notify(G_OBJECT(app), "windows");
+    _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_WINDOWS);
 
     instance->windows = g_list_remove(instance->windows, window);
     if (instance->windows == NULL) {
         g_hash_table_foreach_remove(app->priv->instances, find_instance, window);
         app->priv->instance_list = g_list_remove(app->priv->instance_list, instance);
-        g_object_notify(G_OBJECT(app), "instances");
+        _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_INSTANCES);
     }
 }
 
@@ -283,7 +283,7 @@ _xfw_application_x11_get(WnckClassGroup *wnck_group, XfwWindowX11 *window) {
 
     app->priv->windows = g_list_prepend(app->priv->windows, window);
     g_signal_connect(window, "closed", G_CALLBACK(window_closed), app);
-    g_object_notify(G_OBJECT(app), "windows");
+    _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_WINDOWS);
 
     instance = g_hash_table_lookup(app->priv->instances, wnck_app);
     if (instance == NULL) {
@@ -293,7 +293,7 @@ _xfw_application_x11_get(WnckClassGroup *wnck_group, XfwWindowX11 *window) {
         instance->windows = g_list_prepend(NULL, window);
         g_hash_table_insert(app->priv->instances, g_object_ref(wnck_app), instance);
         app->priv->instance_list = g_list_prepend(app->priv->instance_list, instance);
-        g_object_notify(G_OBJECT(app), "instances");
+        _xfw_application_notify(XFW_APPLICATION(app), APPLICATION_PROP_INSTANCES);
     } else {
         instance->windows = g_list_prepend(instance->windows, window);
     }
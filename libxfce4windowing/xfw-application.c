@@ -39,25 +39,16 @@
 
 #include "libxfce4windowing-private.h"
 #include "xfw-application-private.h"
+#include "xfw-icon-cache.h"
 #include "libxfce4windowing-visibility.h"
 
 #define XFW_APPLICATION_GET_PRIVATE(app) ((XfwApplicationPrivate *)xfw_application_get_instance_private(XFW_APPLICATION(app)))
 
-enum {
-    PROP_0,
-    PROP_CLASS_ID,
-    PROP_NAME,
-    PROP_WINDOWS,
-    PROP_INSTANCES,
-    PROP_GICON,
-};
-
 typedef struct _XfwApplicationPrivate {
     GIcon *gicon;
 
-    GdkPixbuf *icon;
-    gint icon_size;
-    gint icon_scale;
+    // Rendered icons, by (size, scale)
+    XfwIconCache *icon_cache;
 } XfwApplicationPrivate;
 
 
@@ -74,6 +65,8 @@ static void xfw_application_finalize(GObject *object);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(XfwApplication, xfw_application, G_TYPE_OBJECT)
 
+guint _xfw_application_signals[N_APPLICATION_SIGNALS] = { 0 };
+static GParamSpec *application_properties[N_APPLICATION_PROPERTIES] = { NULL };
 
 static void
 xfw_application_class_init(XfwApplicationClass *klass) {
@@ -89,13 +82,13 @@ xfw_application_class_init(XfwApplicationClass *klass) {
      *
      * Emitted when @app's icon changes.
      **/
-    g_signal_new("icon-changed",
-                 XFW_TYPE_APPLICATION,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwApplicationClass, icon_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_application_signals[APPLICATION_SIGNAL_ICON_CHANGED] = g_signal_new("icon-changed",
+                                                                             XFW_TYPE_APPLICATION,
+                                                                             G_SIGNAL_RUN_LAST,
+                                                                             G_STRUCT_OFFSET(XfwApplicationClass, icon_changed),
+                                                                             NULL, NULL,
+                                                                             g_cclosure_marshal_VOID__VOID,
+                                                                             G_TYPE_NONE, 0);
 
     /**
      * XfwApplication:class-id:
@@ -104,67 +97,62 @@ xfw_application_class_init(XfwApplicationClass *klass) {
      *
      * Since: 4.19.3
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_CLASS_ID,
-                                    g_param_spec_string("class-id",
-                                                        "class-id",
-                                                        "class-id",
-                                                        "",
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    application_properties[APPLICATION_PROP_CLASS_ID] = g_param_spec_string("class-id",
+                                                                            "class-id",
+                                                                            "class-id",
+                                                                            "",
+                                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwApplication:name:
      *
      * The application name.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_NAME,
-                                    g_param_spec_string("name",
-                                                        "name",
-                                                        "name",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    application_properties[APPLICATION_PROP_NAME] = g_param_spec_string("name",
+                                                                        "name",
+                                                                        "name",
+                                                                        NULL,
+                                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwApplication:windows: (type GList(XfwWindow))
      *
      * The list of #XfwWindow belonging to the application.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_WINDOWS,
-                                    g_param_spec_pointer("windows",
-                                                         "windows",
-                                                         "windows",
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    application_properties[APPLICATION_PROP_WINDOWS] = g_param_spec_pointer("windows",
+                                                                            "windows",
+                                                                            "windows",
+                                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwApplication:instances: (type GList(XfwApplicationInstance))
      *
      * The list of #XfwApplicationInstance belonging to the application.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_INSTANCES,
-                                    g_param_spec_pointer("instances",
-                                                         "instances",
-                                                         "instances",
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    application_properties[APPLICATION_PROP_INSTANCES] = g_param_spec_pointer("instances",
+                                                                              "instances",
+                                                                              "instances",
+                                                                              G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwApplication:gicon:
      *
      * The #GIcon that represents this application.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_GICON,
-                                    g_param_spec_object("gicon",
-                                                        "gicon",
-                                                        "gicon",
-                                                        G_TYPE_ICON,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    application_properties[APPLICATION_PROP_GICON] = g_param_spec_object("gicon",
+                                                                         "gicon",
+                                                                         "gicon",
+                                                                         G_TYPE_ICON,
+                                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_APPLICATION_PROPERTIES, application_properties);
 }
 
 static void
-xfw_application_init(XfwApplication *app) {}
+xfw_application_init(XfwApplication *app) {
+    XfwApplicationPrivate *priv = XFW_APPLICATION_GET_PRIVATE(app);
+    priv->icon_cache = _xfw_icon_cache_new();
+}
 
 static void
 xfw_application_set_property(GObject *object,
@@ -182,23 +170,23 @@ xfw_application_get_property(GObject *object,
     XfwApplication *app = XFW_APPLICATION(object);
 
     switch (prop_id) {
-        case PROP_CLASS_ID:
+        case APPLICATION_PROP_CLASS_ID:
             g_value_set_string(value, xfw_application_get_class_id(app));
             break;
 
-        case PROP_NAME:
+        case APPLICATION_PROP_NAME:
             g_value_set_string(value, xfw_application_get_name(app));
             break;
 
-        case PROP_WINDOWS:
+        case APPLICATION_PROP_WINDOWS:
             g_value_set_pointer(value, xfw_application_get_windows(app));
             break;
 
-        case PROP_INSTANCES:
+        case APPLICATION_PROP_INSTANCES:
             g_value_set_pointer(value, xfw_application_get_instances(app));
             break;
 
-        case PROP_GICON:
+        case APPLICATION_PROP_GICON:
             g_value_set_object(value, xfw_application_get_gicon(app));
             break;
 
@@ -213,7 +201,7 @@ xfw_application_finalize(GObject *object) {
     XfwApplicationPrivate *priv = XFW_APPLICATION_GET_PRIVATE(object);
 
     g_clear_object(&priv->gicon);
-    g_clear_object(&priv->icon);
+    _xfw_icon_cache_free(priv->icon_cache);
 
     G_OBJECT_CLASS(xfw_application_parent_class)->finalize(object);
 }
@@ -267,6 +255,10 @@ xfw_application_get_name(XfwApplication *app) {
  * returned.  Whether or not the returned icon is a fallback icon can be
  * determined using #xfw_application_icon_is_fallback().
  *
+ * Windows and applications with identical icons may share the same
+ * #GdkPixbuf, so the returned pixbuf must be treated as read-only.  To draw
+ * on it or change its pixels, make a copy with gdk_pixbuf_copy() first.
+ *
  * Return value: (nullable) (transfer none): a #GdkPixbuf, owned by @app,
  * or %NULL if @app has no icon and a fallback cannot be rendered.
  **/
@@ -277,22 +269,42 @@ xfw_application_get_icon(XfwApplication *app, gint size, gint scale) {
     g_return_val_if_fail(XFW_IS_APPLICATION(app), NULL);
 
     priv = XFW_APPLICATION_GET_PRIVATE(app);
-    if (priv->icon == NULL || priv->icon_size != size || priv->icon_scale != scale) {
-        GIcon *gicon;
-
-        if (priv->icon != NULL) {
-            g_object_unref(priv->icon);
-        }
-        gicon = xfw_application_get_gicon(app);
-        priv->icon = _xfw_gicon_load(gicon, size, scale);
-
-        if (priv->icon != NULL) {
-            priv->icon_size = size;
-            priv->icon_scale = scale;
-        }
-    }
+    return _xfw_icon_cache_get_pixbuf(priv->icon_cache, xfw_application_get_gicon(app), size, scale);
+}
+
+/**
+ * xfw_application_get_icon_surface:
+ * @app: an #XfwApplication.
+ * @size: the desired icon size.
+ * @scale: the UI scale factor.
+ *
+ * Fetches @app's icon as a #cairo_surface_t, suitable for painting directly
+ * with cairo.  The returned surface fits in a @size by @size box, and its
+ * device scale is set to @scale.
+ *
+ * This is cheaper than #xfw_application_get_icon() when the icon comes from the
+ * windowing system as raw pixel data, as that data is handed out without
+ * being converted to an image file and decoded again.
+ *
+ * If @app has no icon, a fallback icon may be returned.  Whether or not the
+ * returned icon is a fallback icon can be determined using
+ * #xfw_application_icon_is_fallback().
+ *
+ * Return value: (nullable) (transfer none): a #cairo_surface_t, owned by
+ * @app, or %NULL if @app has no icon and a fallback cannot be rendered.
+ *
+ * Since: 4.21.0
+ **/
+cairo_surface_t *
+xfw_application_get_icon_surface(XfwApplication *app, gint size, gint scale) {
+    XfwApplicationPrivate *priv;
 
-    return priv->icon;
+    g_return_val_if_fail(XFW_IS_APPLICATION(app), NULL);
+    g_return_val_if_fail(size > 0, NULL);
+    g_return_val_if_fail(scale > 0, NULL);
+
+    priv = XFW_APPLICATION_GET_PRIVATE(app);
+    return _xfw_icon_cache_get_surface(priv->icon_cache, xfw_application_get_gicon(app), size, scale);
 }
 
 /**
@@ -456,14 +468,17 @@ xfw_application_instance_get_windows(XfwApplicationInstance *instance) {
     return instance->windows;
 }
 
+void
+_xfw_application_notify(XfwApplication *app, guint prop_id) {
+    g_object_notify_by_pspec(G_OBJECT(app), application_properties[prop_id]);
+}
+
 void
 _xfw_application_invalidate_icon(XfwApplication *app) {
     XfwApplicationPrivate *priv = XFW_APPLICATION_GET_PRIVATE(app);
 
-    g_clear_object(&priv->icon);
+    _xfw_icon_cache_clear(priv->icon_cache);
     g_clear_object(&priv->gicon);
-    priv->icon_size = 0;
-    priv->icon_scale = 0;
 }
 
 void
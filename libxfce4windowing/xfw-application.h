@@ -45,6 +45,7 @@ typedef struct _XfwApplicationInstance XfwApplicationInstance;
 const gchar *xfw_application_get_class_id(XfwApplication *app);
 const gchar *xfw_application_get_name(XfwApplication *app);
 GdkPixbuf *xfw_application_get_icon(XfwApplication *app, gint size, gint scale);
+cairo_surface_t *xfw_application_get_icon_surface(XfwApplication *app, gint size, gint scale);
 GIcon *xfw_application_get_gicon(XfwApplication *app);
 gboolean xfw_application_icon_is_fallback(XfwApplication *app);
 GList *xfw_application_get_windows(XfwApplication *app);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// Windows and applications are usually drawn at a handful of sizes at once
+// (tasklist buttons, menus, the window switcher), so each one keeps its
+// rendered icons for the last few (size, scale) pairs it was asked for.  The
+// entries are kept in most-recently-used order, and there are few enough of
+// them that a linear search is the fastest lookup.
+//
+// Icons that fail to load are remembered too, so a window without a usable
+// icon doesn't go back to the icon theme on every redraw.  Those failures are
+// forgotten when the icon theme changes, since the new theme may have the
+// icon.
+//
+// Like the windows and applications that own the caches, everything here,
+// including the hit and miss counters, is only touched from the main thread.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gtk/gtk.h>
+
+#include "libxfce4windowing-private.h"
+#include "xfw-icon-cache.h"
+
+typedef struct {
+    gint size;
+    gint scale;
+    GdkPixbuf *pixbuf;
+    cairo_surface_t *surface;
+    // The icon_theme_generation a failed load happened in, or 0
+    guint pixbuf_failed_generation;
+    guint surface_failed_generation;
+} IconCacheEntry;
+
+struct _XfwIconCache {
+    // IconCacheEntry, most recently used first
+    GQueue entries;
+};
+
+static guint max_entries = XFW_ICON_CACHE_DEFAULT_SIZE;
+static guint64 n_hits = 0;
+static guint64 n_misses = 0;
+// Bumped whenever the icon theme changes; starts at 1 so 0 can mean "no
+// failed load"
+static guint icon_theme_generation = 1;
+
+static void
+icon_cache_entry_free(IconCacheEntry *entry) {
+    if (entry->pixbuf != NULL) {
+        g_object_unref(entry->pixbuf);
+    }
+    if (entry->surface != NULL) {
+        cairo_surface_destroy(entry->surface);
+    }
+    g_free(entry);
+}
+
+static void
+trim(XfwIconCache *cache, guint n_entries) {
+    while (cache->entries.length > n_entries) {
+        icon_cache_entry_free(g_queue_pop_tail(&cache->entries));
+    }
+}
+
+static IconCacheEntry *
+lookup_entry(XfwIconCache *cache, gint size, gint scale) {
+    for (GList *l = cache->entries.head; l != NULL; l = l->next) {
+        IconCacheEntry *entry = l->data;
+        if (entry->size == size && entry->scale == scale) {
+            if (l != cache->entries.head) {
+                g_queue_unlink(&cache->entries, l);
+                g_queue_push_head_link(&cache->entries, l);
+            }
+            return entry;
+        }
+    }
+
+    IconCacheEntry *entry = g_new0(IconCacheEntry, 1);
+    entry->size = size;
+    entry->scale = scale;
+    g_queue_push_head(&cache->entries, entry);
+    // The new entry is at the head, so it survives the trim
+    trim(cache, max_entries);
+
+    return entry;
+}
+
+static void
+icon_theme_changed(GtkIconTheme *icon_theme) {
+    if (++icon_theme_generation == 0) {
+        icon_theme_generation = 1;
+    }
+}
+
+static void
+watch_icon_theme(void) {
+    static gboolean watching = FALSE;
+
+    if (!watching) {
+        GdkScreen *screen = gdk_screen_get_default();
+        if (screen != NULL) {
+            g_signal_connect(gtk_icon_theme_get_for_screen(screen), "changed",
+                             G_CALLBACK(icon_theme_changed), NULL);
+            watching = TRUE;
+        }
+    }
+}
+
+XfwIconCache *
+_xfw_icon_cache_new(void) {
+    XfwIconCache *cache = g_new0(XfwIconCache, 1);
+    watch_icon_theme();
+    g_queue_init(&cache->entries);
+    return cache;
+}
+
+void
+_xfw_icon_cache_free(XfwIconCache *cache) {
+    if (cache != NULL) {
+        _xfw_icon_cache_clear(cache);
+        g_free(cache);
+    }
+}
+
+void
+_xfw_icon_cache_clear(XfwIconCache *cache) {
+    trim(cache, 0);
+}
+
+// The returned pixbuf stays valid until the cache is cleared, or until
+// enough other sizes have been requested that its entry is evicted.
+GdkPixbuf *
+_xfw_icon_cache_get_pixbuf(XfwIconCache *cache, GIcon *gicon, gint size, gint scale) {
+    IconCacheEntry *entry = lookup_entry(cache, size, scale);
+
+    if (entry->pixbuf != NULL || entry->pixbuf_failed_generation == icon_theme_generation) {
+        n_hits++;
+    } else {
+        n_misses++;
+        entry->pixbuf = _xfw_gicon_load(gicon, size, scale);
+        entry->pixbuf_failed_generation = entry->pixbuf == NULL ? icon_theme_generation : 0;
+    }
+
+    return entry->pixbuf;
+}
+
+// Same lifetime rules as _xfw_icon_cache_get_pixbuf().
+cairo_surface_t *
+_xfw_icon_cache_get_surface(XfwIconCache *cache, GIcon *gicon, gint size, gint scale) {
+    IconCacheEntry *entry = lookup_entry(cache, size, scale);
+
+    if (entry->surface != NULL || entry->surface_failed_generation == icon_theme_generation) {
+        n_hits++;
+    } else {
+        n_misses++;
+        entry->surface = _xfw_gicon_load_surface(gicon, size, scale);
+        entry->surface_failed_generation = entry->surface == NULL ? icon_theme_generation : 0;
+    }
+
+    return entry->surface;
+}
+
+// Existing caches shrink the next time they add an entry.
+void
+_xfw_icon_cache_set_max_entries(guint n_entries) {
+    // We always have to keep the entry we just handed out
+    max_entries = MAX(n_entries, 1);
+}
+
+void
+_xfw_icon_cache_get_stats(guint64 *hits, guint64 *misses) {
+    if (hits != NULL) {
+        *hits = n_hits;
+    }
+    if (misses != NULL) {
+        *misses = n_misses;
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_ICON_CACHE_H__
+#define __XFW_ICON_CACHE_H__
+
+#include <cairo.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+#define XFW_ICON_CACHE_DEFAULT_SIZE 4
+
+typedef struct _XfwIconCache XfwIconCache;
+
+XfwIconCache *_xfw_icon_cache_new(void);
+void _xfw_icon_cache_free(XfwIconCache *cache);
+void _xfw_icon_cache_clear(XfwIconCache *cache);
+
+GdkPixbuf *_xfw_icon_cache_get_pixbuf(XfwIconCache *cache, GIcon *gicon, gint size, gint scale);
+cairo_surface_t *_xfw_icon_cache_get_surface(XfwIconCache *cache, GIcon *gicon, gint size, gint scale);
+
+void _xfw_icon_cache_set_max_entries(guint max_entries);
+void _xfw_icon_cache_get_stats(guint64 *hits, guint64 *misses);
+
+G_END_DECLS
+
+#endif /* __XFW_ICON_CACHE_H__ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+// Answers "which monitors does this point or rectangle touch" without
+// walking the whole monitor list.  The monitors' physical rectangles are
+// kept in an array sorted by their left edge.  A query binary-searches for
+// the monitors that start left of the query's right edge, and walks back
+// from there until no monitor, not even the widest one, can reach the
+// query's left edge.  In the usual side-by-side layouts that only touches
+// the monitors that actually overlap the query.
+//
+// The index is rebuilt lazily, on the first query after the monitor list
+// has changed or any monitor has moved or been resized.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-monitor-index.h"
+#include "xfw-monitor-private.h"
+
+typedef struct {
+    GdkRectangle rect;
+    XfwMonitor *monitor;
+    // Position in the screen's monitor list, so results come back in the same
+    // order as xfw_screen_get_monitors()
+    guint order;
+} IndexedMonitor;
+
+struct _XfwMonitorIndex {
+    GList *monitors;
+    gboolean valid;
+    // Bumped by the monitors in this index when they move (see
+    // _xfw_monitor_set_geometry_generation())
+    guint *geometry_generation;
+    guint built_generation;
+
+    GArray *entries;  // IndexedMonitor, sorted by rect.x
+    gint max_width;
+};
+
+static gint
+compare_entries_by_x(gconstpointer a, gconstpointer b) {
+    const IndexedMonitor *ea = a;
+    const IndexedMonitor *eb = b;
+    return ea->rect.x < eb->rect.x ? -1 : (ea->rect.x > eb->rect.x ? 1 : 0);
+}
+
+static gint
+compare_entries_by_order(gconstpointer a, gconstpointer b) {
+    const IndexedMonitor *ea = *(const IndexedMonitor **)a;
+    const IndexedMonitor *eb = *(const IndexedMonitor **)b;
+    return (gint)ea->order - (gint)eb->order;
+}
+
+static void
+ensure_index(XfwMonitorIndex *index) {
+    if (!index->valid || index->built_generation != *index->geometry_generation) {
+        g_array_set_size(index->entries, 0);
+        index->max_width = 0;
+
+        guint order = 0;
+        for (GList *l = index->monitors; l != NULL; l = l->next, ++order) {
+            IndexedMonitor entry = {
+                .monitor = XFW_MONITOR(l->data),
+                .order = order,
+            };
+            xfw_monitor_get_physical_geometry(entry.monitor, &entry.rect);
+            if (entry.rect.width > 0 && entry.rect.height > 0) {
+                g_array_append_val(index->entries, entry);
+                index->max_width = MAX(index->max_width, entry.rect.width);
+            }
+        }
+        g_array_sort(index->entries, compare_entries_by_x);
+
+        index->valid = TRUE;
+        index->built_generation = *index->geometry_generation;
+    }
+}
+
+// Returns the number of entries whose left edge is < x
+static guint
+entries_left_of(XfwMonitorIndex *index, gint x) {
+    guint lo = 0;
+    guint hi = index->entries->len;
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+        if (g_array_index(index->entries, IndexedMonitor, mid).rect.x < x) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Collects the entries that intersect @rect into @hits
+static void
+query_rect(XfwMonitorIndex *index, const GdkRectangle *rect, GPtrArray *hits) {
+    ensure_index(index);
+
+    for (guint i = entries_left_of(index, rect->x + rect->width); i > 0; --i) {
+        IndexedMonitor *entry = &g_array_index(index->entries, IndexedMonitor, i - 1);
+        if (entry->rect.x + index->max_width <= rect->x) {
+            break;
+        }
+        if (gdk_rectangle_intersect(&entry->rect, rect, NULL)) {
+            g_ptr_array_add(hits, entry);
+        }
+    }
+}
+
+XfwMonitorIndex *
+_xfw_monitor_index_new(void) {
+    XfwMonitorIndex *index = g_new0(XfwMonitorIndex, 1);
+    index->entries = g_array_new(FALSE, FALSE, sizeof(IndexedMonitor));
+    index->geometry_generation = g_rc_box_new0(guint);
+    return index;
+}
+
+void
+_xfw_monitor_index_free(XfwMonitorIndex *index) {
+    g_array_free(index->entries, TRUE);
+    g_rc_box_release(index->geometry_generation);
+    g_free(index);
+}
+
+void
+_xfw_monitor_index_set_monitors(XfwMonitorIndex *index, GList *monitors) {
+    // The list is owned by the screen; it's only read when rebuilding
+    index->monitors = monitors;
+    index->valid = FALSE;
+    for (GList *l = monitors; l != NULL; l = l->next) {
+        _xfw_monitor_set_geometry_generation(XFW_MONITOR(l->data), index->geometry_generation);
+    }
+}
+
+XfwMonitor *
+_xfw_monitor_index_at_point(XfwMonitorIndex *index, gint x, gint y) {
+    GdkRectangle point = { x, y, 1, 1 };
+    GPtrArray *hits = g_ptr_array_sized_new(2);
+    XfwMonitor *monitor = NULL;
+
+    query_rect(index, &point, hits);
+    // Overlapping (e.g. mirrored) monitors: prefer the one listed first
+    guint best_order = G_MAXUINT;
+    for (guint i = 0; i < hits->len; ++i) {
+        IndexedMonitor *entry = g_ptr_array_index(hits, i);
+        if (entry->order < best_order) {
+            best_order = entry->order;
+            monitor = entry->monitor;
+        }
+    }
+
+    g_ptr_array_free(hits, TRUE);
+    return monitor;
+}
+
+GList *
+_xfw_monitor_index_for_rect(XfwMonitorIndex *index, const GdkRectangle *rect) {
+    GList *monitors = NULL;
+
+    if (rect->width > 0 && rect->height > 0) {
+        GPtrArray *hits = g_ptr_array_sized_new(4);
+
+        query_rect(index, rect, hits);
+        g_ptr_array_sort(hits, compare_entries_by_order);
+        for (guint i = hits->len; i > 0; --i) {
+            IndexedMonitor *entry = g_ptr_array_index(hits, i - 1);
+            monitors = g_list_prepend(monitors, entry->monitor);
+        }
+
+        g_ptr_array_free(hits, TRUE);
+    }
+
+    return monitors;
+}
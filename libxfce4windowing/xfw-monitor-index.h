@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+#ifndef __XFW_MONITOR_INDEX_H__
+#define __XFW_MONITOR_INDEX_H__
+
+#include <gdk/gdk.h>
+
+#include "xfw-monitor.h"
+
+G_BEGIN_DECLS
+
+typedef struct _XfwMonitorIndex XfwMonitorIndex;
+
+XfwMonitorIndex *_xfw_monitor_index_new(void);
+void _xfw_monitor_index_free(XfwMonitorIndex *index);
+
+void _xfw_monitor_index_set_monitors(XfwMonitorIndex *index, GList *monitors);
+
+XfwMonitor *_xfw_monitor_index_at_point(XfwMonitorIndex *index, gint x, gint y);
+GList *_xfw_monitor_index_for_rect(XfwMonitorIndex *index, const GdkRectangle *rect);
+
+G_END_DECLS
+
+#endif /* __XFW_MONITOR_INDEX_H__ */
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// Wayland compositors only tell us where monitors are in logical
+// coordinates.  To get a monitor's position in device pixels, we need to
+// know how much physical space lies to its left and above it: every stretch
+// of logical space between zero and the monitor's logical x (or y)
+// coordinate counts for its length times the scale of the monitor that
+// occupies it.  Where monitors overlap on an axis, the one that comes first
+// in the list wins.  If there's a gap, or anything lies at a negative
+// coordinate, the physical position can't be worked out.
+//
+// Each axis is solved for all monitors at once: sort the interval
+// endpoints, sweep over them while keeping the monitors that cover the
+// current stretch in a min-heap ordered by list position, and record the
+// running physical offset at each endpoint.  That's O(n log n) for the
+// whole layout.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "xfw-monitor-layout.h"
+
+typedef struct {
+    gint start;
+    gint end;
+    guint scale;
+    guint index;
+} Interval;
+
+typedef struct {
+    gint coord;
+    gint64 physical;
+    gboolean solvable;
+} Breakpoint;
+
+static gint
+compare_interval_start(gconstpointer a, gconstpointer b) {
+    const Interval *ia = a;
+    const Interval *ib = b;
+    return ia->start < ib->start ? -1 : (ia->start > ib->start ? 1 : 0);
+}
+
+static gint
+compare_coord(gconstpointer a, gconstpointer b) {
+    gint ca = *(const gint *)a;
+    gint cb = *(const gint *)b;
+    return ca < cb ? -1 : (ca > cb ? 1 : 0);
+}
+
+// Min-heap of Interval pointers keyed by list position
+
+static void
+heap_push(GPtrArray *heap, Interval *interval) {
+    g_ptr_array_add(heap, interval);
+    guint i = heap->len - 1;
+    while (i > 0) {
+        guint parent = (i - 1) / 2;
+        Interval *p = g_ptr_array_index(heap, parent);
+        if (p->index <= interval->index) {
+            break;
+        }
+        heap->pdata[i] = p;
+        i = parent;
+    }
+    heap->pdata[i] = interval;
+}
+
+static void
+heap_pop(GPtrArray *heap) {
+    Interval *last = g_ptr_array_index(heap, heap->len - 1);
+    g_ptr_array_set_size(heap, heap->len - 1);
+    if (heap->len == 0) {
+        return;
+    }
+
+    guint i = 0;
+    for (;;) {
+        guint child = i * 2 + 1;
+        if (child >= heap->len) {
+            break;
+        }
+        if (child + 1 < heap->len
+            && ((Interval *)g_ptr_array_index(heap, child + 1))->index < ((Interval *)g_ptr_array_index(heap, child))->index)
+        {
+            child++;
+        }
+        Interval *c = g_ptr_array_index(heap, child);
+        if (last->index <= c->index) {
+            break;
+        }
+        heap->pdata[i] = c;
+        i = child;
+    }
+    heap->pdata[i] = last;
+}
+
+static const Breakpoint *
+find_breakpoint(const Breakpoint *breakpoints, guint n_breakpoints, gint coord) {
+    guint lo = 0;
+    guint hi = n_breakpoints;
+    while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+        if (breakpoints[mid].coord < coord) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < n_breakpoints && breakpoints[lo].coord == coord ? &breakpoints[lo] : NULL;
+}
+
+// Fills in @physical and @solved for each entry, for one axis.  @starts,
+// @lengths and @scales are indexed like the entries.
+static void
+solve_axis(const gint *starts, const gint *lengths, const guint *scales, guint n, gint *physical, gboolean *solved) {
+    Interval *intervals = g_new(Interval, n);
+    guint n_intervals = 0;
+    gint *coords = g_new(gint, n * 2 + 1);
+    guint n_coords = 0;
+    gboolean any_negative = FALSE;
+
+    coords[n_coords++] = 0;
+    for (guint i = 0; i < n; ++i) {
+        coords[n_coords++] = starts[i];
+        if (starts[i] < 0) {
+            any_negative = TRUE;
+        }
+        if (lengths[i] > 0) {
+            intervals[n_intervals++] = (Interval){
+                .start = starts[i],
+                .end = starts[i] + lengths[i],
+                .scale = scales[i],
+                .index = i,
+            };
+            coords[n_coords++] = starts[i] + lengths[i];
+        }
+    }
+
+    if (any_negative) {
+        for (guint i = 0; i < n; ++i) {
+            solved[i] = FALSE;
+        }
+        g_free(intervals);
+        g_free(coords);
+        return;
+    }
+
+    qsort(intervals, n_intervals, sizeof(*intervals), compare_interval_start);
+    qsort(coords, n_coords, sizeof(*coords), compare_coord);
+
+    Breakpoint *breakpoints = g_new(Breakpoint, n_coords);
+    guint n_breakpoints = 0;
+    GPtrArray *active = g_ptr_array_sized_new(n_intervals);
+    guint next_interval = 0;
+    gint64 running_physical = 0;
+    gboolean running_solvable = TRUE;
+
+    for (guint c = 0; c < n_coords; ++c) {
+        gint coord = coords[c];
+        if (n_breakpoints > 0 && breakpoints[n_breakpoints - 1].coord == coord) {
+            continue;
+        }
+
+        if (n_breakpoints > 0) {
+            // Account for the stretch between the previous breakpoint and
+            // this one, which is covered by the earliest active monitor.
+            gint prev = breakpoints[n_breakpoints - 1].coord;
+            while (active->len > 0 && ((Interval *)g_ptr_array_index(active, 0))->end <= prev) {
+                heap_pop(active);
+            }
+            if (active->len > 0) {
+                Interval *cover = g_ptr_array_index(active, 0);
+                running_physical += (gint64)(coord - prev) * cover->scale;
+            } else {
+                running_solvable = FALSE;
+            }
+        }
+
+        breakpoints[n_breakpoints++] = (Breakpoint){
+            .coord = coord,
+            .physical = running_physical,
+            .solvable = running_solvable,
+        };
+
+        while (next_interval < n_intervals && intervals[next_interval].start <= coord) {
+            heap_push(active, &intervals[next_interval]);
+            next_interval++;
+        }
+    }
+
+    for (guint i = 0; i < n; ++i) {
+        const Breakpoint *bp = find_breakpoint(breakpoints, n_breakpoints, starts[i]);
+        if (bp != NULL && bp->solvable && bp->physical <= G_MAXINT) {
+            physical[i] = bp->physical;
+            solved[i] = TRUE;
+        } else {
+            solved[i] = FALSE;
+        }
+    }
+
+    g_ptr_array_free(active, TRUE);
+    g_free(breakpoints);
+    g_free(intervals);
+    g_free(coords);
+}
+
+void
+_xfw_monitor_layout_solve(XfwMonitorLayoutEntry *entries, guint n_entries) {
+    gint *starts = g_new(gint, n_entries);
+    gint *lengths = g_new(gint, n_entries);
+    guint *scales = g_new(guint, n_entries);
+    gint *physical = g_new(gint, n_entries);
+    gboolean *solved_x = g_new(gboolean, n_entries);
+    gboolean *solved_y = g_new(gboolean, n_entries);
+
+    for (guint i = 0; i < n_entries; ++i) {
+        scales[i] = entries[i].scale;
+    }
+
+    for (guint i = 0; i < n_entries; ++i) {
+        starts[i] = entries[i].logical_x;
+        lengths[i] = entries[i].logical_width;
+    }
+    solve_axis(starts, lengths, scales, n_entries, physical, solved_x);
+    for (guint i = 0; i < n_entries; ++i) {
+        entries[i].physical_x = physical[i];
+    }
+
+    for (guint i = 0; i < n_entries; ++i) {
+        starts[i] = entries[i].logical_y;
+        lengths[i] = entries[i].logical_height;
+    }
+    solve_axis(starts, lengths, scales, n_entries, physical, solved_y);
+    for (guint i = 0; i < n_entries; ++i) {
+        entries[i].physical_y = physical[i];
+        entries[i].solved = solved_x[i] && solved_y[i];
+    }
+
+    g_free(starts);
+    g_free(lengths);
+    g_free(scales);
+    g_free(physical);
+    g_free(solved_x);
+    g_free(solved_y);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_MONITOR_LAYOUT_H__
+#define __XFW_MONITOR_LAYOUT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct {
+    // Input
+    gint logical_x;
+    gint logical_y;
+    gint logical_width;
+    gint logical_height;
+    guint scale;
+
+    // Output
+    gint physical_x;
+    gint physical_y;
+    gboolean solved;
+} XfwMonitorLayoutEntry;
+
+void _xfw_monitor_layout_solve(XfwMonitorLayoutEntry *entries, guint n_entries);
+
+G_END_DECLS
+
+#endif /* __XFW_MONITOR_LAYOUT_H__ */
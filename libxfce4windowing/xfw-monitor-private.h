@@ -34,6 +34,15 @@
 
 G_BEGIN_DECLS
 
+enum {
+    MONITOR_SIGNAL_WINDOW_ADDED,
+    MONITOR_SIGNAL_WINDOW_REMOVED,
+    N_MONITOR_SIGNALS,
+};
+
+// Signal ids, indexed by MONITOR_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_monitor_signals[N_MONITOR_SIGNALS];
+
 struct _XfwMonitorClass {
     GObjectClass parent_class;
 };
@@ -82,6 +91,8 @@ void _xfw_monitor_set_fractional_scale(XfwMonitor *monitor,
                                        gdouble fractional_scale);
 void _xfw_monitor_set_physical_geometry(XfwMonitor *monitor,
                                         GdkRectangle *physical_geometry);
+void _xfw_monitor_set_geometry_generation(XfwMonitor *monitor,
+                                          guint *generation);
 void _xfw_monitor_set_logical_geometry(XfwMonitor *monitor,
                                        GdkRectangle *logical_geometry);
 void _xfw_monitor_set_workarea(XfwMonitor *monitor,
@@ -34,14 +34,19 @@
 
 #include "libxfce4windowing-private.h"
 #include "xfw-gdk-private.h"
+#include "xfw-monitor-layout.h"
 #include "xfw-monitor-private.h"
 #include "xfw-monitor-wayland.h"
 #include "xfw-monitor.h"
+#include "xfw-screen-private.h"
 #include "xfw-screen-wayland.h"
 #include "xfw-screen.h"
 
+#define FINALIZE_OUTPUT_TIMEOUT_MS 1000
+
 struct _XfwMonitorManagerWayland {
     XfwScreen *screen;
+    GdkDisplay *gdk_display;
     struct wl_display *wl_display;
     struct wl_registry *registry;
 
@@ -60,6 +65,15 @@ struct _XfwMonitorManagerWayland {
 
     struct zxdg_output_manager_v1 *xdg_output_manager;
     struct xfce_output_manager_private_v1 *xfce_output_manager;
+
+    // Monitors that have received all their initial events, but are waiting
+    // for GDK to have a GdkMonitor with the same connector, so
+    // xfw_monitor_get_gdk_monitor() works.  GDK binds its own wl_outputs, so
+    // it usually sees them within the same round trip; we recheck on
+    // GdkDisplay::monitor-added and GdkMonitor property changes, and give up
+    // after FINALIZE_OUTPUT_TIMEOUT_MS.
+    GList *pending_finalize;  // XfwMonitorWayland
+    guint pending_finalize_timeout_id;
 };
 
 struct _XfwMonitorWayland {
@@ -74,12 +88,11 @@ struct _XfwMonitorWayland {
     GdkRectangle logical_geometry;
 
     guint32 initial_dones_received : 8,
-        geometry_changed : 1;
+        geometry_changed : 1,
+        finalize_pending : 1;
 
     XfwScreen *screen;
     XfwMonitorManagerWayland *manager;
-    guint finalize_output_id;
-    guint finalize_output_count;
 };
 
 typedef struct {
@@ -87,12 +100,6 @@ typedef struct {
     uint32_t version;
 } DeferredOutput;
 
-typedef struct {
-    gint start_logical;  // inclusive
-    gint end_logical;  // exclusive
-    guint scale;
-} FoundSegment;
-
 static void xfw_monitor_wayland_finalize(GObject *object);
 
 
@@ -124,8 +131,8 @@ xfw_monitor_wayland_finalize(GObject *object) {
         }
     }
 
-    if (monitor->finalize_output_id != 0) {
-        g_source_remove(monitor->finalize_output_id);
+    if (monitor->finalize_pending) {
+        monitor->manager->pending_finalize = g_list_remove(monitor->manager->pending_finalize, monitor);
     }
 
     G_OBJECT_CLASS(xfw_monitor_wayland_parent_class)->finalize(object);
@@ -186,155 +193,58 @@ monitors_have_same_scale(GList *monitors, gint scale) {
 }
 
 static void
-print_segment(const char *fmt, const FoundSegment *segment) {
-    gchar *segment_str = g_strdup_printf("{start=%d, end=%d, scale=%u}", segment->start_logical, segment->end_logical, segment->scale);
-    g_debug(fmt, segment_str);
-    g_free(segment_str);
-}
-
-static gboolean
-found_all_segments(GArray *found_segments, gint end_coord) {
-    g_debug("checking segments, end=%d", end_coord);
-    gint last_coord = 0;
-    for (guint i = 0; i < found_segments->len; ++i) {
-        const FoundSegment *fs = &g_array_index(found_segments, const FoundSegment, i);
-        g_debug("    last=%d, cur=%d", last_coord, fs->start_logical);
-        if (fs->start_logical == last_coord) {
-            last_coord = fs->end_logical;
-        } else {
-            return FALSE;
-        }
-    }
+unscale_monitor_coordinates(GList *monitors) {
+    guint n_monitors = g_list_length(monitors);
+    XfwMonitorLayoutEntry *entries = g_new0(XfwMonitorLayoutEntry, n_monitors);
+
+    guint i = 0;
+    for (GList *l = monitors; l != NULL; l = l->next, ++i) {
+        XfwMonitor *monitor = XFW_MONITOR(l->data);
+        GdkRectangle logical_geometry;
+        xfw_monitor_get_logical_geometry(monitor, &logical_geometry);
 
-    g_debug("    last=%d, end=%d", last_coord, end_coord);
-    return last_coord == end_coord;
-}
-
-static void
-merge_found_segment(GArray *found_segments, FoundSegment *segment) {
-    for (guint i = 0; i < found_segments->len; ++i) {
-        const FoundSegment *fs = &g_array_index(found_segments, const FoundSegment, i);
-
-        if (segment->start_logical < fs->start_logical) {
-            // 'segment' starts before 'fs'.  ensure that 'segment' ends no
-            // farther than the start of 'fs' and insert it before 'fs'.
-            segment->end_logical = MIN(segment->end_logical, fs->start_logical);
-            print_segment("insert modified segment %s", segment);
-            g_array_insert_val(found_segments, i, *segment);
-            return;
-        } else if (segment->start_logical < fs->end_logical) {
-            // 'segment' starts inside 'fs'.
-            if (segment->end_logical <= fs->end_logical) {
-                // 'segment' is entirely contained within 'fs', so just drop it.
-                print_segment("dropping segment %s", segment);
-                return;
-            } else {
-                // resize 'segment' so it starts at the end of 'fs'.  we won't
-                // insert it yet, because we have to see if it overlaps with
-                // the next segment in the array, on the next iteration.
-                segment->start_logical = fs->end_logical;
-                print_segment("resized segment %s", segment);
-            }
-        }
+        entries[i].logical_x = logical_geometry.x;
+        entries[i].logical_y = logical_geometry.y;
+        entries[i].logical_width = logical_geometry.width;
+        entries[i].logical_height = logical_geometry.height;
+        entries[i].scale = xfw_monitor_get_scale(monitor);
     }
 
-    // if we haven't inserted 'segment' by now, it's after everything in the array.
-    print_segment("appending segment %s", segment);
-    g_array_append_val(found_segments, *segment);
-}
-
-static void
-unscale_monitor_coordinates(GList *monitors, XfwMonitor *monitor) {
-    // Track segments of logical coordinate space that we've "seen" already via
-    // another monitor.  Our goal is to see everything between zero and the x/y
-    // coord of our monitor.  We have to use an array rather than just tracking
-    // a single min/max because we may not see the coordinate space
-    // contiguously in order.
-    GArray *found_x_segments = g_array_sized_new(FALSE, TRUE, sizeof(FoundSegment), g_list_length(monitors));
-    GArray *found_y_segments = g_array_sized_new(FALSE, TRUE, sizeof(FoundSegment), g_list_length(monitors));
-
-    GdkRectangle logical_geometry;
-    xfw_monitor_get_logical_geometry(monitor, &logical_geometry);
-
-    GList *l = monitors;
-    while (l != NULL
-           && (!found_all_segments(found_x_segments, logical_geometry.x)
-               || !found_all_segments(found_y_segments, logical_geometry.y))) {
-        XfwMonitor *a_monitor = XFW_MONITOR(l->data);
-
-        if (a_monitor != monitor) {
-            GdkRectangle a_logical_geometry;
-            xfw_monitor_get_logical_geometry(a_monitor, &a_logical_geometry);
-
-            if (a_logical_geometry.x < logical_geometry.x) {
-                // a_monitor has at least some area to the left of monitor
-                FoundSegment segment = {
-                    .start_logical = a_logical_geometry.x,
-                    .end_logical = MIN(a_logical_geometry.x + a_logical_geometry.width, logical_geometry.x),
-                    .scale = xfw_monitor_get_scale(a_monitor),
-                };
-                print_segment("merging new x segment %s", &segment);
-                merge_found_segment(found_x_segments, &segment);
-            }
-
-            if (a_logical_geometry.y < logical_geometry.y) {
-                // a_monitor has at least some area above monitor
-                FoundSegment segment = {
-                    .start_logical = a_logical_geometry.y,
-                    .end_logical = MIN(a_logical_geometry.y + a_logical_geometry.height, logical_geometry.y),
-                    .scale = xfw_monitor_get_scale(monitor),
-                };
-                print_segment("merging new y segment %s", &segment);
-                merge_found_segment(found_y_segments, &segment);
-            }
-        }
-
-        l = l->next;
-    }
+    _xfw_monitor_layout_solve(entries, n_monitors);
 
-    XfwMonitorWayland *monitor_wl = XFW_MONITOR_WAYLAND(monitor);
-    g_debug("check: found all x: %d, found all y: %d",
-            found_all_segments(found_x_segments, logical_geometry.x),
-            found_all_segments(found_y_segments, logical_geometry.y));
-    if (found_all_segments(found_x_segments, logical_geometry.x)
-        && found_all_segments(found_y_segments, logical_geometry.y)) {
-        GdkRectangle physical_geometry = {
-            .x = 0,
-            .y = 0,
-            .width = monitor_wl->physical_geometry.width,
-            .height = monitor_wl->physical_geometry.height,
-        };
+    i = 0;
+    for (GList *l = monitors; l != NULL; l = l->next, ++i) {
+        XfwMonitor *monitor = XFW_MONITOR(l->data);
+        XfwMonitorWayland *monitor_wl = XFW_MONITOR_WAYLAND(monitor);
 
-        for (guint i = 0; i < found_x_segments->len; ++i) {
-            const FoundSegment *fs = &g_array_index(found_x_segments, const FoundSegment, i);
-            physical_geometry.x += (fs->end_logical - fs->start_logical) * fs->scale;
-        }
+        if (entries[i].solved) {
+            GdkRectangle physical_geometry = {
+                .x = entries[i].physical_x,
+                .y = entries[i].physical_y,
+                .width = monitor_wl->physical_geometry.width,
+                .height = monitor_wl->physical_geometry.height,
+            };
 
-        for (guint i = 0; i < found_y_segments->len; ++i) {
-            const FoundSegment *fs = &g_array_index(found_y_segments, const FoundSegment, i);
-            physical_geometry.y += (fs->end_logical - fs->start_logical) * fs->scale;
+            g_debug("Unscaled physical geom (%s): %dx%d+%d+%d",
+                    xfw_monitor_get_connector(monitor),
+                    physical_geometry.width, physical_geometry.height,
+                    physical_geometry.x, physical_geometry.y);
+            g_debug("Scaled logical geom (%s): %dx%d+%d+%d",
+                    xfw_monitor_get_connector(monitor),
+                    monitor_wl->logical_geometry.width, monitor_wl->logical_geometry.height,
+                    monitor_wl->logical_geometry.x, monitor_wl->logical_geometry.y);
+            _xfw_monitor_set_physical_geometry(monitor, &physical_geometry);
+        } else {
+            // Either the geometry is something weird (overlaps or gaps) and we can't figure out
+            // the physical coordinates, or we haven't seen the wl_outputs for all monitors yet,
+            // and need to wait until later.  For now, just assign the physical geometry we have,
+            // with x/y equal to whatever the compositor gave us (probably zero).
+            g_debug("unscale failed (%s)", xfw_monitor_get_connector(monitor));
+            _xfw_monitor_set_physical_geometry(monitor, &monitor_wl->physical_geometry);
         }
-
-        g_debug("Unscaled physical geom (%s): %dx%d+%d+%d",
-                xfw_monitor_get_connector(monitor),
-                physical_geometry.width, physical_geometry.height,
-                physical_geometry.x, physical_geometry.y);
-        g_debug("Scaled logical geom (%s): %dx%d+%d+%d",
-                xfw_monitor_get_connector(monitor),
-                monitor_wl->logical_geometry.width, monitor_wl->logical_geometry.height,
-                monitor_wl->logical_geometry.x, monitor_wl->logical_geometry.y);
-        _xfw_monitor_set_physical_geometry(monitor, &physical_geometry);
-    } else {
-        // Either the geometry is something weird (overlaps or gaps) and we can't figure out
-        // the physical coordinates, or we haven't seen the wl_outputs for all monitors yet,
-        // and need to wait until later.  For now, just assign the physical geometry we have,
-        // with x/y equal to whatever the compositor gave us (probably zero).
-        g_debug("unscale failed (%s)", xfw_monitor_get_connector(monitor));
-        _xfw_monitor_set_physical_geometry(monitor, &monitor_wl->physical_geometry);
     }
 
-    g_array_free(found_x_segments, TRUE);
-    g_array_free(found_y_segments, TRUE);
+    g_free(entries);
 }
 
 static void
@@ -369,20 +279,12 @@ commit_geometries(GList *monitors, XfwMonitorWayland *monitor_wl) {
                     monitor_wl->logical_geometry.x, monitor_wl->logical_geometry.y);
             _xfw_monitor_set_physical_geometry(monitor, &physical_geometry);
         } else {
-            g_debug("attempting to unscale monitor that changed (%s)", xfw_monitor_get_connector(monitor));
-            unscale_monitor_coordinates(monitors, monitor);
-
-            // At this point we need to re-compute physical coords for the other
-            // monitors, as they may not have been able to compute properly on a
-            // previous run, or even of they were, they might now be incorrect due
-            // to changes in this monitor.
-            for (GList *l = monitors; l != NULL; l = l->next) {
-                XfwMonitor *a_monitor = XFW_MONITOR(l->data);
-                if (a_monitor != monitor) {
-                    g_debug("attempting to re-unscale monitor (%s)", xfw_monitor_get_connector(a_monitor));
-                    unscale_monitor_coordinates(monitors, a_monitor);
-                }
-            }
+            // The other monitors' physical coords need to be re-computed too,
+            // as they may not have been computable on a previous run, or even
+            // if they were, they might now be incorrect due to changes in
+            // this monitor.
+            g_debug("attempting to unscale all monitors after change to %s", xfw_monitor_get_connector(monitor));
+            unscale_monitor_coordinates(monitors);
         }
 
         GdkRectangle physical_geometry, logical_geometry;
@@ -426,33 +328,29 @@ update_primary_monitor(XfwMonitorManagerWayland *monitor_manager, GList *monitor
     _xfw_screen_set_primary_monitor(monitor_manager->screen, primary_monitor);
 }
 
+// Whether GDK has a GdkMonitor for this output yet, so
+// xfw_monitor_get_gdk_monitor() will find it.  Without a connector name
+// there's nothing to match on, so there's no point in waiting.
 static gboolean
-finalize_output(gpointer data) {
-    XfwMonitorWayland *monitor_wl = data;
-    GdkDisplay *display = gdk_display_get_default();
+gdk_monitor_ready(GdkDisplay *display, XfwMonitorWayland *monitor) {
+    const gchar *connector = xfw_monitor_get_connector(XFW_MONITOR(monitor));
+    if (connector == NULL) {
+        return TRUE;
+    }
+
     gint n_monitors = gdk_display_get_n_monitors(display);
-    gboolean connectors_set = TRUE;
     for (gint i = 0; i < n_monitors; i++) {
         GdkMonitor *gdkmonitor = gdk_display_get_monitor(display, i);
-        if (xfw_gdk_monitor_get_connector(gdkmonitor) == NULL) {
-            connectors_set = FALSE;
-            break;
-        }
-    }
-    if (connectors_set) {
-        g_debug("finalizing for output ID %d", wl_proxy_get_id((struct wl_proxy *)monitor_wl->output));
-    } else {
-        if (monitor_wl->finalize_output_count++ < 10) {
-            g_debug("delaying finalization of output ID %d because of missing gdk data", wl_proxy_get_id((struct wl_proxy *)monitor_wl->output));
-            if (monitor_wl->finalize_output_id != 0) {
-                g_source_remove(monitor_wl->finalize_output_id);
-            }
-            monitor_wl->finalize_output_id = g_timeout_add(100, finalize_output, monitor_wl);
-            return FALSE;
-        } else {
-            g_debug("can't wait for gdk data any longer, finalizing for output ID %d", wl_proxy_get_id((struct wl_proxy *)monitor_wl->output));
+        if (g_strcmp0(xfw_gdk_monitor_get_connector(gdkmonitor), connector) == 0) {
+            return TRUE;
         }
     }
+    return FALSE;
+}
+
+static void
+finalize_output(XfwMonitorWayland *monitor_wl) {
+    g_debug("finalizing for output ID %d", wl_proxy_get_id((struct wl_proxy *)monitor_wl->output));
 
     XfwMonitor *monitor = XFW_MONITOR(monitor_wl);
 
@@ -505,10 +403,104 @@ finalize_output(gpointer data) {
 
     _xfw_screen_set_monitors(monitor_wl->screen, monitors, added, NULL);
     g_list_free(added);
+}
 
-    monitor_wl->finalize_output_count = 0;
-    monitor_wl->finalize_output_id = 0;
-    return FALSE;
+static void
+finalize_pending_outputs(XfwMonitorManagerWayland *monitor_manager) {
+    if (monitor_manager->pending_finalize_timeout_id != 0) {
+        g_source_remove(monitor_manager->pending_finalize_timeout_id);
+        monitor_manager->pending_finalize_timeout_id = 0;
+    }
+
+    GList *pending = g_steal_pointer(&monitor_manager->pending_finalize);
+    for (GList *l = pending; l != NULL; l = l->next) {
+        XfwMonitorWayland *monitor = XFW_MONITOR_WAYLAND(l->data);
+        monitor->finalize_pending = FALSE;
+        finalize_output(monitor);
+    }
+    g_list_free(pending);
+}
+
+static void
+check_pending_outputs(XfwMonitorManagerWayland *monitor_manager) {
+    GList *ready = NULL;
+    for (GList *l = monitor_manager->pending_finalize; l != NULL;) {
+        GList *next = l->next;
+        XfwMonitorWayland *monitor = XFW_MONITOR_WAYLAND(l->data);
+        if (gdk_monitor_ready(monitor_manager->gdk_display, monitor)) {
+            monitor_manager->pending_finalize = g_list_remove_link(monitor_manager->pending_finalize, l);
+            ready = g_list_concat(ready, l);
+        }
+        l = next;
+    }
+
+    if (monitor_manager->pending_finalize == NULL && monitor_manager->pending_finalize_timeout_id != 0) {
+        g_source_remove(monitor_manager->pending_finalize_timeout_id);
+        monitor_manager->pending_finalize_timeout_id = 0;
+    }
+
+    for (GList *l = ready; l != NULL; l = l->next) {
+        XfwMonitorWayland *monitor = XFW_MONITOR_WAYLAND(l->data);
+        monitor->finalize_pending = FALSE;
+        finalize_output(monitor);
+    }
+    g_list_free(ready);
+}
+
+static gboolean
+pending_finalize_timeout(gpointer data) {
+    XfwMonitorManagerWayland *monitor_manager = data;
+    monitor_manager->pending_finalize_timeout_id = 0;
+    g_debug("can't wait for gdk data any longer, finalizing pending outputs");
+    finalize_pending_outputs(monitor_manager);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+request_finalize_output(XfwMonitorManagerWayland *monitor_manager, XfwMonitorWayland *monitor) {
+    monitor->finalize_pending = TRUE;
+    monitor_manager->pending_finalize = g_list_append(monitor_manager->pending_finalize, monitor);
+    check_pending_outputs(monitor_manager);
+
+    if (monitor->finalize_pending) {
+        g_debug("delaying finalization of output ID %d because of missing gdk data", wl_proxy_get_id((struct wl_proxy *)monitor->output));
+        if (monitor_manager->pending_finalize_timeout_id == 0) {
+            monitor_manager->pending_finalize_timeout_id = g_timeout_add(FINALIZE_OUTPUT_TIMEOUT_MS,
+                                                                         pending_finalize_timeout,
+                                                                         monitor_manager);
+        }
+    }
+}
+
+static void
+cancel_finalize_output(XfwMonitorManagerWayland *monitor_manager, XfwMonitorWayland *monitor) {
+    if (monitor->finalize_pending) {
+        monitor->finalize_pending = FALSE;
+        monitor_manager->pending_finalize = g_list_remove(monitor_manager->pending_finalize, monitor);
+        if (monitor_manager->pending_finalize == NULL && monitor_manager->pending_finalize_timeout_id != 0) {
+            g_source_remove(monitor_manager->pending_finalize_timeout_id);
+            monitor_manager->pending_finalize_timeout_id = 0;
+        }
+    }
+}
+
+static void
+gdk_monitor_notify(GdkMonitor *gdkmonitor, GParamSpec *pspec, XfwMonitorManagerWayland *monitor_manager) {
+    check_pending_outputs(monitor_manager);
+}
+
+static void
+gdk_monitor_added(GdkDisplay *display, GdkMonitor *gdkmonitor, XfwMonitorManagerWayland *monitor_manager) {
+    g_signal_connect(gdkmonitor, "notify", G_CALLBACK(gdk_monitor_notify), monitor_manager);
+    check_pending_outputs(monitor_manager);
+}
+
+// The GdkMonitor may outlive its removal if someone else holds a ref, and
+// _xfw_monitor_manager_wayland_destroy() only disconnects from the monitors
+// the display still has
+static void
+gdk_monitor_removed(GdkDisplay *display, GdkMonitor *gdkmonitor, XfwMonitorManagerWayland *monitor_manager) {
+    g_signal_handlers_disconnect_by_data(gdkmonitor, monitor_manager);
 }
 
 static void
@@ -524,7 +516,7 @@ handle_post_finalize_done(XfwMonitorManagerWayland *monitor_manager, XfwMonitorW
     }
 
     if (needs_monitors_changed) {
-        g_signal_emit_by_name(monitor->screen, "monitors-changed");
+        g_signal_emit(monitor->screen, _xfw_screen_signals[SCREEN_SIGNAL_MONITORS_CHANGED], 0);
     }
 }
 
@@ -542,14 +534,14 @@ handle_output_done(XfwMonitorManagerWayland *monitor_manager, XfwMonitorWayland
         monitor->initial_dones_received++;
     }
 
-    if (monitor->finalize_output_id == 0 && monitor->initial_dones_received == needed_initial_dones) {
+    if (!monitor->finalize_pending && monitor->initial_dones_received == needed_initial_dones) {
         g_debug("finalizing output because: xdg_op_mgr=%p, xdg_op_mgr_vers=%d, xfce_op_mgr=%p, dones=%u",
                 monitor_manager->xdg_output_manager,
                 monitor_manager->xdg_output_manager != NULL ? (int)wl_proxy_get_version((struct wl_proxy *)monitor_manager->xdg_output_manager) : -1,
                 monitor_manager->xfce_output_manager,
                 monitor->initial_dones_received);
-        finalize_output(monitor);
-    } else if (monitor->initial_dones_received > needed_initial_dones) {
+        request_finalize_output(monitor_manager, monitor);
+    } else if (!monitor->finalize_pending && monitor->initial_dones_received > needed_initial_dones) {
         handle_post_finalize_done(monitor_manager, monitor);
     }
 }
@@ -791,6 +783,7 @@ _xfw_monitor_manager_wayland_new(XfwScreenWayland *wscreen, struct wl_registry *
 
     XfwMonitorManagerWayland *monitor_manager = g_new0(XfwMonitorManagerWayland, 1);
     monitor_manager->screen = screen;
+    monitor_manager->gdk_display = display;
     monitor_manager->registry = registry;
     monitor_manager->wl_display = gdk_wayland_display_get_wl_display(display);
     monitor_manager->deferred_outputs = g_array_new(FALSE, TRUE, sizeof(DeferredOutput));
@@ -798,6 +791,13 @@ _xfw_monitor_manager_wayland_new(XfwScreenWayland *wscreen, struct wl_registry *
     monitor_manager->xdg_outputs_to_monitors = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
     monitor_manager->xfce_outputs_to_monitors = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
 
+    g_signal_connect(display, "monitor-added", G_CALLBACK(gdk_monitor_added), monitor_manager);
+    g_signal_connect(display, "monitor-removed", G_CALLBACK(gdk_monitor_removed), monitor_manager);
+    gint n_monitors = gdk_display_get_n_monitors(display);
+    for (gint i = 0; i < n_monitors; i++) {
+        g_signal_connect(gdk_display_get_monitor(display, i), "notify", G_CALLBACK(gdk_monitor_notify), monitor_manager);
+    }
+
     return monitor_manager;
 }
 
@@ -843,6 +843,8 @@ _xfw_monitor_manager_wayland_global_removed(XfwMonitorManagerWayland *monitor_ma
     XfwMonitorWayland *monitor;
     while (g_hash_table_iter_next(&iter, (gpointer)&output, (gpointer)&monitor)) {
         if (monitor->global_name == name) {
+            cancel_finalize_output(monitor_manager, monitor);
+
             GList *removed = NULL;
             GList *monitors = _xfw_screen_steal_monitors(monitor_manager->screen);
             GList *lm = g_list_find(monitors, monitor);
@@ -928,6 +930,16 @@ _xfw_monitor_manager_wayland_destroy(XfwMonitorManagerWayland *monitor_manager)
         if (monitor_manager->deferred_outputs != NULL) {
             g_array_free(monitor_manager->deferred_outputs, TRUE);
         }
+
+        while (monitor_manager->pending_finalize != NULL) {
+            cancel_finalize_output(monitor_manager, XFW_MONITOR_WAYLAND(monitor_manager->pending_finalize->data));
+        }
+        g_signal_handlers_disconnect_by_data(monitor_manager->gdk_display, monitor_manager);
+        gint n_monitors = gdk_display_get_n_monitors(monitor_manager->gdk_display);
+        for (gint i = 0; i < n_monitors; i++) {
+            g_signal_handlers_disconnect_by_data(gdk_display_get_monitor(monitor_manager->gdk_display, i), monitor_manager);
+        }
+
         g_hash_table_destroy(monitor_manager->outputs_to_monitors);
         g_hash_table_destroy(monitor_manager->xdg_outputs_to_monitors);
         g_hash_table_destroy(monitor_manager->xfce_outputs_to_monitors);
@@ -31,6 +31,12 @@
 #include <glib/gi18n-lib.h>
 #include <libdisplay-info/info.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_XCB_RANDR) && defined(HAVE_X11_XCB)
+#include <X11/Xlib-xcb.h>
+#include <xcb/randr.h>
+#endif
 
 #include "xfw-monitor-private.h"
 #include "xfw-monitor-x11.h"
@@ -45,6 +51,11 @@ struct _XfwMonitorManagerX11 {
     XSettingsX11 *xsettings;
     gint scale;
     guint refresh_idle_id;
+
+    Atom edid_atom;
+    // RROutput -> OutputCache
+    GHashTable *output_cache;
+    guint cache_generation;
 };
 
 struct _XfwMonitorX11 {
@@ -349,170 +360,487 @@ create_fallback_monitor(Display *dpy, XfwScreenX11 *screen, gint cur_workspace_n
     return monitor;
 }
 
-static GList *
-enumerate_monitors(XfwMonitorManagerX11 *manager, GList **new_monitors, GList **previous_monitors) {
-    GdkScreen *gscreen = _xfw_screen_get_gdk_screen(XFW_SCREEN(manager->screen));
-    GdkDisplay *display = gdk_screen_get_display(gscreen);
-    Display *dpy = gdk_x11_display_get_xdisplay(display);
-    Window root = XDefaultRootWindow(dpy);
+// What we need to know about each monitor's first output.  The two
+// query_outputs_*() functions below fill these in for the parts flagged by
+// fetch_info and fetch_edid; enumerate_monitors() doesn't care which one
+// did.
+typedef struct {
+    RROutput output;
+    gboolean fetch_info;
+    gboolean fetch_edid;
+
+    gboolean valid;
+    RRCrtc crtc;
+    gulong mm_width;
+    gulong mm_height;
+    SubpixelOrder subpixel_order;
+    Rotation rotation;
+    RRMode mode;
+
+    guchar *edid;
+    gsize edid_len;
+} OutputQuery;
+
+// The last known state of an output, so a refresh only has to ask the X
+// server about outputs that an RRNotify event told us about, and only has
+// to parse an EDID when its contents actually changed.
+typedef struct {
+    OutputQuery query;
+    gchar *make;
+    gchar *model;
+    gchar *serial;
+
+    gboolean info_dirty;
+    gboolean edid_dirty;
+    // Whether the last refresh changed anything about this output
+    gboolean changed;
+    guint generation;
+} OutputCache;
 
-    XRRScreenResources *resources = XRRGetScreenResourcesCurrent(dpy, root);
-    if (resources == NULL) {
-        g_message("XRRGetScreenResourcesCurrent() failed");
-        return NULL;
+static void
+output_cache_free(OutputCache *cache) {
+    g_free(cache->query.edid);
+    g_free(cache->make);
+    g_free(cache->model);
+    g_free(cache->serial);
+    g_free(cache);
+}
+
+#if defined(HAVE_XCB_RANDR) && defined(HAVE_X11_XCB)
+// Sends the output info and EDID requests for every output at once, then the
+// CRTC requests for every connected output, so fetching costs two round trips
+// no matter how many outputs there are.  Errors come back with the replies,
+// so no error traps are needed.
+static gboolean
+query_outputs_xcb(Display *dpy, XRRScreenResources *resources, Atom edid_atom, OutputQuery **queries, guint nqueries) {
+    xcb_connection_t *conn = XGetXCBConnection(dpy);
+    if (conn == NULL || xcb_connection_has_error(conn)) {
+        return FALSE;
     }
 
-    ensure_workareas(manager);
-    gint cur_workspace_num = 0;
-    if (!get_cardinal_prop(display, root, "_NET_CURRENT_DESKTOP", &cur_workspace_num)) {
-        g_message("Failed to fetch _NET_CURRENT_DESKTOP; assuming 0");
+    xcb_randr_get_output_info_cookie_t *oinfo_cookies = g_new0(xcb_randr_get_output_info_cookie_t, nqueries);
+    xcb_randr_get_output_property_cookie_t *edid_cookies = g_new0(xcb_randr_get_output_property_cookie_t, nqueries);
+    xcb_randr_get_crtc_info_cookie_t *crtc_cookies = g_new0(xcb_randr_get_crtc_info_cookie_t, nqueries);
+    xcb_randr_crtc_t *crtcs = g_new0(xcb_randr_crtc_t, nqueries);
+
+    for (guint i = 0; i < nqueries; ++i) {
+        if (queries[i]->fetch_info) {
+            oinfo_cookies[i] = xcb_randr_get_output_info(conn, queries[i]->output, resources->configTimestamp);
+        }
+        if (queries[i]->fetch_edid) {
+            edid_cookies[i] = xcb_randr_get_output_property(conn,
+                                                            queries[i]->output,
+                                                            edid_atom,
+                                                            XCB_GET_PROPERTY_TYPE_ANY,
+                                                            0,
+                                                            256,
+                                                            FALSE,
+                                                            FALSE);
+        }
     }
+    xcb_flush(conn);
+
+    for (guint i = 0; i < nqueries; ++i) {
+        if (queries[i]->fetch_info) {
+            xcb_generic_error_t *error = NULL;
+            xcb_randr_get_output_info_reply_t *oinfo = xcb_randr_get_output_info_reply(conn, oinfo_cookies[i], &error);
+            if (oinfo != NULL
+                && oinfo->connection != XCB_RANDR_CONNECTION_DISCONNECTED
+                && oinfo->crtc != XCB_NONE)
+            {
+                queries[i]->mm_width = oinfo->mm_width;
+                queries[i]->mm_height = oinfo->mm_height;
+                queries[i]->subpixel_order = oinfo->subpixel_order;
+                crtcs[i] = oinfo->crtc;
+                crtc_cookies[i] = xcb_randr_get_crtc_info(conn, oinfo->crtc, resources->configTimestamp);
+            }
+            free(oinfo);
+            free(error);
+        }
+    }
+    xcb_flush(conn);
+
+    for (guint i = 0; i < nqueries; ++i) {
+        if (crtcs[i] != XCB_NONE) {
+            xcb_generic_error_t *error = NULL;
+            xcb_randr_get_crtc_info_reply_t *crtc = xcb_randr_get_crtc_info_reply(conn, crtc_cookies[i], &error);
+            if (crtc != NULL) {
+                queries[i]->crtc = crtcs[i];
+                queries[i]->rotation = crtc->rotation;
+                queries[i]->mode = crtc->mode;
+                queries[i]->valid = TRUE;
+            }
+            free(crtc);
+            free(error);
+        }
 
-    int nmonitors = 0;
-    XRRMonitorInfo *rrmonitors = XRRGetMonitors(dpy, root, True, &nmonitors);
+        if (queries[i]->fetch_edid) {
+            xcb_generic_error_t *error = NULL;
+            xcb_randr_get_output_property_reply_t *prop = xcb_randr_get_output_property_reply(conn, edid_cookies[i], &error);
+            if (prop != NULL && prop->format == 8) {
+                int len = xcb_randr_get_output_property_data_length(prop);
+                if (len > 0) {
+                    queries[i]->edid = g_memdup2(xcb_randr_get_output_property_data(prop), len);
+                    queries[i]->edid_len = len;
+                }
+            }
+            free(prop);
+            free(error);
+        }
+    }
 
-    GList *monitors = NULL;
-    XfwMonitor *primary_monitor = NULL;
+    g_free(oinfo_cookies);
+    g_free(edid_cookies);
+    g_free(crtc_cookies);
+    g_free(crtcs);
 
-    for (int i = 0; i < nmonitors; ++i) {
-        RROutput output = rrmonitors[i].outputs[0];
+    return TRUE;
+}
+#endif
 
-        gdk_x11_display_error_trap_push(display);
-        XRROutputInfo *oinfo = XRRGetOutputInfo(dpy, resources, output);
-        if (gdk_x11_display_error_trap_pop(display) != 0
-            || oinfo == NULL
-            || oinfo->connection == RR_Disconnected
-            || oinfo->crtc == None)
-        {
+static void
+query_outputs_xlib(GdkDisplay *display, XRRScreenResources *resources, Atom edid_atom, OutputQuery **queries, guint nqueries) {
+    Display *dpy = gdk_x11_display_get_xdisplay(display);
+
+    for (guint i = 0; i < nqueries; ++i) {
+        OutputQuery *query = queries[i];
+
+        if (query->fetch_info) {
+            gdk_x11_display_error_trap_push(display);
+            XRROutputInfo *oinfo = XRRGetOutputInfo(dpy, resources, query->output);
+            if (gdk_x11_display_error_trap_pop(display) == 0
+                && oinfo != NULL
+                && oinfo->connection != RR_Disconnected
+                && oinfo->crtc != None)
+            {
+                gdk_x11_display_error_trap_push(display);
+                XRRCrtcInfo *crtc = XRRGetCrtcInfo(dpy, resources, oinfo->crtc);
+                if (gdk_x11_display_error_trap_pop(display) == 0 && crtc != NULL) {
+                    query->valid = TRUE;
+                    query->crtc = oinfo->crtc;
+                    query->mm_width = oinfo->mm_width;
+                    query->mm_height = oinfo->mm_height;
+                    query->subpixel_order = oinfo->subpixel_order;
+                    query->rotation = crtc->rotation;
+                    query->mode = crtc->mode;
+                }
+                if (crtc != NULL) {
+                    XRRFreeCrtcInfo(crtc);
+                }
+            }
             if (oinfo != NULL) {
                 XRRFreeOutputInfo(oinfo);
             }
-            continue;
         }
 
-        gdk_x11_display_error_trap_push(display);
-        XRRCrtcInfo *crtc = XRRGetCrtcInfo(dpy, resources, oinfo->crtc);
-        if (gdk_x11_display_error_trap_pop(display) != 0 || crtc == NULL) {
-            XRRFreeOutputInfo(oinfo);
-            continue;
+        if (query->fetch_edid) {
+            gdk_x11_display_error_trap_push(display);
+
+            Atom actual_type = None;
+            int actual_format = 0;
+            unsigned long nbytes = 0;
+            unsigned long bytes_left = 0;
+            unsigned char *edid_data = NULL;
+
+            XRRGetOutputProperty(dpy,
+                                 query->output,
+                                 edid_atom,
+                                 0,
+                                 256,
+                                 False,
+                                 False,
+                                 AnyPropertyType,
+                                 &actual_type,
+                                 &actual_format,
+                                 &nbytes,
+                                 &bytes_left,
+                                 &edid_data);
+
+            if (gdk_x11_display_error_trap_pop(display) == 0 && edid_data != NULL && nbytes > 0) {
+                query->edid = g_memdup2(edid_data, nbytes);
+                query->edid_len = nbytes;
+            }
+            if (edid_data != NULL) {
+                XFree(edid_data);
+            }
         }
+    }
+}
 
-        gchar *connector = g_strdup(gdk_x11_get_xatom_name_for_display(display, rrmonitors[i].name));
-        XfwMonitor *monitor = steal_monitor_by_connector(previous_monitors, connector);
-        if (monitor == NULL) {
-            monitor = g_object_new(XFW_TYPE_MONITOR_X11, NULL);
-            *new_monitors = g_list_append(*new_monitors, monitor);
-            _xfw_monitor_set_connector(monitor, connector);
+static void
+output_cache_parse_edid(OutputCache *cache) {
+    g_clear_pointer(&cache->make, g_free);
+    g_clear_pointer(&cache->model, g_free);
+    g_clear_pointer(&cache->serial, g_free);
+
+    if (cache->query.edid != NULL) {
+        struct di_info *edid_info = di_info_parse_edid(cache->query.edid, cache->query.edid_len);
+        if (edid_info != NULL) {
+            char *make = di_info_get_make(edid_info);
+            cache->make = g_strdup(make);
+            free(make);
+
+            char *model = di_info_get_model(edid_info);
+            cache->model = g_strdup(model);
+            free(model);
+
+            char *serial = di_info_get_serial(edid_info);
+            cache->serial = g_strdup(serial);
+            free(serial);
+
+            di_info_destroy(edid_info);
         }
+    }
+}
 
-        _xfw_monitor_set_scale(monitor, manager->scale);
-        _xfw_monitor_set_fractional_scale(monitor, manager->scale);
-        _xfw_monitor_set_physical_size(monitor, oinfo->mm_width, oinfo->mm_height);
-        _xfw_monitor_set_subpixel(monitor, xfw_subpixel_from_x11(oinfo->subpixel_order));
-        _xfw_monitor_set_transform(monitor, xfw_transform_from_x11(crtc->rotation));
-
-        for (gint j = 0; j < resources->nmode; ++j) {
-            XRRModeInfo *mode = &resources->modes[j];
-            if (mode->id == crtc->mode) {
-                if (mode->hTotal > 0 && mode->vTotal > 0) {
-                    _xfw_monitor_set_refresh(monitor, (mode->dotClock * 1000) / (mode->hTotal * mode->vTotal));
-                    break;
+static gboolean
+output_info_equal(const OutputQuery *a, const OutputQuery *b) {
+    return a->valid == b->valid
+           && a->crtc == b->crtc
+           && a->mm_width == b->mm_width
+           && a->mm_height == b->mm_height
+           && a->subpixel_order == b->subpixel_order
+           && a->rotation == b->rotation
+           && a->mode == b->mode;
+}
+
+// Returns the cache entry for each monitor's first output, in the same order
+// as @rrmonitors.  Outputs we haven't seen before, and those marked dirty by
+// events since the last refresh, are fetched from the X server; all others
+// are used as-is.
+static OutputCache **
+update_output_cache(XfwMonitorManagerX11 *manager, GdkDisplay *display, XRRScreenResources *resources, XRRMonitorInfo *rrmonitors, int nmonitors) {
+    OutputCache **entries = g_new0(OutputCache *, MAX(nmonitors, 1));
+    GPtrArray *stale = g_ptr_array_new();
+    GPtrArray *queries = g_ptr_array_new();
+
+    ++manager->cache_generation;
+
+    for (int i = 0; i < nmonitors; ++i) {
+        if (rrmonitors[i].noutput <= 0) {
+            continue;
+        }
+
+        RROutput output = rrmonitors[i].outputs[0];
+        OutputCache *cache = g_hash_table_lookup(manager->output_cache, GUINT_TO_POINTER(output));
+        if (cache == NULL) {
+            cache = g_new0(OutputCache, 1);
+            cache->query.output = output;
+            cache->info_dirty = TRUE;
+            cache->edid_dirty = TRUE;
+            g_hash_table_insert(manager->output_cache, GUINT_TO_POINTER(output), cache);
+        }
+        entries[i] = cache;
+
+        if (cache->generation != manager->cache_generation) {
+            cache->generation = manager->cache_generation;
+            cache->changed = FALSE;
+
+            if (cache->info_dirty || cache->edid_dirty) {
+                // Keep the previous state around to compare against; the
+                // copy owns the old EDID.
+                OutputQuery *previous = g_memdup2(&cache->query, sizeof(cache->query));
+                g_ptr_array_add(stale, previous);
+                g_ptr_array_add(queries, &cache->query);
+
+                cache->query.fetch_info = cache->info_dirty;
+                cache->query.fetch_edid = cache->edid_dirty;
+                if (cache->info_dirty) {
+                    cache->query.valid = FALSE;
+                    cache->query.crtc = None;
+                }
+                if (cache->edid_dirty) {
+                    cache->query.edid = NULL;
+                    cache->query.edid_len = 0;
+                } else {
+                    previous->edid = NULL;
                 }
             }
         }
+    }
 
-        GdkRectangle geometry = {
-            .x = rrmonitors[i].x,
-            .y = rrmonitors[i].y,
-            .width = rrmonitors[i].width,
-            .height = rrmonitors[i].height,
-        };
-        _xfw_monitor_set_physical_geometry(monitor, &geometry);
+    if (queries->len > 0) {
+        Display *dpy = gdk_x11_display_get_xdisplay(display);
+#if defined(HAVE_XCB_RANDR) && defined(HAVE_X11_XCB)
+        if (!query_outputs_xcb(dpy, resources, manager->edid_atom, (OutputQuery **)queries->pdata, queries->len))
+#endif
+        {
+            query_outputs_xlib(display, resources, manager->edid_atom, (OutputQuery **)queries->pdata, queries->len);
+        }
+    }
 
-        geometry.x /= manager->scale;
-        geometry.y /= manager->scale;
-        geometry.width /= manager->scale;
-        geometry.height /= manager->scale;
-        _xfw_monitor_set_logical_geometry(monitor, &geometry);
+    for (guint i = 0; i < queries->len; ++i) {
+        // The query is the first member of the cache entry
+        OutputCache *cache = (OutputCache *)g_ptr_array_index(queries, i);
+        OutputQuery *previous = g_ptr_array_index(stale, i);
 
-        update_monitor_workarea(manager->screen, monitor, cur_workspace_num);
+        if (cache->query.fetch_info && !output_info_equal(&cache->query, previous)) {
+            cache->changed = TRUE;
+        }
 
-        XRRFreeCrtcInfo(crtc);
+        if (cache->query.fetch_edid
+            && (cache->query.edid_len != previous->edid_len
+                || (cache->query.edid_len > 0 && memcmp(cache->query.edid, previous->edid, cache->query.edid_len) != 0)))
+        {
+            output_cache_parse_edid(cache);
+            cache->changed = TRUE;
+        }
 
-        Atom edid_atom = XInternAtom(dpy, RR_PROPERTY_RANDR_EDID, False);
+        cache->query.fetch_info = FALSE;
+        cache->query.fetch_edid = FALSE;
+        cache->info_dirty = FALSE;
+        cache->edid_dirty = FALSE;
 
-        gdk_x11_display_error_trap_push(display);
+        g_free(previous->edid);
+        g_free(previous);
+    }
 
-        Atom actual_type = None;
-        int actual_format = 0;
-        unsigned long nbytes = 0;
-        unsigned long bytes_left = 0;
-        unsigned char *edid_data = NULL;
-
-        XRRGetOutputProperty(dpy,
-                             output,
-                             edid_atom,
-                             0,
-                             256,
-                             False,
-                             False,
-                             AnyPropertyType,
-                             &actual_type,
-                             &actual_format,
-                             &nbytes,
-                             &bytes_left,
-                             &edid_data);
-
-        if (gdk_x11_display_error_trap_pop(display) == 0 && edid_data != NULL && nbytes > 0) {
-            struct di_info *edid_info = di_info_parse_edid(edid_data, nbytes);
-            if (edid_info != NULL) {
-                char *make = di_info_get_make(edid_info);
-                if (make != NULL) {
-                    _xfw_monitor_set_make(monitor, make);
-                }
-                free(make);
+    g_ptr_array_free(queries, TRUE);
+    g_ptr_array_free(stale, TRUE);
 
-                char *model = di_info_get_model(edid_info);
-                if (model != NULL) {
-                    _xfw_monitor_set_model(monitor, model);
-                }
-                free(model);
+    return entries;
+}
 
-                char *serial = di_info_get_serial(edid_info);
-                if (serial != NULL) {
-                    _xfw_monitor_set_serial(monitor, serial);
-                }
-                free(serial);
+static gboolean
+drop_stale_output(gpointer key, gpointer value, gpointer user_data) {
+    OutputCache *cache = value;
+    XfwMonitorManagerX11 *manager = user_data;
+    return cache->generation != manager->cache_generation;
+}
 
-                di_info_destroy(edid_info);
+static void
+update_monitor(XfwMonitorManagerX11 *manager,
+               XfwMonitor *monitor,
+               OutputCache *cache,
+               XRRMonitorInfo *rrmonitor,
+               XRRScreenResources *resources,
+               const gchar *connector,
+               gint cur_workspace_num) {
+    OutputQuery *query = &cache->query;
+
+    _xfw_monitor_set_scale(monitor, manager->scale);
+    _xfw_monitor_set_fractional_scale(monitor, manager->scale);
+    _xfw_monitor_set_physical_size(monitor, query->mm_width, query->mm_height);
+    _xfw_monitor_set_subpixel(monitor, xfw_subpixel_from_x11(query->subpixel_order));
+    _xfw_monitor_set_transform(monitor, xfw_transform_from_x11(query->rotation));
+
+    for (gint j = 0; j < resources->nmode; ++j) {
+        XRRModeInfo *mode = &resources->modes[j];
+        if (mode->id == query->mode) {
+            if (mode->hTotal > 0 && mode->vTotal > 0) {
+                _xfw_monitor_set_refresh(monitor, (mode->dotClock * 1000) / (mode->hTotal * mode->vTotal));
+                break;
             }
+        }
+    }
+
+    GdkRectangle geometry = {
+        .x = rrmonitor->x,
+        .y = rrmonitor->y,
+        .width = rrmonitor->width,
+        .height = rrmonitor->height,
+    };
+    _xfw_monitor_set_physical_geometry(monitor, &geometry);
+
+    geometry.x /= manager->scale;
+    geometry.y /= manager->scale;
+    geometry.width /= manager->scale;
+    geometry.height /= manager->scale;
+    _xfw_monitor_set_logical_geometry(monitor, &geometry);
 
-            _xfw_monitor_set_edid(monitor, edid_data, nbytes);
+    update_monitor_workarea(manager->screen, monitor, cur_workspace_num);
+
+    if (query->edid != NULL) {
+        if (cache->make != NULL) {
+            _xfw_monitor_set_make(monitor, cache->make);
+        }
+        if (cache->model != NULL) {
+            _xfw_monitor_set_model(monitor, cache->model);
         }
-        if (edid_data != NULL) {
-            XFree(edid_data);
+        if (cache->serial != NULL) {
+            _xfw_monitor_set_serial(monitor, cache->serial);
         }
+        _xfw_monitor_set_edid(monitor, query->edid, query->edid_len);
+    }
 
-        const char *make = xfw_monitor_get_make(monitor);
-        const char *model = xfw_monitor_get_model(monitor);
-        const char *serial = xfw_monitor_get_serial(monitor);
-
-        gchar *identifier = _xfw_monitor_build_identifier(make, model, serial, connector);
-        _xfw_monitor_set_identifier(monitor, identifier);
-        g_free(identifier);
-
-        char *description;
-        if (make != NULL && model != NULL && serial != NULL) {
-            description = g_strdup_printf("%s %s %s (%s)", make, model, serial, connector);
-        } else if (make != NULL && model != NULL) {
-            description = g_strdup_printf("%s %s (%s)", make, model, connector);
-        } else if (make != NULL) {
-            description = g_strdup_printf("%s (%s)", make, connector);
-        } else {
-            description = g_strdup(connector);
+    const char *make = xfw_monitor_get_make(monitor);
+    const char *model = xfw_monitor_get_model(monitor);
+    const char *serial = xfw_monitor_get_serial(monitor);
+
+    gchar *identifier = _xfw_monitor_build_identifier(make, model, serial, connector);
+    _xfw_monitor_set_identifier(monitor, identifier);
+    g_free(identifier);
+
+    char *description;
+    if (make != NULL && model != NULL && serial != NULL) {
+        description = g_strdup_printf("%s %s %s (%s)", make, model, serial, connector);
+    } else if (make != NULL && model != NULL) {
+        description = g_strdup_printf("%s %s (%s)", make, model, connector);
+    } else if (make != NULL) {
+        description = g_strdup_printf("%s (%s)", make, connector);
+    } else {
+        description = g_strdup(connector);
+    }
+    _xfw_monitor_set_description(monitor, description);
+    g_free(description);
+}
+
+static gboolean
+monitor_needs_update(XfwMonitorManagerX11 *manager, XfwMonitor *monitor, OutputCache *cache, XRRMonitorInfo *rrmonitor) {
+    if (cache->changed || xfw_monitor_get_scale(monitor) != (guint)manager->scale) {
+        return TRUE;
+    } else {
+        GdkRectangle geometry;
+        xfw_monitor_get_physical_geometry(monitor, &geometry);
+        return geometry.x != rrmonitor->x
+               || geometry.y != rrmonitor->y
+               || geometry.width != rrmonitor->width
+               || geometry.height != rrmonitor->height;
+    }
+}
+
+static GList *
+enumerate_monitors(XfwMonitorManagerX11 *manager, GList **new_monitors, GList **previous_monitors) {
+    GdkScreen *gscreen = _xfw_screen_get_gdk_screen(XFW_SCREEN(manager->screen));
+    GdkDisplay *display = gdk_screen_get_display(gscreen);
+    Display *dpy = gdk_x11_display_get_xdisplay(display);
+    Window root = XDefaultRootWindow(dpy);
+
+    XRRScreenResources *resources = XRRGetScreenResourcesCurrent(dpy, root);
+    if (resources == NULL) {
+        g_message("XRRGetScreenResourcesCurrent() failed");
+        return NULL;
+    }
+
+    ensure_workareas(manager);
+    gint cur_workspace_num = 0;
+    if (!get_cardinal_prop(display, root, "_NET_CURRENT_DESKTOP", &cur_workspace_num)) {
+        g_message("Failed to fetch _NET_CURRENT_DESKTOP; assuming 0");
+    }
+
+    int nmonitors = 0;
+    XRRMonitorInfo *rrmonitors = XRRGetMonitors(dpy, root, True, &nmonitors);
+    OutputCache **caches = update_output_cache(manager, display, resources, rrmonitors, nmonitors);
+
+    GList *monitors = NULL;
+    XfwMonitor *primary_monitor = NULL;
+
+    for (int i = 0; i < nmonitors; ++i) {
+        OutputCache *cache = caches[i];
+        if (cache == NULL || !cache->query.valid) {
+            continue;
+        }
+
+        gchar *connector = g_strdup(gdk_x11_get_xatom_name_for_display(display, rrmonitors[i].name));
+        XfwMonitor *monitor = steal_monitor_by_connector(previous_monitors, connector);
+        if (monitor == NULL) {
+            monitor = g_object_new(XFW_TYPE_MONITOR_X11, NULL);
+            *new_monitors = g_list_append(*new_monitors, monitor);
+            _xfw_monitor_set_connector(monitor, connector);
+            update_monitor(manager, monitor, cache, &rrmonitors[i], resources, connector, cur_workspace_num);
+        } else if (monitor_needs_update(manager, monitor, cache, &rrmonitors[i])) {
+            update_monitor(manager, monitor, cache, &rrmonitors[i], resources, connector, cur_workspace_num);
         }
-        _xfw_monitor_set_description(monitor, description);
-        g_free(description);
 
         _xfw_monitor_set_is_primary(monitor, !!rrmonitors[i].primary);
         if (rrmonitors[i].primary) {
@@ -522,10 +850,12 @@ enumerate_monitors(XfwMonitorManagerX11 *manager, GList **new_monitors, GList **
         monitors = g_list_prepend(monitors, monitor);
 
         g_free(connector);
-        XRRFreeOutputInfo(oinfo);
     }
     monitors = g_list_reverse(monitors);
 
+    g_free(caches);
+    g_hash_table_foreach_remove(manager->output_cache, drop_stale_output, manager);
+
     XRRFreeScreenResources(resources);
     if (rrmonitors != NULL) {
         XRRFreeMonitors(rrmonitors);
@@ -565,19 +895,85 @@ refresh_monitors_idled(gpointer data) {
     return FALSE;
 }
 
+static void
+schedule_refresh(XfwMonitorManagerX11 *manager) {
+    if (manager->refresh_idle_id != 0) {
+        g_source_remove(manager->refresh_idle_id);
+    }
+    manager->refresh_idle_id = g_idle_add(refresh_monitors_idled, manager);
+}
+
+static void
+mark_all_outputs_dirty(XfwMonitorManagerX11 *manager) {
+    GHashTableIter iter;
+    OutputCache *cache;
+    g_hash_table_iter_init(&iter, manager->output_cache);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer)&cache)) {
+        cache->info_dirty = TRUE;
+    }
+}
+
+static void
+handle_rr_notify(XfwMonitorManagerX11 *manager, XRRNotifyEvent *xevent) {
+    switch (xevent->subtype) {
+        case RRNotify_OutputChange: {
+            // Connection state changed, or a different monitor may have been
+            // plugged into the same connector.
+            XRROutputChangeNotifyEvent *oevent = (XRROutputChangeNotifyEvent *)xevent;
+            OutputCache *cache = g_hash_table_lookup(manager->output_cache, GUINT_TO_POINTER(oevent->output));
+            if (cache != NULL) {
+                cache->info_dirty = TRUE;
+                cache->edid_dirty = TRUE;
+            }
+            schedule_refresh(manager);
+            break;
+        }
+
+        case RRNotify_CrtcChange: {
+            XRRCrtcChangeNotifyEvent *cevent = (XRRCrtcChangeNotifyEvent *)xevent;
+            GHashTableIter iter;
+            OutputCache *cache;
+            g_hash_table_iter_init(&iter, manager->output_cache);
+            while (g_hash_table_iter_next(&iter, NULL, (gpointer)&cache)) {
+                if (cache->query.crtc == cevent->crtc) {
+                    cache->info_dirty = TRUE;
+                }
+            }
+            schedule_refresh(manager);
+            break;
+        }
+
+        case RRNotify_OutputProperty: {
+            // Other properties (backlight and the like) don't affect anything
+            // we expose.
+            XRROutputPropertyNotifyEvent *pevent = (XRROutputPropertyNotifyEvent *)xevent;
+            if (pevent->property == manager->edid_atom) {
+                OutputCache *cache = g_hash_table_lookup(manager->output_cache, GUINT_TO_POINTER(pevent->output));
+                if (cache != NULL) {
+                    cache->edid_dirty = TRUE;
+                }
+                schedule_refresh(manager);
+            }
+            break;
+        }
+
+        default:
+            mark_all_outputs_dirty(manager);
+            schedule_refresh(manager);
+            break;
+    }
+}
+
 static GdkFilterReturn
 rootwin_event_filter(GdkXEvent *gxevent, GdkEvent *event, gpointer data) {
     XfwMonitorManagerX11 *manager = data;
     XEvent *xevent = (XEvent *)gxevent;
 
-    if (manager->xrandr_event_base != -1
-        && (xevent->type - manager->xrandr_event_base == RRScreenChangeNotify
-            || xevent->type - manager->xrandr_event_base == RRNotify))
-    {
-        if (manager->refresh_idle_id != 0) {
-            g_source_remove(manager->refresh_idle_id);
-        }
-        manager->refresh_idle_id = g_idle_add(refresh_monitors_idled, manager);
+    if (manager->xrandr_event_base != -1 && xevent->type - manager->xrandr_event_base == RRScreenChangeNotify) {
+        mark_all_outputs_dirty(manager);
+        schedule_refresh(manager);
+    } else if (manager->xrandr_event_base != -1 && xevent->type - manager->xrandr_event_base == RRNotify) {
+        handle_rr_notify(manager, (XRRNotifyEvent *)xevent);
     } else if (xevent->type == PropertyNotify
                && xevent->xproperty.atom == XInternAtom(xevent->xproperty.display, "_NET_WORKAREA", False))
     {
@@ -596,10 +992,7 @@ scale_factor_changed(gint scale, gpointer data) {
         update_workareas(manager);
 
         if (manager->xrandr_event_base != -1) {
-            if (manager->refresh_idle_id != 0) {
-                g_source_remove(manager->refresh_idle_id);
-            }
-            manager->refresh_idle_id = g_idle_add(refresh_monitors_idled, manager);
+            schedule_refresh(manager);
         } else {
             GList *monitors = _xfw_screen_steal_monitors(XFW_SCREEN(manager->screen));
 
@@ -641,6 +1034,7 @@ _xfw_monitor_manager_x11_new(XfwScreenX11 *xscreen) {
     XfwMonitorManagerX11 *manager = g_new0(XfwMonitorManagerX11, 1);
     manager->screen = xscreen;
     manager->scale = 1;
+    manager->output_cache = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)output_cache_free);
 
     XfwScreen *screen = XFW_SCREEN(xscreen);
     GdkScreen *gscreen = _xfw_screen_get_gdk_screen(screen);
@@ -697,11 +1091,12 @@ _xfw_monitor_manager_x11_new(XfwScreenX11 *xscreen) {
         _xfw_screen_set_monitors(screen, monitors, monitors, NULL);
     } else {
         gdk_x11_register_standard_event_type(display, manager->xrandr_event_base, RRNumberEvents);
+        manager->edid_atom = XInternAtom(dpy, RR_PROPERTY_RANDR_EDID, False);
 
         gdk_x11_display_error_trap_push(display);
         XRRSelectInput(dpy,
                        xrootwin,
-                       RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputPropertyNotifyMask);
+                       RRScreenChangeNotifyMask | RROutputChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputPropertyNotifyMask);
         gdk_x11_display_error_trap_pop_ignored(display);
 
         refresh_monitors(manager);
@@ -731,6 +1126,7 @@ _xfw_monitor_manager_x11_destroy(XfwMonitorManagerX11 *manager) {
     GdkWindow *rootwin = gdk_screen_get_root_window(gscreen);
     gdk_window_remove_filter(rootwin, rootwin_event_filter, manager);
 
+    g_hash_table_destroy(manager->output_cache);
     g_free(manager);
 }
 
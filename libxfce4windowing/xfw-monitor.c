@@ -42,6 +42,8 @@
 #include "libxfce4windowing-private.h"
 #include "xfw-gdk-private.h"
 #include "xfw-monitor-private.h"
+#include "xfw-window-index.h"
+#include "xfw-window.h"
 #include "libxfce4windowing-visibility.h"
 
 #define XFW_MONITOR_GET_PRIVATE(monitor) ((XfwMonitorPrivate *)xfw_monitor_get_instance_private(XFW_MONITOR(monitor)))
@@ -69,6 +71,10 @@ typedef struct _XfwMonitorPrivate {
 
     GdkMonitor *gdkmonitor;
 
+    // Counter shared with the monitor index of the screen this monitor is
+    // on, bumped when the physical geometry changes
+    guint *geometry_generation;
+
     MonitorPendingChanges pending_changes;
 } XfwMonitorPrivate;
 
@@ -94,6 +100,7 @@ enum {
     PROP_TRANSFORM,
     PROP_IS_PRIMARY,
     PROP_GDK_MONITOR,
+    N_PROPERTIES,
 };
 
 static void xfw_monitor_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
@@ -103,6 +110,9 @@ static void xfw_monitor_finalize(GObject *object);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(XfwMonitor, xfw_monitor, G_TYPE_OBJECT)
 
+guint _xfw_monitor_signals[N_MONITOR_SIGNALS] = { 0 };
+static GParamSpec *monitor_properties[N_PROPERTIES] = { NULL };
+
 G_DEFINE_ENUM_TYPE(
     XfwMonitorTransform,
     xfw_monitor_transform,
@@ -133,6 +143,44 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
     gobject_class->get_property = xfw_monitor_get_property;
     gobject_class->finalize = xfw_monitor_finalize;
 
+    /**
+     * XfwMonitor::window-added:
+     * @monitor: the object which received the signal.
+     * @window: the #XfwWindow that is now on @monitor.
+     *
+     * Emitted when @window opens on @monitor, or moves or grows so that it
+     * is at least partially on @monitor.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_monitor_signals[MONITOR_SIGNAL_WINDOW_ADDED] = g_signal_new("window-added",
+                                                                     XFW_TYPE_MONITOR,
+                                                                     G_SIGNAL_RUN_LAST,
+                                                                     0,
+                                                                     NULL, NULL,
+                                                                     g_cclosure_marshal_VOID__OBJECT,
+                                                                     G_TYPE_NONE, 1,
+                                                                     XFW_TYPE_WINDOW);
+
+    /**
+     * XfwMonitor::window-removed:
+     * @monitor: the object which received the signal.
+     * @window: the #XfwWindow that is no longer on @monitor.
+     *
+     * Emitted when @window is closed, or moves or shrinks so that no part of
+     * it is on @monitor anymore.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_monitor_signals[MONITOR_SIGNAL_WINDOW_REMOVED] = g_signal_new("window-removed",
+                                                                       XFW_TYPE_MONITOR,
+                                                                       G_SIGNAL_RUN_LAST,
+                                                                       0,
+                                                                       NULL, NULL,
+                                                                       g_cclosure_marshal_VOID__OBJECT,
+                                                                       G_TYPE_NONE, 1,
+                                                                       XFW_TYPE_WINDOW);
+
     /**
      * XfwMonitor:identifier:
      *
@@ -140,13 +188,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_IDENTIFIER,
-                                    g_param_spec_string("identifier",
-                                                        "identifier",
-                                                        "Opaque, hopefully-unique monitor identifier",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_IDENTIFIER] = g_param_spec_string("identifier",
+                                                              "identifier",
+                                                              "Opaque, hopefully-unique monitor identifier",
+                                                              NULL,
+                                                              G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
     /**
      * XfwMonitor:description:
      *
@@ -154,13 +200,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_DESCRIPTION,
-                                    g_param_spec_string("description",
-                                                        "description",
-                                                        "Human-readable description",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_DESCRIPTION] = g_param_spec_string("description",
+                                                               "description",
+                                                               "Human-readable description",
+                                                               NULL,
+                                                               G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:connector:
@@ -169,13 +213,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_CONNECTOR,
-                                    g_param_spec_string("connector",
-                                                        "connector",
-                                                        "Physical/virtual connector name",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_CONNECTOR] = g_param_spec_string("connector",
+                                                             "connector",
+                                                             "Physical/virtual connector name",
+                                                             NULL,
+                                                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:make:
@@ -184,13 +226,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_MAKE,
-                                    g_param_spec_string("make",
+    monitor_properties[PROP_MAKE] = g_param_spec_string("make",
                                                         "make",
                                                         "Manufacturer name",
                                                         NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:model:
@@ -199,13 +239,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_MODEL,
-                                    g_param_spec_string("model",
-                                                        "model",
-                                                        "Product model name",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_MODEL] = g_param_spec_string("model",
+                                                         "model",
+                                                         "Product model name",
+                                                         NULL,
+                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:serial:
@@ -214,13 +252,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SERIAL,
-                                    g_param_spec_string("serial",
-                                                        "serial",
-                                                        "Product serial number",
-                                                        NULL,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_SERIAL] = g_param_spec_string("serial",
+                                                          "serial",
+                                                          "Product serial number",
+                                                          NULL,
+                                                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:edid:
@@ -229,12 +265,10 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.20.7
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_EDID,
-                                    g_param_spec_pointer("edid",
+    monitor_properties[PROP_EDID] = g_param_spec_pointer("edid",
                                                          "edid",
                                                          "EDID bytes",
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:edid-len:
@@ -243,15 +277,13 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.20.7
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_EDID_LEN,
-                                    g_param_spec_uint64("edid-len",
-                                                        "edid-len",
-                                                        "Number of bytes in the edid property",
-                                                        0,
-                                                        G_MAXUINT64,
-                                                        0,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_EDID_LEN] = g_param_spec_uint64("edid-len",
+                                                            "edid-len",
+                                                            "Number of bytes in the edid property",
+                                                            0,
+                                                            G_MAXUINT64,
+                                                            0,
+                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:refresh:
@@ -260,13 +292,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_REFRESH,
-                                    g_param_spec_uint("refresh",
-                                                      "refresh",
-                                                      "Current refresh rate, in millihertz",
-                                                      0, G_MAXUINT, 60000,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_REFRESH] = g_param_spec_uint("refresh",
+                                                         "refresh",
+                                                         "Current refresh rate, in millihertz",
+                                                         0, G_MAXUINT, 60000,
+                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:scale:
@@ -275,13 +305,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SCALE,
-                                    g_param_spec_uint("scale",
-                                                      "scale",
-                                                      "UI scaling factor",
-                                                      1, G_MAXUINT, 1,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_SCALE] = g_param_spec_uint("scale",
+                                                       "scale",
+                                                       "UI scaling factor",
+                                                       1, G_MAXUINT, 1,
+                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:fractional-scale:
@@ -290,13 +318,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_FRACTIONAL_SCALE,
-                                    g_param_spec_double("fractional-scale",
-                                                        "fractional-scale",
-                                                        "UI fractional scaling factor",
-                                                        1.0, G_MAXDOUBLE, 1.0,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_FRACTIONAL_SCALE] = g_param_spec_double("fractional-scale",
+                                                                    "fractional-scale",
+                                                                    "UI fractional scaling factor",
+                                                                    1.0, G_MAXDOUBLE, 1.0,
+                                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:physical-geometry:
@@ -305,13 +331,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_PHYSICAL_GEOMETRY,
-                                    g_param_spec_boxed("physical-geometry",
-                                                       "physical-geometry",
-                                                       "Coordinates and size of the monitor in physical device pixels",
-                                                       GDK_TYPE_RECTANGLE,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_PHYSICAL_GEOMETRY] = g_param_spec_boxed("physical-geometry",
+                                                                    "physical-geometry",
+                                                                    "Coordinates and size of the monitor in physical device pixels",
+                                                                    GDK_TYPE_RECTANGLE,
+                                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:logical-geometry:
@@ -320,13 +344,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_LOGICAL_GEOMETRY,
-                                    g_param_spec_boxed("logical-geometry",
-                                                       "logical-geometry",
-                                                       "Coordinates and size of the monitor in scaled logical pixels",
-                                                       GDK_TYPE_RECTANGLE,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_LOGICAL_GEOMETRY] = g_param_spec_boxed("logical-geometry",
+                                                                   "logical-geometry",
+                                                                   "Coordinates and size of the monitor in scaled logical pixels",
+                                                                   GDK_TYPE_RECTANGLE,
+                                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:workearea:
@@ -335,13 +357,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_WORKAREA,
-                                    g_param_spec_boxed("workarea",
-                                                       "workarea",
-                                                       "Monitor workarea in scaled logical pixels",
-                                                       GDK_TYPE_RECTANGLE,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_WORKAREA] = g_param_spec_boxed("workarea",
+                                                           "workarea",
+                                                           "Monitor workarea in scaled logical pixels",
+                                                           GDK_TYPE_RECTANGLE,
+                                                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:width-mm:
@@ -350,13 +370,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_PHYSICAL_WIDTH,
-                                    g_param_spec_uint("width-mm",
-                                                      "width-mm",
-                                                      "Physical width of the monitor in millimeters",
-                                                      0, G_MAXUINT, 0,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_PHYSICAL_WIDTH] = g_param_spec_uint("width-mm",
+                                                                "width-mm",
+                                                                "Physical width of the monitor in millimeters",
+                                                                0, G_MAXUINT, 0,
+                                                                G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:height-mm:
@@ -365,13 +383,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_PHYSICAL_HEIGHT,
-                                    g_param_spec_uint("height-mm",
-                                                      "height-mm",
-                                                      "Physical height of the monitor in millimeters",
-                                                      0, G_MAXUINT, 0,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_PHYSICAL_HEIGHT] = g_param_spec_uint("height-mm",
+                                                                 "height-mm",
+                                                                 "Physical height of the monitor in millimeters",
+                                                                 0, G_MAXUINT, 0,
+                                                                 G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:subpixel:
@@ -380,14 +396,12 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SUBPIXEL,
-                                    g_param_spec_enum("subpixel",
-                                                      "subpixel",
-                                                      "Hardware subpixel layout",
-                                                      XFW_TYPE_MONITOR_SUBPIXEL,
-                                                      XFW_MONITOR_SUBPIXEL_UNKNOWN,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_SUBPIXEL] = g_param_spec_enum("subpixel",
+                                                          "subpixel",
+                                                          "Hardware subpixel layout",
+                                                          XFW_TYPE_MONITOR_SUBPIXEL,
+                                                          XFW_MONITOR_SUBPIXEL_UNKNOWN,
+                                                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:transorm
@@ -396,14 +410,12 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_TRANSFORM,
-                                    g_param_spec_enum("transform",
-                                                      "transform",
-                                                      "Rotation and reflection of the monitor's contents",
-                                                      XFW_TYPE_MONITOR_TRANSFORM,
-                                                      XFW_MONITOR_TRANSFORM_NORMAL,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_TRANSFORM] = g_param_spec_enum("transform",
+                                                           "transform",
+                                                           "Rotation and reflection of the monitor's contents",
+                                                           XFW_TYPE_MONITOR_TRANSFORM,
+                                                           XFW_MONITOR_TRANSFORM_NORMAL,
+                                                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:is-primary:
@@ -412,13 +424,11 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_IS_PRIMARY,
-                                    g_param_spec_boolean("is-primary",
-                                                         "is-primary",
-                                                         "If this is the primary monitor",
-                                                         FALSE,
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_IS_PRIMARY] = g_param_spec_boolean("is-primary",
+                                                               "is-primary",
+                                                               "If this is the primary monitor",
+                                                               FALSE,
+                                                               G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwMonitor:gdk-monitor:
@@ -427,13 +437,13 @@ xfw_monitor_class_init(XfwMonitorClass *klass) {
      *
      * Since 4.19.4
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_GDK_MONITOR,
-                                    g_param_spec_object("gdk-monitor",
-                                                        "gdk-monitor",
-                                                        "Monitor's GdkMonitor",
-                                                        GDK_TYPE_MONITOR,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    monitor_properties[PROP_GDK_MONITOR] = g_param_spec_object("gdk-monitor",
+                                                               "gdk-monitor",
+                                                               "Monitor's GdkMonitor",
+                                                               GDK_TYPE_MONITOR,
+                                                               G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_PROPERTIES, monitor_properties);
 }
 
 static void
@@ -555,6 +565,9 @@ xfw_monitor_finalize(GObject *object) {
     g_free(priv->model);
     g_free(priv->serial);
     g_free(priv->edid);
+    if (priv->geometry_generation != NULL) {
+        g_rc_box_release(priv->geometry_generation);
+    }
 
     G_OBJECT_CLASS(xfw_monitor_parent_class)->finalize(object);
 }
@@ -911,6 +924,32 @@ xfw_monitor_get_gdk_monitor(XfwMonitor *monitor) {
     return priv->gdkmonitor;
 }
 
+/**
+ * xfw_monitor_list_windows:
+ * @monitor: a #XfwMonitor.
+ *
+ * Lists the windows that are at least partially on @monitor, as returned by
+ * #xfw_window_get_monitors().
+ *
+ * The list is kept up to date as windows open, close, and move between
+ * monitors, so this is much cheaper than filtering the result of
+ * #xfw_screen_get_windows() for every monitor.  Connect to
+ * #XfwMonitor::window-added and #XfwMonitor::window-removed to find out when
+ * it changes.  The windows are not in stacking order.
+ *
+ * Return value: (nullable) (element-type XfwWindow) (transfer none): the list
+ * of #XfwWindow on @monitor, or %NULL if there are none.  The list and its
+ * contents are owned by @monitor, and the list is only valid until the next
+ * time a window is added to or removed from @monitor.
+ *
+ * Since: 4.21.0
+ **/
+GList *
+xfw_monitor_list_windows(XfwMonitor *monitor) {
+    g_return_val_if_fail(XFW_IS_MONITOR(monitor), NULL);
+    return _xfw_window_index_list_windows(monitor);
+}
+
 
 void
 _xfw_monitor_set_identifier(XfwMonitor *monitor, const char *identifier) {
@@ -1053,6 +1092,25 @@ _xfw_monitor_set_physical_geometry(XfwMonitor *monitor, GdkRectangle *physical_g
     if (!gdk_rectangle_equal(&priv->physical_geometry, physical_geometry)) {
         priv->physical_geometry = *physical_geometry;
         priv->pending_changes |= MONITOR_PENDING_PHYSICAL_GEOMETRY;
+        if (priv->geometry_generation != NULL) {
+            (*priv->geometry_generation)++;
+        }
+    }
+}
+
+// @generation is a g_rc_box()-allocated counter; the monitor keeps a
+// reference to it, so it doesn't matter whether the monitor or its index
+// goes away first.
+void
+_xfw_monitor_set_geometry_generation(XfwMonitor *monitor, guint *generation) {
+    g_return_if_fail(XFW_IS_MONITOR(monitor));
+
+    XfwMonitorPrivate *priv = XFW_MONITOR_GET_PRIVATE(monitor);
+    if (priv->geometry_generation != generation) {
+        if (priv->geometry_generation != NULL) {
+            g_rc_box_release(priv->geometry_generation);
+        }
+        priv->geometry_generation = generation != NULL ? g_rc_box_acquire(generation) : NULL;
     }
 }
 
@@ -1243,26 +1301,26 @@ MonitorPendingChanges
 _xfw_monitor_notify_pending_changes(XfwMonitor *monitor) {
     static const struct {
         MonitorPendingChanges bit;
-        const gchar *property;
+        guint prop_id;
     } change_map[] = {
-        { MONITOR_PENDING_IDENTIFIER, "identifier" },
-        { MONITOR_PENDING_CONNECTOR, "connector" },
-        { MONITOR_PENDING_DESCRIPTION, "description" },
-        { MONITOR_PENDING_MAKE, "make" },
-        { MONITOR_PENDING_MODEL, "model" },
-        { MONITOR_PENDING_SERIAL, "serial" },
-        { MONITOR_PENDING_REFRESH, "refresh" },
-        { MONITOR_PENDING_SCALE, "scale" },
-        { MONITOR_PENDING_FRACTIONAL_SCALE, "fractional-scale" },
-        { MONITOR_PENDING_PHYSICAL_GEOMETRY, "physical-geometry" },
-        { MONITOR_PENDING_LOGICAL_GEOMETRY, "logical-geometry" },
-        { MONITOR_PENDING_WORKAREA, "workarea" },
-        { MONITOR_PENDING_PHYSICAL_WIDTH, "width-mm" },
-        { MONITOR_PENDING_PHYSICAL_HEIGHT, "height-mm" },
-        { MONITOR_PENDING_SUBPIXEL, "subpixel" },
-        { MONITOR_PENDING_TRANSFORM, "transform" },
-        { MONITOR_PENDING_IS_PRIMARY, "is-primary" },
-        { MONITOR_PENDING_EDID, "edid" },
+        { MONITOR_PENDING_IDENTIFIER, PROP_IDENTIFIER },
+        { MONITOR_PENDING_CONNECTOR, PROP_CONNECTOR },
+        { MONITOR_PENDING_DESCRIPTION, PROP_DESCRIPTION },
+        { MONITOR_PENDING_MAKE, PROP_MAKE },
+        { MONITOR_PENDING_MODEL, PROP_MODEL },
+        { MONITOR_PENDING_SERIAL, PROP_SERIAL },
+        { MONITOR_PENDING_REFRESH, PROP_REFRESH },
+        { MONITOR_PENDING_SCALE, PROP_SCALE },
+        { MONITOR_PENDING_FRACTIONAL_SCALE, PROP_FRACTIONAL_SCALE },
+        { MONITOR_PENDING_PHYSICAL_GEOMETRY, PROP_PHYSICAL_GEOMETRY },
+        { MONITOR_PENDING_LOGICAL_GEOMETRY, PROP_LOGICAL_GEOMETRY },
+        { MONITOR_PENDING_WORKAREA, PROP_WORKAREA },
+        { MONITOR_PENDING_PHYSICAL_WIDTH, PROP_PHYSICAL_WIDTH },
+        { MONITOR_PENDING_PHYSICAL_HEIGHT, PROP_PHYSICAL_HEIGHT },
+        { MONITOR_PENDING_SUBPIXEL, PROP_SUBPIXEL },
+        { MONITOR_PENDING_TRANSFORM, PROP_TRANSFORM },
+        { MONITOR_PENDING_IS_PRIMARY, PROP_IS_PRIMARY },
+        { MONITOR_PENDING_EDID, PROP_EDID },
     };
     XfwMonitorPrivate *priv = XFW_MONITOR_GET_PRIVATE(monitor);
 
@@ -1270,9 +1328,9 @@ _xfw_monitor_notify_pending_changes(XfwMonitor *monitor) {
 
     for (gsize i = 0; i < G_N_ELEMENTS(change_map); ++i) {
         if ((priv->pending_changes & change_map[i].bit) != 0) {
-            g_object_notify(G_OBJECT(monitor), change_map[i].property);
+            g_object_notify_by_pspec(G_OBJECT(monitor), monitor_properties[change_map[i].prop_id]);
             if (change_map[i].bit == MONITOR_PENDING_EDID) {
-                g_object_notify(G_OBJECT(monitor), "edid-len");
+                g_object_notify_by_pspec(G_OBJECT(monitor), monitor_properties[PROP_EDID_LEN]);
             }
         }
     }
@@ -115,6 +115,8 @@ gboolean xfw_monitor_is_primary(XfwMonitor *monitor);
 
 GdkMonitor *xfw_monitor_get_gdk_monitor(XfwMonitor *monitor);
 
+GList *xfw_monitor_list_windows(XfwMonitor *monitor);
+
 G_END_DECLS
 
 #endif /* __XFW_MONITOR_H__ */
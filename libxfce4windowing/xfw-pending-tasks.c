@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// Each task gets a GCancellableSource on its own main context, so a
+// cancelled task is completed from the main loop, never from inside
+// g_cancellable_cancel(), and the source can be destroyed safely once the
+// reply has arrived.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-pending-tasks.h"
+
+struct _XfwPendingTasks {
+    // PendingTask, in the order they were added
+    GQueue tasks;
+};
+
+typedef struct {
+    XfwPendingTasks *pending;
+    GTask *task;
+    GSource *cancelled_source;
+    GList link;
+} PendingTask;
+
+static void
+pending_task_unwatch(PendingTask *pending_task) {
+    if (pending_task->cancelled_source != NULL) {
+        g_source_destroy(pending_task->cancelled_source);
+        g_source_unref(pending_task->cancelled_source);
+        pending_task->cancelled_source = NULL;
+    }
+}
+
+static gboolean
+pending_task_cancelled(GCancellable *cancellable, gpointer data) {
+    PendingTask *pending_task = data;
+    GTask *task = pending_task->task;
+
+    g_queue_unlink(&pending_task->pending->tasks, &pending_task->link);
+    pending_task_unwatch(pending_task);
+    g_free(pending_task);
+
+    // The cancellable may have been reset since it fired
+    if (!g_task_return_error_if_cancelled(task)) {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_CANCELLED, "Operation was cancelled");
+    }
+    g_object_unref(task);
+
+    return G_SOURCE_REMOVE;
+}
+
+XfwPendingTasks *
+_xfw_pending_tasks_new(void) {
+    XfwPendingTasks *pending = g_new0(XfwPendingTasks, 1);
+    g_queue_init(&pending->tasks);
+    return pending;
+}
+
+// Anything still waiting is completed with G_IO_ERROR_CANCELLED.
+void
+_xfw_pending_tasks_free(XfwPendingTasks *pending) {
+    if (pending != NULL) {
+        if (pending->tasks.length > 0) {
+            GError *error = g_error_new_literal(G_IO_ERROR, G_IO_ERROR_CANCELLED, "Operation was cancelled");
+            _xfw_pending_tasks_return_error(pending, error);
+            g_error_free(error);
+        }
+        g_free(pending);
+    }
+}
+
+// Takes ownership of @task.
+void
+_xfw_pending_tasks_add(XfwPendingTasks *pending, GTask *task) {
+    PendingTask *pending_task = g_new0(PendingTask, 1);
+    GCancellable *cancellable = g_task_get_cancellable(task);
+
+    pending_task->pending = pending;
+    pending_task->task = task;
+    pending_task->link.data = pending_task;
+    g_queue_push_tail_link(&pending->tasks, &pending_task->link);
+
+    if (cancellable != NULL) {
+        pending_task->cancelled_source = g_cancellable_source_new(cancellable);
+        g_source_set_callback(pending_task->cancelled_source,
+                              G_SOURCE_FUNC(pending_task_cancelled),
+                              pending_task,
+                              NULL);
+        g_source_attach(pending_task->cancelled_source, g_task_get_context(task));
+    }
+}
+
+guint
+_xfw_pending_tasks_get_n_tasks(XfwPendingTasks *pending) {
+    return pending->tasks.length;
+}
+
+// Returns the waiting tasks, oldest first, which the caller now owns and
+// must complete.  Cancelling them no longer completes them.
+GList *
+_xfw_pending_tasks_steal(XfwPendingTasks *pending) {
+    GList *tasks = NULL;
+
+    while (pending->tasks.length > 0) {
+        PendingTask *pending_task = g_queue_pop_tail_link(&pending->tasks)->data;
+        pending_task_unwatch(pending_task);
+        tasks = g_list_prepend(tasks, pending_task->task);
+        g_free(pending_task);
+    }
+
+    return tasks;
+}
+
+// Completes every waiting task with a copy of @error, or with
+// G_IO_ERROR_CANCELLED if the task was cancelled.
+void
+_xfw_pending_tasks_return_error(XfwPendingTasks *pending, const GError *error) {
+    GList *tasks = _xfw_pending_tasks_steal(pending);
+
+    for (GList *l = tasks; l != NULL; l = l->next) {
+        GTask *task = G_TASK(l->data);
+        if (!g_task_return_error_if_cancelled(task)) {
+            g_task_return_error(task, g_error_copy(error));
+        }
+    }
+    g_list_free_full(tasks, g_object_unref);
+}
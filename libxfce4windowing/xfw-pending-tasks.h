@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_PENDING_TASKS_H__
+#define __XFW_PENDING_TASKS_H__
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+// GTasks waiting on the same reply.  A task whose cancellable is cancelled
+// is completed with G_IO_ERROR_CANCELLED right away, rather than whenever
+// (if ever) the reply arrives.
+typedef struct _XfwPendingTasks XfwPendingTasks;
+
+XfwPendingTasks *_xfw_pending_tasks_new(void);
+void _xfw_pending_tasks_free(XfwPendingTasks *pending);
+
+void _xfw_pending_tasks_add(XfwPendingTasks *pending, GTask *task);
+guint _xfw_pending_tasks_get_n_tasks(XfwPendingTasks *pending);
+
+GList *_xfw_pending_tasks_steal(XfwPendingTasks *pending);
+void _xfw_pending_tasks_return_error(XfwPendingTasks *pending, const GError *error);
+
+G_END_DECLS
+
+#endif /* __XFW_PENDING_TASKS_H__ */
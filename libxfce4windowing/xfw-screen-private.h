@@ -33,6 +33,24 @@
 
 G_BEGIN_DECLS
 
+enum {
+    SCREEN_SIGNAL_SEAT_ADDED,
+    SCREEN_SIGNAL_SEAT_REMOVED,
+    SCREEN_SIGNAL_WINDOW_OPENED,
+    SCREEN_SIGNAL_ACTIVE_WINDOW_CHANGED,
+    SCREEN_SIGNAL_WINDOW_STACKING_CHANGED,
+    SCREEN_SIGNAL_WINDOW_CLOSED,
+    SCREEN_SIGNAL_WINDOW_MANAGER_CHANGED,
+    SCREEN_SIGNAL_MONITOR_ADDED,
+    SCREEN_SIGNAL_MONITOR_REMOVED,
+    SCREEN_SIGNAL_MONITORS_CHANGED,
+    SCREEN_SIGNAL_CHANGES_COMMITTED,
+    N_SCREEN_SIGNALS,
+};
+
+// Signal ids, indexed by SCREEN_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_screen_signals[N_SCREEN_SIGNALS];
+
 struct _XfwScreenClass {
     /*< private >*/
     GObjectClass parent_class;
@@ -49,8 +67,20 @@ struct _XfwScreenClass {
     /* Virtual Table */
     GList *(*get_windows)(XfwScreen *screen);
     GList *(*get_windows_stacked)(XfwScreen *screen);
+    gint (*get_stacking_index)(XfwScreen *screen, XfwWindow *window);
 
     void (*set_show_desktop)(XfwScreen *screen, gboolean show);
+
+    // Blocks until the screen is ready; only needed when construction is asynchronous
+    void (*wait_ready)(XfwScreen *screen);
+
+    // The windows that may turn out to be on @monitor, which has just been
+    // added (container only; free with g_list_free()).  Without this, every
+    // window is asked.
+    GList *(*get_windows_for_new_monitor)(XfwScreen *screen, XfwMonitor *monitor);
+
+    // Sends any requests that are still buffered to the display server
+    void (*flush)(XfwScreen *screen);
 };
 
 GdkScreen *_xfw_screen_get_gdk_screen(XfwScreen *screen);
@@ -61,13 +91,19 @@ void _xfw_screen_seat_removed(XfwScreen *screen, XfwSeat *seat);
 void _xfw_screen_set_workspace_manager(XfwScreen *screen, XfwWorkspaceManager *workspace_manager);
 
 void _xfw_screen_set_active_window(XfwScreen *screen, XfwWindow *window);
+void _xfw_screen_window_changed(XfwScreen *screen, XfwWindow *window, XfwWindowChangeFlags changes);
 
 GList *_xfw_screen_steal_monitors(XfwScreen *screen);
 void _xfw_screen_set_monitors(XfwScreen *screen, GList *monitors, GList *added, GList *removed);
+GList *_xfw_screen_get_monitors_for_rect(XfwScreen *screen, const GdkRectangle *rect);
 void _xfw_screen_set_primary_monitor(XfwScreen *screen, XfwMonitor *primary_monitor);
 
 void _xfw_screen_set_show_desktop(XfwScreen *screen, gboolean show_desktop);
 
+void _xfw_screen_set_ready(XfwScreen *screen);
+
+XfwScreenSnapshot *_xfw_screen_snapshot_new(GList *windows, guint64 generation);
+
 G_END_DECLS
 
 #endif /* !__XFW_SCREEN_PRIVATE_H__ */
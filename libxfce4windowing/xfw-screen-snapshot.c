@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+/**
+ * SECTION:xfw-screen-snapshot
+ * @title: XfwScreenSnapshot
+ * @short_description: An immutable copy of the state of all windows
+ * @stability: Unstable
+ * @include: libxfce4windowing/libxfce4windowing.h
+ *
+ * #XfwScreenSnapshot holds an #XfwWindowRecord for each window on an
+ * #XfwScreen, in stacking order, with the bottom-most window first.  The
+ * records are plain structs in a single array, so code that needs to look
+ * at every window, such as a pager redrawing itself, can walk them without
+ * going through the #XfwWindow getters one property at a time.
+ *
+ * Obtain a snapshot with #xfw_screen_snapshot().  The screen keeps handing
+ * out the same snapshot until one of its windows changes, opens or closes,
+ * or the stacking order changes, so taking a snapshot on every redraw is
+ * cheap.  Each new snapshot has a higher generation number than the
+ * previous one (see #xfw_screen_snapshot_get_generation()), which can be
+ * used to tell whether anything needs to be redrawn.
+ *
+ * Snapshots are never modified after they are created.  Like the rest of
+ * the library, they are meant to be used from the main thread: a snapshot
+ * holds references to the windows, workspaces, monitors and applications
+ * it describes, and releasing the last reference to the snapshot releases
+ * those too, so the last #xfw_screen_snapshot_unref() must happen on the
+ * main thread.
+ **/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-screen-private.h"
+#include "xfw-screen-snapshot.h"
+#include "libxfce4windowing-visibility.h"
+
+struct _XfwScreenSnapshot {
+    gatomicrefcount ref_count;
+    guint64 generation;
+
+    XfwWindowRecord *records;
+    guint n_records;
+
+    // Backing storage for the records' strings and arrays
+    GStringChunk *strings;
+    const gchar **class_ids;
+    XfwMonitor **monitors;
+};
+
+G_DEFINE_BOXED_TYPE(XfwScreenSnapshot, xfw_screen_snapshot, xfw_screen_snapshot_ref, xfw_screen_snapshot_unref)
+
+// Takes a copy of the state of each window in @windows, which should be in
+// stacking order.
+XfwScreenSnapshot *
+_xfw_screen_snapshot_new(GList *windows, guint64 generation) {
+    XfwScreenSnapshot *snapshot = g_new0(XfwScreenSnapshot, 1);
+    guint n_class_ids = 0;
+    guint n_monitors = 0;
+
+    g_atomic_ref_count_init(&snapshot->ref_count);
+    snapshot->generation = generation;
+
+    // Size everything up front, so the records can point straight into the
+    // shared arrays
+    for (GList *l = windows; l != NULL; l = l->next) {
+        XfwWindow *window = XFW_WINDOW(l->data);
+        const gchar *const *class_ids = xfw_window_get_class_ids(window);
+        n_class_ids += (class_ids != NULL ? g_strv_length((gchar **)class_ids) : 0) + 1;
+        n_monitors += g_list_length(xfw_window_get_monitors(window));
+        ++snapshot->n_records;
+    }
+
+    snapshot->records = g_new0(XfwWindowRecord, snapshot->n_records);
+    snapshot->strings = g_string_chunk_new(1024);
+    snapshot->class_ids = g_new(const gchar *, n_class_ids);
+    snapshot->monitors = g_new(XfwMonitor *, n_monitors);
+
+    const gchar **next_class_id = snapshot->class_ids;
+    XfwMonitor **next_monitor = snapshot->monitors;
+    XfwWindowRecord *record = snapshot->records;
+    for (GList *l = windows; l != NULL; l = l->next, ++record) {
+        XfwWindow *window = XFW_WINDOW(l->data);
+
+        record->window = g_object_ref(window);
+        const gchar *name = xfw_window_get_name(window);
+        record->name = name != NULL ? g_string_chunk_insert_const(snapshot->strings, name) : NULL;
+        record->window_type = xfw_window_get_window_type(window);
+        record->state = xfw_window_get_state(window);
+        record->capabilities = xfw_window_get_capabilities(window);
+        record->geometry = *xfw_window_get_geometry(window);
+
+        record->class_ids = next_class_id;
+        const gchar *const *class_ids = xfw_window_get_class_ids(window);
+        for (guint i = 0; class_ids != NULL && class_ids[i] != NULL; ++i) {
+            *next_class_id++ = g_string_chunk_insert_const(snapshot->strings, class_ids[i]);
+        }
+        *next_class_id++ = NULL;
+
+        XfwWorkspace *workspace = xfw_window_get_workspace(window);
+        record->workspace = workspace != NULL ? g_object_ref(workspace) : NULL;
+
+        record->monitors = next_monitor;
+        for (GList *lm = xfw_window_get_monitors(window); lm != NULL; lm = lm->next) {
+            *next_monitor++ = g_object_ref(lm->data);
+            ++record->n_monitors;
+        }
+
+        XfwApplication *application = xfw_window_get_application(window);
+        record->application = application != NULL ? g_object_ref(application) : NULL;
+    }
+
+    return snapshot;
+}
+
+/**
+ * xfw_screen_snapshot_ref:
+ * @snapshot: an #XfwScreenSnapshot.
+ *
+ * Increases the reference count of @snapshot by one.
+ *
+ * Return value: (transfer full): @snapshot.
+ *
+ * Since: 4.21.0
+ **/
+XfwScreenSnapshot *
+xfw_screen_snapshot_ref(XfwScreenSnapshot *snapshot) {
+    g_return_val_if_fail(snapshot != NULL, NULL);
+    g_atomic_ref_count_inc(&snapshot->ref_count);
+    return snapshot;
+}
+
+/**
+ * xfw_screen_snapshot_unref:
+ * @snapshot: (transfer full): an #XfwScreenSnapshot.
+ *
+ * Decreases the reference count of @snapshot by one, freeing it, and
+ * releasing its references to the windows and other objects it refers to,
+ * when the count drops to zero.  The last reference must be released on the
+ * main thread.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_screen_snapshot_unref(XfwScreenSnapshot *snapshot) {
+    g_return_if_fail(snapshot != NULL);
+
+    if (g_atomic_ref_count_dec(&snapshot->ref_count)) {
+        for (guint i = 0; i < snapshot->n_records; ++i) {
+            XfwWindowRecord *record = &snapshot->records[i];
+            g_object_unref(record->window);
+            if (record->workspace != NULL) {
+                g_object_unref(record->workspace);
+            }
+            for (guint j = 0; j < record->n_monitors; ++j) {
+                g_object_unref(record->monitors[j]);
+            }
+            if (record->application != NULL) {
+                g_object_unref(record->application);
+            }
+        }
+
+        g_free(snapshot->records);
+        g_string_chunk_free(snapshot->strings);
+        g_free(snapshot->class_ids);
+        g_free(snapshot->monitors);
+        g_free(snapshot);
+    }
+}
+
+/**
+ * xfw_screen_snapshot_get_generation:
+ * @snapshot: an #XfwScreenSnapshot.
+ *
+ * Retrieves the generation number of @snapshot.  Snapshots taken from the
+ * same #XfwScreen have the same generation number if and only if they are
+ * the same snapshot, and later snapshots have higher numbers.
+ *
+ * Return value: the generation number.
+ *
+ * Since: 4.21.0
+ **/
+guint64
+xfw_screen_snapshot_get_generation(XfwScreenSnapshot *snapshot) {
+    g_return_val_if_fail(snapshot != NULL, 0);
+    return snapshot->generation;
+}
+
+/**
+ * xfw_screen_snapshot_get_windows:
+ * @snapshot: an #XfwScreenSnapshot.
+ * @n_windows: (out): return location for the number of windows.
+ *
+ * Retrieves the window records in @snapshot, in stacking order, with the
+ * bottom-most window first.
+ *
+ * Return value: (array length=n_windows) (transfer none): an array of
+ * #XfwWindowRecord, owned by @snapshot.
+ *
+ * Since: 4.21.0
+ **/
+const XfwWindowRecord *
+xfw_screen_snapshot_get_windows(XfwScreenSnapshot *snapshot, guint *n_windows) {
+    g_return_val_if_fail(snapshot != NULL, NULL);
+    g_return_val_if_fail(n_windows != NULL, NULL);
+    *n_windows = snapshot->n_records;
+    return snapshot->records;
+}
+
+#define __XFW_SCREEN_SNAPSHOT_C__
+#include "libxfce4windowing-visibility.c"
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_SCREEN_SNAPSHOT_H__
+#define __XFW_SCREEN_SNAPSHOT_H__
+
+#if !defined(__LIBXFCE4WINDOWING_H_INSIDE__) && !defined(LIBXFCE4WINDOWING_COMPILATION)
+#error "Only libxfce4windowing.h can be included directly"
+#endif
+
+#include <libxfce4windowing/xfw-application.h>
+#include <libxfce4windowing/xfw-monitor.h>
+#include <libxfce4windowing/xfw-window.h>
+#include <libxfce4windowing/xfw-workspace.h>
+
+G_BEGIN_DECLS
+
+#define XFW_TYPE_SCREEN_SNAPSHOT (xfw_screen_snapshot_get_type())
+
+typedef struct _XfwScreenSnapshot XfwScreenSnapshot;
+
+/**
+ * XfwWindowRecord:
+ * @window: the #XfwWindow this record describes.
+ * @name: (nullable): the window's name, as returned by #xfw_window_get_name().
+ * @class_ids: (array zero-terminated=1): the window's class IDs, as returned
+ *             by #xfw_window_get_class_ids().
+ * @window_type: the window's #XfwWindowType.
+ * @state: the window's #XfwWindowState.
+ * @capabilities: the window's #XfwWindowCapabilities.
+ * @geometry: the window's position and size, as returned by
+ *            #xfw_window_get_geometry().
+ * @workspace: (nullable): the window's workspace, or %NULL.
+ * @monitors: (array length=n_monitors): the monitors the window is on.
+ * @n_monitors: the number of entries in @monitors.
+ * @application: (nullable): the window's #XfwApplication.
+ *
+ * A copy of the state of an #XfwWindow at the time an #XfwScreenSnapshot
+ * was taken.  The strings and arrays are owned by the snapshot, and the
+ * snapshot holds a reference to each of the objects, so everything stays
+ * valid for as long as the snapshot does, even after the window has
+ * closed.
+ *
+ * Since: 4.21.0
+ **/
+typedef struct {
+    XfwWindow *window;
+    const gchar *name;
+    const gchar *const *class_ids;
+    XfwWindowType window_type;
+    XfwWindowState state;
+    XfwWindowCapabilities capabilities;
+    GdkRectangle geometry;
+    XfwWorkspace *workspace;
+    XfwMonitor *const *monitors;
+    guint n_monitors;
+    XfwApplication *application;
+} XfwWindowRecord;
+
+GType xfw_screen_snapshot_get_type(void);
+
+XfwScreenSnapshot *xfw_screen_snapshot_ref(XfwScreenSnapshot *snapshot);
+void xfw_screen_snapshot_unref(XfwScreenSnapshot *snapshot);
+
+guint64 xfw_screen_snapshot_get_generation(XfwScreenSnapshot *snapshot);
+const XfwWindowRecord *xfw_screen_snapshot_get_windows(XfwScreenSnapshot *snapshot,
+                                                       guint *n_windows);
+
+G_END_DECLS
+
+#endif /* !__XFW_SCREEN_SNAPSHOT_H__ */
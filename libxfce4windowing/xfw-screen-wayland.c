@@ -36,17 +36,30 @@
 #include "xfw-screen-private.h"
 #include "xfw-screen-wayland.h"
 #include "xfw-seat-wayland.h"
+#include "xfw-show-desktop.h"
 #include "xfw-util.h"
+#include "xfw-window-registry.h"
 #include "xfw-window-wayland.h"
 #include "xfw-workspace-manager-dummy.h"
 #include "xfw-workspace-manager-wayland.h"
 
+typedef enum {
+    // Waiting for the registry globals, and for seat capabilities
+    BOOTSTRAP_GLOBALS,
+    // Waiting for outputs, workspaces, and toplevels
+    BOOTSTRAP_MANAGERS,
+    // Waiting for the xfce toplevel handles of the initial toplevels
+    BOOTSTRAP_XFCE_HANDLES,
+    BOOTSTRAP_DONE,
+} BootstrapStage;
+
 struct _XfwScreenWayland {
     XfwScreen parent;
 
     struct wl_display *wl_display;
     struct wl_registry *wl_registry;
     GList *async_roundtrips;
+    BootstrapStage bootstrap_stage;
 
     GList *pending_seats;
 
@@ -61,13 +74,12 @@ struct _XfwScreenWayland {
     uint32_t workspace_manager_name;
     uint32_t workspace_manager_version;
 
-    GList *windows;
-    GList *windows_stacked;
-    GHashTable *wlr_windows;
-    struct {
-        GList *minimized;
-        XfwWindow *was_active;
-    } show_desktop_data;
+    // Keyed by zwlr_foreign_toplevel_handle_v1
+    XfwWindowRegistry *windows;
+    // wl_output -> set of XfwWindow, for windows that entered an output
+    // before its monitor was added
+    GHashTable *pending_output_windows;
+    XfwShowDesktop *show_desktop;
 
     XfwMonitorManagerWayland *monitor_manager;
 };
@@ -77,12 +89,18 @@ static void xfw_screen_wayland_finalize(GObject *obj);
 static GList *xfw_screen_wayland_get_windows(XfwScreen *screen);
 static GList *xfw_screen_wayland_get_windows_stacked(XfwScreen *screen);
 static void xfw_screen_wayland_set_show_desktop(XfwScreen *screen, gboolean show);
+static void xfw_screen_wayland_wait_ready(XfwScreen *screen);
+static void xfw_screen_wayland_flush(XfwScreen *screen);
+static GList *xfw_screen_wayland_get_windows_for_new_monitor(XfwScreen *screen, XfwMonitor *monitor);
 
-static void show_desktop_disconnect(gpointer object, gpointer data);
+static void show_desktop_window_closed(XfwScreenWayland *wscreen, XfwWindow *window);
 
 static void add_async_roundtrip(XfwScreenWayland *screen);
 static void async_roundtrip_done(void *data, struct wl_callback *callback, uint32_t callback_id);
 
+static void bootstrap_advance(XfwScreenWayland *screen);
+static void bootstrap_finish(XfwScreenWayland *screen);
+
 static void init_toplevel_manager(XfwScreenWayland *screen);
 static void init_workspace_manager(XfwScreenWayland *screen);
 
@@ -118,13 +136,18 @@ xfw_screen_wayland_class_init(XfwScreenWaylandClass *klass) {
     screen_class->get_windows = xfw_screen_wayland_get_windows;
     screen_class->get_windows_stacked = xfw_screen_wayland_get_windows_stacked;
     screen_class->set_show_desktop = xfw_screen_wayland_set_show_desktop;
+    screen_class->wait_ready = xfw_screen_wayland_wait_ready;
+    screen_class->flush = xfw_screen_wayland_flush;
+    screen_class->get_windows_for_new_monitor = xfw_screen_wayland_get_windows_for_new_monitor;
 }
 
 static void
 xfw_screen_wayland_init(XfwScreenWayland *screen) {
     screen->defer_wlr_toplevel_manager = TRUE;
     screen->defer_workspace_manager = TRUE;
-    screen->wlr_windows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
+    screen->windows = _xfw_window_registry_new();
+    screen->pending_output_windows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)g_hash_table_destroy);
+    screen->show_desktop = _xfw_show_desktop_new();
 }
 
 static void
@@ -141,63 +164,12 @@ xfw_screen_wayland_constructed(GObject *obj) {
 
     wscreen->monitor_manager = _xfw_monitor_manager_wayland_new(wscreen, wscreen->wl_registry);
 
-    wl_display_roundtrip(wscreen->wl_display);
-    while (wscreen->async_roundtrips != NULL) {
-        wl_display_dispatch(wscreen->wl_display);
-    }
-
-    // We defer binding outputs until after we have the wl_seat instances so
-    // that xfce_output_manager's pointer_enter will work.
-    _xfw_monitor_manager_wayland_start(wscreen->monitor_manager);
-    // FIXME: one per output?  one per output & per xdg_output & per xfce_output?
+    // The rest of the initial setup happens as our roundtrips complete (see
+    // bootstrap_advance()), so constructing the screen never blocks.  The
+    // "ready" property is set once everything has been received.
+    wscreen->bootstrap_stage = BOOTSTRAP_GLOBALS;
     add_async_roundtrip(wscreen);
-
-    // We defer binding to the toplevel and workspace managers until after we have all
-    // XfwMonitor instances initialized.  Otherwise, we would get output_enter
-    // events for toplevels or workspace groups, but have no XfwMonitor to match them to.
-    //
-    // We also need to bind the workspage manager before the toplevel manager,
-    // because the xfce extension protocol for the toplevel manager will need
-    // workspaces available.
-    wscreen->defer_workspace_manager = FALSE;
-    if (wscreen->workspace_manager_name != 0 && wscreen->workspace_manager_version != 0) {
-        init_workspace_manager(wscreen);
-    }
-    wscreen->defer_wlr_toplevel_manager = FALSE;
-    if (wscreen->wlr_toplevel_manager_name != 0 && wscreen->wlr_toplevel_manager_version != 0) {
-        init_toplevel_manager(wscreen);
-    }
-    if (wscreen->wlr_toplevel_manager != NULL) {
-        while (wscreen->async_roundtrips != NULL) {
-            wl_display_dispatch(wscreen->wl_display);
-        }
-
-        if (wscreen->xfce_toplevel_manager != NULL) {
-            if (wscreen->windows != NULL) {
-                // If we have the xfce toplevel manager and at least one window,
-                // then one of the previous roundtrips will have caused us to
-                // request xfce toplevel handles.  All that should take one more
-                // roundtrip to come back to us, so add another.
-                add_async_roundtrip(wscreen);
-                while (wscreen->async_roundtrips != NULL) {
-                    wl_display_dispatch(wscreen->wl_display);
-                }
-            }
-        } else {
-            g_message("Window<->Workspace association is not available on your compositor");
-        }
-    } else {
-        g_message("Your compositor does not support the wlr_foreign_toplevel_manager_v1 protocol");
-    }
-
-    if (xfw_screen_get_workspace_manager(XFW_SCREEN(screen)) != NULL) {
-        while (wscreen->async_roundtrips != NULL) {
-            wl_display_dispatch(wscreen->wl_display);
-        }
-    } else {
-        g_message("Your compositor does not support the ext_workspace_manager_v1 protocol");
-        _xfw_screen_set_workspace_manager(XFW_SCREEN(screen), _xfw_workspace_manager_dummy_new(screen));
-    }
+    wl_display_flush(wscreen->wl_display);
 }
 
 static void
@@ -218,107 +190,131 @@ xfw_screen_wayland_finalize(GObject *obj) {
     if (screen->wl_registry != NULL) {
         wl_registry_destroy(screen->wl_registry);
     }
-    g_list_free(screen->windows);
-    g_list_free(screen->windows_stacked);
-    g_hash_table_destroy(screen->wlr_windows);
-    g_list_free(screen->show_desktop_data.minimized);
+    _xfw_window_registry_free(screen->windows);
+    g_hash_table_destroy(screen->pending_output_windows);
+    _xfw_show_desktop_free(screen->show_desktop);
 
     G_OBJECT_CLASS(xfw_screen_wayland_parent_class)->finalize(obj);
 }
 
 static GList *
 xfw_screen_wayland_get_windows(XfwScreen *screen) {
-    return XFW_SCREEN_WAYLAND(screen)->windows;
+    return _xfw_window_registry_get_windows(XFW_SCREEN_WAYLAND(screen)->windows);
 }
 
 static GList *
 xfw_screen_wayland_get_windows_stacked(XfwScreen *screen) {
     _xfw_g_message_once("Wayland does not support discovering window stacking; windows returned are unordered");
-    return XFW_SCREEN_WAYLAND(screen)->windows_stacked;
+    return _xfw_window_registry_get_windows_stacked(XFW_SCREEN_WAYLAND(screen)->windows);
 }
 
 static void
-show_desktop_state_changed(XfwWindow *window, XfwWindowState changed_mask, XfwWindowState new_state, XfwScreenWayland *wscreen) {
-    if (!(changed_mask & XFW_WINDOW_STATE_MINIMIZED)) {
-        return;
-    }
+xfw_screen_wayland_wait_ready(XfwScreen *screen) {
+    XfwScreenWayland *wscreen = XFW_SCREEN_WAYLAND(screen);
 
-    if (new_state & XFW_WINDOW_STATE_MINIMIZED) {
-        wscreen->show_desktop_data.minimized = g_list_prepend(wscreen->show_desktop_data.minimized, window);
-    } else {
-        show_desktop_disconnect(window, wscreen);
-        wscreen->show_desktop_data.minimized = g_list_remove(wscreen->show_desktop_data.minimized, window);
-        if (wscreen->show_desktop_data.minimized == NULL) {
-            XfwScreen *screen = XFW_SCREEN(wscreen);
-            if (xfw_screen_get_show_desktop(screen)) {
-                _xfw_screen_set_show_desktop(screen, FALSE);
-            }
-            if (wscreen->show_desktop_data.was_active != NULL) {
-                for (GList *l = xfw_screen_get_seats(XFW_SCREEN(wscreen)); l != NULL; l = l->next) {
-                    XfwSeat *seat = XFW_SEAT(l->data);
-                    xfw_window_activate(wscreen->show_desktop_data.was_active, seat, 0, NULL);
-                }
-            }
+    while (wscreen->bootstrap_stage != BOOTSTRAP_DONE) {
+        if (wl_display_dispatch(wscreen->wl_display) < 0) {
+            g_warning("Failed to dispatch Wayland events while setting up the screen");
+            bootstrap_finish(wscreen);
         }
     }
 }
 
 static void
-show_desktop_closed(XfwWindow *window, XfwScreenWayland *wscreen) {
+xfw_screen_wayland_flush(XfwScreen *screen) {
+    wl_display_flush(XFW_SCREEN_WAYLAND(screen)->wl_display);
+}
+
+static GList *
+xfw_screen_wayland_get_windows_for_new_monitor(XfwScreen *screen, XfwMonitor *monitor) {
+    GHashTable *windows = g_hash_table_lookup(XFW_SCREEN_WAYLAND(screen)->pending_output_windows,
+                                              _xfw_monitor_wayland_get_wl_output(XFW_MONITOR_WAYLAND(monitor)));
+    return windows != NULL ? g_hash_table_get_keys(windows) : NULL;
+}
+
+// Called once the last window we minimized has been unminimized or closed,
+// whether or not that was our doing
+static void
+show_desktop_finish(XfwScreenWayland *wscreen, XfwWindow *reactivate) {
     XfwScreen *screen = XFW_SCREEN(wscreen);
-    wscreen->show_desktop_data.minimized = g_list_remove(wscreen->show_desktop_data.minimized, window);
-    if (wscreen->show_desktop_data.minimized == NULL) {
-        _xfw_screen_set_show_desktop(XFW_SCREEN(screen), FALSE);
+
+    if (xfw_screen_get_show_desktop(screen)) {
+        _xfw_screen_set_show_desktop(screen, FALSE);
+    }
+    if (reactivate != NULL) {
+        for (GList *l = xfw_screen_get_seats(screen); l != NULL; l = l->next) {
+            XfwSeat *seat = XFW_SEAT(l->data);
+            xfw_window_activate(reactivate, seat, 0, NULL);
+        }
+    }
+}
+
+// Called by every window when its state changes, instead of the screen
+// connecting to each window's state-changed signal while showing the desktop
+void
+_xfw_screen_wayland_window_state_changed(XfwScreenWayland *wscreen, XfwWindow *window, XfwWindowState changed_mask, XfwWindowState new_state) {
+    gpointer reactivate = NULL;
+
+    if ((changed_mask & XFW_WINDOW_STATE_MINIMIZED) != 0
+        && _xfw_show_desktop_window_state_changed(wscreen->show_desktop,
+                                                  window,
+                                                  (new_state & XFW_WINDOW_STATE_MINIMIZED) != 0,
+                                                  &reactivate))
+    {
+        show_desktop_finish(wscreen, reactivate);
+    }
+}
+
+static void
+show_desktop_window_closed(XfwScreenWayland *wscreen, XfwWindow *window) {
+    if (_xfw_show_desktop_window_closed(wscreen->show_desktop, window)) {
+        show_desktop_finish(wscreen, NULL);
     }
 }
 
 static void
 xfw_screen_wayland_set_show_desktop(XfwScreen *screen, gboolean show) {
     XfwScreenWayland *wscreen = XFW_SCREEN_WAYLAND(screen);
-    gboolean revert = TRUE;
 
     _xfw_screen_set_show_desktop(screen, !!show);
 
     // unminimize previously minimized windows
     if (!show) {
-        for (GList *lp = wscreen->show_desktop_data.minimized; lp != NULL; lp = lp->next) {
+        GList *to_unminimize = _xfw_show_desktop_restore(wscreen->show_desktop);
+        for (GList *lp = to_unminimize; lp != NULL; lp = lp->next) {
             xfw_window_set_minimized(lp->data, FALSE, NULL);
         }
+        if (to_unminimize != NULL) {
+            wl_display_flush(wscreen->wl_display);
+            g_list_free(to_unminimize);
+        }
         return;
     }
 
-    // remove and disconnect from any previously minimized window: probably there is none,
-    // but it is asynchronous and the compositor might have failed to unminimize some of them
-    g_list_foreach(wscreen->show_desktop_data.minimized, show_desktop_disconnect, wscreen);
-    g_clear_list(&wscreen->show_desktop_data.minimized, NULL);
-    wscreen->show_desktop_data.was_active = NULL;
-
     // request for showing the desktop and prepare reverse process
+    GList *to_minimize = NULL;
+    XfwWindow *active_window = NULL;
     for (GList *lp = xfw_screen_wayland_get_windows(screen); lp != NULL; lp = lp->next) {
         XfwWindowState state = xfw_window_get_state(lp->data);
         if (!(state & XFW_WINDOW_STATE_MINIMIZED)) {
-            revert = FALSE;
-            g_signal_connect(lp->data, "state-changed", G_CALLBACK(show_desktop_state_changed), wscreen);
-            g_signal_connect(lp->data, "closed", G_CALLBACK(show_desktop_closed), wscreen);
+            to_minimize = g_list_prepend(to_minimize, lp->data);
             if (state & XFW_WINDOW_STATE_ACTIVE) {
-                wscreen->show_desktop_data.was_active = lp->data;
+                active_window = lp->data;
             }
             xfw_window_set_minimized(lp->data, TRUE, NULL);
         }
     }
+    _xfw_show_desktop_show(wscreen->show_desktop, to_minimize, active_window);
 
-    // there was no window to minimize, revert state
-    if (revert) {
+    if (to_minimize == NULL) {
+        // there was no window to minimize, revert state
         _xfw_screen_set_show_desktop(screen, FALSE);
+    } else {
+        wl_display_flush(wscreen->wl_display);
+        g_list_free(to_minimize);
     }
 }
 
-static void
-show_desktop_disconnect(gpointer object, gpointer data) {
-    g_signal_handlers_disconnect_by_func(object, show_desktop_state_changed, data);
-    g_signal_handlers_disconnect_by_func(object, show_desktop_closed, data);
-}
-
 static void
 add_async_roundtrip(XfwScreenWayland *screen) {
     struct wl_callback *callback = wl_display_sync(screen->wl_display);
@@ -331,6 +327,80 @@ async_roundtrip_done(void *data, struct wl_callback *callback, uint32_t callback
     XfwScreenWayland *screen = data;
     screen->async_roundtrips = g_list_remove(screen->async_roundtrips, callback);
     wl_callback_destroy(callback);
+
+    if (screen->async_roundtrips == NULL && screen->bootstrap_stage != BOOTSTRAP_DONE) {
+        bootstrap_advance(screen);
+    }
+}
+
+static void
+bootstrap_advance(XfwScreenWayland *wscreen) {
+    switch (wscreen->bootstrap_stage) {
+        case BOOTSTRAP_GLOBALS:
+            // We defer binding outputs until after we have the wl_seat instances so
+            // that xfce_output_manager's pointer_enter will work.
+            _xfw_monitor_manager_wayland_start(wscreen->monitor_manager);
+            // FIXME: one per output?  one per output & per xdg_output & per xfce_output?
+            add_async_roundtrip(wscreen);
+
+            // We defer binding to the toplevel and workspace managers until after we have all
+            // XfwMonitor instances initialized.  Otherwise, we would get output_enter
+            // events for toplevels or workspace groups, but have no XfwMonitor to match them to.
+            //
+            // We also need to bind the workspage manager before the toplevel manager,
+            // because the xfce extension protocol for the toplevel manager will need
+            // workspaces available.
+            wscreen->defer_workspace_manager = FALSE;
+            if (wscreen->workspace_manager_name != 0 && wscreen->workspace_manager_version != 0) {
+                init_workspace_manager(wscreen);
+            }
+            wscreen->defer_wlr_toplevel_manager = FALSE;
+            if (wscreen->wlr_toplevel_manager_name != 0 && wscreen->wlr_toplevel_manager_version != 0) {
+                init_toplevel_manager(wscreen);
+            }
+
+            wscreen->bootstrap_stage = BOOTSTRAP_MANAGERS;
+            wl_display_flush(wscreen->wl_display);
+            break;
+
+        case BOOTSTRAP_MANAGERS:
+            if (wscreen->wlr_toplevel_manager == NULL) {
+                g_message("Your compositor does not support the wlr_foreign_toplevel_manager_v1 protocol");
+            } else if (wscreen->xfce_toplevel_manager == NULL) {
+                g_message("Window<->Workspace association is not available on your compositor");
+            } else if (_xfw_window_registry_get_n_windows(wscreen->windows) > 0) {
+                // If we have the xfce toplevel manager and at least one window,
+                // then one of the previous roundtrips will have caused us to
+                // request xfce toplevel handles.  All that should take one more
+                // roundtrip to come back to us, so add another.
+                wscreen->bootstrap_stage = BOOTSTRAP_XFCE_HANDLES;
+                add_async_roundtrip(wscreen);
+                wl_display_flush(wscreen->wl_display);
+                break;
+            }
+            bootstrap_finish(wscreen);
+            break;
+
+        case BOOTSTRAP_XFCE_HANDLES:
+            bootstrap_finish(wscreen);
+            break;
+
+        case BOOTSTRAP_DONE:
+            break;
+    }
+}
+
+static void
+bootstrap_finish(XfwScreenWayland *wscreen) {
+    XfwScreen *screen = XFW_SCREEN(wscreen);
+
+    if (xfw_screen_get_workspace_manager(screen) == NULL) {
+        g_message("Your compositor does not support the ext_workspace_manager_v1 protocol");
+        _xfw_screen_set_workspace_manager(screen, _xfw_workspace_manager_dummy_new(screen));
+    }
+
+    wscreen->bootstrap_stage = BOOTSTRAP_DONE;
+    _xfw_screen_set_ready(screen);
 }
 
 static void
@@ -450,12 +520,12 @@ registry_global_remove(void *data, struct wl_registry *registry, uint32_t name)
 
 static void
 window_closed(XfwWindowWayland *window, XfwScreenWayland *wscreen) {
-    g_object_ref(window);
     g_signal_handlers_disconnect_by_func(window, window_closed, wscreen);
-    wscreen->windows = g_list_remove(wscreen->windows, window);
-    wscreen->windows_stacked = g_list_remove(wscreen->windows_stacked, window);
-    g_hash_table_remove(wscreen->wlr_windows, _xfw_window_wayland_get_wlr_handle(window));
-    g_signal_emit_by_name(wscreen, "window-closed", window);
+    // We get the registry's reference to the window
+    window = XFW_WINDOW_WAYLAND(_xfw_window_registry_remove(wscreen->windows, _xfw_window_wayland_get_wlr_handle(window)));
+    g_return_if_fail(window != NULL);
+    show_desktop_window_closed(wscreen, XFW_WINDOW(window));
+    g_signal_emit(wscreen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_CLOSED], 0, window);
 
     XfwScreen *screen = XFW_SCREEN(wscreen);
     if (XFW_WINDOW(window) == xfw_screen_get_active_window(screen)) {
@@ -480,9 +550,9 @@ toplevel_manager_toplevel(void *data, struct zwlr_foreign_toplevel_manager_v1 *w
                                             "wlr-handle", wlr_toplevel,
                                             "xfce-handle", xfce_toplevel,
                                             NULL);
-    screen->windows = g_list_prepend(screen->windows, window);
-    screen->windows_stacked = g_list_prepend(screen->windows_stacked, window);
-    g_hash_table_insert(screen->wlr_windows, wlr_toplevel, window);
+    // The protocol says nothing about stacking, so the stacked list has
+    // always just had the newest window first
+    _xfw_window_registry_add_at_bottom(screen->windows, wlr_toplevel, XFW_WINDOW(window));
     g_signal_connect(window, "closed", G_CALLBACK(window_closed), screen);
 }
 
@@ -502,6 +572,29 @@ _xfw_screen_wayland_seat_ready(XfwScreenWayland *screen, XfwSeatWayland *seat) {
     }
 }
 
+void
+_xfw_screen_wayland_add_pending_output(XfwScreenWayland *screen, XfwWindow *window, struct wl_output *output) {
+    GHashTable *windows = g_hash_table_lookup(screen->pending_output_windows, output);
+    if (windows == NULL) {
+        windows = g_hash_table_new(g_direct_hash, g_direct_equal);
+        g_hash_table_insert(screen->pending_output_windows, output, windows);
+    }
+    g_hash_table_add(windows, window);
+}
+
+void
+_xfw_screen_wayland_remove_pending_outputs(XfwScreenWayland *screen, XfwWindow *window, GList *outputs) {
+    for (GList *l = outputs; l != NULL; l = l->next) {
+        GHashTable *windows = g_hash_table_lookup(screen->pending_output_windows, l->data);
+        if (windows != NULL
+            && g_hash_table_remove(windows, window)
+            && g_hash_table_size(windows) == 0)
+        {
+            g_hash_table_remove(screen->pending_output_windows, l->data);
+        }
+    }
+}
+
 XfwWorkspace *
 _xfw_screen_wayland_get_window_workspace(XfwScreenWayland *screen, XfwWindow *window) {
     XfwWorkspaceManager *workspace_manager = xfw_screen_get_workspace_manager(XFW_SCREEN(screen));
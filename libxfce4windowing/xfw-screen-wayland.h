@@ -42,6 +42,10 @@ typedef struct _XfwScreenWaylandPrivate XfwScreenWaylandPrivate;
 void _xfw_screen_wayland_seat_ready(XfwScreenWayland *screen, XfwSeatWayland *seat);
 
 XfwWorkspace *_xfw_screen_wayland_get_window_workspace(XfwScreenWayland *screen, XfwWindow *window);
+void _xfw_screen_wayland_window_state_changed(XfwScreenWayland *screen, XfwWindow *window, XfwWindowState changed_mask, XfwWindowState new_state);
+
+void _xfw_screen_wayland_add_pending_output(XfwScreenWayland *screen, XfwWindow *window, struct wl_output *output);
+void _xfw_screen_wayland_remove_pending_outputs(XfwScreenWayland *screen, XfwWindow *window, GList *outputs);
 
 G_END_DECLS
 
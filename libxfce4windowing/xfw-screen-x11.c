@@ -22,6 +22,7 @@
 #endif
 
 #include <X11/X.h>
+#include <X11/Xlib.h>
 #include <gdk/gdkx.h>
 #include <libwnck/libwnck.h>
 
@@ -30,6 +31,9 @@
 #include "xfw-screen-private.h"
 #include "xfw-screen-x11.h"
 #include "xfw-util.h"
+#include "xfw-window-private.h"
+#include "xfw-window-registry.h"
+#include "xfw-window-spatial-index.h"
 #include "xfw-window-x11.h"
 #include "xfw-workspace-manager-x11.h"
 
@@ -37,9 +41,18 @@ struct _XfwScreenX11 {
     XfwScreen parent;
 
     WnckScreen *wnck_screen;
-    GList *windows;
-    GList *windows_stacked;
-    GHashTable *wnck_windows;
+    // Keyed by WnckWindow
+    XfwWindowRegistry *windows;
+    // Every window's geometry, so a new monitor only has to look at the
+    // windows it overlaps
+    XfwWindowSpatialIndex *window_rects;
+    gboolean stacking_dirty;
+    // Whether the stacking order has changed since window-stacking-changed
+    // was last emitted.  Opened windows go on top and closed windows are
+    // dropped without counting as a change: that's what everyone assumes
+    // happens, so it only needs announcing if libwnck disagrees.
+    gboolean stacking_changed;
+    guint stacking_changed_idle_id;
 
     // _NET_WORKAREA is defined for each workspace
     GArray *workareas;  // GdkRectangle
@@ -51,19 +64,25 @@ static void xfw_screen_x11_constructed(GObject *obj);
 static void xfw_screen_x11_finalize(GObject *obj);
 static GList *xfw_screen_x11_get_windows(XfwScreen *screen);
 static GList *xfw_screen_x11_get_windows_stacked(XfwScreen *screen);
+static gint xfw_screen_x11_get_stacking_index(XfwScreen *screen, XfwWindow *window);
 static void xfw_screen_x11_set_show_desktop(XfwScreen *screen, gboolean show);
+static void xfw_screen_x11_flush(XfwScreen *screen);
+static GList *xfw_screen_x11_get_windows_for_new_monitor(XfwScreen *screen, XfwMonitor *monitor);
 
 static void window_opened(WnckScreen *wnck_screen, WnckWindow *window, XfwScreenX11 *screen);
 static void window_closed(WnckScreen *wnck_screen, WnckWindow *window, XfwScreenX11 *screen);
 static void active_window_changed(WnckScreen *wnck_screen, WnckWindow *previous_window, XfwScreenX11 *screen);
 static void window_stacking_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen);
 static void showing_desktop_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen);
+static void rebuild_stacking(XfwScreenX11 *screen);
+static void queue_stacking_changed(XfwScreenX11 *screen);
 static void window_manager_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen);
 static void active_workspace_changed(WnckScreen *wnck_screen, WnckWorkspace *previous_workspace, XfwScreenX11 *screen);
 
 
 G_DEFINE_FINAL_TYPE(XfwScreenX11, xfw_screen_x11, XFW_TYPE_SCREEN)
 
+static guint wnck_window_state_changed_signal = 0;
 
 static void
 xfw_screen_x11_class_init(XfwScreenX11Class *klass) {
@@ -74,7 +93,13 @@ xfw_screen_x11_class_init(XfwScreenX11Class *klass) {
     XfwScreenClass *screen_class = XFW_SCREEN_CLASS(klass);
     screen_class->get_windows = xfw_screen_x11_get_windows;
     screen_class->get_windows_stacked = xfw_screen_x11_get_windows_stacked;
+    screen_class->get_stacking_index = xfw_screen_x11_get_stacking_index;
     screen_class->set_show_desktop = xfw_screen_x11_set_show_desktop;
+    screen_class->flush = xfw_screen_x11_flush;
+    screen_class->get_windows_for_new_monitor = xfw_screen_x11_get_windows_for_new_monitor;
+
+    g_type_class_ensure(WNCK_TYPE_WINDOW);
+    wnck_window_state_changed_signal = g_signal_lookup("state-changed", WNCK_TYPE_WINDOW);
 }
 
 static void
@@ -97,22 +122,25 @@ xfw_screen_x11_constructed(GObject *obj) {
     G_GNUC_BEGIN_IGNORE_DEPRECATIONS
     xscreen->wnck_screen = g_object_ref(wnck_screen_get(gdk_x11_screen_get_screen_number(_xfw_screen_get_gdk_screen(screen))));
     G_GNUC_END_IGNORE_DEPRECATIONS
-    xscreen->wnck_windows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_object_unref);
-
-    for (GList *l = wnck_screen_get_windows(xscreen->wnck_screen); l != NULL; l = l->next) {
-        XfwWindowX11 *window = g_object_new(XFW_TYPE_WINDOW_X11,
-                                            "screen", screen,
-                                            "wnck-window", l->data,
-                                            NULL);
-        xscreen->windows = g_list_prepend(xscreen->windows, window);
-        g_hash_table_insert(xscreen->wnck_windows, l->data, window);
+    xscreen->windows = _xfw_window_registry_new();
+    xscreen->window_rects = _xfw_window_spatial_index_new();
+
+    // The registry lists the newest window first, so adding libwnck's
+    // windows last to first keeps them in libwnck's order, as they always
+    // have been; windows opened later go in front of them
+    for (GList *l = g_list_last(wnck_screen_get_windows(xscreen->wnck_screen)); l != NULL; l = l->prev) {
+        XfwWindow *window = g_object_new(XFW_TYPE_WINDOW_X11,
+                                         "screen", screen,
+                                         "wnck-window", l->data,
+                                         NULL);
+        _xfw_window_registry_add(xscreen->windows, l->data, window);
     }
-    xscreen->windows = g_list_reverse(xscreen->windows);
-    window_stacking_changed(xscreen->wnck_screen, xscreen);
+    rebuild_stacking(xscreen);
+    xscreen->stacking_changed = FALSE;
 
     _xfw_screen_set_active_window(screen,
-                                  g_hash_table_lookup(xscreen->wnck_windows,
-                                                      wnck_screen_get_active_window(xscreen->wnck_screen)));
+                                  _xfw_window_registry_lookup(xscreen->windows,
+                                                              wnck_screen_get_active_window(xscreen->wnck_screen)));
 
     g_signal_connect(xscreen->wnck_screen, "window-opened", G_CALLBACK(window_opened), xscreen);
     g_signal_connect(xscreen->wnck_screen, "window-closed", G_CALLBACK(window_closed), xscreen);
@@ -123,6 +151,9 @@ xfw_screen_x11_constructed(GObject *obj) {
     g_signal_connect(xscreen->wnck_screen, "active-workspace-changed", G_CALLBACK(active_workspace_changed), xscreen);
 
     xscreen->monitor_manager = _xfw_monitor_manager_x11_new(xscreen);
+
+    // libwnck fetches everything synchronously, so we're ready right away
+    _xfw_screen_set_ready(screen);
 }
 
 static void
@@ -131,10 +162,13 @@ xfw_screen_x11_finalize(GObject *obj) {
 
     _xfw_monitor_manager_x11_destroy(screen->monitor_manager);
 
+    if (screen->stacking_changed_idle_id != 0) {
+        g_source_remove(screen->stacking_changed_idle_id);
+    }
+
     g_signal_handlers_disconnect_by_data(screen->wnck_screen, screen);
-    g_list_free(screen->windows);
-    g_list_free(screen->windows_stacked);
-    g_hash_table_destroy(screen->wnck_windows);
+    _xfw_window_registry_free(screen->windows);
+    _xfw_window_spatial_index_free(screen->window_rects);
 
     if (screen->workareas != NULL) {
         g_array_free(screen->workareas, TRUE);
@@ -148,12 +182,25 @@ xfw_screen_x11_finalize(GObject *obj) {
 
 static GList *
 xfw_screen_x11_get_windows(XfwScreen *screen) {
-    return XFW_SCREEN_X11(screen)->windows;
+    return _xfw_window_registry_get_windows(XFW_SCREEN_X11(screen)->windows);
 }
 
 static GList *
 xfw_screen_x11_get_windows_stacked(XfwScreen *screen) {
-    return XFW_SCREEN_X11(screen)->windows_stacked;
+    XfwScreenX11 *xscreen = XFW_SCREEN_X11(screen);
+    if (xscreen->stacking_dirty) {
+        rebuild_stacking(xscreen);
+    }
+    return _xfw_window_registry_get_windows_stacked(xscreen->windows);
+}
+
+static gint
+xfw_screen_x11_get_stacking_index(XfwScreen *screen, XfwWindow *window) {
+    XfwScreenX11 *xscreen = XFW_SCREEN_X11(screen);
+    if (xscreen->stacking_dirty) {
+        rebuild_stacking(xscreen);
+    }
+    return _xfw_window_registry_get_stacking_index(xscreen->windows, window);
 }
 
 static void
@@ -165,36 +212,46 @@ xfw_screen_x11_set_show_desktop(XfwScreen *screen, gboolean show) {
     }
 }
 
+static void
+xfw_screen_x11_flush(XfwScreen *screen) {
+    GdkDisplay *display = gdk_screen_get_display(_xfw_screen_get_gdk_screen(screen));
+    XFlush(gdk_x11_display_get_xdisplay(display));
+}
+
+static GList *
+xfw_screen_x11_get_windows_for_new_monitor(XfwScreen *screen, XfwMonitor *monitor) {
+    GdkRectangle geometry;
+    xfw_monitor_get_physical_geometry(monitor, &geometry);
+    return _xfw_window_spatial_index_for_rect(XFW_SCREEN_X11(screen)->window_rects, &geometry);
+}
+
 static void
 window_opened(WnckScreen *wnck_screen, WnckWindow *wnck_window, XfwScreenX11 *screen) {
-    XfwWindowX11 *window = XFW_WINDOW_X11(g_object_new(XFW_TYPE_WINDOW_X11,
-                                                       "screen", screen,
-                                                       "wnck-window", wnck_window,
-                                                       NULL));
-    screen->windows = g_list_prepend(screen->windows, window);
-    g_hash_table_insert(screen->wnck_windows, wnck_window, window);
-    // FIXME: window-stacking-changed signal will fire out of order
-    window_stacking_changed(screen->wnck_screen, screen);
-    g_signal_emit_by_name(screen, "window-opened", window);
+    XfwWindow *window = g_object_new(XFW_TYPE_WINDOW_X11,
+                                     "screen", screen,
+                                     "wnck-window", wnck_window,
+                                     NULL);
+    _xfw_window_registry_add(screen->windows, wnck_window, window);
+    // The stacking order will be rebuilt on demand, and window-stacking-changed
+    // will fire after window-opened, once per burst of new windows.
+    queue_stacking_changed(screen);
+    g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_OPENED], 0, window);
 }
 
 static void
 window_closed(WnckScreen *wnck_screen, WnckWindow *wnck_window, XfwScreenX11 *screen) {
-    XfwWindowX11 *window = g_hash_table_lookup(screen->wnck_windows, wnck_window);
+    // We get the registry's reference to the window
+    XfwWindow *window = _xfw_window_registry_remove(screen->windows, wnck_window);
     if (window != NULL) {
-        g_object_ref(window);
-
-        g_hash_table_remove(screen->wnck_windows, wnck_window);
-        screen->windows = g_list_remove(screen->windows, window);
-        screen->windows_stacked = g_list_remove(screen->windows_stacked, window);
+        _xfw_window_spatial_index_remove(screen->window_rects, window);
+        queue_stacking_changed(screen);
 
-        if (xfw_screen_get_active_window(XFW_SCREEN(screen)) == XFW_WINDOW(window)) {
+        if (xfw_screen_get_active_window(XFW_SCREEN(screen)) == window) {
             _xfw_screen_set_active_window(XFW_SCREEN(screen), NULL);
         }
 
-        g_signal_emit_by_name(window, "closed");
-        g_signal_emit_by_name(screen, "window-closed", window);
-        g_signal_emit_by_name(screen, "window-stacking-changed", screen);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CLOSED], 0);
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_CLOSED], 0, window);
 
         g_object_unref(window);
     }
@@ -203,36 +260,63 @@ window_closed(WnckScreen *wnck_screen, WnckWindow *wnck_window, XfwScreenX11 *sc
 static void
 active_window_changed(WnckScreen *wnck_screen, WnckWindow *previous_wnck_window, XfwScreenX11 *screen) {
     WnckWindow *wnck_window = wnck_screen_get_active_window(screen->wnck_screen);
-    XfwWindow *window = g_hash_table_lookup(screen->wnck_windows, wnck_window);
+    XfwWindow *window = _xfw_window_registry_lookup(screen->windows, wnck_window);
     if (window != xfw_screen_get_active_window(XFW_SCREEN(screen))) {
         if (previous_wnck_window != NULL) {
-            g_signal_emit_by_name(previous_wnck_window, "state-changed", 0, wnck_window_get_state(previous_wnck_window));
+            g_signal_emit(previous_wnck_window, wnck_window_state_changed_signal, 0, 0, wnck_window_get_state(previous_wnck_window));
         }
         if (wnck_window != NULL) {
-            g_signal_emit_by_name(wnck_window, "state-changed", 0, wnck_window_get_state(wnck_window));
+            g_signal_emit(wnck_window, wnck_window_state_changed_signal, 0, 0, wnck_window_get_state(wnck_window));
         }
 
         _xfw_screen_set_active_window(XFW_SCREEN(screen), window);
     }
 }
 
+// Rebuilding doesn't free the list callers got from
+// xfw_screen_get_windows_stacked(): the registry only replaces it on the
+// next call, and only if the order has really changed.
 static void
-window_stacking_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen) {
-    g_clear_list(&screen->windows_stacked, NULL);
+rebuild_stacking(XfwScreenX11 *screen) {
+    if (_xfw_window_registry_set_stacking(screen->windows, wnck_screen_get_windows_stacked(screen->wnck_screen))) {
+        screen->stacking_changed = TRUE;
+    }
+    screen->stacking_dirty = FALSE;
+}
 
-    for (GList *l = wnck_screen_get_windows_stacked(screen->wnck_screen); l != NULL; l = l->next) {
-        XfwWindowX11 *window = g_hash_table_lookup(screen->wnck_windows, l->data);
-        if (window != NULL) {
-            screen->windows_stacked = g_list_prepend(screen->windows_stacked, window);
-        }
+static gboolean
+stacking_changed_idled(gpointer data) {
+    XfwScreenX11 *screen = XFW_SCREEN_X11(data);
+
+    screen->stacking_changed_idle_id = 0;
+    if (screen->stacking_dirty) {
+        rebuild_stacking(screen);
+    }
+    // Closing a window, for example, usually leaves the rest as they were
+    if (screen->stacking_changed) {
+        screen->stacking_changed = FALSE;
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_STACKING_CHANGED], 0);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+queue_stacking_changed(XfwScreenX11 *screen) {
+    screen->stacking_dirty = TRUE;
+    if (screen->stacking_changed_idle_id == 0) {
+        screen->stacking_changed_idle_id = g_idle_add(stacking_changed_idled, screen);
     }
-    screen->windows_stacked = g_list_reverse(screen->windows_stacked);
-    g_signal_emit_by_name(screen, "window-stacking-changed");
+}
+
+static void
+window_stacking_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen) {
+    queue_stacking_changed(screen);
 }
 
 static void
 window_manager_changed(WnckScreen *wnck_screen, XfwScreenX11 *screen) {
-    g_signal_emit_by_name(screen, "window-manager-changed");
+    g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_MANAGER_CHANGED], 0);
 }
 
 static void
@@ -269,3 +353,8 @@ _xfw_screen_x11_set_workareas(XfwScreenX11 *screen, GArray *workareas) {
     }
     screen->workareas = workareas;
 }
+
+void
+_xfw_screen_x11_window_geometry_changed(XfwScreenX11 *screen, XfwWindow *window, const GdkRectangle *geometry) {
+    _xfw_window_spatial_index_set(screen->window_rects, window, geometry);
+}
@@ -40,6 +40,8 @@ XfwWorkspace *_xfw_screen_x11_workspace_for_wnck_workspace(XfwScreenX11 *screen,
 GArray *_xfw_screen_x11_get_workareas(XfwScreenX11 *screen);
 void _xfw_screen_x11_set_workareas(XfwScreenX11 *screen, GArray *workareas);
 
+void _xfw_screen_x11_window_geometry_changed(XfwScreenX11 *screen, XfwWindow *window, const GdkRectangle *geometry);
+
 G_END_DECLS
 
 #endif /* __XFW_SCREEN_X11_H__ */
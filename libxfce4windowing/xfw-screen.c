@@ -45,9 +45,13 @@
 #include <limits.h>
 
 #include "libxfce4windowing-private.h"
+#include "xfw-monitor-index.h"
 #include "xfw-monitor-private.h"
 #include "xfw-screen-private.h"
 #include "xfw-util.h"
+#include "xfw-window-index.h"
+#include "xfw-window-model.h"
+#include "xfw-window-private.h"
 #include "xfw-window.h"
 #include "xfw-workspace-manager.h"
 
@@ -69,9 +73,29 @@ typedef struct _XfwXcreenPrivate {
     GList *seats;
     XfwWorkspaceManager *workspace_manager;
     GList *monitors;
+    XfwMonitorIndex *monitor_index;
     XfwMonitor *primary_monitor;
     XfwWindow *active_window;
+    XfwWindowIndex *window_index;
+    guint geometry_throttle_interval;
+    guint name_throttle_interval;
+
+    // Created on first use by the *_model() getters
+    XfwWindowModel *windows_model;
+    XfwWindowModel *windows_stacked_model;
+    GListStore *monitors_model;
+
+    // The snapshot handed out until something changes
+    XfwScreenSnapshot *snapshot;
+    guint64 snapshot_generation;
+
+    // Window changes waiting for XfwScreen::changes-committed
+    GPtrArray *pending_changes;
+    GHashTable *pending_changes_by_window;
+    guint commit_changes_id;
+
     guint32 show_desktop : 1;
+    guint32 ready : 1;
 } XfwScreenPrivate;
 
 enum {
@@ -80,6 +104,10 @@ enum {
     PROP_WORKSPACE_MANAGER,
     PROP_ACTIVE_WINDOW,
     PROP_SHOW_DESKTOP,
+    PROP_READY,
+    PROP_GEOMETRY_THROTTLE_INTERVAL,
+    PROP_NAME_THROTTLE_INTERVAL,
+    N_PROPERTIES,
 };
 
 static void xfw_screen_set_property(GObject *object,
@@ -90,17 +118,26 @@ static void xfw_screen_get_property(GObject *object,
                                     guint property_id,
                                     GValue *value,
                                     GParamSpec *pspec);
+static void xfw_screen_dispose(GObject *object);
 static void xfw_screen_finalize(GObject *object);
 
+static void window_opened(XfwScreen *screen, XfwWindow *window);
+static void window_closed(XfwScreen *screen, XfwWindow *window);
+static void window_stacking_changed(XfwScreen *screen);
+
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(XfwScreen, xfw_screen, G_TYPE_OBJECT)
 
+guint _xfw_screen_signals[N_SCREEN_SIGNALS] = { 0 };
+static GParamSpec *screen_properties[N_PROPERTIES] = { NULL };
+
 
 static void
 xfw_screen_class_init(XfwScreenClass *klass) {
     GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
     gobject_class->set_property = xfw_screen_set_property;
     gobject_class->get_property = xfw_screen_get_property;
+    gobject_class->dispose = xfw_screen_dispose;
     gobject_class->finalize = xfw_screen_finalize;
 
     /**
@@ -110,16 +147,16 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Emitted when @seat has been added to @screen.
      **/
-    g_signal_new("seat-added",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 0,
-                 NULL,
-                 NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE,
-                 1,
-                 XFW_TYPE_SEAT);
+    _xfw_screen_signals[SCREEN_SIGNAL_SEAT_ADDED] = g_signal_new("seat-added",
+                                                                 XFW_TYPE_SCREEN,
+                                                                 G_SIGNAL_RUN_LAST,
+                                                                 0,
+                                                                 NULL,
+                                                                 NULL,
+                                                                 g_cclosure_marshal_VOID__OBJECT,
+                                                                 G_TYPE_NONE,
+                                                                 1,
+                                                                 XFW_TYPE_SEAT);
 
     /**
      * XfwScreen::seat-removed:
@@ -128,16 +165,16 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Emitted when @seat has been added to @screen.
      **/
-    g_signal_new("seat-removed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 0,
-                 NULL,
-                 NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE,
-                 1,
-                 XFW_TYPE_SEAT);
+    _xfw_screen_signals[SCREEN_SIGNAL_SEAT_REMOVED] = g_signal_new("seat-removed",
+                                                                   XFW_TYPE_SCREEN,
+                                                                   G_SIGNAL_RUN_LAST,
+                                                                   0,
+                                                                   NULL,
+                                                                   NULL,
+                                                                   g_cclosure_marshal_VOID__OBJECT,
+                                                                   G_TYPE_NONE,
+                                                                   1,
+                                                                   XFW_TYPE_SEAT);
 
     /**
      * XfwScreen::window-opened:
@@ -146,14 +183,14 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Emitted when a new window is opened on the screen.
      **/
-    g_signal_new("window-opened",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwScreenClass, window_opened),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WINDOW);
+    _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_OPENED] = g_signal_new("window-opened",
+                                                                    XFW_TYPE_SCREEN,
+                                                                    G_SIGNAL_RUN_LAST,
+                                                                    G_STRUCT_OFFSET(XfwScreenClass, window_opened),
+                                                                    NULL, NULL,
+                                                                    g_cclosure_marshal_VOID__OBJECT,
+                                                                    G_TYPE_NONE, 1,
+                                                                    XFW_TYPE_WINDOW);
 
     /**
      * XfwScreen::active-window-changed:
@@ -166,14 +203,14 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      * newly-active window can be retrieved via
      * #xfw_screen_get_active_window().
      **/
-    g_signal_new("active-window-changed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwScreenClass, active_window_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WINDOW);
+    _xfw_screen_signals[SCREEN_SIGNAL_ACTIVE_WINDOW_CHANGED] = g_signal_new("active-window-changed",
+                                                                            XFW_TYPE_SCREEN,
+                                                                            G_SIGNAL_RUN_LAST,
+                                                                            G_STRUCT_OFFSET(XfwScreenClass, active_window_changed),
+                                                                            NULL, NULL,
+                                                                            g_cclosure_marshal_VOID__OBJECT,
+                                                                            G_TYPE_NONE, 1,
+                                                                            XFW_TYPE_WINDOW);
 
     /**
      * XfwScreen::window-stacking-changed:
@@ -183,15 +220,20 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      * changed.  Windows, in stacking order, can be retrieved via
      * #xfw_screen_get_windows_stacked().
      *
+     * Several changes happening in quick succession may be reported with a
+     * single emission.  A window opening on top of the others, or closing,
+     * leaves the rest of the windows in the same order, so it is only
+     * reported through #XfwScreen::window-opened or #XfwScreen::window-closed.
+     *
      * Note that currently this signal is not emitted on Wayland.
      **/
-    g_signal_new("window-stacking-changed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwScreenClass, window_stacking_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_STACKING_CHANGED] = g_signal_new("window-stacking-changed",
+                                                                              XFW_TYPE_SCREEN,
+                                                                              G_SIGNAL_RUN_LAST,
+                                                                              G_STRUCT_OFFSET(XfwScreenClass, window_stacking_changed),
+                                                                              NULL, NULL,
+                                                                              g_cclosure_marshal_VOID__VOID,
+                                                                              G_TYPE_NONE, 0);
 
     /**
      * XfwScreen::window-closed:
@@ -200,14 +242,14 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Emitted when a window is closed on the screen.
      **/
-    g_signal_new("window-closed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwScreenClass, window_closed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WINDOW);
+    _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_CLOSED] = g_signal_new("window-closed",
+                                                                    XFW_TYPE_SCREEN,
+                                                                    G_SIGNAL_RUN_LAST,
+                                                                    G_STRUCT_OFFSET(XfwScreenClass, window_closed),
+                                                                    NULL, NULL,
+                                                                    g_cclosure_marshal_VOID__OBJECT,
+                                                                    G_TYPE_NONE, 1,
+                                                                    XFW_TYPE_WINDOW);
 
     /**
      * XfwScreen::window-manager-changed:
@@ -217,13 +259,13 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Note that currently this signal is not emitted on Wayland.
      **/
-    g_signal_new("window-manager-changed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwScreenClass, window_manager_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_MANAGER_CHANGED] = g_signal_new("window-manager-changed",
+                                                                             XFW_TYPE_SCREEN,
+                                                                             G_SIGNAL_RUN_LAST,
+                                                                             G_STRUCT_OFFSET(XfwScreenClass, window_manager_changed),
+                                                                             NULL, NULL,
+                                                                             g_cclosure_marshal_VOID__VOID,
+                                                                             G_TYPE_NONE, 0);
 
     /**
      * XfwScreen::monitor-added:
@@ -234,14 +276,14 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_signal_new("monitor-added",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 0,
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_MONITOR);
+    _xfw_screen_signals[SCREEN_SIGNAL_MONITOR_ADDED] = g_signal_new("monitor-added",
+                                                                    XFW_TYPE_SCREEN,
+                                                                    G_SIGNAL_RUN_LAST,
+                                                                    0,
+                                                                    NULL, NULL,
+                                                                    g_cclosure_marshal_VOID__OBJECT,
+                                                                    G_TYPE_NONE, 1,
+                                                                    XFW_TYPE_MONITOR);
 
     /**
      * XfwScreen::monitor-removed:
@@ -252,14 +294,14 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_signal_new("monitor-removed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 0,
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_MONITOR);
+    _xfw_screen_signals[SCREEN_SIGNAL_MONITOR_REMOVED] = g_signal_new("monitor-removed",
+                                                                      XFW_TYPE_SCREEN,
+                                                                      G_SIGNAL_RUN_LAST,
+                                                                      0,
+                                                                      NULL, NULL,
+                                                                      g_cclosure_marshal_VOID__OBJECT,
+                                                                      G_TYPE_NONE, 1,
+                                                                      XFW_TYPE_MONITOR);
     /**
      * XfwScreen::monitors-changed:
      * @screen: the object which received the signal.
@@ -280,26 +322,52 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      *
      * Since: 4.19.4
      **/
-    g_signal_new("monitors-changed",
-                 XFW_TYPE_SCREEN,
-                 G_SIGNAL_RUN_LAST,
-                 0,
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_screen_signals[SCREEN_SIGNAL_MONITORS_CHANGED] = g_signal_new("monitors-changed",
+                                                                       XFW_TYPE_SCREEN,
+                                                                       G_SIGNAL_RUN_LAST,
+                                                                       0,
+                                                                       NULL, NULL,
+                                                                       g_cclosure_marshal_VOID__VOID,
+                                                                       G_TYPE_NONE, 0);
+
+    /**
+     * XfwScreen::changes-committed:
+     * @screen: the object which received the signal.
+     * @changes: (element-type XfwWindowChange): an array of #XfwWindowChange,
+     *           one for each window that changed.
+     *
+     * Emitted at most once per main loop iteration, after the windowing
+     * system has delivered a batch of events, with everything that happened
+     * to the windows on @screen in the meantime.  Each window appears in
+     * @changes only once, with all of its changes combined, in the order in
+     * which the windows first changed.
+     *
+     * This is an alternative to connecting to the individual signals on
+     * every #XfwWindow, which can be costly on a busy screen; changes are
+     * only tracked while a handler is connected.  The window signals are
+     * still emitted as usual.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_screen_signals[SCREEN_SIGNAL_CHANGES_COMMITTED] = g_signal_new("changes-committed",
+                                                                        XFW_TYPE_SCREEN,
+                                                                        G_SIGNAL_RUN_LAST,
+                                                                        0,
+                                                                        NULL, NULL,
+                                                                        g_cclosure_marshal_VOID__BOXED,
+                                                                        G_TYPE_NONE, 1,
+                                                                        G_TYPE_PTR_ARRAY);
 
     /**
      * XfwScreen:gdk-screen:
      *
      * The #GdkScreen instance used to construct this #XfwScreen.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SCREEN,
-                                    g_param_spec_object("gdk-screen",
-                                                        "gdk-screen",
-                                                        "GdkScreen",
-                                                        GDK_TYPE_SCREEN,
-                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    screen_properties[PROP_SCREEN] = g_param_spec_object("gdk-screen",
+                                                         "gdk-screen",
+                                                         "GdkScreen",
+                                                         GDK_TYPE_SCREEN,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwScreen:workspace-manager:
@@ -307,43 +375,113 @@ xfw_screen_class_init(XfwScreenClass *klass) {
      * The #XfwWorkspaceManager that manages and describes workspace groups
      * and workspaces on this screen instance.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_WORKSPACE_MANAGER,
-                                    g_param_spec_object("workspace-manager",
-                                                        "workspace-manager",
-                                                        "workspace-manager",
-                                                        XFW_TYPE_WORKSPACE_MANAGER,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    screen_properties[PROP_WORKSPACE_MANAGER] = g_param_spec_object("workspace-manager",
+                                                                    "workspace-manager",
+                                                                    "workspace-manager",
+                                                                    XFW_TYPE_WORKSPACE_MANAGER,
+                                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwScreen:active-window:
      *
      * The currently-active window.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_ACTIVE_WINDOW,
-                                    g_param_spec_object("active-window",
-                                                        "active-window",
-                                                        "active-window",
-                                                        XFW_TYPE_WINDOW,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    screen_properties[PROP_ACTIVE_WINDOW] = g_param_spec_object("active-window",
+                                                                "active-window",
+                                                                "active-window",
+                                                                XFW_TYPE_WINDOW,
+                                                                G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwScreen:show-desktop:
      *
      * Whether or not to show the desktop.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SHOW_DESKTOP,
-                                    g_param_spec_boolean("show-desktop",
-                                                         "show-desktop",
-                                                         "show-desktop",
+    screen_properties[PROP_SHOW_DESKTOP] = g_param_spec_boolean("show-desktop",
+                                                                "show-desktop",
+                                                                "show-desktop",
+                                                                FALSE,
+                                                                G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwScreen:ready:
+     *
+     * Whether or not the initial state of the screen (seats, monitors,
+     * workspaces, and windows) has been fully received from the windowing
+     * system.
+     *
+     * Instances returned by #xfw_screen_get_default() are always ready.
+     * Instances returned by #xfw_screen_get_default_finish() are ready as
+     * well, but the property can be watched to find out when a screen that
+     * is still being set up becomes usable.
+     *
+     * Since: 4.21.0
+     **/
+    screen_properties[PROP_READY] = g_param_spec_boolean("ready",
+                                                         "ready",
+                                                         "ready",
                                                          FALSE,
-                                                         G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS));
+                                                         G_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwScreen:geometry-throttle-interval:
+     *
+     * The minimum time, in milliseconds, between two emissions of
+     * #XfwWindow::geometry-changed for the same window, or 0 to emit the
+     * signal for every change.
+     *
+     * While a window is moved or resized interactively, its geometry can
+     * change hundreds of times per second.  With a throttle interval set, the
+     * first change is reported right away, further changes are coalesced,
+     * and the final geometry is always reported before
+     * #XfwWindow::geometry-settled is emitted.  An interval of 16 to 33
+     * milliseconds matches the refresh rate of most displays.
+     *
+     * Since: 4.21.0
+     **/
+    screen_properties[PROP_GEOMETRY_THROTTLE_INTERVAL] = g_param_spec_uint("geometry-throttle-interval",
+                                                                           "geometry-throttle-interval",
+                                                                           "geometry-throttle-interval",
+                                                                           0, G_MAXUINT, 0,
+                                                                           G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwScreen:name-throttle-interval:
+     *
+     * The minimum time, in milliseconds, between two emissions of
+     * #XfwWindow::name-changed (and notifications of #XfwWindow:name) for
+     * the same window, or 0 to emit the signal for every change.
+     *
+     * Some applications, such as terminals showing the progress of a
+     * command, update their title many times per second.  With a throttle
+     * interval set, the first change is reported right away, further changes
+     * are coalesced, and the final title is always reported once the interval
+     * has passed.  An interval of 100 milliseconds (10 updates per second) is
+     * plenty for a tasklist.
+     *
+     * Since: 4.21.0
+     **/
+    screen_properties[PROP_NAME_THROTTLE_INTERVAL] = g_param_spec_uint("name-throttle-interval",
+                                                                       "name-throttle-interval",
+                                                                       "name-throttle-interval",
+                                                                       0, G_MAXUINT, 0,
+                                                                       G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_PROPERTIES, screen_properties);
 }
 
 static void
-xfw_screen_init(XfwScreen *screen) {}
+xfw_screen_init(XfwScreen *screen) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    priv->monitor_index = _xfw_monitor_index_new();
+    priv->window_index = _xfw_window_index_new();
+
+    // Connected before anyone else gets a chance to, so the per-workspace and
+    // per-monitor window lists are already up to date in other handlers
+    g_signal_connect(screen, "window-opened", G_CALLBACK(window_opened), NULL);
+    g_signal_connect(screen, "window-closed", G_CALLBACK(window_closed), NULL);
+    g_signal_connect(screen, "window-stacking-changed", G_CALLBACK(window_stacking_changed), NULL);
+}
 
 static void
 xfw_screen_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec) {
@@ -362,6 +500,14 @@ xfw_screen_set_property(GObject *object, guint property_id, const GValue *value,
             xfw_screen_set_show_desktop(XFW_SCREEN(object), g_value_get_boolean(value));
             break;
 
+        case PROP_GEOMETRY_THROTTLE_INTERVAL:
+            xfw_screen_set_geometry_throttle_interval(XFW_SCREEN(object), g_value_get_uint(value));
+            break;
+
+        case PROP_NAME_THROTTLE_INTERVAL:
+            xfw_screen_set_name_throttle_interval(XFW_SCREEN(object), g_value_get_uint(value));
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
@@ -389,20 +535,70 @@ xfw_screen_get_property(GObject *object, guint property_id, GValue *value, GPara
             g_value_set_boolean(value, priv->show_desktop);
             break;
 
+        case PROP_READY:
+            g_value_set_boolean(value, priv->ready);
+            break;
+
+        case PROP_GEOMETRY_THROTTLE_INTERVAL:
+            g_value_set_uint(value, priv->geometry_throttle_interval);
+            break;
+
+        case PROP_NAME_THROTTLE_INTERVAL:
+            g_value_set_uint(value, priv->name_throttle_interval);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
             break;
     }
 }
 
+static void
+xfw_screen_dispose(GObject *object) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(object);
+
+    // The backends drop their windows in finalize, so the index has to let go
+    // of them first
+    g_clear_pointer(&priv->window_index, _xfw_window_index_free);
+
+    if (priv->commit_changes_id != 0) {
+        g_source_remove(priv->commit_changes_id);
+        priv->commit_changes_id = 0;
+    }
+    g_clear_pointer(&priv->pending_changes_by_window, g_hash_table_destroy);
+    g_clear_pointer(&priv->pending_changes, g_ptr_array_unref);
+
+    g_clear_pointer(&priv->snapshot, xfw_screen_snapshot_unref);
+
+    // Someone may still hold on to a model, but it shouldn't keep the
+    // windows and monitors alive
+    XfwWindowModel **window_models[] = { &priv->windows_model, &priv->windows_stacked_model };
+    for (gsize i = 0; i < G_N_ELEMENTS(window_models); ++i) {
+        if (*window_models[i] != NULL) {
+            _xfw_window_model_clear(*window_models[i]);
+            g_clear_object(window_models[i]);
+        }
+    }
+    if (priv->monitors_model != NULL) {
+        g_list_store_remove_all(priv->monitors_model);
+        g_clear_object(&priv->monitors_model);
+    }
+
+    G_OBJECT_CLASS(xfw_screen_parent_class)->dispose(object);
+}
+
 static void
 xfw_screen_finalize(GObject *object) {
     XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(object);
 
     g_list_free_full(priv->seats, g_object_unref);
     g_list_free_full(priv->monitors, g_object_unref);
+    _xfw_monitor_index_free(priv->monitor_index);
 
-    g_object_unref(priv->workspace_manager);
+    // The screen can go away before the initial setup has completed
+    if (priv->workspace_manager != NULL) {
+        g_object_unref(priv->workspace_manager);
+    }
 
     G_OBJECT_CLASS(xfw_screen_parent_class)->finalize(object);
 }
@@ -475,6 +671,97 @@ xfw_screen_get_windows_stacked(XfwScreen *screen) {
     return klass->get_windows_stacked(screen);
 }
 
+/**
+ * xfw_screen_get_windows_model:
+ * @screen: an #XfwScreen.
+ *
+ * Retrieves a #GListModel of the windows on @screen, in the order in which
+ * they were opened.
+ *
+ * The model is kept up to date as windows open and close, and emits
+ * #GListModel::items-changed for exactly the windows that were added or
+ * removed, so a widget showing the windows can update one row at a time
+ * instead of comparing the lists returned by #xfw_screen_get_windows().
+ * See #XfwWindowListView for filtered and sorted views of the model.
+ *
+ * Return value: (not nullable) (transfer none): a #GListModel of
+ * #XfwWindow, owned by @screen.
+ *
+ * Since: 4.21.0
+ **/
+GListModel *
+xfw_screen_get_windows_model(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    if (priv->windows_model == NULL) {
+        // xfw_screen_get_windows() has the most recently opened window first
+        GList *windows = g_list_reverse(g_list_copy(xfw_screen_get_windows(screen)));
+        priv->windows_model = _xfw_window_model_new();
+        _xfw_window_model_sync(priv->windows_model, windows);
+        g_list_free(windows);
+    }
+
+    return G_LIST_MODEL(priv->windows_model);
+}
+
+/**
+ * xfw_screen_get_windows_stacked_model:
+ * @screen: an #XfwScreen.
+ *
+ * Retrieves a #GListModel of the windows on @screen, in stacking order, with
+ * the bottom-most window first.
+ *
+ * When the stacking order changes, the model emits a single
+ * #GListModel::items-changed covering only the windows that moved; raising
+ * a window to the top, for example, touches the range between its old
+ * position and the top of the stack.
+ *
+ * Return value: (not nullable) (transfer none): a #GListModel of
+ * #XfwWindow, owned by @screen.
+ *
+ * Since: 4.21.0
+ **/
+GListModel *
+xfw_screen_get_windows_stacked_model(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    if (priv->windows_stacked_model == NULL) {
+        priv->windows_stacked_model = _xfw_window_model_new();
+        _xfw_window_model_sync(priv->windows_stacked_model, xfw_screen_get_windows_stacked(screen));
+    }
+
+    return G_LIST_MODEL(priv->windows_stacked_model);
+}
+
+/**
+ * xfw_screen_snapshot:
+ * @screen: an #XfwScreen.
+ *
+ * Takes a snapshot of the state of all windows on @screen.  See
+ * #XfwScreenSnapshot for details.
+ *
+ * If nothing has changed since the last call, the same snapshot is
+ * returned again, so this is cheap enough to call on every redraw.
+ *
+ * Return value: (transfer full): an #XfwScreenSnapshot.  Release it with
+ * #xfw_screen_snapshot_unref().
+ *
+ * Since: 4.21.0
+ **/
+XfwScreenSnapshot *
+xfw_screen_snapshot(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    if (priv->snapshot == NULL) {
+        priv->snapshot = _xfw_screen_snapshot_new(xfw_screen_get_windows_stacked(screen), ++priv->snapshot_generation);
+    }
+
+    return xfw_screen_snapshot_ref(priv->snapshot);
+}
+
 /**
  * xfw_screen_get_active_window:
  * @screen: an #XfwScreen.
@@ -508,6 +795,34 @@ xfw_screen_get_monitors(XfwScreen *screen) {
     return XFW_SCREEN_GET_PRIVATE(screen)->monitors;
 }
 
+/**
+ * xfw_screen_get_monitors_model:
+ * @screen: an #XfwScreen.
+ *
+ * Retrieves a #GListModel of the monitors currently attached and enabled on
+ * @screen, in the same order as #xfw_screen_get_monitors().
+ *
+ * The model is updated before #XfwScreen::monitor-added and
+ * #XfwScreen::monitor-removed are emitted.
+ *
+ * Return value: (not nullable) (transfer none): a #GListModel of
+ * #XfwMonitor, owned by @screen.
+ *
+ * Since: 4.21.0
+ **/
+GListModel *
+xfw_screen_get_monitors_model(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    if (priv->monitors_model == NULL) {
+        priv->monitors_model = g_list_store_new(XFW_TYPE_MONITOR);
+        _xfw_list_store_sync(priv->monitors_model, priv->monitors);
+    }
+
+    return G_LIST_MODEL(priv->monitors_model);
+}
+
 /**
  * xfw_screen_get_primary_monitor:
  * @screen: an #XfwScreen.
@@ -552,6 +867,90 @@ xfw_screen_get_monitor_from_gdk_monitor(XfwScreen *screen, GdkMonitor *monitor)
     return _xfw_monitor_from_gdk_monitor(XFW_SCREEN_GET_PRIVATE(screen)->monitors, monitor);
 }
 
+/**
+ * xfw_screen_get_monitor_at_point:
+ * @screen: an #XfwScreen.
+ * @x: the X coordinate of the point, in physical device pixels.
+ * @y: the Y coordinate of the point, in physical device pixels.
+ *
+ * Finds the monitor that contains the point at (@x, @y), in the same
+ * coordinate space as #xfw_monitor_get_physical_geometry().
+ *
+ * If more than one monitor contains the point (for example, when monitors
+ * are mirrored), the one that comes first in the list returned by
+ * #xfw_screen_get_monitors() is returned.
+ *
+ * Return value: (nullable) (transfer none): an #XfwMonitor, or %NULL if no
+ * monitor contains the point.
+ *
+ * Since: 4.21.0
+ **/
+XfwMonitor *
+xfw_screen_get_monitor_at_point(XfwScreen *screen, gint x, gint y) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    return _xfw_monitor_index_at_point(XFW_SCREEN_GET_PRIVATE(screen)->monitor_index, x, y);
+}
+
+/**
+ * xfw_screen_get_monitor_for_rect:
+ * @screen: an #XfwScreen.
+ * @rect: (not nullable): a #GdkRectangle, in physical device pixels.
+ *
+ * Finds the monitor that @rect overlaps the most, in the same coordinate
+ * space as #xfw_monitor_get_physical_geometry().  This can be used with the
+ * geometry returned by #xfw_window_get_geometry() to find out which monitor
+ * a window is mostly on.
+ *
+ * Ties are broken in favor of the monitor that comes first in the list
+ * returned by #xfw_screen_get_monitors().
+ *
+ * Return value: (nullable) (transfer none): an #XfwMonitor, or %NULL if
+ * @rect doesn't overlap any monitor.
+ *
+ * Since: 4.21.0
+ **/
+XfwMonitor *
+xfw_screen_get_monitor_for_rect(XfwScreen *screen, const GdkRectangle *rect) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), NULL);
+    g_return_val_if_fail(rect != NULL, NULL);
+
+    GList *monitors = _xfw_screen_get_monitors_for_rect(screen, rect);
+    XfwMonitor *best_monitor = NULL;
+    gint64 best_area = 0;
+
+    for (GList *l = monitors; l != NULL; l = l->next) {
+        GdkRectangle geom, intersection;
+        xfw_monitor_get_physical_geometry(XFW_MONITOR(l->data), &geom);
+        if (gdk_rectangle_intersect(&geom, rect, &intersection)) {
+            gint64 area = (gint64)intersection.width * intersection.height;
+            if (area > best_area) {
+                best_area = area;
+                best_monitor = XFW_MONITOR(l->data);
+            }
+        }
+    }
+
+    g_list_free(monitors);
+    return best_monitor;
+}
+
+/**
+ * xfw_screen_is_ready:
+ * @screen: an #XfwScreen.
+ *
+ * Checks whether or not the initial state of @screen has been fully received
+ * from the windowing system.  See #XfwScreen:ready for details.
+ *
+ * Return value: %TRUE if @screen is ready, %FALSE otherwise.
+ *
+ * Since: 4.21.0
+ **/
+gboolean
+xfw_screen_is_ready(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), FALSE);
+    return XFW_SCREEN_GET_PRIVATE(screen)->ready;
+}
+
 /**
  * xfw_screen_get_show_desktop:
  * @screen: an #XfwScreen.
@@ -588,6 +987,150 @@ xfw_screen_set_show_desktop(XfwScreen *screen, gboolean show) {
     }
 }
 
+/**
+ * xfw_screen_get_geometry_throttle_interval:
+ * @screen: an #XfwScreen.
+ *
+ * Retrieves the minimum time between #XfwWindow::geometry-changed emissions
+ * for windows on @screen.  See #XfwScreen:geometry-throttle-interval.
+ *
+ * Return value: the interval in milliseconds, or 0 if geometry changes are
+ * not throttled.
+ *
+ * Since: 4.21.0
+ **/
+guint
+xfw_screen_get_geometry_throttle_interval(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), 0);
+    return XFW_SCREEN_GET_PRIVATE(screen)->geometry_throttle_interval;
+}
+
+/**
+ * xfw_screen_set_geometry_throttle_interval:
+ * @screen: an #XfwScreen.
+ * @interval_ms: the minimum time between emissions, in milliseconds, or 0.
+ *
+ * Limits how often #XfwWindow::geometry-changed is emitted for each window
+ * on @screen.  See #XfwScreen:geometry-throttle-interval.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_screen_set_geometry_throttle_interval(XfwScreen *screen, guint interval_ms) {
+    g_return_if_fail(XFW_IS_SCREEN(screen));
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    if (priv->geometry_throttle_interval != interval_ms) {
+        priv->geometry_throttle_interval = interval_ms;
+        g_object_notify_by_pspec(G_OBJECT(screen), screen_properties[PROP_GEOMETRY_THROTTLE_INTERVAL]);
+    }
+}
+
+/**
+ * xfw_screen_get_name_throttle_interval:
+ * @screen: an #XfwScreen.
+ *
+ * Retrieves the minimum time between #XfwWindow::name-changed emissions for
+ * windows on @screen.  See #XfwScreen:name-throttle-interval.
+ *
+ * Return value: the interval in milliseconds, or 0 if name changes are not
+ * throttled.
+ *
+ * Since: 4.21.0
+ **/
+guint
+xfw_screen_get_name_throttle_interval(XfwScreen *screen) {
+    g_return_val_if_fail(XFW_IS_SCREEN(screen), 0);
+    return XFW_SCREEN_GET_PRIVATE(screen)->name_throttle_interval;
+}
+
+/**
+ * xfw_screen_set_name_throttle_interval:
+ * @screen: an #XfwScreen.
+ * @interval_ms: the minimum time between emissions, in milliseconds, or 0.
+ *
+ * Limits how often #XfwWindow::name-changed is emitted for each window on
+ * @screen.  See #XfwScreen:name-throttle-interval.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_screen_set_name_throttle_interval(XfwScreen *screen, guint interval_ms) {
+    g_return_if_fail(XFW_IS_SCREEN(screen));
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    if (priv->name_throttle_interval != interval_ms) {
+        priv->name_throttle_interval = interval_ms;
+        g_object_notify_by_pspec(G_OBJECT(screen), screen_properties[PROP_NAME_THROTTLE_INTERVAL]);
+    }
+}
+
+static void
+window_model_add(XfwWindowModel *model, XfwWindow *window) {
+    // A model created before the screen announced the window already has it,
+    // in which case this does nothing
+    if (model != NULL) {
+        _xfw_window_model_append(model, window);
+    }
+}
+
+static void
+window_model_remove(XfwWindowModel *model, XfwWindow *window) {
+    if (model != NULL) {
+        _xfw_window_model_remove(model, window);
+    }
+}
+
+static void
+window_opened(XfwScreen *screen, XfwWindow *window) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    if (priv->window_index != NULL) {
+        _xfw_window_index_add(priv->window_index, window);
+    }
+    window_model_add(priv->windows_model, window);
+    // New windows go on top; the backend follows up with
+    // window-stacking-changed if that's not where it ended up
+    window_model_add(priv->windows_stacked_model, window);
+    _xfw_screen_window_changed(screen, window, XFW_WINDOW_CHANGE_OPENED);
+}
+
+static void
+window_closed(XfwScreen *screen, XfwWindow *window) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    if (priv->window_index != NULL) {
+        _xfw_window_index_remove(priv->window_index, window);
+    }
+    window_model_remove(priv->windows_model, window);
+    window_model_remove(priv->windows_stacked_model, window);
+    _xfw_screen_window_changed(screen, window, XFW_WINDOW_CHANGE_CLOSED);
+}
+
+static void
+window_stacking_changed(XfwScreen *screen) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    g_clear_pointer(&priv->snapshot, xfw_screen_snapshot_unref);
+    if (priv->windows_stacked_model != NULL) {
+        _xfw_window_model_sync(priv->windows_stacked_model, xfw_screen_get_windows_stacked(screen));
+    }
+}
+
+static gboolean
+commit_changes(gpointer data) {
+    XfwScreen *screen = XFW_SCREEN(data);
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    priv->commit_changes_id = 0;
+
+    // Handlers may cause more changes; those go into the next batch
+    GPtrArray *changes = g_steal_pointer(&priv->pending_changes);
+    g_hash_table_remove_all(priv->pending_changes_by_window);
+
+    if (changes != NULL) {
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_CHANGES_COMMITTED], 0, changes);
+        g_ptr_array_unref(changes);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
 static void
 screen_destroyed(GdkScreen *gdk_screen, XfwScreen *screen) {
     g_object_steal_data(G_OBJECT(gdk_screen), GDK_SCREEN_XFW_SCREEN_KEY);
@@ -635,12 +1178,100 @@ xfw_screen_get(GdkScreen *gdk_screen) {
  *
  * Retrieves the #XfwScreen instance corresponding to the default #GdkScreen.
  *
+ * On some windowing systems (Wayland in particular), this needs to wait for
+ * several round trips to the display server before returning.  Applications
+ * that care about startup latency may want to use
+ * #xfw_screen_get_default_async() instead.
+ *
  * Return value: (not nullable) (transfer full): an #XfwScreen instance, with
  * a reference owned by the caller.
  **/
 XfwScreen *
 xfw_screen_get_default(void) {
-    return xfw_screen_get(gdk_screen_get_default());
+    XfwScreen *screen = xfw_screen_get(gdk_screen_get_default());
+
+    if (screen != NULL && !XFW_SCREEN_GET_PRIVATE(screen)->ready) {
+        XfwScreenClass *klass = XFW_SCREEN_GET_CLASS(screen);
+        if (klass->wait_ready != NULL) {
+            klass->wait_ready(screen);
+        }
+    }
+
+    return screen;
+}
+
+static void
+get_default_async_ready(XfwScreen *screen, GParamSpec *pspec, GTask *task) {
+    if (XFW_SCREEN_GET_PRIVATE(screen)->ready) {
+        g_signal_handlers_disconnect_by_func(screen, get_default_async_ready, task);
+        if (!g_task_return_error_if_cancelled(task)) {
+            g_task_return_pointer(task, g_object_ref(screen), g_object_unref);
+        }
+        g_object_unref(task);
+    }
+}
+
+/**
+ * xfw_screen_get_default_async:
+ * @cancellable: (nullable): a #GCancellable, or %NULL.
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the screen is
+ *            ready.
+ * @user_data: (closure): data to pass to @callback.
+ *
+ * Asynchronously retrieves the #XfwScreen instance corresponding to the
+ * default #GdkScreen.
+ *
+ * Unlike #xfw_screen_get_default(), this does not block while the initial
+ * state of the screen is received from the windowing system; @callback is
+ * invoked from the thread-default main context once the screen is ready.
+ * Call #xfw_screen_get_default_finish() from @callback to obtain the screen.
+ *
+ * Cancelling @cancellable does not abort the setup of the screen, which will
+ * still be shared with later callers; it only causes the operation to finish
+ * with %G_IO_ERROR_CANCELLED.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_screen_get_default_async(GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data) {
+    g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+
+    GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+    g_task_set_source_tag(task, xfw_screen_get_default_async);
+
+    XfwScreen *screen = xfw_screen_get(gdk_screen_get_default());
+    if (screen == NULL) {
+        g_task_return_new_error(task, XFW_ERROR, XFW_ERROR_UNSUPPORTED, "Unknown/unsupported windowing environment");
+        g_object_unref(task);
+    } else {
+        // The task holds the only reference we take here until the screen is ready
+        g_task_set_task_data(task, screen, g_object_unref);
+        if (XFW_SCREEN_GET_PRIVATE(screen)->ready) {
+            g_task_return_pointer(task, g_object_ref(screen), g_object_unref);
+            g_object_unref(task);
+        } else {
+            g_signal_connect(screen, "notify::ready", G_CALLBACK(get_default_async_ready), task);
+        }
+    }
+}
+
+/**
+ * xfw_screen_get_default_finish:
+ * @result: the #GAsyncResult passed to the #GAsyncReadyCallback.
+ * @error: (out) (optional): a location to store a #GError, or %NULL.
+ *
+ * Finishes an operation started with #xfw_screen_get_default_async().
+ *
+ * Return value: (nullable) (transfer full): an #XfwScreen instance, with a
+ * reference owned by the caller, or %NULL if @error is set.
+ *
+ * Since: 4.21.0
+ **/
+XfwScreen *
+xfw_screen_get_default_finish(GAsyncResult *result, GError **error) {
+    g_return_val_if_fail(g_task_is_valid(result, NULL), NULL);
+    g_return_val_if_fail(g_task_get_source_tag(G_TASK(result)) == xfw_screen_get_default_async, NULL);
+    return g_task_propagate_pointer(G_TASK(result), error);
 }
 
 GdkScreen *
@@ -653,14 +1284,14 @@ void
 _xfw_screen_seat_added(XfwScreen *screen, XfwSeat *seat) {
     XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
     priv->seats = g_list_append(priv->seats, seat);
-    g_signal_emit_by_name(screen, "seat-added", seat);
+    g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_SEAT_ADDED], 0, seat);
 }
 
 void
 _xfw_screen_seat_removed(XfwScreen *screen, XfwSeat *seat) {
     XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
     priv->seats = g_list_remove(priv->seats, seat);
-    g_signal_emit_by_name(screen, "seat-removed", seat);
+    g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_SEAT_REMOVED], 0, seat);
     g_object_unref(seat);
 }
 
@@ -680,6 +1311,7 @@ _xfw_screen_set_monitors(XfwScreen *screen, GList *monitors, GList *added, GList
     XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
     g_list_free_full(priv->monitors, g_object_unref);
     priv->monitors = monitors;
+    _xfw_monitor_index_set_monitors(priv->monitor_index, monitors);
 
     for (GList *l = monitors; l != NULL; l = l->next) {
         XfwMonitor *monitor = XFW_MONITOR(l->data);
@@ -694,21 +1326,55 @@ _xfw_screen_set_monitors(XfwScreen *screen, GList *monitors, GList *added, GList
         changed |= _xfw_monitor_notify_pending_changes(XFW_MONITOR(l->data));
     }
 
+    // Bring the windows' monitor lists up to date before anyone hears about
+    // the change.  Only the windows on a removed monitor (according to the
+    // window index, which only exists once the screen is ready) are told about
+    // the removal, and only the windows the backend thinks may be on an added
+    // monitor are asked about it.
+    XfwScreenClass *klass = XFW_SCREEN_GET_CLASS(screen);
+    for (GList *l = removed; l != NULL; l = l->next) {
+        XfwMonitor *monitor = XFW_MONITOR(l->data);
+        GList *affected = g_list_copy(priv->ready ? xfw_monitor_list_windows(monitor) : xfw_screen_get_windows(screen));
+        for (GList *lw = affected; lw != NULL; lw = lw->next) {
+            _xfw_window_monitor_removed(XFW_WINDOW(lw->data), monitor);
+        }
+        g_list_free(affected);
+    }
+    for (GList *l = added; l != NULL; l = l->next) {
+        XfwMonitor *monitor = XFW_MONITOR(l->data);
+        GList *candidates = klass->get_windows_for_new_monitor != NULL
+                                ? klass->get_windows_for_new_monitor(screen, monitor)
+                                : g_list_copy(xfw_screen_get_windows(screen));
+        for (GList *lw = candidates; lw != NULL; lw = lw->next) {
+            _xfw_window_monitor_added(XFW_WINDOW(lw->data), monitor);
+        }
+        g_list_free(candidates);
+    }
+
+    if (priv->monitors_model != NULL) {
+        _xfw_list_store_sync(priv->monitors_model, monitors);
+    }
+
     for (GList *l = added; l != NULL; l = l->next) {
-        g_signal_emit_by_name(screen, "monitor-added", XFW_MONITOR(l->data));
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_MONITOR_ADDED], 0, XFW_MONITOR(l->data));
     }
 
     for (GList *l = removed; l != NULL; l = l->next) {
-        g_signal_emit_by_name(screen, "monitor-removed", XFW_MONITOR(l->data));
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_MONITOR_REMOVED], 0, XFW_MONITOR(l->data));
     }
 
     if ((changed & MONITORS_CHANGED_MASK) != 0 || added != NULL || removed != NULL) {
         // Only notify if what has changed is relevant to positioning or size, or if
         // a monitor was added or removed, or the primary monitor has changed.
-        g_signal_emit_by_name(screen, "monitors-changed");
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_MONITORS_CHANGED], 0);
     }
 }
 
+GList *
+_xfw_screen_get_monitors_for_rect(XfwScreen *screen, const GdkRectangle *rect) {
+    return _xfw_monitor_index_for_rect(XFW_SCREEN_GET_PRIVATE(screen)->monitor_index, rect);
+}
+
 void
 _xfw_screen_set_primary_monitor(XfwScreen *screen, XfwMonitor *primary_monitor) {
     XFW_SCREEN_GET_PRIVATE(screen)->primary_monitor = primary_monitor;
@@ -721,8 +1387,60 @@ _xfw_screen_set_active_window(XfwScreen *screen, XfwWindow *window) {
         XfwWindow *previous_window = priv->active_window;
         priv->active_window = window;
 
-        g_object_notify(G_OBJECT(screen), "active-window");
-        g_signal_emit_by_name(screen, "active-window-changed", previous_window);
+        g_object_notify_by_pspec(G_OBJECT(screen), screen_properties[PROP_ACTIVE_WINDOW]);
+        g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_ACTIVE_WINDOW_CHANGED], 0, previous_window);
+    }
+}
+
+void
+_xfw_screen_window_changed(XfwScreen *screen, XfwWindow *window, XfwWindowChangeFlags changes) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+
+    // Every change to a window goes through here, so the backends don't
+    // need to know about the snapshot
+    g_clear_pointer(&priv->snapshot, xfw_screen_snapshot_unref);
+
+    // Nothing is recorded unless someone is going to look at it
+    if (!g_signal_has_handler_pending(screen, _xfw_screen_signals[SCREEN_SIGNAL_CHANGES_COMMITTED], 0, TRUE)) {
+        return;
+    }
+
+    if (priv->pending_changes_by_window == NULL) {
+        priv->pending_changes_by_window = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+    if (priv->pending_changes == NULL) {
+        priv->pending_changes = g_ptr_array_new_with_free_func((GDestroyNotify)_xfw_window_change_free);
+    }
+
+    XfwWindowChange *change = g_hash_table_lookup(priv->pending_changes_by_window, window);
+    if (change == NULL) {
+        change = g_new(XfwWindowChange, 1);
+        change->window = g_object_ref(window);
+        change->changes = XFW_WINDOW_CHANGE_NONE;
+        g_ptr_array_add(priv->pending_changes, change);
+        g_hash_table_insert(priv->pending_changes_by_window, window, change);
+    }
+    change->changes |= changes;
+
+    // High priority, so the batch goes out before redrawing, but only after
+    // the rest of the events that were read along with this one
+    if (priv->commit_changes_id == 0) {
+        priv->commit_changes_id = g_idle_add_full(G_PRIORITY_HIGH_IDLE, commit_changes, screen, NULL);
+    }
+}
+
+void
+_xfw_screen_set_ready(XfwScreen *screen) {
+    XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
+    if (!priv->ready) {
+        // Windows that were already there when the screen was set up don't
+        // get a window-opened emission
+        for (GList *l = xfw_screen_get_windows(screen); l != NULL; l = l->next) {
+            _xfw_window_index_add(priv->window_index, l->data);
+        }
+
+        priv->ready = TRUE;
+        g_object_notify_by_pspec(G_OBJECT(screen), screen_properties[PROP_READY]);
     }
 }
 
@@ -731,7 +1449,7 @@ _xfw_screen_set_show_desktop(XfwScreen *screen, gboolean show_desktop) {
     XfwScreenPrivate *priv = XFW_SCREEN_GET_PRIVATE(screen);
     if (priv->show_desktop != show_desktop) {
         priv->show_desktop = show_desktop;
-        g_object_notify(G_OBJECT(screen), "show-desktop");
+        g_object_notify_by_pspec(G_OBJECT(screen), screen_properties[PROP_SHOW_DESKTOP]);
     }
 }
 
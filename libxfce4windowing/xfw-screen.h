@@ -25,6 +25,7 @@
 #endif
 
 #include <libxfce4windowing/xfw-monitor.h>
+#include <libxfce4windowing/xfw-screen-snapshot.h>
 #include <libxfce4windowing/xfw-window.h>
 #include <libxfce4windowing/xfw-workspace-manager.h>
 
@@ -34,6 +35,13 @@ G_BEGIN_DECLS
 G_DECLARE_DERIVABLE_TYPE(XfwScreen, xfw_screen, XFW, SCREEN, GObject)
 
 XfwScreen *xfw_screen_get_default(void);
+void xfw_screen_get_default_async(GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data);
+XfwScreen *xfw_screen_get_default_finish(GAsyncResult *result,
+                                         GError **error);
+
+gboolean xfw_screen_is_ready(XfwScreen *screen);
 
 GList *xfw_screen_get_seats(XfwScreen *screen);
 
@@ -41,16 +49,30 @@ XfwWorkspaceManager *xfw_screen_get_workspace_manager(XfwScreen *screen);
 
 GList *xfw_screen_get_windows(XfwScreen *screen);
 GList *xfw_screen_get_windows_stacked(XfwScreen *screen);
+GListModel *xfw_screen_get_windows_model(XfwScreen *screen);
+GListModel *xfw_screen_get_windows_stacked_model(XfwScreen *screen);
 XfwWindow *xfw_screen_get_active_window(XfwScreen *screen);
+XfwScreenSnapshot *xfw_screen_snapshot(XfwScreen *screen);
 
 GList *xfw_screen_get_monitors(XfwScreen *screen);
+GListModel *xfw_screen_get_monitors_model(XfwScreen *screen);
 XfwMonitor *xfw_screen_get_primary_monitor(XfwScreen *screen);
 XfwMonitor *xfw_screen_get_monitor_from_gdk_monitor(XfwScreen *screen,
                                                     GdkMonitor *monitor);
+XfwMonitor *xfw_screen_get_monitor_at_point(XfwScreen *screen,
+                                            gint x,
+                                            gint y);
+XfwMonitor *xfw_screen_get_monitor_for_rect(XfwScreen *screen,
+                                            const GdkRectangle *rect);
 
 gboolean xfw_screen_get_show_desktop(XfwScreen *screen);
 void xfw_screen_set_show_desktop(XfwScreen *screen, gboolean show);
 
+guint xfw_screen_get_geometry_throttle_interval(XfwScreen *screen);
+void xfw_screen_set_geometry_throttle_interval(XfwScreen *screen, guint interval_ms);
+guint xfw_screen_get_name_throttle_interval(XfwScreen *screen);
+void xfw_screen_set_name_throttle_interval(XfwScreen *screen, guint interval_ms);
+
 G_END_DECLS
 
 #endif /* !__XFW_SCREEN_H__ */
@@ -45,6 +45,7 @@ typedef struct _XfwSeatPrivate {
 enum {
     PROP_0,
     PROP_NAME,
+    N_PROPERTIES,
 };
 
 static void xfw_seat_set_property(GObject *object,
@@ -60,6 +61,7 @@ static void xfw_seat_finalize(GObject *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE(XfwSeat, xfw_seat, G_TYPE_OBJECT)
 
+static GParamSpec *seat_properties[N_PROPERTIES] = { NULL };
 
 static void
 xfw_seat_class_init(XfwSeatClass *klass) {
@@ -73,13 +75,13 @@ xfw_seat_class_init(XfwSeatClass *klass) {
      *
      * The seat's identifier.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_NAME,
-                                    g_param_spec_string("name",
-                                                        "name",
-                                                        "seat name",
-                                                        NULL,
-                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    seat_properties[PROP_NAME] = g_param_spec_string("name",
+                                                     "name",
+                                                     "seat name",
+                                                     NULL,
+                                                     G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_PROPERTIES, seat_properties);
 }
 
 static void
@@ -144,7 +146,7 @@ _xfw_seat_set_name(XfwSeat *seat, const gchar *name) {
     if (g_strcmp0(priv->name, name) != 0) {
         g_free(priv->name);
         priv->name = g_strdup(name);
-        g_object_notify(G_OBJECT(seat), "name");
+        g_object_notify_by_pspec(G_OBJECT(seat), seat_properties[PROP_NAME]);
     }
 }
 
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+// The Wayland foreign toplevel protocols have no "show desktop" request, so
+// we minimize every window ourselves and remember which ones, to restore
+// them later.  Minimizing is asynchronous: the compositor may apply our
+// requests late, or not at all, so we track both the windows we asked to
+// minimize and the ones it has actually minimized, and only ever restore
+// (or keep watching) the latter.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-show-desktop.h"
+
+struct _XfwShowDesktop {
+    XfwShowDesktopStage stage;
+    // Set of windows that we asked to minimize
+    GHashTable *requested;
+    // Subset of 'requested' that the compositor has since minimized
+    GHashTable *minimized;
+    gpointer was_active;
+};
+
+static void
+reset(XfwShowDesktop *show_desktop) {
+    show_desktop->stage = XFW_SHOW_DESKTOP_IDLE;
+    g_hash_table_remove_all(show_desktop->requested);
+    g_hash_table_remove_all(show_desktop->minimized);
+    show_desktop->was_active = NULL;
+}
+
+XfwShowDesktop *
+_xfw_show_desktop_new(void) {
+    XfwShowDesktop *show_desktop = g_new0(XfwShowDesktop, 1);
+    show_desktop->requested = g_hash_table_new(g_direct_hash, g_direct_equal);
+    show_desktop->minimized = g_hash_table_new(g_direct_hash, g_direct_equal);
+    return show_desktop;
+}
+
+void
+_xfw_show_desktop_free(XfwShowDesktop *show_desktop) {
+    g_hash_table_destroy(show_desktop->requested);
+    g_hash_table_destroy(show_desktop->minimized);
+    g_free(show_desktop);
+}
+
+XfwShowDesktopStage
+_xfw_show_desktop_get_stage(XfwShowDesktop *show_desktop) {
+    return show_desktop->stage;
+}
+
+gboolean
+_xfw_show_desktop_is_tracking(XfwShowDesktop *show_desktop, gpointer window) {
+    return g_hash_table_contains(show_desktop->requested, window);
+}
+
+// Starts tracking @to_minimize, forgetting anything from a previous round:
+// probably there is nothing, but the compositor might have failed to
+// unminimize some windows.  The caller sends the actual requests.
+void
+_xfw_show_desktop_show(XfwShowDesktop *show_desktop, GList *to_minimize, gpointer active_window) {
+    reset(show_desktop);
+    for (GList *l = to_minimize; l != NULL; l = l->next) {
+        g_hash_table_add(show_desktop->requested, l->data);
+        if (l->data == active_window) {
+            show_desktop->was_active = active_window;
+        }
+    }
+    if (g_hash_table_size(show_desktop->requested) > 0) {
+        show_desktop->stage = XFW_SHOW_DESKTOP_SHOWN;
+    }
+}
+
+// Returns the windows the caller should unminimize, to be freed with
+// g_list_free().  Windows the compositor never minimized are forgotten, so
+// they can be minimized by hand later without us interfering; if there are
+// none left, we're done straight away.
+GList *
+_xfw_show_desktop_restore(XfwShowDesktop *show_desktop) {
+    if (show_desktop->stage != XFW_SHOW_DESKTOP_SHOWN) {
+        return NULL;
+    }
+
+    GList *to_unminimize = g_hash_table_get_keys(show_desktop->minimized);
+    if (to_unminimize == NULL) {
+        reset(show_desktop);
+    } else {
+        GHashTableIter iter;
+        gpointer window;
+        g_hash_table_iter_init(&iter, show_desktop->requested);
+        while (g_hash_table_iter_next(&iter, &window, NULL)) {
+            if (!g_hash_table_contains(show_desktop->minimized, window)) {
+                g_hash_table_iter_remove(&iter);
+                if (show_desktop->was_active == window) {
+                    show_desktop->was_active = NULL;
+                }
+            }
+        }
+        show_desktop->stage = XFW_SHOW_DESKTOP_RESTORING;
+    }
+    return to_unminimize;
+}
+
+// Returns TRUE if showing the desktop is over, because the last window we
+// are tracking has been unminimized, by us or by the user.  @reactivate is then
+// set to the window that was active before, or NULL.
+gboolean
+_xfw_show_desktop_window_state_changed(XfwShowDesktop *show_desktop,
+                                       gpointer window,
+                                       gboolean is_minimized,
+                                       gpointer *reactivate) {
+    if (show_desktop->stage == XFW_SHOW_DESKTOP_IDLE || !g_hash_table_contains(show_desktop->requested, window)) {
+        return FALSE;
+    }
+
+    if (is_minimized) {
+        g_hash_table_add(show_desktop->minimized, window);
+        return FALSE;
+    }
+
+    // Once unminimized, a window is none of our business any more
+    g_hash_table_remove(show_desktop->requested, window);
+    g_hash_table_remove(show_desktop->minimized, window);
+    if (g_hash_table_size(show_desktop->requested) == 0) {
+        *reactivate = show_desktop->was_active;
+        reset(show_desktop);
+        return TRUE;
+    } else {
+        return FALSE;
+    }
+}
+
+// Returns TRUE if showing the desktop is over, because the last window we
+// are tracking has closed.
+gboolean
+_xfw_show_desktop_window_closed(XfwShowDesktop *show_desktop, gpointer window) {
+    if (show_desktop->stage == XFW_SHOW_DESKTOP_IDLE || !g_hash_table_remove(show_desktop->requested, window)) {
+        return FALSE;
+    }
+
+    g_hash_table_remove(show_desktop->minimized, window);
+    if (show_desktop->was_active == window) {
+        show_desktop->was_active = NULL;
+    }
+    if (g_hash_table_size(show_desktop->requested) == 0) {
+        reset(show_desktop);
+        return TRUE;
+    } else {
+        return FALSE;
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+#ifndef __XFW_SHOW_DESKTOP_H__
+#define __XFW_SHOW_DESKTOP_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+    // Not showing the desktop, and not tracking any windows
+    XFW_SHOW_DESKTOP_IDLE,
+    // Showing the desktop: we've asked the requested windows to minimize
+    XFW_SHOW_DESKTOP_SHOWN,
+    // We've asked the windows we minimized to unminimize
+    XFW_SHOW_DESKTOP_RESTORING,
+} XfwShowDesktopStage;
+
+// Bookkeeping for showing the desktop on compositors that don't do it for
+// us.  Windows are opaque pointers here, so this can be tested on its own.
+typedef struct _XfwShowDesktop XfwShowDesktop;
+
+XfwShowDesktop *_xfw_show_desktop_new(void);
+void _xfw_show_desktop_free(XfwShowDesktop *show_desktop);
+
+XfwShowDesktopStage _xfw_show_desktop_get_stage(XfwShowDesktop *show_desktop);
+gboolean _xfw_show_desktop_is_tracking(XfwShowDesktop *show_desktop, gpointer window);
+
+void _xfw_show_desktop_show(XfwShowDesktop *show_desktop, GList *to_minimize, gpointer active_window);
+GList *_xfw_show_desktop_restore(XfwShowDesktop *show_desktop);
+
+gboolean _xfw_show_desktop_window_state_changed(XfwShowDesktop *show_desktop,
+                                                gpointer window,
+                                                gboolean is_minimized,
+                                                gpointer *reactivate);
+gboolean _xfw_show_desktop_window_closed(XfwShowDesktop *show_desktop, gpointer window);
+
+G_END_DECLS
+
+#endif /* __XFW_SHOW_DESKTOP_H__ */
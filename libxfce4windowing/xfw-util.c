@@ -39,6 +39,7 @@
 #endif
 
 #include "libxfce4windowing-private.h"
+#include "xfw-icon-cache.h"
 #include "xfw-util.h"
 #include "libxfce4windowing-visibility.h"
 
@@ -109,6 +110,48 @@ xfw_set_client_type(XfwClientType client_type) {
 #endif
 }
 
+/**
+ * xfw_set_icon_cache_size:
+ * @n_entries: the number of icon sizes to keep
+ *
+ * Sets how many rendered icons each #XfwWindow and #XfwApplication keeps
+ * around.  Icons are cached per requested size and scale, so an application
+ * that shows window icons at several different sizes (say, in a tasklist, a
+ * menu, and a window switcher) may want to raise this to avoid rendering the
+ * same icons over and over.  The least-recently-requested icons are dropped
+ * first.  The default is 4, and values less than 1 are treated as 1.
+ *
+ * Icons returned from #xfw_window_get_icon(), #xfw_window_get_icon_surface(),
+ * and their #XfwApplication counterparts remain valid until they are dropped
+ * from the cache, or until the icon changes.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_set_icon_cache_size(guint n_entries) {
+    _xfw_icon_cache_set_max_entries(n_entries);
+}
+
+/**
+ * xfw_get_icon_cache_stats:
+ * @hits: (out) (optional): return location for the number of cache hits
+ * @misses: (out) (optional): return location for the number of cache misses
+ *
+ * Retrieves the number of times, since the program started, a request for a
+ * window or application icon was served from the icon cache, and the number
+ * of times the icon had to be rendered.  This can be used to choose a value
+ * for #xfw_set_icon_cache_size().
+ *
+ * The counters are updated without locking, so this must be called from the
+ * main thread, like the functions that return icons.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_get_icon_cache_stats(guint64 *hits, guint64 *misses) {
+    _xfw_icon_cache_get_stats(hits, misses);
+}
+
 GQuark
 xfw_error_quark(void) {
     static GQuark quark = 0;
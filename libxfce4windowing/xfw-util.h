@@ -108,6 +108,9 @@ XfwWindowing xfw_windowing_get(void);
 
 void xfw_set_client_type(XfwClientType client_type);
 
+void xfw_set_icon_cache_size(guint n_entries);
+void xfw_get_icon_cache_stats(guint64 *hits, guint64 *misses);
+
 /**
  * xfw_windowing_error_trap_push:
  * @display: a #GdkDisplay.
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+/**
+ * SECTION:xfw-window-batch
+ * @title: XfwWindowBatch
+ * @short_description: Perform actions on many windows at once
+ * @stability: Unstable
+ * @include: libxfce4windowing/libxfce4windowing.h
+ *
+ * #XfwWindowBatch collects actions on any number of windows, such as
+ * minimizing every window on a monitor or closing every window in a
+ * tasklist group, and sends them to the display server together when
+ * #xfw_window_batch_submit() is called.
+ *
+ * Calling #xfw_window_set_minimized() and friends in a loop sends each
+ * request on its own, and on X11 can wait for the X server after each one.
+ * A batch sends all of its requests and then flushes the connection to the
+ * display server once.
+ *
+ * Actions are carried out in the order they were added.  An action that
+ * fails doesn't stop the others; once the batch has been submitted, the
+ * windows whose actions failed can be found with
+ * #xfw_window_batch_get_failed_windows(), and the reason with
+ * #xfw_window_batch_get_error().
+ *
+ * Since: 4.21.0
+ **/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gtk/gtk.h>
+
+#include "xfw-screen-private.h"
+#include "xfw-util.h"
+#include "xfw-window-batch.h"
+#include "xfw-window-private.h"
+#include "libxfce4windowing-visibility.h"
+
+struct _XfwWindowBatch {
+    gatomicrefcount ref_count;
+    GArray *actions;  // XfwWindowAction
+    guint n_failed;
+    // XfwWindow -> the error from its first failed action; created on the
+    // first failure
+    GHashTable *errors;
+    gboolean submitted;
+};
+
+G_DEFINE_BOXED_TYPE(XfwWindowBatch, xfw_window_batch, xfw_window_batch_ref, xfw_window_batch_unref)
+
+static void
+clear_action(XfwWindowAction *action) {
+    g_object_unref(action->window);
+    g_clear_object(&action->workspace);
+    g_clear_error(&action->error);
+}
+
+static XfwWindowAction *
+add_action(XfwWindowBatch *batch, XfwWindowActionType type, XfwWindow *window) {
+    XfwWindowAction action = {
+        .type = type,
+        .window = g_object_ref(window),
+    };
+    g_array_append_val(batch->actions, action);
+    return &g_array_index(batch->actions, XfwWindowAction, batch->actions->len - 1);
+}
+
+static gboolean
+check_capabilities(const XfwWindowAction *action, GError **error) {
+    XfwWindowCapabilities required;
+    const gchar *message;
+
+    switch (action->type) {
+        case WINDOW_ACTION_SET_MINIMIZED:
+            required = action->enable ? XFW_WINDOW_CAPABILITIES_CAN_MINIMIZE : XFW_WINDOW_CAPABILITIES_CAN_UNMINIMIZE;
+            message = action->enable
+                          ? "This window does not currently support being minimized"
+                          : "This window does not currently support being unminimized";
+            break;
+
+        case WINDOW_ACTION_SET_MAXIMIZED:
+            required = action->enable ? XFW_WINDOW_CAPABILITIES_CAN_MAXIMIZE : XFW_WINDOW_CAPABILITIES_CAN_UNMAXIMIZE;
+            message = action->enable
+                          ? "This window does not currently support being maximized"
+                          : "This window does not currently support being unmaximized";
+            break;
+
+        default:
+            // Left to the backend
+            return TRUE;
+    }
+
+    if ((xfw_window_get_capabilities(action->window) & required) == 0) {
+        g_set_error_literal(error, XFW_ERROR, XFW_ERROR_UNSUPPORTED, message);
+        return FALSE;
+    } else {
+        return TRUE;
+    }
+}
+
+// The unbatched equivalent of @action, for backends whose actions don't
+// block anyway
+static gboolean
+run_action(const XfwWindowAction *action, GError **error) {
+    switch (action->type) {
+        case WINDOW_ACTION_CLOSE:
+            return xfw_window_close(action->window, action->event_timestamp, error);
+        case WINDOW_ACTION_MOVE_TO_WORKSPACE:
+            return xfw_window_move_to_workspace(action->window, action->workspace, error);
+        case WINDOW_ACTION_SET_MINIMIZED:
+            return xfw_window_set_minimized(action->window, action->enable, error);
+        case WINDOW_ACTION_SET_MAXIMIZED:
+            return xfw_window_set_maximized(action->window, action->enable, error);
+        case WINDOW_ACTION_SET_PINNED:
+            return xfw_window_set_pinned(action->window, action->enable, error);
+    }
+
+    g_return_val_if_reached(FALSE);
+}
+
+/**
+ * xfw_window_batch_new:
+ *
+ * Creates a new, empty batch of window actions.
+ *
+ * Return value: (transfer full): a new #XfwWindowBatch.  Release it with
+ * #xfw_window_batch_unref().
+ *
+ * Since: 4.21.0
+ **/
+XfwWindowBatch *
+xfw_window_batch_new(void) {
+    XfwWindowBatch *batch = g_new0(XfwWindowBatch, 1);
+    g_atomic_ref_count_init(&batch->ref_count);
+    batch->actions = g_array_new(FALSE, FALSE, sizeof(XfwWindowAction));
+    g_array_set_clear_func(batch->actions, (GDestroyNotify)clear_action);
+    return batch;
+}
+
+/**
+ * xfw_window_batch_ref:
+ * @batch: an #XfwWindowBatch.
+ *
+ * Increases the reference count of @batch by one.
+ *
+ * Return value: (transfer full): @batch.
+ *
+ * Since: 4.21.0
+ **/
+XfwWindowBatch *
+xfw_window_batch_ref(XfwWindowBatch *batch) {
+    g_return_val_if_fail(batch != NULL, NULL);
+    g_atomic_ref_count_inc(&batch->ref_count);
+    return batch;
+}
+
+/**
+ * xfw_window_batch_unref:
+ * @batch: (transfer full): an #XfwWindowBatch.
+ *
+ * Decreases the reference count of @batch by one, freeing it when the count
+ * drops to zero.  Actions that haven't been submitted are discarded.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_unref(XfwWindowBatch *batch) {
+    g_return_if_fail(batch != NULL);
+
+    if (g_atomic_ref_count_dec(&batch->ref_count)) {
+        g_clear_pointer(&batch->errors, g_hash_table_destroy);
+        g_array_free(batch->actions, TRUE);
+        g_free(batch);
+    }
+}
+
+/**
+ * xfw_window_batch_close:
+ * @batch: an #XfwWindowBatch.
+ * @window: an #XfwWindow.
+ * @event_timestamp: the timestamp from the user event that caused this
+ *                   action, or 0.
+ *
+ * Adds a request to close @window to @batch.  See #xfw_window_close().
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_close(XfwWindowBatch *batch, XfwWindow *window, guint64 event_timestamp) {
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(!batch->submitted);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    add_action(batch, WINDOW_ACTION_CLOSE, window)->event_timestamp = event_timestamp;
+}
+
+/**
+ * xfw_window_batch_move_to_workspace:
+ * @batch: an #XfwWindowBatch.
+ * @window: an #XfwWindow.
+ * @workspace: an #XfwWorkspace.
+ *
+ * Adds a request to move @window to @workspace to @batch.  See
+ * #xfw_window_move_to_workspace().
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_move_to_workspace(XfwWindowBatch *batch, XfwWindow *window, XfwWorkspace *workspace) {
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(!batch->submitted);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    g_return_if_fail(XFW_IS_WORKSPACE(workspace));
+    add_action(batch, WINDOW_ACTION_MOVE_TO_WORKSPACE, window)->workspace = g_object_ref(workspace);
+}
+
+/**
+ * xfw_window_batch_set_minimized:
+ * @batch: an #XfwWindowBatch.
+ * @window: an #XfwWindow.
+ * @is_minimized: whether or not @window should be minimized.
+ *
+ * Adds a request to minimize or unminimize @window to @batch.  See
+ * #xfw_window_set_minimized().
+ *
+ * Unminimizing activates @window, so the timestamp of the event GTK is
+ * currently handling, if any, is recorded to go with the request.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_set_minimized(XfwWindowBatch *batch, XfwWindow *window, gboolean is_minimized) {
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(!batch->submitted);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    XfwWindowAction *action = add_action(batch, WINDOW_ACTION_SET_MINIMIZED, window);
+    action->enable = !!is_minimized;
+    if (!is_minimized) {
+        // Window managers use this to decide whether to let the window take
+        // focus; 0 (GDK_CURRENT_TIME) if we're not in an event handler
+        action->event_timestamp = gtk_get_current_event_time();
+    }
+}
+
+/**
+ * xfw_window_batch_set_maximized:
+ * @batch: an #XfwWindowBatch.
+ * @window: an #XfwWindow.
+ * @is_maximized: whether or not @window should be maximized.
+ *
+ * Adds a request to maximize or unmaximize @window to @batch.  See
+ * #xfw_window_set_maximized().
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_set_maximized(XfwWindowBatch *batch, XfwWindow *window, gboolean is_maximized) {
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(!batch->submitted);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    add_action(batch, WINDOW_ACTION_SET_MAXIMIZED, window)->enable = !!is_maximized;
+}
+
+/**
+ * xfw_window_batch_set_pinned:
+ * @batch: an #XfwWindowBatch.
+ * @window: an #XfwWindow.
+ * @is_pinned: whether or not @window should be pinned.
+ *
+ * Adds a request to pin or unpin @window to @batch.  See
+ * #xfw_window_set_pinned().
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_batch_set_pinned(XfwWindowBatch *batch, XfwWindow *window, gboolean is_pinned) {
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(!batch->submitted);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    add_action(batch, WINDOW_ACTION_SET_PINNED, window)->enable = !!is_pinned;
+}
+
+/**
+ * xfw_window_batch_submit:
+ * @batch: an #XfwWindowBatch.
+ * @error: (out) (nullable): a location to store a possible error.
+ *
+ * Sends all of the actions in @batch to the display server, and then
+ * flushes the connection once.  A batch can only be submitted once.
+ *
+ * If any of the actions fail, @error is set to a summary, and the
+ * individual errors can be retrieved with #xfw_window_batch_get_error().
+ * As with the unbatched functions, success only means that the request was
+ * sent; the display server may still decide not to carry it out.
+ *
+ * Return value: %TRUE if every action was sent, %FALSE otherwise.
+ *
+ * Since: 4.21.0
+ **/
+gboolean
+xfw_window_batch_submit(XfwWindowBatch *batch, GError **error) {
+    g_return_val_if_fail(batch != NULL, FALSE);
+    g_return_val_if_fail(!batch->submitted, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    batch->submitted = TRUE;
+
+    // Almost always just the one
+    GPtrArray *screens = g_ptr_array_new();
+    const GError *first_error = NULL;
+
+    for (guint i = 0; i < batch->actions->len; ++i) {
+        XfwWindowAction *action = &g_array_index(batch->actions, XfwWindowAction, i);
+        XfwWindowClass *klass = XFW_WINDOW_GET_CLASS(action->window);
+
+        if (check_capabilities(action, &action->error)) {
+            if (klass->queue_action != NULL) {
+                klass->queue_action(action->window, action, &action->error);
+            } else {
+                run_action(action, &action->error);
+            }
+        }
+
+        if (action->error != NULL) {
+            ++batch->n_failed;
+            if (first_error == NULL) {
+                first_error = action->error;
+                batch->errors = g_hash_table_new(g_direct_hash, g_direct_equal);
+            }
+            if (!g_hash_table_contains(batch->errors, action->window)) {
+                g_hash_table_insert(batch->errors, action->window, action->error);
+            }
+        }
+
+        XfwScreen *screen = _xfw_window_get_screen(action->window);
+        if (!g_ptr_array_find(screens, screen, NULL)) {
+            g_ptr_array_add(screens, screen);
+        }
+    }
+
+    for (guint i = 0; i < screens->len; ++i) {
+        XfwScreenClass *klass = XFW_SCREEN_GET_CLASS(g_ptr_array_index(screens, i));
+        if (klass->flush != NULL) {
+            klass->flush(g_ptr_array_index(screens, i));
+        }
+    }
+    g_ptr_array_free(screens, TRUE);
+
+    if (first_error != NULL) {
+        if (batch->n_failed == 1) {
+            g_propagate_error(error, g_error_copy(first_error));
+        } else {
+            g_set_error(error,
+                        first_error->domain,
+                        first_error->code,
+                        "%u of %u window actions failed; the first error was: %s",
+                        batch->n_failed,
+                        batch->actions->len,
+                        first_error->message);
+        }
+        return FALSE;
+    } else {
+        return TRUE;
+    }
+}
+
+/**
+ * xfw_window_batch_get_failed_windows:
+ * @batch: an #XfwWindowBatch that has been submitted.
+ *
+ * Lists the windows for which at least one action in @batch failed, in the
+ * order the actions were added.
+ *
+ * Return value: (nullable) (element-type XfwWindow) (transfer container):
+ * the list of windows, or %NULL if every action succeeded.  The list should
+ * be freed with #g_list_free(); the windows are owned by @batch.
+ *
+ * Since: 4.21.0
+ **/
+GList *
+xfw_window_batch_get_failed_windows(XfwWindowBatch *batch) {
+    g_return_val_if_fail(batch != NULL, NULL);
+    g_return_val_if_fail(batch->submitted, NULL);
+
+    GList *windows = NULL;
+    for (guint i = 0; i < batch->actions->len && batch->n_failed > 0; ++i) {
+        XfwWindowAction *action = &g_array_index(batch->actions, XfwWindowAction, i);
+        // Each window is listed at its first failed action only
+        if (action->error != NULL && g_hash_table_lookup(batch->errors, action->window) == action->error) {
+            windows = g_list_prepend(windows, action->window);
+        }
+    }
+    return g_list_reverse(windows);
+}
+
+/**
+ * xfw_window_batch_get_error:
+ * @batch: an #XfwWindowBatch that has been submitted.
+ * @window: an #XfwWindow.
+ *
+ * Retrieves the reason the first failed action on @window in @batch
+ * failed.
+ *
+ * Return value: (nullable) (transfer none): a #GError owned by @batch, or
+ * %NULL if every action on @window succeeded.
+ *
+ * Since: 4.21.0
+ **/
+const GError *
+xfw_window_batch_get_error(XfwWindowBatch *batch, XfwWindow *window) {
+    g_return_val_if_fail(batch != NULL, NULL);
+    g_return_val_if_fail(batch->submitted, NULL);
+    g_return_val_if_fail(XFW_IS_WINDOW(window), NULL);
+
+    return batch->errors != NULL ? g_hash_table_lookup(batch->errors, window) : NULL;
+}
+
+#define __XFW_WINDOW_BATCH_C__
+#include "libxfce4windowing-visibility.c"
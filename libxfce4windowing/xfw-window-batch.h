@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+#ifndef __XFW_WINDOW_BATCH_H__
+#define __XFW_WINDOW_BATCH_H__
+
+#if !defined(__LIBXFCE4WINDOWING_H_INSIDE__) && !defined(LIBXFCE4WINDOWING_COMPILATION)
+#error "Only libxfce4windowing.h can be included directly"
+#endif
+
+#include <libxfce4windowing/xfw-window.h>
+#include <libxfce4windowing/xfw-workspace.h>
+
+G_BEGIN_DECLS
+
+#define XFW_TYPE_WINDOW_BATCH (xfw_window_batch_get_type())
+
+typedef struct _XfwWindowBatch XfwWindowBatch;
+
+GType xfw_window_batch_get_type(void);
+
+XfwWindowBatch *xfw_window_batch_new(void);
+XfwWindowBatch *xfw_window_batch_ref(XfwWindowBatch *batch);
+void xfw_window_batch_unref(XfwWindowBatch *batch);
+
+void xfw_window_batch_close(XfwWindowBatch *batch, XfwWindow *window, guint64 event_timestamp);
+void xfw_window_batch_move_to_workspace(XfwWindowBatch *batch, XfwWindow *window, XfwWorkspace *workspace);
+void xfw_window_batch_set_minimized(XfwWindowBatch *batch, XfwWindow *window, gboolean is_minimized);
+void xfw_window_batch_set_maximized(XfwWindowBatch *batch, XfwWindow *window, gboolean is_maximized);
+void xfw_window_batch_set_pinned(XfwWindowBatch *batch, XfwWindow *window, gboolean is_pinned);
+
+gboolean xfw_window_batch_submit(XfwWindowBatch *batch, GError **error);
+GList *xfw_window_batch_get_failed_windows(XfwWindowBatch *batch);
+const GError *xfw_window_batch_get_error(XfwWindowBatch *batch, XfwWindow *window);
+
+G_END_DECLS
+
+#endif /* !__XFW_WINDOW_BATCH_H__ */
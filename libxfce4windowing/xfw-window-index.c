@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+
+// Keeps track of which windows are on each workspace and each monitor, so
+// that listing the windows on one of them doesn't require a scan of every
+// window on the screen.  The screen adds windows as they open; from then on
+// each window's entry follows its "workspace-changed" signal and "monitors"
+// property, moving the window between the per-workspace and per-monitor
+// lists and emitting "window-added"/"window-removed" on the workspaces and
+// monitors involved.
+//
+// The lists themselves are attached to the workspace and monitor objects as
+// qdata, so they go away along with their owner.  Entries hold a reference
+// on the workspace and monitors they are filed under, which keeps the lists
+// alive until the window moves somewhere else.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-monitor-private.h"
+#include "xfw-window-index.h"
+#include "xfw-workspace-private.h"
+
+typedef struct {
+    XfwWindowIndex *index;
+    XfwWindow *window;
+    XfwWorkspace *workspace;
+    GList *monitors;
+} IndexedWindow;
+
+struct _XfwWindowIndex {
+    // XfwWindow -> IndexedWindow
+    GHashTable *windows;
+};
+
+G_DEFINE_QUARK(xfw-window-index-windows, window_index_windows)
+
+static GQueue *
+owner_windows(gpointer owner, gboolean create) {
+    GQueue *windows = g_object_get_qdata(G_OBJECT(owner), window_index_windows_quark());
+    if (windows == NULL && create) {
+        windows = g_queue_new();
+        g_object_set_qdata_full(G_OBJECT(owner), window_index_windows_quark(), windows, (GDestroyNotify)g_queue_free);
+    }
+    return windows;
+}
+
+static void
+file_window(gpointer owner, XfwWindow *window, gboolean notify) {
+    g_queue_push_tail(owner_windows(owner, TRUE), window);
+    if (notify) {
+        guint signal_id = XFW_IS_MONITOR(owner)
+                              ? _xfw_monitor_signals[MONITOR_SIGNAL_WINDOW_ADDED]
+                              : _xfw_workspace_signals[WORKSPACE_SIGNAL_WINDOW_ADDED];
+        g_signal_emit(owner, signal_id, 0, window);
+    }
+}
+
+static void
+unfile_window(gpointer owner, XfwWindow *window, gboolean notify) {
+    GQueue *windows = owner_windows(owner, FALSE);
+    if (windows != NULL) {
+        g_queue_remove(windows, window);
+    }
+    if (notify) {
+        guint signal_id = XFW_IS_MONITOR(owner)
+                              ? _xfw_monitor_signals[MONITOR_SIGNAL_WINDOW_REMOVED]
+                              : _xfw_workspace_signals[WORKSPACE_SIGNAL_WINDOW_REMOVED];
+        g_signal_emit(owner, signal_id, 0, window);
+    }
+}
+
+static void
+update_workspace(IndexedWindow *entry, gboolean notify) {
+    XfwWorkspace *workspace = xfw_window_get_workspace(entry->window);
+    if (workspace != entry->workspace) {
+        XfwWorkspace *old_workspace = entry->workspace;
+        entry->workspace = workspace != NULL ? g_object_ref(workspace) : NULL;
+
+        if (old_workspace != NULL) {
+            unfile_window(old_workspace, entry->window, notify);
+            g_object_unref(old_workspace);
+        }
+        if (workspace != NULL) {
+            file_window(workspace, entry->window, notify);
+        }
+    }
+}
+
+static void
+update_monitors(IndexedWindow *entry, gboolean notify) {
+    GList *monitors = xfw_window_get_monitors(entry->window);
+    GList *old_monitors = entry->monitors;
+    entry->monitors = NULL;
+
+    // Windows are rarely on more than a couple of monitors, so the quadratic
+    // comparison here is cheaper than anything fancier.
+    for (GList *l = monitors; l != NULL; l = l->next) {
+        GList *old = g_list_find(old_monitors, l->data);
+        if (old != NULL) {
+            old_monitors = g_list_remove_link(old_monitors, old);
+            entry->monitors = g_list_concat(old, entry->monitors);
+        } else {
+            entry->monitors = g_list_prepend(entry->monitors, g_object_ref(l->data));
+            file_window(l->data, entry->window, notify);
+        }
+    }
+
+    for (GList *l = old_monitors; l != NULL; l = l->next) {
+        unfile_window(l->data, entry->window, notify);
+    }
+    g_list_free_full(old_monitors, g_object_unref);
+}
+
+static void
+unindex_window(IndexedWindow *entry, gboolean notify) {
+    g_signal_handlers_disconnect_by_data(entry->window, entry);
+    if (entry->workspace != NULL) {
+        unfile_window(entry->workspace, entry->window, notify);
+        g_object_unref(entry->workspace);
+    }
+    for (GList *l = entry->monitors; l != NULL; l = l->next) {
+        unfile_window(l->data, entry->window, notify);
+    }
+    g_list_free_full(entry->monitors, g_object_unref);
+    g_free(entry);
+}
+
+static void
+indexed_window_free(IndexedWindow *entry) {
+    unindex_window(entry, FALSE);
+}
+
+static void
+workspace_changed(XfwWindow *window, IndexedWindow *entry) {
+    update_workspace(entry, TRUE);
+}
+
+static void
+monitors_changed(XfwWindow *window, GParamSpec *pspec, IndexedWindow *entry) {
+    update_monitors(entry, TRUE);
+}
+
+static void
+window_closed(XfwWindow *window, IndexedWindow *entry) {
+    _xfw_window_index_remove(entry->index, window);
+}
+
+XfwWindowIndex *
+_xfw_window_index_new(void) {
+    XfwWindowIndex *index = g_new0(XfwWindowIndex, 1);
+    index->windows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)indexed_window_free);
+    return index;
+}
+
+void
+_xfw_window_index_free(XfwWindowIndex *index) {
+    g_hash_table_destroy(index->windows);
+    g_free(index);
+}
+
+void
+_xfw_window_index_add(XfwWindowIndex *index, XfwWindow *window) {
+    if (!g_hash_table_contains(index->windows, window)) {
+        IndexedWindow *entry = g_new0(IndexedWindow, 1);
+        entry->index = index;
+        entry->window = window;
+        g_hash_table_insert(index->windows, window, entry);
+
+        update_workspace(entry, TRUE);
+        update_monitors(entry, TRUE);
+
+        g_signal_connect(window, "workspace-changed", G_CALLBACK(workspace_changed), entry);
+        g_signal_connect(window, "notify::monitors", G_CALLBACK(monitors_changed), entry);
+        g_signal_connect(window, "closed", G_CALLBACK(window_closed), entry);
+    }
+}
+
+void
+_xfw_window_index_remove(XfwWindowIndex *index, XfwWindow *window) {
+    IndexedWindow *entry = g_hash_table_lookup(index->windows, window);
+    if (entry != NULL) {
+        g_hash_table_steal(index->windows, window);
+        unindex_window(entry, TRUE);
+    }
+}
+
+GList *
+_xfw_window_index_list_windows(gpointer owner) {
+    GQueue *windows = owner_windows(owner, FALSE);
+    return windows != NULL ? windows->head : NULL;
+}
@@ -0,0 +1,812 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+/**
+ * SECTION:xfw-window-list-view
+ * @title: XfwWindowListView
+ * @short_description: A filtered and sorted view of a list of windows
+ * @stability: Unstable
+ * @include: libxfce4windowing/libxfce4windowing.h
+ *
+ * #XfwWindowListView is a #GListModel that presents the windows in another
+ * #GListModel, usually the one returned by #xfw_screen_get_windows_model()
+ * or #xfw_screen_get_windows_stacked_model(), that are on a particular
+ * workspace or monitor, belong to a particular application, or aren't
+ * marked as skip-tasklist.  By default the windows keep the order they
+ * have in the underlying model; a sort function can be set with
+ * #xfw_window_list_view_set_sort_func().
+ *
+ * The view keeps itself up to date using #XfwScreen::changes-committed:
+ * when a window moves to another workspace, for example, it is added to or
+ * removed from the view with a single #GListModel::items-changed emission
+ * for that window, and nothing else is touched.  Windows that are opened
+ * or closed, or reordered in the underlying model, are handled the same
+ * way.
+ *
+ * Changing one of the filters, or the sort function, re-evaluates every
+ * window, and emits one #GListModel::items-changed covering the range of
+ * the view between the first and last window that changed.
+ *
+ * Since: 4.21.0
+ **/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-screen.h"
+#include "xfw-window-list-view.h"
+#include "libxfce4windowing-visibility.h"
+
+typedef struct {
+    XfwWindow *window;
+    // Where the entry is in entries, and in items if it passes the filters
+    GSequenceIter *entry_iter;
+    GSequenceIter *item_iter;
+} ViewEntry;
+
+struct _XfwWindowListView {
+    GObject parent;
+
+    GListModel *model;
+    XfwScreen *screen;
+    gulong changes_committed_id;
+
+    XfwWorkspace *workspace;
+    XfwMonitor *monitor;
+    XfwApplication *application;
+    gboolean hide_skip_tasklist;
+
+    GCompareDataFunc sort_func;
+    gpointer sort_data;
+    GDestroyNotify sort_data_destroy;
+
+    // One ViewEntry for each window in the model, in the same order.  Both
+    // sequences are balanced trees, so finding an entry's position (or the
+    // entry at a position) doesn't mean walking the list.
+    GSequence *entries;
+    // XfwWindow -> its ViewEntry
+    GHashTable *entry_map;
+    // The entries that pass the filters, in the order the view presents them
+    GSequence *items;
+};
+
+enum {
+    PROP_0,
+    PROP_MODEL,
+    PROP_WORKSPACE,
+    PROP_MONITOR,
+    PROP_APPLICATION,
+    PROP_HIDE_SKIP_TASKLIST,
+    N_PROPERTIES,
+};
+
+static void xfw_window_list_view_list_model_init(GListModelInterface *iface);
+static void xfw_window_list_view_set_property(GObject *object,
+                                              guint property_id,
+                                              const GValue *value,
+                                              GParamSpec *pspec);
+static void xfw_window_list_view_get_property(GObject *object,
+                                              guint property_id,
+                                              GValue *value,
+                                              GParamSpec *pspec);
+static void xfw_window_list_view_dispose(GObject *object);
+static void xfw_window_list_view_finalize(GObject *object);
+
+static GType xfw_window_list_view_get_item_type(GListModel *list);
+static guint xfw_window_list_view_get_n_items(GListModel *list);
+static gpointer xfw_window_list_view_get_item(GListModel *list, guint position);
+
+static void model_items_changed(GListModel *model, guint position, guint removed, guint added, XfwWindowListView *view);
+static void changes_committed(XfwScreen *screen, GPtrArray *changes, XfwWindowListView *view);
+
+
+G_DEFINE_FINAL_TYPE_WITH_CODE(XfwWindowListView, xfw_window_list_view, G_TYPE_OBJECT,
+                              G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, xfw_window_list_view_list_model_init))
+
+static GParamSpec *window_list_view_properties[N_PROPERTIES] = { NULL };
+
+
+static void
+xfw_window_list_view_class_init(XfwWindowListViewClass *klass) {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+    gobject_class->set_property = xfw_window_list_view_set_property;
+    gobject_class->get_property = xfw_window_list_view_get_property;
+    gobject_class->dispose = xfw_window_list_view_dispose;
+    gobject_class->finalize = xfw_window_list_view_finalize;
+
+    /**
+     * XfwWindowListView:model:
+     *
+     * The #GListModel of #XfwWindow that this view presents.
+     *
+     * Since: 4.21.0
+     **/
+    window_list_view_properties[PROP_MODEL] = g_param_spec_object("model",
+                                                                  "model",
+                                                                  "model",
+                                                                  G_TYPE_LIST_MODEL,
+                                                                  G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwWindowListView:workspace:
+     *
+     * If set, only windows that are on this workspace (including pinned
+     * windows) are included in the view.
+     *
+     * Since: 4.21.0
+     **/
+    window_list_view_properties[PROP_WORKSPACE] = g_param_spec_object("workspace",
+                                                                      "workspace",
+                                                                      "workspace",
+                                                                      XFW_TYPE_WORKSPACE,
+                                                                      G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwWindowListView:monitor:
+     *
+     * If set, only windows that are at least partially on this monitor are
+     * included in the view.
+     *
+     * Since: 4.21.0
+     **/
+    window_list_view_properties[PROP_MONITOR] = g_param_spec_object("monitor",
+                                                                    "monitor",
+                                                                    "monitor",
+                                                                    XFW_TYPE_MONITOR,
+                                                                    G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwWindowListView:application:
+     *
+     * If set, only windows that belong to this application are included in
+     * the view.
+     *
+     * Since: 4.21.0
+     **/
+    window_list_view_properties[PROP_APPLICATION] = g_param_spec_object("application",
+                                                                        "application",
+                                                                        "application",
+                                                                        XFW_TYPE_APPLICATION,
+                                                                        G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    /**
+     * XfwWindowListView:hide-skip-tasklist:
+     *
+     * Whether or not windows with %XFW_WINDOW_STATE_SKIP_TASKLIST set are
+     * left out of the view.
+     *
+     * Since: 4.21.0
+     **/
+    window_list_view_properties[PROP_HIDE_SKIP_TASKLIST] = g_param_spec_boolean("hide-skip-tasklist",
+                                                                                "hide-skip-tasklist",
+                                                                                "hide-skip-tasklist",
+                                                                                FALSE,
+                                                                                G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_PROPERTIES, window_list_view_properties);
+}
+
+static void
+xfw_window_list_view_list_model_init(GListModelInterface *iface) {
+    iface->get_item_type = xfw_window_list_view_get_item_type;
+    iface->get_n_items = xfw_window_list_view_get_n_items;
+    iface->get_item = xfw_window_list_view_get_item;
+}
+
+static void
+free_entry(gpointer data) {
+    ViewEntry *entry = data;
+    g_object_unref(entry->window);
+    g_free(entry);
+}
+
+static void
+xfw_window_list_view_init(XfwWindowListView *view) {
+    view->entries = g_sequence_new(free_entry);
+    view->entry_map = g_hash_table_new(g_direct_hash, g_direct_equal);
+    view->items = g_sequence_new(NULL);
+}
+
+static void
+clear_sequence(GSequence *sequence) {
+    g_sequence_remove_range(g_sequence_get_begin_iter(sequence), g_sequence_get_end_iter(sequence));
+}
+
+static void
+set_model(XfwWindowListView *view, GListModel *model) {
+    if (model != NULL) {
+        view->model = g_object_ref(model);
+        g_signal_connect(model, "items-changed", G_CALLBACK(model_items_changed), view);
+        model_items_changed(model, 0, 0, g_list_model_get_n_items(model), view);
+    }
+}
+
+static void
+xfw_window_list_view_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(object);
+
+    switch (property_id) {
+        case PROP_MODEL:
+            set_model(view, g_value_get_object(value));
+            break;
+
+        case PROP_WORKSPACE:
+            xfw_window_list_view_set_workspace(view, g_value_get_object(value));
+            break;
+
+        case PROP_MONITOR:
+            xfw_window_list_view_set_monitor(view, g_value_get_object(value));
+            break;
+
+        case PROP_APPLICATION:
+            xfw_window_list_view_set_application(view, g_value_get_object(value));
+            break;
+
+        case PROP_HIDE_SKIP_TASKLIST:
+            xfw_window_list_view_set_hide_skip_tasklist(view, g_value_get_boolean(value));
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void
+xfw_window_list_view_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(object);
+
+    switch (property_id) {
+        case PROP_MODEL:
+            g_value_set_object(value, view->model);
+            break;
+
+        case PROP_WORKSPACE:
+            g_value_set_object(value, view->workspace);
+            break;
+
+        case PROP_MONITOR:
+            g_value_set_object(value, view->monitor);
+            break;
+
+        case PROP_APPLICATION:
+            g_value_set_object(value, view->application);
+            break;
+
+        case PROP_HIDE_SKIP_TASKLIST:
+            g_value_set_boolean(value, view->hide_skip_tasklist);
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void
+xfw_window_list_view_dispose(GObject *object) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(object);
+
+    if (view->model != NULL) {
+        g_signal_handlers_disconnect_by_func(view->model, model_items_changed, view);
+        g_clear_object(&view->model);
+    }
+    if (view->screen != NULL) {
+        g_clear_signal_handler(&view->changes_committed_id, view->screen);
+        g_clear_object(&view->screen);
+    }
+
+    g_clear_object(&view->workspace);
+    g_clear_object(&view->monitor);
+    g_clear_object(&view->application);
+
+    clear_sequence(view->items);
+    g_hash_table_remove_all(view->entry_map);
+    clear_sequence(view->entries);
+
+    G_OBJECT_CLASS(xfw_window_list_view_parent_class)->dispose(object);
+}
+
+static void
+xfw_window_list_view_finalize(GObject *object) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(object);
+
+    if (view->sort_data_destroy != NULL) {
+        view->sort_data_destroy(view->sort_data);
+    }
+    g_sequence_free(view->items);
+    g_hash_table_destroy(view->entry_map);
+    g_sequence_free(view->entries);
+
+    G_OBJECT_CLASS(xfw_window_list_view_parent_class)->finalize(object);
+}
+
+static GType
+xfw_window_list_view_get_item_type(GListModel *list) {
+    return XFW_TYPE_WINDOW;
+}
+
+static guint
+xfw_window_list_view_get_n_items(GListModel *list) {
+    return g_sequence_get_length(XFW_WINDOW_LIST_VIEW(list)->items);
+}
+
+static gpointer
+xfw_window_list_view_get_item(GListModel *list, guint position) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(list);
+    GSequenceIter *iter = g_sequence_get_iter_at_pos(view->items, position);
+    return !g_sequence_iter_is_end(iter) ? g_object_ref(((ViewEntry *)g_sequence_get(iter))->window) : NULL;
+}
+
+static gboolean
+has_filters(XfwWindowListView *view) {
+    return view->workspace != NULL
+           || view->monitor != NULL
+           || view->application != NULL
+           || view->hide_skip_tasklist;
+}
+
+static gboolean
+window_matches(XfwWindowListView *view, XfwWindow *window) {
+    if (view->hide_skip_tasklist && xfw_window_is_skip_tasklist(window)) {
+        return FALSE;
+    } else if (view->workspace != NULL && !xfw_window_is_on_workspace(window, view->workspace)) {
+        return FALSE;
+    } else if (view->monitor != NULL && g_list_find(xfw_window_get_monitors(window), view->monitor) == NULL) {
+        return FALSE;
+    } else if (view->application != NULL && xfw_window_get_application(window) != view->application) {
+        return FALSE;
+    } else {
+        return TRUE;
+    }
+}
+
+// The screen only keeps track of window changes while someone is listening,
+// so only listen while there's a filter or sort order that depends on them.
+static void
+update_changes_committed_handler(XfwWindowListView *view) {
+    gboolean needed = view->screen != NULL && (has_filters(view) || view->sort_func != NULL);
+
+    if (needed && view->changes_committed_id == 0) {
+        view->changes_committed_id = g_signal_connect(view->screen, "changes-committed", G_CALLBACK(changes_committed), view);
+    } else if (!needed && view->changes_committed_id != 0) {
+        g_clear_signal_handler(&view->changes_committed_id, view->screen);
+    }
+}
+
+static void
+watch_screen(XfwWindowListView *view, XfwWindow *window) {
+    if (view->screen == NULL) {
+        view->screen = g_object_ref(xfw_window_get_screen(window));
+        update_changes_committed_handler(view);
+    }
+}
+
+// Windows the sort function considers equal (or all windows, without a sort
+// function) are ordered as they are in the model, so the order doesn't
+// depend on the order windows were shown in
+static gint
+compare_entries(gconstpointer a, gconstpointer b, gpointer data) {
+    XfwWindowListView *view = XFW_WINDOW_LIST_VIEW(data);
+    const ViewEntry *entry_a = a;
+    const ViewEntry *entry_b = b;
+    gint result = view->sort_func != NULL ? view->sort_func(entry_a->window, entry_b->window, view->sort_data) : 0;
+    if (result == 0) {
+        result = g_sequence_iter_compare(entry_a->entry_iter, entry_b->entry_iter);
+    }
+    return result;
+}
+
+static void
+show_entry(XfwWindowListView *view, ViewEntry *entry) {
+    entry->item_iter = g_sequence_insert_sorted(view->items, entry, compare_entries, view);
+    g_list_model_items_changed(G_LIST_MODEL(view), g_sequence_iter_get_position(entry->item_iter), 0, 1);
+}
+
+static void
+hide_entry(XfwWindowListView *view, ViewEntry *entry) {
+    guint position = g_sequence_iter_get_position(entry->item_iter);
+    g_sequence_remove(entry->item_iter);
+    entry->item_iter = NULL;
+    g_list_model_items_changed(G_LIST_MODEL(view), position, 1, 0);
+}
+
+static void
+resort_entry(XfwWindowListView *view, ViewEntry *entry) {
+    GSequenceIter *prev = !g_sequence_iter_is_begin(entry->item_iter) ? g_sequence_iter_prev(entry->item_iter) : NULL;
+    GSequenceIter *next = g_sequence_iter_next(entry->item_iter);
+    gboolean in_order = (prev == NULL || compare_entries(g_sequence_get(prev), entry, view) < 0)
+                        && (g_sequence_iter_is_end(next) || compare_entries(entry, g_sequence_get(next), view) < 0);
+
+    if (!in_order) {
+        guint old_position = g_sequence_iter_get_position(entry->item_iter);
+        g_sequence_sort_changed(entry->item_iter, compare_entries, view);
+        guint new_position = g_sequence_iter_get_position(entry->item_iter);
+
+        // A single emission for the move, covering the windows in between,
+        // which have each shifted by one
+        guint first = MIN(old_position, new_position);
+        guint n = MAX(old_position, new_position) - first + 1;
+        g_list_model_items_changed(G_LIST_MODEL(view), first, n, n);
+    }
+}
+
+static void
+model_items_changed(GListModel *model, guint position, guint removed, guint added, XfwWindowListView *view) {
+    // Without a sort function, the windows keep the model's order, so the
+    // change maps to a single range of the view
+    gboolean single_range = view->sort_func == NULL;
+    gint view_position = -1;
+    guint view_removed = 0;
+    guint view_added = 0;
+
+    GSequenceIter *iter = g_sequence_get_iter_at_pos(view->entries, position);
+    for (guint i = 0; i < removed; ++i) {
+        ViewEntry *entry = g_sequence_get(iter);
+        GSequenceIter *next = g_sequence_iter_next(iter);
+
+        if (entry->item_iter != NULL) {
+            if (single_range) {
+                if (view_position < 0) {
+                    view_position = g_sequence_iter_get_position(entry->item_iter);
+                }
+                g_sequence_remove(entry->item_iter);
+                ++view_removed;
+            } else {
+                hide_entry(view, entry);
+            }
+        }
+
+        g_hash_table_remove(view->entry_map, entry->window);
+        g_sequence_remove(iter);
+        iter = next;
+    }
+
+    // All of the new entries go in before any of them is shown, as the
+    // order of the view depends on their positions
+    GSequenceIter *first_added = iter;
+    for (guint i = 0; i < added; ++i) {
+        ViewEntry *entry = g_new0(ViewEntry, 1);
+        entry->window = g_list_model_get_item(model, position + i);
+        entry->entry_iter = g_sequence_insert_before(iter, entry);
+        if (i == 0) {
+            first_added = entry->entry_iter;
+        }
+        g_hash_table_insert(view->entry_map, entry->window, entry);
+        watch_screen(view, entry->window);
+    }
+
+    iter = first_added;
+    for (guint i = 0; i < added; ++i, iter = g_sequence_iter_next(iter)) {
+        ViewEntry *entry = g_sequence_get(iter);
+
+        if (window_matches(view, entry->window)) {
+            if (single_range) {
+                entry->item_iter = g_sequence_insert_sorted(view->items, entry, compare_entries, view);
+                if (view_position < 0) {
+                    view_position = g_sequence_iter_get_position(entry->item_iter);
+                }
+                ++view_added;
+            } else {
+                show_entry(view, entry);
+            }
+        }
+    }
+
+    if (view_removed > 0 || view_added > 0) {
+        g_list_model_items_changed(G_LIST_MODEL(view), view_position, view_removed, view_added);
+    }
+}
+
+static void
+changes_committed(XfwScreen *screen, GPtrArray *changes, XfwWindowListView *view) {
+    for (guint i = 0; i < changes->len; ++i) {
+        XfwWindowChange *change = g_ptr_array_index(changes, i);
+
+        // Windows coming and going are picked up through the model
+        if ((change->changes & ~(XFW_WINDOW_CHANGE_OPENED | XFW_WINDOW_CHANGE_CLOSED)) == 0) {
+            continue;
+        }
+
+        ViewEntry *entry = g_hash_table_lookup(view->entry_map, change->window);
+        if (entry != NULL) {
+            gboolean visible = window_matches(view, entry->window);
+
+            if (visible != (entry->item_iter != NULL)) {
+                if (visible) {
+                    show_entry(view, entry);
+                } else {
+                    hide_entry(view, entry);
+                }
+            } else if (visible && view->sort_func != NULL) {
+                resort_entry(view, entry);
+            }
+        }
+    }
+}
+
+static GPtrArray *
+sequence_to_array(GSequence *sequence) {
+    GPtrArray *array = g_ptr_array_sized_new(g_sequence_get_length(sequence));
+    for (GSequenceIter *iter = g_sequence_get_begin_iter(sequence); !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        g_ptr_array_add(array, g_sequence_get(iter));
+    }
+    return array;
+}
+
+static void
+rebuild(XfwWindowListView *view) {
+    GPtrArray *old_items = sequence_to_array(view->items);
+
+    clear_sequence(view->items);
+    for (GSequenceIter *iter = g_sequence_get_begin_iter(view->entries); !g_sequence_iter_is_end(iter); iter = g_sequence_iter_next(iter)) {
+        ViewEntry *entry = g_sequence_get(iter);
+        entry->item_iter = window_matches(view, entry->window) ? g_sequence_append(view->items, entry) : NULL;
+    }
+    if (view->sort_func != NULL) {
+        // Moves the entries without invalidating their item_iter
+        g_sequence_sort(view->items, compare_entries, view);
+    }
+
+    GPtrArray *new_items = sequence_to_array(view->items);
+
+    guint prefix = 0;
+    while (prefix < old_items->len
+           && prefix < new_items->len
+           && g_ptr_array_index(old_items, prefix) == g_ptr_array_index(new_items, prefix))
+    {
+        ++prefix;
+    }
+    guint suffix = 0;
+    while (suffix < old_items->len - prefix
+           && suffix < new_items->len - prefix
+           && g_ptr_array_index(old_items, old_items->len - suffix - 1) == g_ptr_array_index(new_items, new_items->len - suffix - 1))
+    {
+        ++suffix;
+    }
+
+    if (prefix != old_items->len || prefix != new_items->len) {
+        g_list_model_items_changed(G_LIST_MODEL(view),
+                                   prefix,
+                                   old_items->len - prefix - suffix,
+                                   new_items->len - prefix - suffix);
+    }
+    g_ptr_array_free(new_items, TRUE);
+    g_ptr_array_free(old_items, TRUE);
+}
+
+static void
+filters_changed(XfwWindowListView *view, guint prop_id) {
+    update_changes_committed_handler(view);
+    rebuild(view);
+    g_object_notify_by_pspec(G_OBJECT(view), window_list_view_properties[prop_id]);
+}
+
+/**
+ * xfw_window_list_view_new:
+ * @windows: a #GListModel of #XfwWindow.
+ *
+ * Creates a view of the windows in @windows.  Initially, no filters are set
+ * and the view contains all of the windows, in the same order.
+ *
+ * Return value: (transfer full): a new #XfwWindowListView.
+ *
+ * Since: 4.21.0
+ **/
+XfwWindowListView *
+xfw_window_list_view_new(GListModel *windows) {
+    g_return_val_if_fail(G_IS_LIST_MODEL(windows), NULL);
+    g_return_val_if_fail(g_type_is_a(g_list_model_get_item_type(windows), XFW_TYPE_WINDOW), NULL);
+    return g_object_new(XFW_TYPE_WINDOW_LIST_VIEW,
+                        "model", windows,
+                        NULL);
+}
+
+/**
+ * xfw_window_list_view_get_model:
+ * @view: an #XfwWindowListView.
+ *
+ * Retrieves the model that @view presents.
+ *
+ * Return value: (transfer none): a #GListModel of #XfwWindow.
+ *
+ * Since: 4.21.0
+ **/
+GListModel *
+xfw_window_list_view_get_model(XfwWindowListView *view) {
+    g_return_val_if_fail(XFW_IS_WINDOW_LIST_VIEW(view), NULL);
+    return view->model;
+}
+
+/**
+ * xfw_window_list_view_get_workspace:
+ * @view: an #XfwWindowListView.
+ *
+ * Retrieves the workspace @view is filtered by.
+ *
+ * Return value: (nullable) (transfer none): an #XfwWorkspace, or %NULL.
+ *
+ * Since: 4.21.0
+ **/
+XfwWorkspace *
+xfw_window_list_view_get_workspace(XfwWindowListView *view) {
+    g_return_val_if_fail(XFW_IS_WINDOW_LIST_VIEW(view), NULL);
+    return view->workspace;
+}
+
+/**
+ * xfw_window_list_view_set_workspace:
+ * @view: an #XfwWindowListView.
+ * @workspace: (nullable): an #XfwWorkspace, or %NULL.
+ *
+ * Only includes the windows that are on @workspace in @view, or removes the
+ * filter if @workspace is %NULL.  See #XfwWindowListView:workspace.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_list_view_set_workspace(XfwWindowListView *view, XfwWorkspace *workspace) {
+    g_return_if_fail(XFW_IS_WINDOW_LIST_VIEW(view));
+    g_return_if_fail(workspace == NULL || XFW_IS_WORKSPACE(workspace));
+    if (g_set_object(&view->workspace, workspace)) {
+        filters_changed(view, PROP_WORKSPACE);
+    }
+}
+
+/**
+ * xfw_window_list_view_get_monitor:
+ * @view: an #XfwWindowListView.
+ *
+ * Retrieves the monitor @view is filtered by.
+ *
+ * Return value: (nullable) (transfer none): an #XfwMonitor, or %NULL.
+ *
+ * Since: 4.21.0
+ **/
+XfwMonitor *
+xfw_window_list_view_get_monitor(XfwWindowListView *view) {
+    g_return_val_if_fail(XFW_IS_WINDOW_LIST_VIEW(view), NULL);
+    return view->monitor;
+}
+
+/**
+ * xfw_window_list_view_set_monitor:
+ * @view: an #XfwWindowListView.
+ * @monitor: (nullable): an #XfwMonitor, or %NULL.
+ *
+ * Only includes the windows that are on @monitor in @view, or removes the
+ * filter if @monitor is %NULL.  See #XfwWindowListView:monitor.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_list_view_set_monitor(XfwWindowListView *view, XfwMonitor *monitor) {
+    g_return_if_fail(XFW_IS_WINDOW_LIST_VIEW(view));
+    g_return_if_fail(monitor == NULL || XFW_IS_MONITOR(monitor));
+    if (g_set_object(&view->monitor, monitor)) {
+        filters_changed(view, PROP_MONITOR);
+    }
+}
+
+/**
+ * xfw_window_list_view_get_application:
+ * @view: an #XfwWindowListView.
+ *
+ * Retrieves the application @view is filtered by.
+ *
+ * Return value: (nullable) (transfer none): an #XfwApplication, or %NULL.
+ *
+ * Since: 4.21.0
+ **/
+XfwApplication *
+xfw_window_list_view_get_application(XfwWindowListView *view) {
+    g_return_val_if_fail(XFW_IS_WINDOW_LIST_VIEW(view), NULL);
+    return view->application;
+}
+
+/**
+ * xfw_window_list_view_set_application:
+ * @view: an #XfwWindowListView.
+ * @application: (nullable): an #XfwApplication, or %NULL.
+ *
+ * Only includes the windows that belong to @application in @view, or
+ * removes the filter if @application is %NULL.  See
+ * #XfwWindowListView:application.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_list_view_set_application(XfwWindowListView *view, XfwApplication *application) {
+    g_return_if_fail(XFW_IS_WINDOW_LIST_VIEW(view));
+    g_return_if_fail(application == NULL || XFW_IS_APPLICATION(application));
+    if (g_set_object(&view->application, application)) {
+        filters_changed(view, PROP_APPLICATION);
+    }
+}
+
+/**
+ * xfw_window_list_view_get_hide_skip_tasklist:
+ * @view: an #XfwWindowListView.
+ *
+ * Return value: %TRUE if windows marked as skip-tasklist are left out of
+ * @view, %FALSE otherwise.
+ *
+ * Since: 4.21.0
+ **/
+gboolean
+xfw_window_list_view_get_hide_skip_tasklist(XfwWindowListView *view) {
+    g_return_val_if_fail(XFW_IS_WINDOW_LIST_VIEW(view), FALSE);
+    return view->hide_skip_tasklist;
+}
+
+/**
+ * xfw_window_list_view_set_hide_skip_tasklist:
+ * @view: an #XfwWindowListView.
+ * @hide_skip_tasklist: whether or not to leave out skip-tasklist windows.
+ *
+ * Sets whether or not windows with %XFW_WINDOW_STATE_SKIP_TASKLIST set are
+ * left out of @view.  See #XfwWindowListView:hide-skip-tasklist.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_list_view_set_hide_skip_tasklist(XfwWindowListView *view, gboolean hide_skip_tasklist) {
+    g_return_if_fail(XFW_IS_WINDOW_LIST_VIEW(view));
+    if (view->hide_skip_tasklist != !!hide_skip_tasklist) {
+        view->hide_skip_tasklist = !!hide_skip_tasklist;
+        filters_changed(view, PROP_HIDE_SKIP_TASKLIST);
+    }
+}
+
+/**
+ * xfw_window_list_view_set_sort_func:
+ * @view: an #XfwWindowListView.
+ * @sort_func: (nullable) (scope notified): a function comparing two
+ *             #XfwWindow, or %NULL to keep the order of the underlying model.
+ * @user_data: (closure): data to pass to @sort_func.
+ * @destroy: (nullable): a function to free @user_data, or %NULL.
+ *
+ * Sorts the windows in @view using @sort_func.  Windows that compare equal
+ * keep the order of the underlying model.
+ *
+ * Whenever a window in @view changes (see #XfwScreen::changes-committed),
+ * it is compared against its neighbors, and moved if it is no longer in
+ * order.  If the order depends on something else, set the sort function
+ * again to re-sort the whole view.
+ *
+ * Since: 4.21.0
+ **/
+void
+xfw_window_list_view_set_sort_func(XfwWindowListView *view, GCompareDataFunc sort_func, gpointer user_data, GDestroyNotify destroy) {
+    g_return_if_fail(XFW_IS_WINDOW_LIST_VIEW(view));
+
+    if (view->sort_data_destroy != NULL) {
+        view->sort_data_destroy(view->sort_data);
+    }
+    view->sort_func = sort_func;
+    view->sort_data = user_data;
+    view->sort_data_destroy = destroy;
+
+    update_changes_committed_handler(view);
+    rebuild(view);
+}
+
+#define __XFW_WINDOW_LIST_VIEW_C__
+#include "libxfce4windowing-visibility.c"
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_WINDOW_LIST_VIEW_H__
+#define __XFW_WINDOW_LIST_VIEW_H__
+
+#if !defined(__LIBXFCE4WINDOWING_H_INSIDE__) && !defined(LIBXFCE4WINDOWING_COMPILATION)
+#error "Only libxfce4windowing.h can be included directly"
+#endif
+
+#include <gio/gio.h>
+#include <libxfce4windowing/xfw-application.h>
+#include <libxfce4windowing/xfw-monitor.h>
+#include <libxfce4windowing/xfw-window.h>
+#include <libxfce4windowing/xfw-workspace.h>
+
+G_BEGIN_DECLS
+
+#define XFW_TYPE_WINDOW_LIST_VIEW (xfw_window_list_view_get_type())
+G_DECLARE_FINAL_TYPE(XfwWindowListView, xfw_window_list_view, XFW, WINDOW_LIST_VIEW, GObject)
+
+XfwWindowListView *xfw_window_list_view_new(GListModel *windows);
+
+GListModel *xfw_window_list_view_get_model(XfwWindowListView *view);
+
+XfwWorkspace *xfw_window_list_view_get_workspace(XfwWindowListView *view);
+void xfw_window_list_view_set_workspace(XfwWindowListView *view,
+                                        XfwWorkspace *workspace);
+
+XfwMonitor *xfw_window_list_view_get_monitor(XfwWindowListView *view);
+void xfw_window_list_view_set_monitor(XfwWindowListView *view,
+                                      XfwMonitor *monitor);
+
+XfwApplication *xfw_window_list_view_get_application(XfwWindowListView *view);
+void xfw_window_list_view_set_application(XfwWindowListView *view,
+                                          XfwApplication *application);
+
+gboolean xfw_window_list_view_get_hide_skip_tasklist(XfwWindowListView *view);
+void xfw_window_list_view_set_hide_skip_tasklist(XfwWindowListView *view,
+                                                 gboolean hide_skip_tasklist);
+
+void xfw_window_list_view_set_sort_func(XfwWindowListView *view,
+                                        GCompareDataFunc sort_func,
+                                        gpointer user_data,
+                                        GDestroyNotify destroy);
+
+G_END_DECLS
+
+#endif /* !__XFW_WINDOW_LIST_VIEW_H__ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// The list of windows behind xfw_screen_get_windows_model() and
+// xfw_screen_get_windows_stacked_model().  Unlike a GListStore, it can find
+// a window without searching for it: each window maps to its node in a
+// balanced tree, which also knows the node's position.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-window-model.h"
+
+struct _XfwWindowModel {
+    GObject parent;
+
+    GSequence *windows;
+    // XfwWindow -> GSequenceIter in windows
+    GHashTable *iters;
+};
+
+static void xfw_window_model_list_model_init(GListModelInterface *iface);
+static void xfw_window_model_finalize(GObject *object);
+
+static GType xfw_window_model_get_item_type(GListModel *list);
+static guint xfw_window_model_get_n_items(GListModel *list);
+static gpointer xfw_window_model_get_item(GListModel *list, guint position);
+
+
+G_DEFINE_FINAL_TYPE_WITH_CODE(XfwWindowModel, xfw_window_model, G_TYPE_OBJECT,
+                              G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, xfw_window_model_list_model_init))
+
+
+static void
+xfw_window_model_class_init(XfwWindowModelClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = xfw_window_model_finalize;
+}
+
+static void
+xfw_window_model_list_model_init(GListModelInterface *iface) {
+    iface->get_item_type = xfw_window_model_get_item_type;
+    iface->get_n_items = xfw_window_model_get_n_items;
+    iface->get_item = xfw_window_model_get_item;
+}
+
+static void
+xfw_window_model_init(XfwWindowModel *model) {
+    model->windows = g_sequence_new(g_object_unref);
+    model->iters = g_hash_table_new(g_direct_hash, g_direct_equal);
+}
+
+static void
+xfw_window_model_finalize(GObject *object) {
+    XfwWindowModel *model = XFW_WINDOW_MODEL(object);
+
+    g_hash_table_destroy(model->iters);
+    g_sequence_free(model->windows);
+
+    G_OBJECT_CLASS(xfw_window_model_parent_class)->finalize(object);
+}
+
+static GType
+xfw_window_model_get_item_type(GListModel *list) {
+    return XFW_TYPE_WINDOW;
+}
+
+static guint
+xfw_window_model_get_n_items(GListModel *list) {
+    return g_sequence_get_length(XFW_WINDOW_MODEL(list)->windows);
+}
+
+static gpointer
+xfw_window_model_get_item(GListModel *list, guint position) {
+    GSequenceIter *iter = g_sequence_get_iter_at_pos(XFW_WINDOW_MODEL(list)->windows, position);
+    return !g_sequence_iter_is_end(iter) ? g_object_ref(g_sequence_get(iter)) : NULL;
+}
+
+XfwWindowModel *
+_xfw_window_model_new(void) {
+    return g_object_new(XFW_TYPE_WINDOW_MODEL, NULL);
+}
+
+// Does nothing if @window is already in @model
+void
+_xfw_window_model_append(XfwWindowModel *model, XfwWindow *window) {
+    if (!g_hash_table_contains(model->iters, window)) {
+        GSequenceIter *iter = g_sequence_append(model->windows, g_object_ref(window));
+        g_hash_table_insert(model->iters, window, iter);
+        g_list_model_items_changed(G_LIST_MODEL(model), g_sequence_iter_get_position(iter), 0, 1);
+    }
+}
+
+void
+_xfw_window_model_remove(XfwWindowModel *model, XfwWindow *window) {
+    GSequenceIter *iter = g_hash_table_lookup(model->iters, window);
+    if (iter != NULL) {
+        guint position = g_sequence_iter_get_position(iter);
+        g_hash_table_remove(model->iters, window);
+        g_sequence_remove(iter);
+        g_list_model_items_changed(G_LIST_MODEL(model), position, 1, 0);
+    }
+}
+
+// Makes @model hold @windows, in order, with a single items-changed emission
+// covering only the run between the unchanged head and tail, like
+// _xfw_list_store_sync()
+void
+_xfw_window_model_sync(XfwWindowModel *model, GList *windows) {
+    guint n_old = g_sequence_get_length(model->windows);
+    guint n_new = g_list_length(windows);
+    guint prefix = 0;
+    guint suffix = 0;
+
+    GSequenceIter *head = g_sequence_get_begin_iter(model->windows);
+    GList *l = windows;
+    while (l != NULL && !g_sequence_iter_is_end(head) && g_sequence_get(head) == l->data) {
+        head = g_sequence_iter_next(head);
+        l = l->next;
+        ++prefix;
+    }
+
+    if (prefix == n_old && prefix == n_new) {
+        return;
+    }
+
+    GSequenceIter *tail = g_sequence_get_end_iter(model->windows);
+    GList *tail_link = g_list_last(windows);
+    while (suffix < n_old - prefix && suffix < n_new - prefix) {
+        GSequenceIter *prev = g_sequence_iter_prev(tail);
+        if (g_sequence_get(prev) != tail_link->data) {
+            break;
+        }
+        tail = prev;
+        tail_link = tail_link->prev;
+        ++suffix;
+    }
+
+    for (GSequenceIter *iter = head; iter != tail; iter = g_sequence_iter_next(iter)) {
+        g_hash_table_remove(model->iters, g_sequence_get(iter));
+    }
+    g_sequence_remove_range(head, tail);
+
+    guint n_added = n_new - prefix - suffix;
+    for (guint i = 0; i < n_added; ++i, l = l->next) {
+        GSequenceIter *iter = g_sequence_insert_before(tail, g_object_ref(l->data));
+        g_hash_table_insert(model->iters, l->data, iter);
+    }
+
+    g_list_model_items_changed(G_LIST_MODEL(model), prefix, n_old - prefix - suffix, n_added);
+}
+
+void
+_xfw_window_model_clear(XfwWindowModel *model) {
+    guint n_items = g_sequence_get_length(model->windows);
+    if (n_items > 0) {
+        g_hash_table_remove_all(model->iters);
+        g_sequence_remove_range(g_sequence_get_begin_iter(model->windows), g_sequence_get_end_iter(model->windows));
+        g_list_model_items_changed(G_LIST_MODEL(model), 0, n_items, 0);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_WINDOW_MODEL_H__
+#define __XFW_WINDOW_MODEL_H__
+
+#if !defined(__LIBXFCE4WINDOWING_H_INSIDE__) && !defined(LIBXFCE4WINDOWING_COMPILATION)
+#error "Only libxfce4windowing.h can be included directly"
+#endif
+
+#include <gio/gio.h>
+
+#include "xfw-window.h"
+
+G_BEGIN_DECLS
+
+#define XFW_TYPE_WINDOW_MODEL (xfw_window_model_get_type())
+G_DECLARE_FINAL_TYPE(XfwWindowModel, xfw_window_model, XFW, WINDOW_MODEL, GObject)
+
+XfwWindowModel *_xfw_window_model_new(void);
+
+void _xfw_window_model_append(XfwWindowModel *model, XfwWindow *window);
+void _xfw_window_model_remove(XfwWindowModel *model, XfwWindow *window);
+void _xfw_window_model_sync(XfwWindowModel *model, GList *windows);
+void _xfw_window_model_clear(XfwWindowModel *model);
+
+G_END_DECLS
+
+#endif /* __XFW_WINDOW_MODEL_H__ */
@@ -31,6 +31,56 @@
 
 G_BEGIN_DECLS
 
+enum {
+    WINDOW_SIGNAL_CLASS_CHANGED,
+    WINDOW_SIGNAL_NAME_CHANGED,
+    WINDOW_SIGNAL_ICON_CHANGED,
+    WINDOW_SIGNAL_TYPE_CHANGED,
+    WINDOW_SIGNAL_STATE_CHANGED,
+    WINDOW_SIGNAL_CAPABILITIES_CHANGED,
+    WINDOW_SIGNAL_GEOMETRY_CHANGED,
+    WINDOW_SIGNAL_GEOMETRY_SETTLED,
+    WINDOW_SIGNAL_WORKSPACE_CHANGED,
+    WINDOW_SIGNAL_CLOSED,
+    N_WINDOW_SIGNALS,
+};
+
+enum {
+    WINDOW_PROP_0,
+    WINDOW_PROP_SCREEN,
+    WINDOW_PROP_CLASS_IDS,
+    WINDOW_PROP_NAME,
+    WINDOW_PROP_TYPE,
+    WINDOW_PROP_STATE,
+    WINDOW_PROP_CAPABILITIES,
+    WINDOW_PROP_WORKSPACE,
+    WINDOW_PROP_MONITORS,
+    WINDOW_PROP_APPLICATION,
+    WINDOW_PROP_GICON,
+    N_WINDOW_PROPERTIES,
+};
+
+// Signal ids, indexed by WINDOW_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_window_signals[N_WINDOW_SIGNALS];
+
+typedef enum {
+    WINDOW_ACTION_CLOSE,
+    WINDOW_ACTION_MOVE_TO_WORKSPACE,
+    WINDOW_ACTION_SET_MINIMIZED,
+    WINDOW_ACTION_SET_MAXIMIZED,
+    WINDOW_ACTION_SET_PINNED,
+} XfwWindowActionType;
+
+// An action queued on an XfwWindowBatch
+typedef struct {
+    XfwWindowActionType type;
+    XfwWindow *window;
+    guint64 event_timestamp;  // WINDOW_ACTION_CLOSE, WINDOW_ACTION_SET_MINIMIZED
+    XfwWorkspace *workspace;  // WINDOW_ACTION_MOVE_TO_WORKSPACE
+    gboolean enable;  // WINDOW_ACTION_SET_*
+    GError *error;
+} XfwWindowAction;
+
 struct _XfwWindowClass {
     /*< private >*/
     GObjectClass parent_class;
@@ -81,10 +131,29 @@ struct _XfwWindowClass {
 
     gboolean (*is_on_workspace)(XfwWindow *window, XfwWorkspace *workspace);
     gboolean (*is_in_viewport)(XfwWindow *window, XfwWorkspace *workspace);
+
+    // Called by the screen when monitors come and go, before the screen's
+    // monitor-added/monitor-removed signals are emitted
+    void (*monitor_added)(XfwWindow *window, XfwMonitor *monitor);
+    void (*monitor_removed)(XfwWindow *window, XfwMonitor *monitor);
+
+    // Sends @action as part of an XfwWindowBatch, without flushing or waiting
+    // for a reply; the screen's flush() is called once the whole batch has
+    // been queued.  The minimize and maximize capabilities have already been
+    // checked.  Backends whose ordinary actions never block can leave this
+    // NULL.
+    gboolean (*queue_action)(XfwWindow *window, const XfwWindowAction *action, GError **error);
 };
 
 XfwScreen *_xfw_window_get_screen(XfwWindow *window);
+void _xfw_window_notify(XfwWindow *window, guint prop_id);
+XfwWindowChange *_xfw_window_change_copy(XfwWindowChange *change);
+void _xfw_window_change_free(XfwWindowChange *change);
 void _xfw_window_invalidate_icon(XfwWindow *window);
+void _xfw_window_geometry_changed(XfwWindow *window);
+void _xfw_window_name_changed(XfwWindow *window);
+void _xfw_window_monitor_added(XfwWindow *window, XfwMonitor *monitor);
+void _xfw_window_monitor_removed(XfwWindow *window, XfwMonitor *monitor);
 
 G_END_DECLS
 
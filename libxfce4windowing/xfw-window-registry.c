@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// The screen backends keep their windows here.  Windows live in a dense
+// array; a hash table maps each backend handle (WnckWindow, wlr toplevel
+// handle) to its slot, and removal moves the last slot into the hole, so
+// adding, looking up, and removing a window are all O(1).  Since that
+// shuffles the array, the stacking order is kept as a doubly-linked list
+// threaded through the slots by index.
+//
+// The list of windows, newest first, is the GList that
+// _xfw_window_registry_get_windows() hands out.  Each slot points at its
+// link, so the list is updated in place, in O(1), as windows come and go.
+// The stacking order changes wholesale, so that GList is built on demand and cached
+// until the next change; a stale one is only freed when the getter is next
+// called and builds its replacement.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-window-registry.h"
+
+#define NO_SLOT (-1)
+
+typedef struct {
+    gpointer handle;
+    XfwWindow *window;
+
+    // This window's link in the list of windows
+    GList *link;
+
+    // Stacking order, bottom to top
+    gint stack_below;
+    gint stack_above;
+    gboolean stacked;
+    gint stacking_index;
+} WindowSlot;
+
+struct _XfwWindowRegistry {
+    GArray *slots;  // WindowSlot
+    // handle -> slot + 1
+    GHashTable *handle_slots;
+    // XfwWindow -> slot + 1
+    GHashTable *window_slots;
+
+    gint stack_bottom;
+    gint stack_top;
+    gboolean stacking_indices_valid;
+
+    // Newest first
+    GList *windows;
+    GList *windows_stacked;
+    gboolean windows_stacked_valid;
+};
+
+static inline WindowSlot *
+get_slot(XfwWindowRegistry *registry, gint slot) {
+    return &g_array_index(registry->slots, WindowSlot, slot);
+}
+
+static gint
+lookup_slot(GHashTable *table, gconstpointer key) {
+    return GPOINTER_TO_INT(g_hash_table_lookup(table, key)) - 1;
+}
+
+static void
+invalidate_stacking(XfwWindowRegistry *registry) {
+    registry->windows_stacked_valid = FALSE;
+    registry->stacking_indices_valid = FALSE;
+}
+
+// Points everything that referred to @ws's old slot at @to, where it's
+// being moved
+static void
+relink_slot(XfwWindowRegistry *registry, WindowSlot *ws, gint to) {
+    if (ws->stacked) {
+        if (ws->stack_below != NO_SLOT) {
+            get_slot(registry, ws->stack_below)->stack_above = to;
+        } else {
+            registry->stack_bottom = to;
+        }
+        if (ws->stack_above != NO_SLOT) {
+            get_slot(registry, ws->stack_above)->stack_below = to;
+        } else {
+            registry->stack_top = to;
+        }
+    }
+}
+
+static void
+stack_unlink(XfwWindowRegistry *registry, gint slot) {
+    WindowSlot *ws = get_slot(registry, slot);
+
+    if (ws->stacked) {
+        if (ws->stack_below != NO_SLOT) {
+            get_slot(registry, ws->stack_below)->stack_above = ws->stack_above;
+        } else {
+            registry->stack_bottom = ws->stack_above;
+        }
+        if (ws->stack_above != NO_SLOT) {
+            get_slot(registry, ws->stack_above)->stack_below = ws->stack_below;
+        } else {
+            registry->stack_top = ws->stack_below;
+        }
+
+        ws->stack_below = NO_SLOT;
+        ws->stack_above = NO_SLOT;
+        ws->stacked = FALSE;
+        invalidate_stacking(registry);
+    }
+}
+
+static void
+stack_link_top(XfwWindowRegistry *registry, gint slot) {
+    WindowSlot *ws = get_slot(registry, slot);
+
+    ws->stack_below = registry->stack_top;
+    ws->stack_above = NO_SLOT;
+    ws->stacked = TRUE;
+    if (registry->stack_top != NO_SLOT) {
+        get_slot(registry, registry->stack_top)->stack_above = slot;
+    } else {
+        registry->stack_bottom = slot;
+    }
+    registry->stack_top = slot;
+    invalidate_stacking(registry);
+}
+
+static void
+stack_link_bottom(XfwWindowRegistry *registry, gint slot) {
+    WindowSlot *ws = get_slot(registry, slot);
+
+    ws->stack_below = NO_SLOT;
+    ws->stack_above = registry->stack_bottom;
+    ws->stacked = TRUE;
+    if (registry->stack_bottom != NO_SLOT) {
+        get_slot(registry, registry->stack_bottom)->stack_below = slot;
+    } else {
+        registry->stack_top = slot;
+    }
+    registry->stack_bottom = slot;
+    invalidate_stacking(registry);
+}
+
+XfwWindowRegistry *
+_xfw_window_registry_new(void) {
+    XfwWindowRegistry *registry = g_new0(XfwWindowRegistry, 1);
+    registry->slots = g_array_new(FALSE, FALSE, sizeof(WindowSlot));
+    registry->handle_slots = g_hash_table_new(g_direct_hash, g_direct_equal);
+    registry->window_slots = g_hash_table_new(g_direct_hash, g_direct_equal);
+    registry->stack_bottom = NO_SLOT;
+    registry->stack_top = NO_SLOT;
+    return registry;
+}
+
+void
+_xfw_window_registry_free(XfwWindowRegistry *registry) {
+    if (registry != NULL) {
+        g_list_free(registry->windows);
+        g_list_free(registry->windows_stacked);
+        for (guint i = 0; i < registry->slots->len; ++i) {
+            g_object_unref(get_slot(registry, i)->window);
+        }
+        g_array_free(registry->slots, TRUE);
+        g_hash_table_destroy(registry->handle_slots);
+        g_hash_table_destroy(registry->window_slots);
+        g_free(registry);
+    }
+}
+
+static void
+add_window(XfwWindowRegistry *registry, gpointer handle, XfwWindow *window, gboolean on_top) {
+    WindowSlot ws = {
+        .handle = handle,
+        .window = window,
+        .stack_below = NO_SLOT,
+        .stack_above = NO_SLOT,
+        .stacked = FALSE,
+        .stacking_index = -1,
+    };
+    gint slot;
+
+    g_return_if_fail(handle != NULL);
+    g_return_if_fail(XFW_IS_WINDOW(window));
+    g_return_if_fail(!g_hash_table_contains(registry->handle_slots, handle));
+
+    registry->windows = g_list_prepend(registry->windows, window);
+    ws.link = registry->windows;
+
+    slot = registry->slots->len;
+    g_array_append_val(registry->slots, ws);
+    g_hash_table_insert(registry->handle_slots, handle, GINT_TO_POINTER(slot + 1));
+    g_hash_table_insert(registry->window_slots, window, GINT_TO_POINTER(slot + 1));
+
+    if (on_top) {
+        stack_link_top(registry, slot);
+    } else {
+        stack_link_bottom(registry, slot);
+    }
+}
+
+// Takes ownership of the reference to @window.  The new window goes on top
+// of the stacking order.
+void
+_xfw_window_registry_add(XfwWindowRegistry *registry, gpointer handle, XfwWindow *window) {
+    add_window(registry, handle, window, TRUE);
+}
+
+// Like _xfw_window_registry_add(), but the new window goes to the bottom of
+// the stacking order.
+void
+_xfw_window_registry_add_at_bottom(XfwWindowRegistry *registry, gpointer handle, XfwWindow *window) {
+    add_window(registry, handle, window, FALSE);
+}
+
+// Returns the registry's reference to the window, which the caller now owns,
+// or NULL if nothing was registered for @handle.
+XfwWindow *
+_xfw_window_registry_remove(XfwWindowRegistry *registry, gpointer handle) {
+    gint slot = lookup_slot(registry->handle_slots, handle);
+    gint last;
+    XfwWindow *window;
+
+    if (slot < 0) {
+        return NULL;
+    }
+
+    stack_unlink(registry, slot);
+    registry->windows = g_list_delete_link(registry->windows, get_slot(registry, slot)->link);
+    window = get_slot(registry, slot)->window;
+    g_hash_table_remove(registry->handle_slots, handle);
+    g_hash_table_remove(registry->window_slots, window);
+
+    // Fill the hole with the last slot, and point everything that referred
+    // to that slot at its new position.
+    last = registry->slots->len - 1;
+    if (slot != last) {
+        WindowSlot *moved = get_slot(registry, last);
+
+        relink_slot(registry, moved, slot);
+        g_hash_table_insert(registry->handle_slots, moved->handle, GINT_TO_POINTER(slot + 1));
+        g_hash_table_insert(registry->window_slots, moved->window, GINT_TO_POINTER(slot + 1));
+
+        *get_slot(registry, slot) = *moved;
+    }
+    g_array_set_size(registry->slots, last);
+
+    return window;
+}
+
+XfwWindow *
+_xfw_window_registry_lookup(XfwWindowRegistry *registry, gpointer handle) {
+    gint slot = lookup_slot(registry->handle_slots, handle);
+    return slot >= 0 ? get_slot(registry, slot)->window : NULL;
+}
+
+guint
+_xfw_window_registry_get_n_windows(XfwWindowRegistry *registry) {
+    return registry->slots->len;
+}
+
+// Most recently added first
+GList *
+_xfw_window_registry_get_windows(XfwWindowRegistry *registry) {
+    return registry->windows;
+}
+
+// Bottom to top
+GList *
+_xfw_window_registry_get_windows_stacked(XfwWindowRegistry *registry) {
+    if (!registry->windows_stacked_valid) {
+        GList *windows_stacked = NULL;
+        for (gint slot = registry->stack_top; slot != NO_SLOT; slot = get_slot(registry, slot)->stack_below) {
+            windows_stacked = g_list_prepend(windows_stacked, get_slot(registry, slot)->window);
+        }
+        g_list_free(registry->windows_stacked);
+        registry->windows_stacked = windows_stacked;
+        registry->windows_stacked_valid = TRUE;
+    }
+    return registry->windows_stacked;
+}
+
+gint
+_xfw_window_registry_get_stacking_index(XfwWindowRegistry *registry, XfwWindow *window) {
+    gint slot = lookup_slot(registry->window_slots, window);
+
+    if (slot < 0) {
+        return -1;
+    }
+
+    if (!registry->stacking_indices_valid) {
+        gint index = 0;
+        for (gint s = registry->stack_bottom; s != NO_SLOT; s = get_slot(registry, s)->stack_above) {
+            get_slot(registry, s)->stacking_index = index++;
+        }
+        registry->stacking_indices_valid = TRUE;
+    }
+
+    return get_slot(registry, slot)->stacking_index;
+}
+
+static gboolean
+stacking_matches(XfwWindowRegistry *registry, GList *handles) {
+    gint cur = registry->stack_bottom;
+
+    for (GList *l = handles; l != NULL; l = l->next) {
+        gint slot = lookup_slot(registry->handle_slots, l->data);
+        if (slot >= 0) {
+            if (slot != cur) {
+                return FALSE;
+            }
+            cur = get_slot(registry, cur)->stack_above;
+        }
+    }
+
+    return cur == NO_SLOT;
+}
+
+// Replaces the stacking order with @handles, bottom to top.  Handles that
+// aren't registered are skipped, and registered windows that aren't in
+// @handles are left out of the stacking order.  If that's the order we
+// already have, nothing is invalidated, and the list returned by
+// _xfw_window_registry_get_windows_stacked() stays the same.  Returns
+// whether the order changed.
+gboolean
+_xfw_window_registry_set_stacking(XfwWindowRegistry *registry, GList *handles) {
+    if (stacking_matches(registry, handles)) {
+        return FALSE;
+    }
+
+    for (guint i = 0; i < registry->slots->len; ++i) {
+        WindowSlot *ws = get_slot(registry, i);
+        ws->stack_below = NO_SLOT;
+        ws->stack_above = NO_SLOT;
+        ws->stacked = FALSE;
+        ws->stacking_index = -1;
+    }
+    registry->stack_bottom = NO_SLOT;
+    registry->stack_top = NO_SLOT;
+
+    for (GList *l = handles; l != NULL; l = l->next) {
+        gint slot = lookup_slot(registry->handle_slots, l->data);
+        if (slot >= 0 && !get_slot(registry, slot)->stacked) {
+            stack_link_top(registry, slot);
+        }
+    }
+
+    invalidate_stacking(registry);
+    return TRUE;
+}
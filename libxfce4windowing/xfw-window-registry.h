@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_WINDOW_REGISTRY_H__
+#define __XFW_WINDOW_REGISTRY_H__
+
+#include <glib.h>
+
+#include "xfw-window.h"
+
+G_BEGIN_DECLS
+
+typedef struct _XfwWindowRegistry XfwWindowRegistry;
+
+XfwWindowRegistry *_xfw_window_registry_new(void);
+void _xfw_window_registry_free(XfwWindowRegistry *registry);
+
+void _xfw_window_registry_add(XfwWindowRegistry *registry, gpointer handle, XfwWindow *window);
+void _xfw_window_registry_add_at_bottom(XfwWindowRegistry *registry, gpointer handle, XfwWindow *window);
+XfwWindow *_xfw_window_registry_remove(XfwWindowRegistry *registry, gpointer handle);
+XfwWindow *_xfw_window_registry_lookup(XfwWindowRegistry *registry, gpointer handle);
+guint _xfw_window_registry_get_n_windows(XfwWindowRegistry *registry);
+
+GList *_xfw_window_registry_get_windows(XfwWindowRegistry *registry);
+GList *_xfw_window_registry_get_windows_stacked(XfwWindowRegistry *registry);
+gint _xfw_window_registry_get_stacking_index(XfwWindowRegistry *registry, XfwWindow *window);
+gboolean _xfw_window_registry_set_stacking(XfwWindowRegistry *registry, GList *handles);
+
+G_END_DECLS
+
+#endif /* __XFW_WINDOW_REGISTRY_H__ */
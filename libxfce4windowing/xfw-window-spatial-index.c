@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+// Finds the windows whose geometry intersects a rectangle, without looking
+// at every window.  The screen is divided into square cells, and each window
+// is filed under the cells it covers.  A query only looks at the cells the
+// rectangle covers, and then checks the windows filed there.  Windows
+// covering a silly number of cells (clients can make their windows as big as
+// they like) go on a separate list that every query checks instead.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "xfw-window-spatial-index.h"
+
+#define CELL_SIZE 512
+#define MAX_CELLS_PER_WINDOW 64
+
+typedef struct {
+    GdkRectangle rect;
+    gboolean oversized;
+} SpatialEntry;
+
+struct _XfwWindowSpatialIndex {
+    // XfwWindow -> SpatialEntry
+    GHashTable *windows;
+    // Cell (packed by cell_key()) -> set of XfwWindow
+    GHashTable *cells;
+    // Windows covering more than MAX_CELLS_PER_WINDOW cells
+    GHashTable *oversized;
+};
+
+static gint
+cell_coord(gint64 coord) {
+    // Rounds towards negative infinity, so cells don't straddle 0
+    return coord >= 0 ? coord / CELL_SIZE : -((-coord + CELL_SIZE - 1) / CELL_SIZE);
+}
+
+static gint64
+cell_key(gint cx, gint cy) {
+    return (gint64)(((guint64)(guint32)cx << 32) | (guint32)cy);
+}
+
+static void
+cell_coords(gint64 key, gint *cx, gint *cy) {
+    *cx = (gint32)(guint32)((guint64)key >> 32);
+    *cy = (gint32)(guint32)key;
+}
+
+// Cell ranges are inclusive
+static void
+cell_range(const GdkRectangle *rect, gint *cx0, gint *cy0, gint *cx1, gint *cy1) {
+    *cx0 = cell_coord(rect->x);
+    *cy0 = cell_coord(rect->y);
+    *cx1 = cell_coord((gint64)rect->x + rect->width - 1);
+    *cy1 = cell_coord((gint64)rect->y + rect->height - 1);
+}
+
+static gint64
+n_cells(gint cx0, gint cy0, gint cx1, gint cy1) {
+    return ((gint64)cx1 - cx0 + 1) * ((gint64)cy1 - cy0 + 1);
+}
+
+static void
+file_entry(XfwWindowSpatialIndex *index, XfwWindow *window, SpatialEntry *entry) {
+    if (entry->rect.width > 0 && entry->rect.height > 0) {
+        gint cx0, cy0, cx1, cy1;
+        cell_range(&entry->rect, &cx0, &cy0, &cx1, &cy1);
+        entry->oversized = n_cells(cx0, cy0, cx1, cy1) > MAX_CELLS_PER_WINDOW;
+
+        if (entry->oversized) {
+            g_hash_table_add(index->oversized, window);
+        } else {
+            for (gint cx = cx0; cx <= cx1; ++cx) {
+                for (gint cy = cy0; cy <= cy1; ++cy) {
+                    gint64 key = cell_key(cx, cy);
+                    GHashTable *cell = g_hash_table_lookup(index->cells, &key);
+                    if (cell == NULL) {
+                        cell = g_hash_table_new(g_direct_hash, g_direct_equal);
+                        g_hash_table_insert(index->cells, g_memdup2(&key, sizeof(key)), cell);
+                    }
+                    g_hash_table_add(cell, window);
+                }
+            }
+        }
+    }
+}
+
+static void
+unfile_entry(XfwWindowSpatialIndex *index, XfwWindow *window, SpatialEntry *entry) {
+    if (entry->rect.width > 0 && entry->rect.height > 0) {
+        if (entry->oversized) {
+            g_hash_table_remove(index->oversized, window);
+        } else {
+            gint cx0, cy0, cx1, cy1;
+            cell_range(&entry->rect, &cx0, &cy0, &cx1, &cy1);
+            for (gint cx = cx0; cx <= cx1; ++cx) {
+                for (gint cy = cy0; cy <= cy1; ++cy) {
+                    gint64 key = cell_key(cx, cy);
+                    GHashTable *cell = g_hash_table_lookup(index->cells, &key);
+                    if (cell != NULL) {
+                        g_hash_table_remove(cell, window);
+                        if (g_hash_table_size(cell) == 0) {
+                            g_hash_table_remove(index->cells, &key);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+XfwWindowSpatialIndex *
+_xfw_window_spatial_index_new(void) {
+    XfwWindowSpatialIndex *index = g_new0(XfwWindowSpatialIndex, 1);
+    index->windows = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    index->cells = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, (GDestroyNotify)g_hash_table_destroy);
+    index->oversized = g_hash_table_new(g_direct_hash, g_direct_equal);
+    return index;
+}
+
+void
+_xfw_window_spatial_index_free(XfwWindowSpatialIndex *index) {
+    if (index != NULL) {
+        g_hash_table_destroy(index->oversized);
+        g_hash_table_destroy(index->cells);
+        g_hash_table_destroy(index->windows);
+        g_free(index);
+    }
+}
+
+// Adds @window, or moves it if it's already there
+void
+_xfw_window_spatial_index_set(XfwWindowSpatialIndex *index, XfwWindow *window, const GdkRectangle *rect) {
+    SpatialEntry *entry = g_hash_table_lookup(index->windows, window);
+    if (entry == NULL) {
+        entry = g_new0(SpatialEntry, 1);
+        g_hash_table_insert(index->windows, window, entry);
+    } else if (gdk_rectangle_equal(&entry->rect, rect)) {
+        return;
+    } else {
+        unfile_entry(index, window, entry);
+    }
+
+    entry->rect = *rect;
+    file_entry(index, window, entry);
+}
+
+void
+_xfw_window_spatial_index_remove(XfwWindowSpatialIndex *index, XfwWindow *window) {
+    SpatialEntry *entry = g_hash_table_lookup(index->windows, window);
+    if (entry != NULL) {
+        unfile_entry(index, window, entry);
+        g_hash_table_remove(index->windows, window);
+    }
+}
+
+static void
+add_if_intersecting(XfwWindowSpatialIndex *index, XfwWindow *window, const GdkRectangle *rect, GHashTable *found, GList **windows) {
+    if (!g_hash_table_contains(found, window)) {
+        SpatialEntry *entry = g_hash_table_lookup(index->windows, window);
+        g_hash_table_add(found, window);
+        if (gdk_rectangle_intersect(&entry->rect, rect, NULL)) {
+            *windows = g_list_prepend(*windows, window);
+        }
+    }
+}
+
+// Returns the windows intersecting @rect, in no particular order.  Free the
+// list with g_list_free().
+GList *
+_xfw_window_spatial_index_for_rect(XfwWindowSpatialIndex *index, const GdkRectangle *rect) {
+    GList *windows = NULL;
+
+    if (rect->width > 0 && rect->height > 0) {
+        GHashTable *found = g_hash_table_new(g_direct_hash, g_direct_equal);
+        GHashTableIter iter;
+        gpointer window;
+        gint cx0, cy0, cx1, cy1;
+
+        cell_range(rect, &cx0, &cy0, &cx1, &cy1);
+        if (n_cells(cx0, cy0, cx1, cy1) > g_hash_table_size(index->cells)) {
+            // Cheaper to go through the occupied cells than the covered ones
+            GHashTableIter cells_iter;
+            gpointer key, cell;
+            g_hash_table_iter_init(&cells_iter, index->cells);
+            while (g_hash_table_iter_next(&cells_iter, &key, &cell)) {
+                gint cx, cy;
+                cell_coords(*(gint64 *)key, &cx, &cy);
+                if (cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1) {
+                    g_hash_table_iter_init(&iter, cell);
+                    while (g_hash_table_iter_next(&iter, &window, NULL)) {
+                        add_if_intersecting(index, window, rect, found, &windows);
+                    }
+                }
+            }
+        } else {
+            for (gint cx = cx0; cx <= cx1; ++cx) {
+                for (gint cy = cy0; cy <= cy1; ++cy) {
+                    gint64 key = cell_key(cx, cy);
+                    GHashTable *cell = g_hash_table_lookup(index->cells, &key);
+                    if (cell != NULL) {
+                        g_hash_table_iter_init(&iter, cell);
+                        while (g_hash_table_iter_next(&iter, &window, NULL)) {
+                            add_if_intersecting(index, window, rect, found, &windows);
+                        }
+                    }
+                }
+            }
+        }
+
+        g_hash_table_iter_init(&iter, index->oversized);
+        while (g_hash_table_iter_next(&iter, &window, NULL)) {
+            add_if_intersecting(index, window, rect, found, &windows);
+        }
+
+        g_hash_table_destroy(found);
+    }
+
+    return windows;
+}
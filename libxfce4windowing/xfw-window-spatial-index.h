@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Brian Tarricone <brian@tarricone.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301 USA
+ */
+
+#ifndef __XFW_WINDOW_SPATIAL_INDEX_H__
+#define __XFW_WINDOW_SPATIAL_INDEX_H__
+
+#include <gdk/gdk.h>
+
+#include "xfw-window.h"
+
+G_BEGIN_DECLS
+
+typedef struct _XfwWindowSpatialIndex XfwWindowSpatialIndex;
+
+XfwWindowSpatialIndex *_xfw_window_spatial_index_new(void);
+void _xfw_window_spatial_index_free(XfwWindowSpatialIndex *index);
+
+void _xfw_window_spatial_index_set(XfwWindowSpatialIndex *index, XfwWindow *window, const GdkRectangle *rect);
+void _xfw_window_spatial_index_remove(XfwWindowSpatialIndex *index, XfwWindow *window);
+
+GList *_xfw_window_spatial_index_for_rect(XfwWindowSpatialIndex *index, const GdkRectangle *rect);
+
+G_END_DECLS
+
+#endif /* __XFW_WINDOW_SPATIAL_INDEX_H__ */
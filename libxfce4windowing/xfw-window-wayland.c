@@ -30,6 +30,7 @@
 #include "libxfce4windowing-private.h"
 #include "xfw-application-wayland.h"
 #include "xfw-monitor-wayland.h"
+#include "xfw-screen-private.h"
 #include "xfw-screen-wayland.h"
 #include "xfw-screen.h"
 #include "xfw-seat-wayland.h"
@@ -123,6 +124,8 @@ static gboolean xfw_window_wayland_set_above(XfwWindow *window, gboolean is_abov
 static gboolean xfw_window_wayland_set_below(XfwWindow *window, gboolean is_below, GError **error);
 static gboolean xfw_window_wayland_is_on_workspace(XfwWindow *window, XfwWorkspace *workspace);
 static gboolean xfw_window_wayland_is_in_viewport(XfwWindow *window, XfwWorkspace *workspace);
+static void xfw_window_wayland_monitor_added(XfwWindow *window, XfwMonitor *monitor);
+static void xfw_window_wayland_monitor_removed(XfwWindow *window, XfwMonitor *monitor);
 
 static void wlr_toplevel_app_id(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel, const char *app_id);
 static void wlr_toplevel_title(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel, const char *title);
@@ -140,9 +143,6 @@ static void xfce_toplevel_no_icon(void *data, struct xfce_foreign_toplevel_handl
 static void xfce_toplevel_workspace_enter(void *data, struct xfce_foreign_toplevel_handle_v1 *xfce_toplevel, struct ext_workspace_handle_v1 *ext_workspace);
 static void xfce_toplevel_workspace_leave(void *data, struct xfce_foreign_toplevel_handle_v1 *xfce_toplevel, struct ext_workspace_handle_v1 *ext_workspace);
 
-static void monitor_added(XfwScreen *screen, XfwMonitor *monitor, XfwWindowWayland *window);
-static void monitor_removed(XfwScreen *screen, XfwMonitor *monitor, XfwWindowWayland *window);
-
 static IconSize *icon_size_new(uint32_t size, uint32_t scale);
 
 static const struct {
@@ -251,6 +251,8 @@ xfw_window_wayland_class_init(XfwWindowWaylandClass *klass) {
     window_class->set_below = xfw_window_wayland_set_below;
     window_class->is_on_workspace = xfw_window_wayland_is_on_workspace;
     window_class->is_in_viewport = xfw_window_wayland_is_in_viewport;
+    window_class->monitor_added = xfw_window_wayland_monitor_added;
+    window_class->monitor_removed = xfw_window_wayland_monitor_removed;
 
     g_object_class_install_property(gklass,
                                     PROP_WLR_HANDLE,
@@ -282,10 +284,6 @@ xfw_window_wayland_constructed(GObject *obj) {
         xfce_foreign_toplevel_handle_v1_add_listener(window->priv->xfce_handle, &xfce_toplevel_handle_listener, window);
     }
 
-    XfwScreen *screen = _xfw_window_get_screen(XFW_WINDOW(window));
-    g_signal_connect(screen, "monitor-added", G_CALLBACK(monitor_added), window);
-    g_signal_connect(screen, "monitor-removed", G_CALLBACK(monitor_removed), window);
-
     G_OBJECT_CLASS(xfw_window_wayland_parent_class)->constructed(obj);
 }
 
@@ -331,8 +329,6 @@ static void
 xfw_window_wayland_finalize(GObject *obj) {
     XfwWindowWayland *window = XFW_WINDOW_WAYLAND(obj);
 
-    g_signal_handlers_disconnect_by_data(_xfw_window_get_screen(XFW_WINDOW(window)), window);
-
     if (window->priv->xfce_handle != NULL) {
         xfce_foreign_toplevel_handle_v1_destroy(window->priv->xfce_handle);
     }
@@ -749,6 +745,34 @@ xfw_window_wayland_is_in_viewport(XfwWindow *window, XfwWorkspace *workspace) {
     return FALSE;
 }
 
+static void
+xfw_window_wayland_monitor_added(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowWayland *wwindow = XFW_WINDOW_WAYLAND(window);
+    for (GList *l = wwindow->priv->pending_outputs; l != NULL; l = l->next) {
+        if (l->data == _xfw_monitor_wayland_get_wl_output(XFW_MONITOR_WAYLAND(monitor))) {
+            if (wwindow->priv->created_emitted) {
+                wwindow->priv->monitors = g_list_prepend(wwindow->priv->monitors, monitor);
+                _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
+            } else if (g_list_find(wwindow->priv->pending.monitors_to_add, monitor) == NULL) {
+                // Not in the screen's window index yet, so wait for the initial
+                // commit like the rest of the window's state
+                wwindow->priv->pending.monitors_to_add = g_list_prepend(wwindow->priv->pending.monitors_to_add, monitor);
+            }
+            break;
+        }
+    }
+}
+
+static void
+xfw_window_wayland_monitor_removed(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowWayland *wwindow = XFW_WINDOW_WAYLAND(window);
+    GList *lm = g_list_find(wwindow->priv->monitors, monitor);
+    if (lm != NULL) {
+        wwindow->priv->monitors = g_list_delete_link(wwindow->priv->monitors, lm);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
+    }
+}
+
 static void
 xfw_window_commit_changes(XfwWindowWayland *window) {
     PendingChanges *pending = &window->priv->pending;
@@ -828,6 +852,19 @@ xfw_window_commit_changes(XfwWindowWayland *window) {
         capabilities_changed_mask = 0;
     }
 
+    if (pending->monitors_to_add != NULL) {
+        // The screen only tells windows holding a monitor that it went away,
+        // so drop any queued monitor that has been removed since
+        GList *screen_monitors = xfw_screen_get_monitors(_xfw_window_get_screen(XFW_WINDOW(window)));
+        for (GList *l = pending->monitors_to_add; l != NULL;) {
+            GList *next = l->next;
+            if (g_list_find(screen_monitors, l->data) == NULL) {
+                pending->monitors_to_add = g_list_delete_link(pending->monitors_to_add, l);
+            }
+            l = next;
+        }
+    }
+
     if (pending->monitors_to_add != NULL) {
         GList *last = g_list_last(window->priv->monitors);
         if (last == NULL) {
@@ -864,21 +901,24 @@ xfw_window_commit_changes(XfwWindowWayland *window) {
 
     if (pending->new_app_id != NULL) {
         pending->new_app_id = NULL;
-        g_object_notify(G_OBJECT(window), "application");
-        g_signal_emit_by_name(window, "icon-changed");
-        g_object_notify(G_OBJECT(window), "class-ids");
-        g_signal_emit_by_name(window, "class-changed");
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_APPLICATION);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_ICON_CHANGED], 0);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_CLASS_IDS);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CLASS_CHANGED], 0);
     }
 
     if (pending->new_name != NULL) {
         pending->new_name = NULL;
-        g_object_notify(G_OBJECT(window), "name");
-        g_signal_emit_by_name(window, "name-changed");
+        _xfw_window_name_changed(XFW_WINDOW(window));
     }
 
     if (state_changed_mask != 0) {
-        g_object_notify(G_OBJECT(window), "state");
-        g_signal_emit_by_name(window, "state-changed", state_changed_mask, window->priv->state);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_STATE);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_STATE_CHANGED], 0, state_changed_mask, window->priv->state);
+        _xfw_screen_wayland_window_state_changed(XFW_SCREEN_WAYLAND(_xfw_window_get_screen(XFW_WINDOW(window))),
+                                                 XFW_WINDOW(window),
+                                                 state_changed_mask,
+                                                 window->priv->state);
 
         if (window->priv->created_emitted && (old_state & XFW_WINDOW_STATE_ACTIVE) != (window->priv->state & XFW_WINDOW_STATE_ACTIVE)) {
             XfwScreen *screen = _xfw_window_get_screen(XFW_WINDOW(window));
@@ -892,27 +932,27 @@ xfw_window_commit_changes(XfwWindowWayland *window) {
     }
 
     if (capabilities_changed_mask != 0) {
-        g_object_notify(G_OBJECT(window), "capabilities");
-        g_signal_emit_by_name(window, "capabilities-changed", capabilities_changed_mask, window->priv->capabilities);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_CAPABILITIES);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CAPABILITIES_CHANGED], 0, capabilities_changed_mask, window->priv->capabilities);
     }
 
     if (pending->monitors_to_add != NULL || pending->monitors_to_remove != NULL) {
         pending->monitors_to_add = NULL;
         g_clear_pointer(&pending->monitors_to_remove, g_list_free);
-        g_object_notify(G_OBJECT(window), "monitors");
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
     }
 
     if (pending->icon_changed) {
         pending->icon_changed = FALSE;
-        g_object_notify(G_OBJECT(window), "gicon");
-        g_signal_emit_by_name(window, "icon-changed");
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_GICON);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_ICON_CHANGED], 0);
     }
 
     if (pending->workspace_changed) {
         pending->workspace_changed = FALSE;
         pending->new_workspace = NULL;
-        g_object_notify(G_OBJECT(window), "workspace");
-        g_signal_emit_by_name(window, "workspace-changed");
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_WORKSPACE);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_WORKSPACE_CHANGED], 0);
     }
 }
 
@@ -920,20 +960,35 @@ static void
 wlr_toplevel_app_id(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel, const char *app_id) {
     XfwWindowWayland *window = XFW_WINDOW_WAYLAND(data);
 
-    if (app_id == NULL || *app_id == '\0' || g_strcmp0(app_id, window->priv->app_id) == 0) {
+    if (app_id == NULL || *app_id == '\0') {
         return;
     }
 
-    g_free(window->priv->pending.new_app_id);
-    window->priv->pending.new_app_id = g_strdup(app_id);
+    if (g_strcmp0(app_id, window->priv->app_id) == 0) {
+        // Changed back before the 'done' event, or just resent
+        g_clear_pointer(&window->priv->pending.new_app_id, g_free);
+    } else if (g_strcmp0(app_id, window->priv->pending.new_app_id) != 0) {
+        g_free(window->priv->pending.new_app_id);
+        window->priv->pending.new_app_id = g_strdup(app_id);
+    }
 }
 
 static void
 wlr_toplevel_title(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel, const char *title) {
     XfwWindowWayland *window = XFW_WINDOW_WAYLAND(data);
 
-    g_free(window->priv->pending.new_name);
-    window->priv->pending.new_name = title != NULL ? g_strdup(title) : g_strdup("");
+    if (title == NULL) {
+        title = "";
+    }
+
+    // Many clients resend their title without changing it, so only commit
+    // (and later emit name-changed for) one that differs from what we have
+    if (g_strcmp0(title, window->priv->name) == 0) {
+        g_clear_pointer(&window->priv->pending.new_name, g_free);
+    } else if (g_strcmp0(title, window->priv->pending.new_name) != 0) {
+        g_free(window->priv->pending.new_name);
+        window->priv->pending.new_name = g_strdup(title);
+    }
 }
 
 static void
@@ -959,10 +1014,17 @@ static void
 wlr_toplevel_parent(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel, struct zwlr_foreign_toplevel_handle_v1 *wl_parent) {
 }
 
+static void
+clear_pending_outputs(XfwWindowWayland *window) {
+    XfwScreenWayland *screen = XFW_SCREEN_WAYLAND(_xfw_window_get_screen(XFW_WINDOW(window)));
+    _xfw_screen_wayland_remove_pending_outputs(screen, XFW_WINDOW(window), window->priv->pending_outputs);
+    g_clear_list(&window->priv->pending_outputs, NULL);
+}
+
 static gboolean
 free_pending_outputs(gpointer data) {
     XfwWindowWayland *window = XFW_WINDOW_WAYLAND(data);
-    g_clear_list(&window->priv->pending_outputs, NULL);
+    clear_pending_outputs(window);
     window->priv->pending_outputs_id = 0;
     return FALSE;
 }
@@ -1009,6 +1071,7 @@ wlr_toplevel_output_enter(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl
         // therefore seems to be to clean up the list a few seconds after a series of changes.
         if (l == NULL) {
             window->priv->pending_outputs = g_list_prepend(window->priv->pending_outputs, output);
+            _xfw_screen_wayland_add_pending_output(XFW_SCREEN_WAYLAND(screen), XFW_WINDOW(window), output);
             if (window->priv->pending_outputs_id != 0) {
                 g_source_remove(window->priv->pending_outputs_id);
             }
@@ -1046,7 +1109,16 @@ wlr_toplevel_output_leave(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl
 static void
 wlr_toplevel_closed(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_toplevel) {
     XfwWindowWayland *window = XFW_WINDOW_WAYLAND(data);
-    g_signal_emit_by_name(window, "closed");
+
+    // Once closed, the window may well outlive the screen, so take it out of the
+    // screen's pending outputs now rather than when it is finalized
+    clear_pending_outputs(window);
+    if (window->priv->pending_outputs_id != 0) {
+        g_source_remove(window->priv->pending_outputs_id);
+        window->priv->pending_outputs_id = 0;
+    }
+
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CLOSED], 0);
 }
 
 static void
@@ -1067,7 +1139,7 @@ wlr_toplevel_done(void *data, struct zwlr_foreign_toplevel_handle_v1 *wl_topleve
             }
 
             window->priv->created_emitted = TRUE;
-            g_signal_emit_by_name(screen, "window-opened", window);
+            g_signal_emit(screen, _xfw_screen_signals[SCREEN_SIGNAL_WINDOW_OPENED], 0, window);
             if (window->priv->state & XFW_WINDOW_STATE_ACTIVE) {
                 _xfw_screen_set_active_window(screen, XFW_WINDOW(window));
             }
@@ -1152,26 +1224,6 @@ xfce_toplevel_workspace_leave(void *data, struct xfce_foreign_toplevel_handle_v1
     }
 }
 
-static void
-monitor_added(XfwScreen *screen, XfwMonitor *monitor, XfwWindowWayland *window) {
-    for (GList *l = window->priv->pending_outputs; l != NULL; l = l->next) {
-        if (l->data == _xfw_monitor_wayland_get_wl_output(XFW_MONITOR_WAYLAND(monitor))) {
-            window->priv->monitors = g_list_prepend(window->priv->monitors, monitor);
-            g_object_notify(G_OBJECT(window), "monitors");
-            break;
-        }
-    }
-}
-
-static void
-monitor_removed(XfwScreen *screen, XfwMonitor *monitor, XfwWindowWayland *window) {
-    GList *lm = g_list_find(window->priv->monitors, monitor);
-    if (lm != NULL) {
-        window->priv->monitors = g_list_delete_link(window->priv->monitors, lm);
-        g_object_notify(G_OBJECT(window), "monitors");
-    }
-}
-
 static IconSize *
 icon_size_new(uint32_t size, uint32_t scale) {
     IconSize *icon_size = g_new0(IconSize, 1);
@@ -21,10 +21,14 @@
 #include "config.h"
 #endif
 
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <gdk/gdkx.h>
 #include <libwnck/libwnck.h>
 
 #include "libxfce4windowing-private.h"
 #include "xfw-application-x11.h"
+#include "xfw-screen-private.h"
 #include "xfw-screen-x11.h"
 #include "xfw-screen.h"
 #include "xfw-util.h"
@@ -43,7 +47,7 @@ enum {
 struct _XfwWindowX11Private {
     WnckWindow *wnck_window;
 
-    const gchar **class_ids;
+    gchar **class_ids;
     XfwWindowType window_type;
     XfwWindowState state;
     XfwWindowCapabilities capabilities;
@@ -86,6 +90,10 @@ static gboolean xfw_window_x11_set_above(XfwWindow *window, gboolean is_above, G
 static gboolean xfw_window_x11_set_below(XfwWindow *window, gboolean is_below, GError **error);
 static gboolean xfw_window_x11_is_on_workspace(XfwWindow *window, XfwWorkspace *workspace);
 static gboolean xfw_window_x11_is_in_viewport(XfwWindow *window, XfwWorkspace *workspace);
+static void xfw_window_x11_geometry_changed(XfwWindow *window);
+static void xfw_window_x11_monitor_added(XfwWindow *window, XfwMonitor *monitor);
+static void xfw_window_x11_monitor_removed(XfwWindow *window, XfwMonitor *monitor);
+static gboolean xfw_window_x11_queue_action(XfwWindow *window, const XfwWindowAction *action, GError **error);
 
 static void class_changed(WnckWindow *wnck_window, XfwWindowX11 *window);
 static void name_changed(WnckWindow *wnck_window, XfwWindowX11 *window);
@@ -95,10 +103,9 @@ static void type_changed(WnckWindow *wnck_window, XfwWindowX11 *window);
 static void state_changed(WnckWindow *wnck_window, WnckWindowState changed_mask, WnckWindowState new_state, XfwWindowX11 *window);
 static void actions_changed(WnckWindow *wnck_window, WnckWindowActions wnck_changed_mask, WnckWindowActions wnck_new_actions, XfwWindowX11 *window);
 static void geometry_changed(WnckWindow *wnck_window, XfwWindowX11 *window);
-static void monitor_added(XfwScreen *screen, XfwMonitor *monitor, XfwWindowX11 *window);
-static void monitor_removed(XfwScreen *screen, XfwMonitor *monitor, XfwWindowX11 *window);
 static void workspace_changed(WnckWindow *wnck_window, XfwWindowX11 *window);
 
+static gboolean set_class_ids(XfwWindowX11 *window);
 static XfwWindowType convert_type(WnckWindowType wnck_type);
 static XfwWindowState convert_state(WnckWindow *wnck_window, WnckWindowState wnck_state);
 static XfwWindowCapabilities convert_capabilities(WnckWindow *wnck_window, WnckWindowActions wnck_actions);
@@ -145,6 +152,10 @@ xfw_window_x11_class_init(XfwWindowX11Class *klass) {
     window_class->set_below = xfw_window_x11_set_below;
     window_class->is_on_workspace = xfw_window_x11_is_on_workspace;
     window_class->is_in_viewport = xfw_window_x11_is_in_viewport;
+    window_class->geometry_changed = xfw_window_x11_geometry_changed;
+    window_class->monitor_added = xfw_window_x11_monitor_added;
+    window_class->monitor_removed = xfw_window_x11_monitor_removed;
+    window_class->queue_action = xfw_window_x11_queue_action;
 
     g_object_class_install_property(gklass,
                                     PROP_WNCK_WINDOW,
@@ -164,29 +175,16 @@ static void
 xfw_window_x11_constructed(GObject *obj) {
     XfwWindowX11 *window = XFW_WINDOW_X11(obj);
     XfwScreen *screen = _xfw_window_get_screen(XFW_WINDOW(window));
-    const gchar *class_name = wnck_window_get_class_group_name(window->priv->wnck_window);
-    const gchar *instance_name = wnck_window_get_class_instance_name(window->priv->wnck_window);
 
-    window->priv->class_ids = g_new0(const gchar *, 3);
-    if (class_name != NULL && *class_name != '\0') {
-        window->priv->class_ids[0] = class_name;
-        window->priv->class_ids[1] = instance_name;
-    } else {
-        window->priv->class_ids[0] = instance_name;
-    }
+    window->priv->class_ids = g_new0(gchar *, 3);
+    set_class_ids(window);
     window->priv->window_type = convert_type(wnck_window_get_window_type(window->priv->wnck_window));
     window->priv->state = convert_state(window->priv->wnck_window, wnck_window_get_state(window->priv->wnck_window));
     wnck_window_get_geometry(window->priv->wnck_window,
                              &window->priv->geometry.x, &window->priv->geometry.y,
                              &window->priv->geometry.width, &window->priv->geometry.height);
-    for (GList *l = xfw_screen_get_monitors(screen); l != NULL; l = l->next) {
-        XfwMonitor *monitor = XFW_MONITOR(l->data);
-        GdkRectangle geom;
-        xfw_monitor_get_physical_geometry(monitor, &geom);
-        if (gdk_rectangle_intersect(&window->priv->geometry, &geom, NULL)) {
-            window->priv->monitors = g_list_prepend(window->priv->monitors, monitor);
-        }
-    }
+    window->priv->monitors = _xfw_screen_get_monitors_for_rect(screen, &window->priv->geometry);
+    _xfw_screen_x11_window_geometry_changed(XFW_SCREEN_X11(screen), XFW_WINDOW(window), &window->priv->geometry);
     window->priv->capabilities = convert_capabilities(window->priv->wnck_window, wnck_window_get_actions(window->priv->wnck_window));
     window->priv->workspace = _xfw_screen_x11_workspace_for_wnck_workspace(XFW_SCREEN_X11(screen),
                                                                            wnck_window_get_workspace(window->priv->wnck_window));
@@ -204,8 +202,6 @@ xfw_window_x11_constructed(GObject *obj) {
     g_signal_connect(window->priv->wnck_window, "actions-changed", G_CALLBACK(actions_changed), window);
     g_signal_connect(window->priv->wnck_window, "geometry-changed", G_CALLBACK(geometry_changed), window);
     g_signal_connect(window->priv->wnck_window, "workspace-changed", G_CALLBACK(workspace_changed), window);
-    g_signal_connect(screen, "monitor-added", G_CALLBACK(monitor_added), window);
-    g_signal_connect(screen, "monitor-removed", G_CALLBACK(monitor_removed), window);
 
     G_OBJECT_CLASS(xfw_window_x11_parent_class)->constructed(obj);
 }
@@ -246,9 +242,8 @@ xfw_window_x11_finalize(GObject *obj) {
 
     g_signal_handlers_disconnect_by_data(window->priv->wnck_window, window);
     g_signal_handlers_disconnect_by_data(window->priv->app, window);
-    g_signal_handlers_disconnect_by_data(_xfw_window_get_screen(XFW_WINDOW(window)), window);
 
-    g_free(window->priv->class_ids);
+    g_strfreev(window->priv->class_ids);
     g_list_free(window->priv->monitors);
     g_object_unref(window->priv->app);
     if (window->priv->workspace != NULL) {
@@ -263,7 +258,7 @@ xfw_window_x11_finalize(GObject *obj) {
 
 static const gchar *const *
 xfw_window_x11_get_class_ids(XfwWindow *window) {
-    return XFW_WINDOW_X11(window)->priv->class_ids;
+    return (const gchar *const *)XFW_WINDOW_X11(window)->priv->class_ids;
 }
 
 static const gchar *
@@ -584,45 +579,177 @@ xfw_window_x11_is_in_viewport(XfwWindow *window, XfwWorkspace *workspace) {
                                       _xfw_workspace_x11_get_wnck_workspace(XFW_WORKSPACE_X11(workspace)));
 }
 
+static gboolean
+monitor_lists_equal(GList *a, GList *b) {
+    if (g_list_length(a) != g_list_length(b)) {
+        return FALSE;
+    }
+    for (GList *l = a; l != NULL; l = l->next) {
+        if (g_list_find(b, l->data) == NULL) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 static void
-class_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
-    const gchar *class_name = wnck_window_get_class_group_name(wnck_window);
-    const gchar *instance_name = wnck_window_get_class_instance_name(wnck_window);
-    if (class_name != NULL && *class_name != '\0') {
-        window->priv->class_ids[0] = class_name;
-        window->priv->class_ids[1] = instance_name;
+xfw_window_x11_geometry_changed(XfwWindow *window) {
+    XfwWindowX11 *xwindow = XFW_WINDOW_X11(window);
+    GList *monitors = _xfw_screen_get_monitors_for_rect(_xfw_window_get_screen(window), &xwindow->priv->geometry);
+    if (monitor_lists_equal(monitors, xwindow->priv->monitors)) {
+        g_list_free(monitors);
     } else {
-        window->priv->class_ids[0] = instance_name;
-        window->priv->class_ids[1] = NULL;
+        g_list_free(xwindow->priv->monitors);
+        xwindow->priv->monitors = monitors;
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
+    }
+}
+
+static void
+xfw_window_x11_monitor_added(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowX11 *xwindow = XFW_WINDOW_X11(window);
+    GdkRectangle geom;
+    xfw_monitor_get_physical_geometry(monitor, &geom);
+    if (gdk_rectangle_intersect(&xwindow->priv->geometry, &geom, NULL)
+        && g_list_find(xwindow->priv->monitors, monitor) == NULL)
+    {
+        xwindow->priv->monitors = g_list_prepend(xwindow->priv->monitors, monitor);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
     }
-    g_object_notify(G_OBJECT(window), "class-ids");
-    g_signal_emit_by_name(window, "class-changed");
+}
+
+static void
+xfw_window_x11_monitor_removed(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowX11 *xwindow = XFW_WINDOW_X11(window);
+    GList *lp = g_list_find(xwindow->priv->monitors, monitor);
+    if (lp != NULL) {
+        xwindow->priv->monitors = g_list_delete_link(xwindow->priv->monitors, lp);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_MONITORS);
+    }
+}
+
+// Sends an EWMH client message about @window to the root window.  libwnck
+// does the same, but waits for the X server to process each request, which
+// adds up when acting on many windows at once.
+static void
+send_wm_message(XfwWindowX11 *window, const gchar *message_type, glong l0, glong l1, glong l2, glong l3) {
+    GdkScreen *gdk_screen = _xfw_screen_get_gdk_screen(_xfw_window_get_screen(XFW_WINDOW(window)));
+    GdkDisplay *display = gdk_screen_get_display(gdk_screen);
+    Display *dpy = gdk_x11_display_get_xdisplay(display);
+    XEvent xev = { 0 };
+
+    xev.xclient.type = ClientMessage;
+    xev.xclient.send_event = True;
+    xev.xclient.display = dpy;
+    xev.xclient.window = wnck_window_get_xid(window->priv->wnck_window);
+    xev.xclient.message_type = gdk_x11_get_xatom_by_name_for_display(display, message_type);
+    xev.xclient.format = 32;
+    xev.xclient.data.l[0] = l0;
+    xev.xclient.data.l[1] = l1;
+    xev.xclient.data.l[2] = l2;
+    xev.xclient.data.l[3] = l3;
+
+    gdk_x11_display_error_trap_push(display);
+    XSendEvent(dpy,
+               RootWindow(dpy, gdk_x11_screen_get_screen_number(gdk_screen)),
+               False,
+               SubstructureRedirectMask | SubstructureNotifyMask,
+               &xev);
+    gdk_x11_display_error_trap_pop_ignored(display);
+}
+
+static gboolean
+xfw_window_x11_queue_action(XfwWindow *window, const XfwWindowAction *action, GError **error) {
+    XfwWindowX11 *xwindow = XFW_WINDOW_X11(window);
+    GdkDisplay *display = gdk_screen_get_display(_xfw_screen_get_gdk_screen(_xfw_window_get_screen(window)));
+    // Source indication: a pager or similar acting on the user's behalf
+    const glong source = 2;
+
+    switch (action->type) {
+        case WINDOW_ACTION_CLOSE:
+            send_wm_message(xwindow, "_NET_CLOSE_WINDOW", (guint32)action->event_timestamp, source, 0, 0);
+            return TRUE;
+
+        case WINDOW_ACTION_MOVE_TO_WORKSPACE: {
+            WnckWorkspace *wnck_workspace = _xfw_workspace_x11_get_wnck_workspace(XFW_WORKSPACE_X11(action->workspace));
+            send_wm_message(xwindow, "_NET_WM_DESKTOP", wnck_workspace_get_number(wnck_workspace), source, 0, 0);
+            return TRUE;
+        }
+
+        case WINDOW_ACTION_SET_MINIMIZED:
+            if (action->enable) {
+                send_wm_message(xwindow, "WM_CHANGE_STATE", IconicState, 0, 0, 0);
+            } else {
+                // Like wnck_window_unminimize(), unminimize by activating
+                send_wm_message(xwindow, "_NET_ACTIVE_WINDOW", source, (guint32)action->event_timestamp, 0, 0);
+            }
+            return TRUE;
+
+        case WINDOW_ACTION_SET_MAXIMIZED:
+            send_wm_message(xwindow,
+                            "_NET_WM_STATE",
+                            action->enable ? 1 : 0,
+                            gdk_x11_get_xatom_by_name_for_display(display, "_NET_WM_STATE_MAXIMIZED_VERT"),
+                            gdk_x11_get_xatom_by_name_for_display(display, "_NET_WM_STATE_MAXIMIZED_HORZ"),
+                            source);
+            return TRUE;
+
+        case WINDOW_ACTION_SET_PINNED:
+            if ((xwindow->priv->capabilities & XFW_WINDOW_CAPABILITIES_CAN_CHANGE_WORKSPACE) == 0) {
+                g_set_error_literal(error,
+                                    XFW_ERROR,
+                                    XFW_ERROR_UNSUPPORTED,
+                                    action->enable
+                                        ? "This window does not currently support being pinned"
+                                        : "This window does not currently support being unpinned");
+                return FALSE;
+            } else if (action->enable) {
+                send_wm_message(xwindow, "_NET_WM_DESKTOP", 0xFFFFFFFF, source, 0, 0);
+                return TRUE;
+            } else {
+                // Like wnck_window_unpin(), unpin onto the active workspace
+                WnckScreen *wnck_screen = wnck_window_get_screen(xwindow->priv->wnck_window);
+                WnckWorkspace *active = wnck_screen_get_active_workspace(wnck_screen);
+                send_wm_message(xwindow, "_NET_WM_DESKTOP", active != NULL ? wnck_workspace_get_number(active) : 0, source, 0, 0);
+                return TRUE;
+            }
+    }
+
+    g_return_val_if_reached(FALSE);
+}
+
+static void
+class_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
+    if (!set_class_ids(window)) {
+        return;
+    }
+    _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_CLASS_IDS);
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CLASS_CHANGED], 0);
 }
 
 static void
 name_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
-    g_object_notify(G_OBJECT(window), "name");
-    g_signal_emit_by_name(window, "name-changed");
+    _xfw_window_name_changed(XFW_WINDOW(window));
 }
 
 static void
 icon_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
     _xfw_window_invalidate_icon(XFW_WINDOW(window));
-    g_signal_emit_by_name(window, "icon-changed");
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_ICON_CHANGED], 0);
 }
 
 static void
 app_name_changed(XfwApplication *app, GParamSpec *pspec, XfwWindowX11 *window) {
     _xfw_window_invalidate_icon(XFW_WINDOW(window));
-    g_signal_emit_by_name(window, "icon-changed");
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_ICON_CHANGED], 0);
 }
 
 static void
 type_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
     XfwWindowType old_type = window->priv->window_type;
     window->priv->window_type = convert_type(wnck_window_get_window_type(window->priv->wnck_window));
-    g_object_notify(G_OBJECT(window), "type");
-    g_signal_emit_by_name(window, "type-changed", old_type);
+    _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_TYPE);
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_TYPE_CHANGED], 0, old_type);
 }
 
 static void
@@ -633,8 +760,8 @@ state_changed(WnckWindow *wnck_window, WnckWindowState wnck_changed_mask, WnckWi
 
     if (changed_mask != XFW_WINDOW_STATE_NONE) {
         window->priv->state = new_state;
-        g_object_notify(G_OBJECT(window), "state");
-        g_signal_emit_by_name(window, "state-changed", changed_mask, new_state);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_STATE);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_STATE_CHANGED], 0, changed_mask, new_state);
     }
 
     // Not all capability changes are reported by WnckWindow::actions-changed (e.g. shade/unshade) so we need to add this update
@@ -649,63 +776,21 @@ actions_changed(WnckWindow *wnck_window, WnckWindowActions wnck_changed_mask, Wn
 
     if (changed_mask != XFW_WINDOW_CAPABILITIES_NONE) {
         window->priv->capabilities = new_capabilities;
-        g_object_notify(G_OBJECT(window), "capabilities");
-        g_signal_emit_by_name(window, "capabilities-changed", changed_mask, new_capabilities);
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_CAPABILITIES);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_CAPABILITIES_CHANGED], 0, changed_mask, new_capabilities);
     }
 }
 
 static void
 geometry_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
-    gboolean notify = FALSE;
-
     wnck_window_get_geometry(wnck_window,
                              &window->priv->geometry.x, &window->priv->geometry.y,
                              &window->priv->geometry.width, &window->priv->geometry.height);
-    g_signal_emit_by_name(window, "geometry-changed");
-
-    for (GList *lp = window->priv->monitors; lp != NULL;) {
-        GList *lnext = lp->next;
-        GdkRectangle geom;
-        xfw_monitor_get_physical_geometry(XFW_MONITOR(lp->data), &geom);
-        if (!gdk_rectangle_intersect(&window->priv->geometry, &geom, NULL)) {
-            window->priv->monitors = g_list_delete_link(window->priv->monitors, lp);
-            notify = TRUE;
-        }
-        lp = lnext;
-    }
-
-    for (GList *l = xfw_screen_get_monitors(_xfw_window_get_screen(XFW_WINDOW(window))); l != NULL; l = l->next) {
-        XfwMonitor *monitor = XFW_MONITOR(l->data);
-        GdkRectangle geom;
-        xfw_monitor_get_physical_geometry(monitor, &geom);
-        if (gdk_rectangle_intersect(&window->priv->geometry, &geom, NULL) && !g_list_find(window->priv->monitors, monitor)) {
-            window->priv->monitors = g_list_prepend(window->priv->monitors, monitor);
-            notify = TRUE;
-        }
-    }
-
-    if (notify) {
-        g_object_notify(G_OBJECT(window), "monitors");
-    }
-}
-
-static void
-monitor_added(XfwScreen *screen, XfwMonitor *monitor, XfwWindowX11 *window) {
-    geometry_changed(window->priv->wnck_window, window);
-}
-
-static void
-monitor_removed(XfwScreen *screen, XfwMonitor *monitor, XfwWindowX11 *window) {
-    g_object_freeze_notify(G_OBJECT(window));
-
-    GList *lp = g_list_find(window->priv->monitors, monitor);
-    if (lp != NULL) {
-        window->priv->monitors = g_list_delete_link(window->priv->monitors, lp);
-        g_object_notify(G_OBJECT(window), "monitors");
-    }
-    geometry_changed(window->priv->wnck_window, window);
-
-    g_object_thaw_notify(G_OBJECT(window));
+    _xfw_screen_x11_window_geometry_changed(XFW_SCREEN_X11(_xfw_window_get_screen(XFW_WINDOW(window))),
+                                            XFW_WINDOW(window),
+                                            &window->priv->geometry);
+    // Possibly throttled; the monitors are updated when the signal is emitted
+    _xfw_window_geometry_changed(XFW_WINDOW(window));
 }
 
 static void
@@ -726,14 +811,41 @@ workspace_changed(WnckWindow *wnck_window, XfwWindowX11 *window) {
     state_changed(wnck_window, 0, wnck_window_get_state(wnck_window), window);
 
     if (old_workspace != new_workspace) {
-        g_object_notify(G_OBJECT(window), "workspace");
-        g_signal_emit_by_name(window, "workspace-changed");
+        _xfw_window_notify(XFW_WINDOW(window), WINDOW_PROP_WORKSPACE);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_WORKSPACE_CHANGED], 0);
         if (old_workspace != NULL) {
             g_object_unref(old_workspace);
         }
     }
 }
 
+// Copies the window's class and instance names from libwnck (which frees its
+// own copies when they change), and returns whether they differ from before
+static gboolean
+set_class_ids(XfwWindowX11 *window) {
+    const gchar *class_name = wnck_window_get_class_group_name(window->priv->wnck_window);
+    const gchar *instance_name = wnck_window_get_class_instance_name(window->priv->wnck_window);
+    const gchar *new_class_ids[2];
+    if (class_name != NULL && *class_name != '\0') {
+        new_class_ids[0] = class_name;
+        new_class_ids[1] = instance_name;
+    } else {
+        new_class_ids[0] = instance_name;
+        new_class_ids[1] = NULL;
+    }
+
+    if (g_strcmp0(new_class_ids[0], window->priv->class_ids[0]) == 0
+        && g_strcmp0(new_class_ids[1], window->priv->class_ids[1]) == 0)
+    {
+        return FALSE;
+    }
+    for (gsize i = 0; i < G_N_ELEMENTS(new_class_ids); ++i) {
+        g_free(window->priv->class_ids[i]);
+        window->priv->class_ids[i] = g_strdup(new_class_ids[i]);
+    }
+    return TRUE;
+}
+
 static XfwWindowType
 convert_type(WnckWindowType wnck_type) {
     switch (wnck_type) {
@@ -47,34 +47,33 @@
 #include <stdint.h>
 
 #include "libxfce4windowing-private.h"
+#include "xfw-icon-cache.h"
 #include "xfw-marshal.h"
-#include "xfw-screen.h"
+#include "xfw-screen-private.h"
 #include "xfw-window-private.h"
 #include "libxfce4windowing-visibility.h"
 
 #define XFW_WINDOW_GET_PRIVATE(window) ((XfwWindowPrivate *)xfw_window_get_instance_private(window))
 
-enum {
-    PROP_0,
-    PROP_SCREEN,
-    PROP_CLASS_IDS,
-    PROP_NAME,
-    PROP_TYPE,
-    PROP_STATE,
-    PROP_CAPABILITIES,
-    PROP_WORKSPACE,
-    PROP_MONITORS,
-    PROP_APPLICATION,
-    PROP_GICON,
-};
+// How long a window's geometry has to stay put before it's considered settled
+#define GEOMETRY_SETTLE_DELAY_MS 150
 
 typedef struct _XfwWindowPrivate {
     XfwScreen *screen;
     GIcon *gicon;
 
-    GdkPixbuf *icon;
-    gint icon_size;
-    gint icon_scale;
+    // Rendered icons, by (size, scale)
+    XfwIconCache *icon_cache;
+
+    // Geometry change throttling; see _xfw_window_geometry_changed()
+    guint geometry_throttle_id;
+    guint geometry_settle_id;
+    gint64 last_geometry_change;
+    guint geometry_pending : 1;
+
+    // Name change throttling; see _xfw_window_name_changed()
+    guint name_throttle_id;
+    guint name_pending : 1;
 } XfwWindowPrivate;
 
 static void xfw_window_set_property(GObject *object,
@@ -85,11 +84,22 @@ static void xfw_window_get_property(GObject *object,
                                     guint prop_id,
                                     GValue *value,
                                     GParamSpec *pspec);
+static void xfw_window_dispatch_properties_changed(GObject *object,
+                                                  guint n_pspecs,
+                                                  GParamSpec **pspecs);
 static void xfw_window_finalize(GObject *object);
 
+static gboolean window_changed_hook(GSignalInvocationHint *ihint,
+                                    guint n_param_values,
+                                    const GValue *param_values,
+                                    gpointer data);
+
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE(XfwWindow, xfw_window, G_TYPE_OBJECT)
 
+guint _xfw_window_signals[N_WINDOW_SIGNALS] = { 0 };
+static GParamSpec *window_properties[N_WINDOW_PROPERTIES] = { NULL };
+
 G_DEFINE_FLAGS_TYPE(
     XfwWindowState, xfw_window_state,
     G_DEFINE_ENUM_VALUE(XFW_WINDOW_STATE_NONE, "none"),
@@ -124,6 +134,24 @@ G_DEFINE_FLAGS_TYPE(
     G_DEFINE_ENUM_VALUE(XFW_WINDOW_CAPABILITIES_CAN_UNPLACE_BELOW, "can-unplace-below"),
     G_DEFINE_ENUM_VALUE(XFW_WINDOW_CAPABILITIES_CAN_CHANGE_WORKSPACE, "can-change-workspace"))
 
+G_DEFINE_FLAGS_TYPE(
+    XfwWindowChangeFlags, xfw_window_change_flags,
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_NONE, "none"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_OPENED, "opened"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_CLOSED, "closed"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_CLASS, "class"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_NAME, "name"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_ICON, "icon"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_TYPE, "type"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_STATE, "state"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_CAPABILITIES, "capabilities"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_GEOMETRY, "geometry"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_WORKSPACE, "workspace"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_MONITORS, "monitors"),
+    G_DEFINE_ENUM_VALUE(XFW_WINDOW_CHANGE_APPLICATION, "application"))
+
+G_DEFINE_BOXED_TYPE(XfwWindowChange, xfw_window_change, _xfw_window_change_copy, _xfw_window_change_free)
+
 G_DEFINE_ENUM_TYPE(
     XfwWindowType, xfw_window_type,
     G_DEFINE_ENUM_VALUE(XFW_WINDOW_TYPE_NORMAL, "normal"),
@@ -142,6 +170,7 @@ xfw_window_class_init(XfwWindowClass *klass) {
 
     gobject_class->set_property = xfw_window_set_property;
     gobject_class->get_property = xfw_window_get_property;
+    gobject_class->dispatch_properties_changed = xfw_window_dispatch_properties_changed;
     gobject_class->finalize = xfw_window_finalize;
 
     /**
@@ -152,27 +181,30 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Since: 4.19.3
      **/
-    g_signal_new("class-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, class_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_CLASS_CHANGED] = g_signal_new("class-changed",
+                                                                    XFW_TYPE_WINDOW,
+                                                                    G_SIGNAL_RUN_LAST,
+                                                                    G_STRUCT_OFFSET(XfwWindowClass, class_changed),
+                                                                    NULL, NULL,
+                                                                    g_cclosure_marshal_VOID__VOID,
+                                                                    G_TYPE_NONE, 0);
 
     /**
      * XfwWindow::name-changed:
      * @window: the object which received the signal.
      *
      * Emitted when @window's name/title changes.
+     *
+     * Some applications change their title many times per second.  See
+     * #XfwScreen:name-throttle-interval to limit the rate.
      **/
-    g_signal_new("name-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, name_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_NAME_CHANGED] = g_signal_new("name-changed",
+                                                                   XFW_TYPE_WINDOW,
+                                                                   G_SIGNAL_RUN_LAST,
+                                                                   G_STRUCT_OFFSET(XfwWindowClass, name_changed),
+                                                                   NULL, NULL,
+                                                                   g_cclosure_marshal_VOID__VOID,
+                                                                   G_TYPE_NONE, 0);
 
     /**
      * XfwWindow::icon-changed:
@@ -180,13 +212,13 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window's icon changes.
      **/
-    g_signal_new("icon-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, icon_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_ICON_CHANGED] = g_signal_new("icon-changed",
+                                                                   XFW_TYPE_WINDOW,
+                                                                   G_SIGNAL_RUN_LAST,
+                                                                   G_STRUCT_OFFSET(XfwWindowClass, icon_changed),
+                                                                   NULL, NULL,
+                                                                   g_cclosure_marshal_VOID__VOID,
+                                                                   G_TYPE_NONE, 0);
 
     /**
      * XfwWindow::type-changed:
@@ -195,14 +227,14 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window's type changes.
      **/
-    g_signal_new("type-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, type_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__ENUM,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WINDOW_TYPE);
+    _xfw_window_signals[WINDOW_SIGNAL_TYPE_CHANGED] = g_signal_new("type-changed",
+                                                                   XFW_TYPE_WINDOW,
+                                                                   G_SIGNAL_RUN_LAST,
+                                                                   G_STRUCT_OFFSET(XfwWindowClass, type_changed),
+                                                                   NULL, NULL,
+                                                                   g_cclosure_marshal_VOID__ENUM,
+                                                                   G_TYPE_NONE, 1,
+                                                                   XFW_TYPE_WINDOW_TYPE);
 
     /**
      * XfwWindow::state-changed:
@@ -212,15 +244,15 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window's state changes.
      **/
-    g_signal_new("state-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, state_changed),
-                 NULL, NULL,
-                 xfw_marshal_VOID__FLAGS_FLAGS,
-                 G_TYPE_NONE, 2,
-                 XFW_TYPE_WINDOW_STATE,
-                 XFW_TYPE_WINDOW_STATE);
+    _xfw_window_signals[WINDOW_SIGNAL_STATE_CHANGED] = g_signal_new("state-changed",
+                                                                    XFW_TYPE_WINDOW,
+                                                                    G_SIGNAL_RUN_LAST,
+                                                                    G_STRUCT_OFFSET(XfwWindowClass, state_changed),
+                                                                    NULL, NULL,
+                                                                    xfw_marshal_VOID__FLAGS_FLAGS,
+                                                                    G_TYPE_NONE, 2,
+                                                                    XFW_TYPE_WINDOW_STATE,
+                                                                    XFW_TYPE_WINDOW_STATE);
 
     /**
      * XfwWindow::capabilities-changed:
@@ -230,29 +262,52 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window's capabilities change.
      **/
-    g_signal_new("capabilities-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, capabilities_changed),
-                 NULL, NULL,
-                 xfw_marshal_VOID__FLAGS_FLAGS,
-                 G_TYPE_NONE, 2,
-                 XFW_TYPE_WINDOW_CAPABILITIES,
-                 XFW_TYPE_WINDOW_CAPABILITIES);
+    _xfw_window_signals[WINDOW_SIGNAL_CAPABILITIES_CHANGED] = g_signal_new("capabilities-changed",
+                                                                           XFW_TYPE_WINDOW,
+                                                                           G_SIGNAL_RUN_LAST,
+                                                                           G_STRUCT_OFFSET(XfwWindowClass, capabilities_changed),
+                                                                           NULL, NULL,
+                                                                           xfw_marshal_VOID__FLAGS_FLAGS,
+                                                                           G_TYPE_NONE, 2,
+                                                                           XFW_TYPE_WINDOW_CAPABILITIES,
+                                                                           XFW_TYPE_WINDOW_CAPABILITIES);
 
     /**
      * XfwWindow::geometry-changed:
      * @window: the object which received the signal.
      *
      * Emitted when @window's position or size changes.
+     *
+     * While a window is being moved or resized interactively, this can be
+     * emitted hundreds of times per second.  See
+     * #XfwScreen:geometry-throttle-interval to limit the rate, and
+     * #XfwWindow::geometry-settled to only be told about the final geometry.
      **/
-    g_signal_new("geometry-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, geometry_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_CHANGED] = g_signal_new("geometry-changed",
+                                                                       XFW_TYPE_WINDOW,
+                                                                       G_SIGNAL_RUN_LAST,
+                                                                       G_STRUCT_OFFSET(XfwWindowClass, geometry_changed),
+                                                                       NULL, NULL,
+                                                                       g_cclosure_marshal_VOID__VOID,
+                                                                       G_TYPE_NONE, 0);
+
+    /**
+     * XfwWindow::geometry-settled:
+     * @window: the object which received the signal.
+     *
+     * Emitted once after a series of changes to @window's position or size
+     * (such as an interactive move or resize) has come to an end, after the
+     * last #XfwWindow::geometry-changed of the series.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_SETTLED] = g_signal_new("geometry-settled",
+                                                                       XFW_TYPE_WINDOW,
+                                                                       G_SIGNAL_RUN_LAST,
+                                                                       0,
+                                                                       NULL, NULL,
+                                                                       g_cclosure_marshal_VOID__VOID,
+                                                                       G_TYPE_NONE, 0);
 
     /**
      * XfwWindow::workspace-changed:
@@ -260,13 +315,13 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window is moved to a different worksapce.
      **/
-    g_signal_new("workspace-changed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, state_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_WORKSPACE_CHANGED] = g_signal_new("workspace-changed",
+                                                                        XFW_TYPE_WINDOW,
+                                                                        G_SIGNAL_RUN_LAST,
+                                                                        G_STRUCT_OFFSET(XfwWindowClass, state_changed),
+                                                                        NULL, NULL,
+                                                                        g_cclosure_marshal_VOID__VOID,
+                                                                        G_TYPE_NONE, 0);
 
     /**
      * XfwWindow::closed:
@@ -274,26 +329,24 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Emitted when @window is closed.
      **/
-    g_signal_new("closed",
-                 XFW_TYPE_WINDOW,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWindowClass, closed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_window_signals[WINDOW_SIGNAL_CLOSED] = g_signal_new("closed",
+                                                             XFW_TYPE_WINDOW,
+                                                             G_SIGNAL_RUN_LAST,
+                                                             G_STRUCT_OFFSET(XfwWindowClass, closed),
+                                                             NULL, NULL,
+                                                             g_cclosure_marshal_VOID__VOID,
+                                                             G_TYPE_NONE, 0);
 
     /**
      * XfwWindow:screen:
      *
      * The #XfwScreen instances that owns this window.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_SCREEN,
-                                    g_param_spec_object("screen",
-                                                        "screen",
-                                                        "screen",
-                                                        XFW_TYPE_SCREEN,
-                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_SCREEN] = g_param_spec_object("screen",
+                                                                "screen",
+                                                                "screen",
+                                                                XFW_TYPE_SCREEN,
+                                                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:class-ids:
@@ -302,68 +355,58 @@ xfw_window_class_init(XfwWindowClass *klass) {
      *
      * Since: 4.19.3
      */
-    g_object_class_install_property(gobject_class,
-                                    PROP_CLASS_IDS,
-                                    g_param_spec_boxed("class-ids",
-                                                       "class-ids",
-                                                       "class-ids",
-                                                       G_TYPE_STRV,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_CLASS_IDS] = g_param_spec_boxed("class-ids",
+                                                                  "class-ids",
+                                                                  "class-ids",
+                                                                  G_TYPE_STRV,
+                                                                  G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:name:
      *
      * The window's name or title.
      */
-    g_object_class_install_property(gobject_class,
-                                    PROP_NAME,
-                                    g_param_spec_string("name",
-                                                        "name",
-                                                        "name",
-                                                        "",
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_NAME] = g_param_spec_string("name",
+                                                              "name",
+                                                              "name",
+                                                              "",
+                                                              G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:type
      *
      * The window's type or function.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_TYPE,
-                                    g_param_spec_enum("type",
-                                                      "type",
-                                                      "type",
-                                                      XFW_TYPE_WINDOW_TYPE,
-                                                      XFW_WINDOW_TYPE_NORMAL,
-                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_TYPE] = g_param_spec_enum("type",
+                                                            "type",
+                                                            "type",
+                                                            XFW_TYPE_WINDOW_TYPE,
+                                                            XFW_WINDOW_TYPE_NORMAL,
+                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:state:
      *
      * The window's state bitfield.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_STATE,
-                                    g_param_spec_flags("state",
-                                                       "state",
-                                                       "state",
-                                                       XFW_TYPE_WINDOW_STATE,
-                                                       XFW_WINDOW_STATE_NONE,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_STATE] = g_param_spec_flags("state",
+                                                              "state",
+                                                              "state",
+                                                              XFW_TYPE_WINDOW_STATE,
+                                                              XFW_WINDOW_STATE_NONE,
+                                                              G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:capabilities:
      *
      * The window's capabilities bitfield.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_CAPABILITIES,
-                                    g_param_spec_flags("capabilities",
-                                                       "capabilities",
-                                                       "capabilities",
-                                                       XFW_TYPE_WINDOW_CAPABILITIES,
-                                                       XFW_WINDOW_CAPABILITIES_NONE,
-                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_CAPABILITIES] = g_param_spec_flags("capabilities",
+                                                                     "capabilities",
+                                                                     "capabilities",
+                                                                     XFW_TYPE_WINDOW_CAPABILITIES,
+                                                                     XFW_WINDOW_CAPABILITIES_NONE,
+                                                                     G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:wokspace:
@@ -371,55 +414,75 @@ xfw_window_class_init(XfwWindowClass *klass) {
      * The workspace the window is shown on.  May be %NULL if the window is not
      * on a workspace, or is pinned to all workspaces.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_WORKSPACE,
-                                    g_param_spec_object("workspace",
-                                                        "workspace",
-                                                        "workspace",
-                                                        XFW_TYPE_WORKSPACE,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_WORKSPACE] = g_param_spec_object("workspace",
+                                                                   "workspace",
+                                                                   "workspace",
+                                                                   XFW_TYPE_WORKSPACE,
+                                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:monitors: (type GList(XfwMonitor))
      *
      * The list of #XfwMonitor<!-- -->s (if any) that the window is displayed on.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_MONITORS,
-                                    g_param_spec_pointer("monitors",
-                                                         "monitors",
-                                                         "monitors",
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_MONITORS] = g_param_spec_pointer("monitors",
+                                                                   "monitors",
+                                                                   "monitors",
+                                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:application:
      *
      * The #XfwApplication that owns this window.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_APPLICATION,
-                                    g_param_spec_object("application",
-                                                        "application",
-                                                        "application",
-                                                        XFW_TYPE_APPLICATION,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_APPLICATION] = g_param_spec_object("application",
+                                                                     "application",
+                                                                     "application",
+                                                                     XFW_TYPE_APPLICATION,
+                                                                     G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
     /**
      * XfwWindow:gicon:
      *
      * The #GIcon that represents this window.
      **/
-    g_object_class_install_property(gobject_class,
-                                    PROP_GICON,
-                                    g_param_spec_object("gicon",
-                                                        "gicon",
-                                                        "gicon",
-                                                        G_TYPE_ICON,
-                                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    window_properties[WINDOW_PROP_GICON] = g_param_spec_object("gicon",
+                                                               "gicon",
+                                                               "gicon",
+                                                               G_TYPE_ICON,
+                                                               G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(gobject_class, N_WINDOW_PROPERTIES, window_properties);
+
+    // Feeds XfwScreen::changes-committed.  Emission hooks run for every
+    // window, so there's no need to connect to each one separately.
+    static const struct {
+        guint signal;
+        XfwWindowChangeFlags change;
+    } change_signals[] = {
+        { WINDOW_SIGNAL_CLASS_CHANGED, XFW_WINDOW_CHANGE_CLASS },
+        { WINDOW_SIGNAL_NAME_CHANGED, XFW_WINDOW_CHANGE_NAME },
+        { WINDOW_SIGNAL_ICON_CHANGED, XFW_WINDOW_CHANGE_ICON },
+        { WINDOW_SIGNAL_TYPE_CHANGED, XFW_WINDOW_CHANGE_TYPE },
+        { WINDOW_SIGNAL_STATE_CHANGED, XFW_WINDOW_CHANGE_STATE },
+        { WINDOW_SIGNAL_CAPABILITIES_CHANGED, XFW_WINDOW_CHANGE_CAPABILITIES },
+        { WINDOW_SIGNAL_GEOMETRY_CHANGED, XFW_WINDOW_CHANGE_GEOMETRY },
+        { WINDOW_SIGNAL_WORKSPACE_CHANGED, XFW_WINDOW_CHANGE_WORKSPACE },
+    };
+    for (gsize i = 0; i < G_N_ELEMENTS(change_signals); ++i) {
+        g_signal_add_emission_hook(_xfw_window_signals[change_signals[i].signal],
+                                   0,
+                                   window_changed_hook,
+                                   GUINT_TO_POINTER(change_signals[i].change),
+                                   NULL);
+    }
 }
 
 static void
-xfw_window_init(XfwWindow *window) {}
+xfw_window_init(XfwWindow *window) {
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+    priv->icon_cache = _xfw_icon_cache_new();
+}
 
 static void
 xfw_window_set_property(GObject *object,
@@ -429,7 +492,7 @@ xfw_window_set_property(GObject *object,
     XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(XFW_WINDOW(object));
 
     switch (prop_id) {
-        case PROP_SCREEN:
+        case WINDOW_PROP_SCREEN:
             priv->screen = g_value_get_object(value);
             break;
 
@@ -448,43 +511,43 @@ xfw_window_get_property(GObject *object,
     XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
 
     switch (prop_id) {
-        case PROP_SCREEN:
+        case WINDOW_PROP_SCREEN:
             g_value_set_object(value, priv->screen);
             break;
 
-        case PROP_CLASS_IDS:
+        case WINDOW_PROP_CLASS_IDS:
             g_value_set_boxed(value, xfw_window_get_class_ids(window));
             break;
 
-        case PROP_NAME:
+        case WINDOW_PROP_NAME:
             g_value_set_string(value, xfw_window_get_name(window));
             break;
 
-        case PROP_TYPE:
+        case WINDOW_PROP_TYPE:
             g_value_set_enum(value, xfw_window_get_window_type(window));
             break;
 
-        case PROP_STATE:
+        case WINDOW_PROP_STATE:
             g_value_set_flags(value, xfw_window_get_state(window));
             break;
 
-        case PROP_CAPABILITIES:
+        case WINDOW_PROP_CAPABILITIES:
             g_value_set_flags(value, xfw_window_get_capabilities(window));
             break;
 
-        case PROP_WORKSPACE:
+        case WINDOW_PROP_WORKSPACE:
             g_value_set_object(value, xfw_window_get_workspace(window));
             break;
 
-        case PROP_MONITORS:
+        case WINDOW_PROP_MONITORS:
             g_value_set_pointer(value, xfw_window_get_monitors(window));
             break;
 
-        case PROP_APPLICATION:
+        case WINDOW_PROP_APPLICATION:
             g_value_set_object(value, xfw_window_get_application(window));
             break;
 
-        case PROP_GICON:
+        case WINDOW_PROP_GICON:
             g_value_set_object(value, priv->gicon);
             break;
 
@@ -494,12 +557,47 @@ xfw_window_get_property(GObject *object,
     }
 }
 
+static void
+xfw_window_dispatch_properties_changed(GObject *object, guint n_pspecs, GParamSpec **pspecs) {
+    XfwWindow *window = XFW_WINDOW(object);
+    XfwScreen *screen = XFW_WINDOW_GET_PRIVATE(window)->screen;
+
+    if (screen != NULL) {
+        // Monitors and application have no signal of their own, only a notify
+        XfwWindowChangeFlags changes = XFW_WINDOW_CHANGE_NONE;
+        for (guint i = 0; i < n_pspecs; ++i) {
+            if (pspecs[i]->owner_type == XFW_TYPE_WINDOW) {
+                if (pspecs[i]->param_id == WINDOW_PROP_MONITORS) {
+                    changes |= XFW_WINDOW_CHANGE_MONITORS;
+                } else if (pspecs[i]->param_id == WINDOW_PROP_APPLICATION) {
+                    changes |= XFW_WINDOW_CHANGE_APPLICATION;
+                }
+            }
+        }
+        if (changes != XFW_WINDOW_CHANGE_NONE) {
+            _xfw_screen_window_changed(screen, window, changes);
+        }
+    }
+
+    G_OBJECT_CLASS(xfw_window_parent_class)->dispatch_properties_changed(object, n_pspecs, pspecs);
+}
+
 static void
 xfw_window_finalize(GObject *object) {
     XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(XFW_WINDOW(object));
 
+    if (priv->geometry_throttle_id != 0) {
+        g_source_remove(priv->geometry_throttle_id);
+    }
+    if (priv->geometry_settle_id != 0) {
+        g_source_remove(priv->geometry_settle_id);
+    }
+    if (priv->name_throttle_id != 0) {
+        g_source_remove(priv->name_throttle_id);
+    }
+
     g_clear_object(&priv->gicon);
-    g_clear_object(&priv->icon);
+    _xfw_icon_cache_free(priv->icon_cache);
 
     G_OBJECT_CLASS(xfw_window_parent_class)->finalize(object);
 }
@@ -553,6 +651,10 @@ xfw_window_get_name(XfwWindow *window) {
  * returned.  Whether or not the returned icon is a fallback icon can be
  * determined using #xfw_window_icon_is_fallback().
  *
+ * Windows and applications with identical icons may share the same
+ * #GdkPixbuf, so the returned pixbuf must be treated as read-only.  To draw
+ * on it or change its pixels, make a copy with gdk_pixbuf_copy() first.
+ *
  * Return value: (nullable) (transfer none): a #GdkPixbuf, owned by @window,
  * or %NULL if @window has no icon and a fallback cannot be rendered.
  **/
@@ -563,22 +665,42 @@ xfw_window_get_icon(XfwWindow *window, gint size, gint scale) {
     g_return_val_if_fail(XFW_IS_WINDOW(window), NULL);
 
     priv = XFW_WINDOW_GET_PRIVATE(window);
-    if (priv->icon == NULL || priv->icon_size != size || priv->icon_scale != scale) {
-        GIcon *gicon;
+    return _xfw_icon_cache_get_pixbuf(priv->icon_cache, xfw_window_get_gicon(window), size, scale);
+}
 
-        if (priv->icon != NULL) {
-            g_object_unref(priv->icon);
-        }
-        gicon = xfw_window_get_gicon(window);
-        priv->icon = _xfw_gicon_load(gicon, size, scale);
+/**
+ * xfw_window_get_icon_surface:
+ * @window: an #XfwWindow.
+ * @size: the desired icon size.
+ * @scale: the UI scale factor.
+ *
+ * Fetches @window's icon as a #cairo_surface_t, suitable for painting directly
+ * with cairo.  The returned surface fits in a @size by @size box, and its
+ * device scale is set to @scale.
+ *
+ * This is cheaper than #xfw_window_get_icon() when the icon comes from the
+ * windowing system as raw pixel data, as that data is handed out without
+ * being converted to an image file and decoded again.
+ *
+ * If @window has no icon, a fallback icon may be returned.  Whether or not the
+ * returned icon is a fallback icon can be determined using
+ * #xfw_window_icon_is_fallback().
+ *
+ * Return value: (nullable) (transfer none): a #cairo_surface_t, owned by
+ * @window, or %NULL if @window has no icon and a fallback cannot be rendered.
+ *
+ * Since: 4.21.0
+ **/
+cairo_surface_t *
+xfw_window_get_icon_surface(XfwWindow *window, gint size, gint scale) {
+    XfwWindowPrivate *priv;
 
-        if (priv->icon != NULL) {
-            priv->icon_size = size;
-            priv->icon_scale = scale;
-        }
-    }
+    g_return_val_if_fail(XFW_IS_WINDOW(window), NULL);
+    g_return_val_if_fail(size > 0, NULL);
+    g_return_val_if_fail(scale > 0, NULL);
 
-    return priv->icon;
+    priv = XFW_WINDOW_GET_PRIVATE(window);
+    return _xfw_icon_cache_get_surface(priv->icon_cache, xfw_window_get_gicon(window), size, scale);
 }
 
 /**
@@ -714,6 +836,38 @@ xfw_window_get_screen(XfwWindow *window) {
     return XFW_WINDOW_GET_PRIVATE(window)->screen;
 }
 
+/**
+ * xfw_window_get_stacking_index:
+ * @window: an #XfwWindow.
+ *
+ * Fetches @window's position in the stacking order of its screen, where `0`
+ * is the bottom-most window.  This is the same as @window's position in the
+ * list returned by #xfw_screen_get_windows_stacked(), but does not require
+ * walking the list.
+ *
+ * Note that Wayland does not support discovering window stacking, so this
+ * always returns `-1` there.
+ *
+ * Return value: the stacking index of @window, or `-1` if it is unknown.
+ *
+ * Since: 4.21.0
+ **/
+gint
+xfw_window_get_stacking_index(XfwWindow *window) {
+    XfwScreen *screen;
+    XfwScreenClass *klass;
+
+    g_return_val_if_fail(XFW_IS_WINDOW(window), -1);
+
+    screen = XFW_WINDOW_GET_PRIVATE(window)->screen;
+    klass = XFW_SCREEN_GET_CLASS(screen);
+    if (klass->get_stacking_index != NULL) {
+        return klass->get_stacking_index(screen, window);
+    } else {
+        return -1;
+    }
+}
+
 /**
  * xfw_window_get_workspace:
  * @window: an #XfwWindow.
@@ -888,14 +1042,176 @@ _xfw_window_get_screen(XfwWindow *window) {
     return XFW_WINDOW_GET_PRIVATE(window)->screen;
 }
 
+void
+_xfw_window_notify(XfwWindow *window, guint prop_id) {
+    g_object_notify_by_pspec(G_OBJECT(window), window_properties[prop_id]);
+}
+
+XfwWindowChange *
+_xfw_window_change_copy(XfwWindowChange *change) {
+    XfwWindowChange *copy = g_new(XfwWindowChange, 1);
+    copy->window = g_object_ref(change->window);
+    copy->changes = change->changes;
+    return copy;
+}
+
+void
+_xfw_window_change_free(XfwWindowChange *change) {
+    if (change != NULL) {
+        g_object_unref(change->window);
+        g_free(change);
+    }
+}
+
+static gboolean
+window_changed_hook(GSignalInvocationHint *ihint, guint n_param_values, const GValue *param_values, gpointer data) {
+    XfwWindow *window = g_value_get_object(&param_values[0]);
+    XfwScreen *screen = XFW_WINDOW_GET_PRIVATE(window)->screen;
+    if (screen != NULL) {
+        _xfw_screen_window_changed(screen, window, GPOINTER_TO_UINT(data));
+    }
+    return TRUE;
+}
+
 void
 _xfw_window_invalidate_icon(XfwWindow *window) {
     XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
 
-    g_clear_object(&priv->icon);
+    _xfw_icon_cache_clear(priv->icon_cache);
     g_clear_object(&priv->gicon);
-    priv->icon_size = 0;
-    priv->icon_scale = 0;
+}
+
+static void
+flush_geometry_changed(XfwWindow *window) {
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+
+    if (priv->geometry_throttle_id != 0) {
+        g_source_remove(priv->geometry_throttle_id);
+        priv->geometry_throttle_id = 0;
+    }
+    if (priv->geometry_pending) {
+        priv->geometry_pending = FALSE;
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_CHANGED], 0);
+    }
+}
+
+static gboolean
+geometry_throttle_timeout(gpointer data) {
+    XfwWindow *window = XFW_WINDOW(data);
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+
+    if (priv->geometry_pending) {
+        priv->geometry_pending = FALSE;
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_CHANGED], 0);
+        return G_SOURCE_CONTINUE;
+    } else {
+        priv->geometry_throttle_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+}
+
+static gboolean
+geometry_settle_timeout(gpointer data) {
+    XfwWindow *window = XFW_WINDOW(data);
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+
+    gint64 quiet_ms = (g_get_monotonic_time() - priv->last_geometry_change) / 1000;
+    if (quiet_ms < GEOMETRY_SETTLE_DELAY_MS) {
+        // Rather than resetting the timer on every change, check again once
+        // the window could have been still for long enough
+        priv->geometry_settle_id = g_timeout_add(GEOMETRY_SETTLE_DELAY_MS - quiet_ms, geometry_settle_timeout, window);
+    } else {
+        priv->geometry_settle_id = 0;
+        flush_geometry_changed(window);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_SETTLED], 0);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+// Called by the backends instead of emitting geometry-changed directly.  With
+// a throttle interval set on the screen, the first change of a burst is
+// emitted right away, and the rest are coalesced into at most one emission
+// per interval.
+void
+_xfw_window_geometry_changed(XfwWindow *window) {
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+    guint interval = xfw_screen_get_geometry_throttle_interval(priv->screen);
+
+    if (interval == 0) {
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_CHANGED], 0);
+    } else if (priv->geometry_throttle_id != 0) {
+        priv->geometry_pending = TRUE;
+    } else {
+        priv->geometry_throttle_id = g_timeout_add(interval, geometry_throttle_timeout, window);
+        g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_CHANGED], 0);
+    }
+
+    // Throttled emissions always need the trailing flush; otherwise, don't
+    // bother keeping a timer going unless someone is listening
+    if (interval != 0 || g_signal_has_handler_pending(window, _xfw_window_signals[WINDOW_SIGNAL_GEOMETRY_SETTLED], 0, FALSE)) {
+        priv->last_geometry_change = g_get_monotonic_time();
+        if (priv->geometry_settle_id == 0) {
+            priv->geometry_settle_id = g_timeout_add(GEOMETRY_SETTLE_DELAY_MS, geometry_settle_timeout, window);
+        }
+    }
+}
+
+static void
+emit_name_changed(XfwWindow *window) {
+    _xfw_window_notify(window, WINDOW_PROP_NAME);
+    g_signal_emit(window, _xfw_window_signals[WINDOW_SIGNAL_NAME_CHANGED], 0);
+}
+
+static gboolean
+name_throttle_timeout(gpointer data) {
+    XfwWindow *window = XFW_WINDOW(data);
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+
+    if (priv->name_pending) {
+        priv->name_pending = FALSE;
+        emit_name_changed(window);
+        return G_SOURCE_CONTINUE;
+    } else {
+        priv->name_throttle_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+}
+
+// Called by the backends instead of notifying the name property and emitting
+// name-changed directly.  Works like _xfw_window_geometry_changed(): with a
+// throttle interval set on the screen, the first change of a burst is
+// emitted right away, and the last one is always delivered at the end of the
+// interval.
+void
+_xfw_window_name_changed(XfwWindow *window) {
+    XfwWindowPrivate *priv = XFW_WINDOW_GET_PRIVATE(window);
+    guint interval = xfw_screen_get_name_throttle_interval(priv->screen);
+
+    if (interval == 0) {
+        emit_name_changed(window);
+    } else if (priv->name_throttle_id != 0) {
+        priv->name_pending = TRUE;
+    } else {
+        priv->name_throttle_id = g_timeout_add(interval, name_throttle_timeout, window);
+        emit_name_changed(window);
+    }
+}
+
+void
+_xfw_window_monitor_added(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowClass *klass = XFW_WINDOW_GET_CLASS(window);
+    if (klass->monitor_added != NULL) {
+        (*klass->monitor_added)(window, monitor);
+    }
+}
+
+void
+_xfw_window_monitor_removed(XfwWindow *window, XfwMonitor *monitor) {
+    XfwWindowClass *klass = XFW_WINDOW_GET_CLASS(window);
+    if (klass->monitor_removed != NULL) {
+        (*klass->monitor_removed)(window, monitor);
+    }
 }
 
 #define __XFW_WINDOW_C__
@@ -40,6 +40,8 @@ G_DECLARE_DERIVABLE_TYPE(XfwWindow, xfw_window, XFW, WINDOW, GObject)
 #define XFW_TYPE_WINDOW_TYPE (xfw_window_type_get_type())
 #define XFW_TYPE_WINDOW_STATE (xfw_window_state_get_type())
 #define XFW_TYPE_WINDOW_CAPABILITIES (xfw_window_capabilities_get_type())
+#define XFW_TYPE_WINDOW_CHANGE_FLAGS (xfw_window_change_flags_get_type())
+#define XFW_TYPE_WINDOW_CHANGE (xfw_window_change_get_type())
 
 /**
  * XfwWindowState:
@@ -145,13 +147,68 @@ typedef enum {
     XFW_WINDOW_TYPE_SPLASHSCREEN = 7,
 } XfwWindowType;
 
+/**
+ * XfwWindowChangeFlags:
+ * @XFW_WINDOW_CHANGE_NONE: nothing changed.
+ * @XFW_WINDOW_CHANGE_OPENED: the window was opened.
+ * @XFW_WINDOW_CHANGE_CLOSED: the window was closed.
+ * @XFW_WINDOW_CHANGE_CLASS: the window's class ids changed.
+ * @XFW_WINDOW_CHANGE_NAME: the window's name changed.
+ * @XFW_WINDOW_CHANGE_ICON: the window's icon changed.
+ * @XFW_WINDOW_CHANGE_TYPE: the window's type changed.
+ * @XFW_WINDOW_CHANGE_STATE: the window's state changed.
+ * @XFW_WINDOW_CHANGE_CAPABILITIES: the window's capabilities changed.
+ * @XFW_WINDOW_CHANGE_GEOMETRY: the window's position or size changed.
+ * @XFW_WINDOW_CHANGE_WORKSPACE: the window moved to another workspace.
+ * @XFW_WINDOW_CHANGE_MONITORS: the set of monitors the window is on changed.
+ * @XFW_WINDOW_CHANGE_APPLICATION: the window's application changed.
+ *
+ * Flags bitfield describing what has changed about a window, as reported
+ * by #XfwScreen::changes-committed.
+ *
+ * Since: 4.21.0
+ **/
+typedef enum {
+    XFW_WINDOW_CHANGE_NONE = 0,
+    XFW_WINDOW_CHANGE_OPENED = (1 << 0),
+    XFW_WINDOW_CHANGE_CLOSED = (1 << 1),
+    XFW_WINDOW_CHANGE_CLASS = (1 << 2),
+    XFW_WINDOW_CHANGE_NAME = (1 << 3),
+    XFW_WINDOW_CHANGE_ICON = (1 << 4),
+    XFW_WINDOW_CHANGE_TYPE = (1 << 5),
+    XFW_WINDOW_CHANGE_STATE = (1 << 6),
+    XFW_WINDOW_CHANGE_CAPABILITIES = (1 << 7),
+    XFW_WINDOW_CHANGE_GEOMETRY = (1 << 8),
+    XFW_WINDOW_CHANGE_WORKSPACE = (1 << 9),
+    XFW_WINDOW_CHANGE_MONITORS = (1 << 10),
+    XFW_WINDOW_CHANGE_APPLICATION = (1 << 11),
+} XfwWindowChangeFlags;
+
+/**
+ * XfwWindowChange:
+ * @window: the #XfwWindow that changed.
+ * @changes: a bitfield of what changed about @window.
+ *
+ * Describes the changes made to a window since the previous emission of
+ * #XfwScreen::changes-committed.
+ *
+ * Since: 4.21.0
+ **/
+typedef struct {
+    XfwWindow *window;
+    XfwWindowChangeFlags changes;
+} XfwWindowChange;
+
 GType xfw_window_type_get_type(void);
 GType xfw_window_state_get_type(void);
 GType xfw_window_capabilities_get_type(void);
+GType xfw_window_change_flags_get_type(void);
+GType xfw_window_change_get_type(void);
 
 const gchar *const *xfw_window_get_class_ids(XfwWindow *window);
 const gchar *xfw_window_get_name(XfwWindow *window);
 GdkPixbuf *xfw_window_get_icon(XfwWindow *window, gint size, gint scale);
+cairo_surface_t *xfw_window_get_icon_surface(XfwWindow *window, gint size, gint scale);
 GIcon *xfw_window_get_gicon(XfwWindow *window);
 gboolean xfw_window_icon_is_fallback(XfwWindow *window);
 XfwWindowType xfw_window_get_window_type(XfwWindow *window);
@@ -159,6 +216,7 @@ XfwWindowState xfw_window_get_state(XfwWindow *window);
 XfwWindowCapabilities xfw_window_get_capabilities(XfwWindow *window);
 GdkRectangle *xfw_window_get_geometry(XfwWindow *window);
 XfwScreen *xfw_window_get_screen(XfwWindow *window);
+gint xfw_window_get_stacking_index(XfwWindow *window);
 XfwWorkspace *xfw_window_get_workspace(XfwWindow *window);
 GList *xfw_window_get_monitors(XfwWindow *window);
 XfwApplication *xfw_window_get_application(XfwWindow *window);
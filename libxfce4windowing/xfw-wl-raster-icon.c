@@ -25,12 +25,14 @@
 #include <gdk/gdkwayland.h>
 #include <gio/gio.h>
 #include <glib/gi18n-lib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
 #include "protocols/xfce-foreign-toplevel-management-private-v1-client.h"
 
 #include "window-icon-utils.h"
+#include "xfw-pending-tasks.h"
 #include "xfw-screen-private.h"
 #include "xfw-wl-raster-icon.h"
 
@@ -47,12 +49,31 @@ struct _XfwWlRasterIcon {
     guint window_icon_size;
     guint window_icon_scale;
     enum xfce_foreign_toplevel_icon_pixels_v1_failure_reason failure_reason;
+
+    // PixelsRequest, one per size/scale pair currently in flight
+    GList *requests;
+    // The compositor won't answer requests for a closed window, so once it's
+    // closed, in-flight and new requests fail right away
+    gboolean window_closed;
 };
 
 struct _XfwWlRasterIconClass {
     GObjectClass parent_class;
 };
 
+typedef struct {
+    XfwWlRasterIcon *raster_icon;
+    struct xfce_foreign_toplevel_icon_pixels_v1 *pixels;
+    guint size;
+    guint scale;
+
+    WindowIcon *window_icon;
+    enum xfce_foreign_toplevel_icon_pixels_v1_failure_reason failure_reason;
+
+    // GTasks from load_async() waiting for this request to complete
+    XfwPendingTasks *tasks;
+} PixelsRequest;
+
 static void xfw_wl_raster_icon_set_property(GObject *object,
                                             guint prop_id,
                                             const GValue *value,
@@ -96,6 +117,8 @@ static void pixels_failed(void *data,
                           struct xfce_foreign_toplevel_icon_pixels_v1 *pixels,
                           enum xfce_foreign_toplevel_icon_pixels_v1_failure_reason reason);
 
+static void pixels_request_free(PixelsRequest *request);
+static void fail_requests(XfwWlRasterIcon *raster_icon);
 static GInputStream *create_input_stream(WindowIcon *icon);
 
 static const struct xfce_foreign_toplevel_icon_pixels_v1_listener pixels_listener = {
@@ -137,6 +160,7 @@ xfw_wl_raster_icon_set_property(GObject *object,
     switch (prop_id) {
         case PROP_WINDOW:
             icon->window = g_value_dup_object(value);
+            g_signal_connect_swapped(icon->window, "closed", G_CALLBACK(fail_requests), icon);
             break;
 
         default:
@@ -167,7 +191,11 @@ static void
 xfw_wl_raster_icon_dispose(GObject *object) {
     XfwWlRasterIcon *icon = XFW_WL_RASTER_ICON(object);
 
-    g_clear_object(&icon->window);
+    if (icon->window != NULL) {
+        g_signal_handlers_disconnect_by_func(icon->window, fail_requests, icon);
+        g_clear_object(&icon->window);
+    }
+    fail_requests(icon);
 
     G_OBJECT_CLASS(xfw_wl_raster_icon_parent_class)->dispose(object);
 }
@@ -176,7 +204,10 @@ static void
 xfw_wl_raster_icon_finalize(GObject *object) {
     XfwWlRasterIcon *icon = XFW_WL_RASTER_ICON(object);
 
-    g_clear_pointer(&icon->window_icon, _window_icon_free);
+    // Requests with pending tasks hold a reference on us, so anything left
+    // here has nobody waiting on it.
+    g_list_free_full(icon->requests, (GDestroyNotify)pixels_request_free);
+    g_clear_pointer(&icon->window_icon, _window_icon_unref);
 
     G_OBJECT_CLASS(xfw_wl_raster_icon_parent_class)->finalize(object);
 }
@@ -212,99 +243,248 @@ xfw_wl_raster_icon_hash(GIcon *icon) {
     return g_direct_hash(raster_icon->window);
 }
 
-static GInputStream *
-xfw_wl_raster_icon_load(GLoadableIcon *icon,
-                        int size,
-                        char **type,
-                        GCancellable *cancellable,
-                        GError **error) {
-    XfwWlRasterIcon *raster_icon = XFW_WL_RASTER_ICON(icon);
+static struct wl_display *
+get_wl_display(XfwWlRasterIcon *raster_icon) {
+    XfwScreen *screen = _xfw_window_get_screen(XFW_WINDOW(raster_icon->window));
+    GdkScreen *gscreen = _xfw_screen_get_gdk_screen(screen);
+    GdkDisplay *display = gdk_screen_get_display(gscreen);
+    return gdk_wayland_display_get_wl_display(display);
+}
 
+static guint
+get_desired_scale(XfwWlRasterIcon *raster_icon) {
     guint desired_scale = 1;
     for (GList *lm = xfw_window_get_monitors(XFW_WINDOW(raster_icon->window)); lm != NULL; lm = lm->next) {
         desired_scale = MAX(desired_scale, xfw_monitor_get_scale(XFW_MONITOR(lm->data)));
     }
-    guint desired_size = size / desired_scale;
+    return desired_scale;
+}
 
+static gboolean
+has_cached_window_icon(XfwWlRasterIcon *raster_icon, guint desired_size, guint desired_scale) {
+    return raster_icon->window_icon != NULL
+           && raster_icon->window_icon_scale == desired_scale
+           && raster_icon->window_icon_size == desired_size;
+}
+
+static IconSize *
+choose_icon_size(XfwWlRasterIcon *raster_icon, guint desired_size, guint desired_scale, GError **error) {
     GList *icon_sizes = _xfw_window_wayland_get_icon_sizes(raster_icon->window);
+    IconSize *best_size = NULL;
+
     if (icon_sizes == NULL) {
         g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, _("This window does not have any raster icons"));
         return NULL;
-    } else if (raster_icon->window_icon != NULL && raster_icon->window_icon_scale == desired_scale && raster_icon->window_icon_size == desired_size) {
-        GInputStream *is = create_input_stream(raster_icon->window_icon);
-        if (is != NULL) {
-            return is;
-        } else {
-            g_clear_pointer(&raster_icon->window_icon, _window_icon_free);
-            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, _("Unknown error loading icon"));
-            return NULL;
+    }
+
+    for (GList *ls = icon_sizes; ls != NULL; ls = ls->next) {
+        IconSize *icon_size = ls->data;
+        if (icon_size->scale == desired_scale && icon_size->size >= desired_size) {
+            best_size = icon_size;
+            break;
         }
-    } else {
-        IconSize *best_size = NULL;
+    }
+
+    if (best_size == NULL) {
         for (GList *ls = icon_sizes; ls != NULL; ls = ls->next) {
             IconSize *icon_size = ls->data;
-            if (icon_size->scale == desired_scale && icon_size->size >= desired_size) {
+            if (icon_size->size * icon_size->scale >= desired_size * desired_scale) {
                 best_size = icon_size;
                 break;
             }
         }
+    }
 
-        if (best_size == NULL) {
-            for (GList *ls = icon_sizes; ls != NULL; ls = ls->next) {
-                IconSize *icon_size = ls->data;
-                if (icon_size->size * icon_size->scale >= (guint)size) {
-                    best_size = icon_size;
-                    break;
-                }
-            }
-        }
+    if (best_size == NULL) {
+        best_size = g_list_last(icon_sizes)->data;
+    }
 
-        if (best_size == NULL) {
-            best_size = g_list_last(icon_sizes)->data;
+    return best_size;
+}
+
+static void
+set_error_for_failure_reason(GError **error, enum xfce_foreign_toplevel_icon_pixels_v1_failure_reason failure_reason) {
+    switch (failure_reason) {
+        case XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_NO_PIXEL_DATA:
+            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, _("This window does not have any raster icons"));
+            break;
+
+        case XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_INVALID_ARGS:
+            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, _("The requested size/scale pair does not exist"));
+            break;
+
+        default:
+            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, _("Unknown error loading icon"));
+            break;
+    }
+}
+
+// Sends a get_icon_pixels request, or joins one for the same size/scale that
+// is already in flight.  The request completes in pixels_request_complete().
+static PixelsRequest *
+pixels_request_start(XfwWlRasterIcon *raster_icon, const IconSize *icon_size) {
+    for (GList *l = raster_icon->requests; l != NULL; l = l->next) {
+        PixelsRequest *request = l->data;
+        if (request->size == icon_size->size && request->scale == icon_size->scale) {
+            return request;
         }
+    }
 
-        // Shouldn't be possible, but...
-        g_return_val_if_fail(best_size != NULL, NULL);
+    PixelsRequest *request = g_new0(PixelsRequest, 1);
+    request->raster_icon = raster_icon;
+    request->size = icon_size->size;
+    request->scale = icon_size->scale;
+    request->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
+    request->tasks = _xfw_pending_tasks_new();
 
-        struct xfce_foreign_toplevel_handle_v1 *xfce_handle = _xfw_window_wayland_get_xfce_handle(raster_icon->window);
-        struct xfce_foreign_toplevel_icon_pixels_v1 *pixels = xfce_foreign_toplevel_handle_v1_get_icon_pixels(xfce_handle, best_size->size, best_size->scale);
-        xfce_foreign_toplevel_icon_pixels_v1_add_listener(pixels, &pixels_listener, raster_icon);
+    struct xfce_foreign_toplevel_handle_v1 *xfce_handle = _xfw_window_wayland_get_xfce_handle(raster_icon->window);
+    request->pixels = xfce_foreign_toplevel_handle_v1_get_icon_pixels(xfce_handle, icon_size->size, icon_size->scale);
+    xfce_foreign_toplevel_icon_pixels_v1_add_listener(request->pixels, &pixels_listener, request);
 
-        XfwScreen *screen = _xfw_window_get_screen(XFW_WINDOW(raster_icon->window));
-        GdkScreen *gscreen = _xfw_screen_get_gdk_screen(screen);
-        GdkDisplay *display = gdk_screen_get_display(gscreen);
-        struct wl_display *wl_display = gdk_wayland_display_get_wl_display(display);
-        wl_display_roundtrip(wl_display);
+    raster_icon->requests = g_list_prepend(raster_icon->requests, request);
+    wl_display_flush(get_wl_display(raster_icon));
 
-        xfce_foreign_toplevel_icon_pixels_v1_destroy(pixels);
+    return request;
+}
 
-        if (raster_icon->window_icon == NULL) {
-            switch (raster_icon->failure_reason) {
-                case XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_NO_PIXEL_DATA:
-                    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, _("This window does not have any raster icons"));
-                    return NULL;
+static void
+pixels_request_complete(PixelsRequest *request) {
+    XfwWlRasterIcon *raster_icon = request->raster_icon;
 
-                case XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_INVALID_ARGS:
-                    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, _("The requested size/scale pair does not exist"));
-                    return NULL;
+    raster_icon->requests = g_list_remove(raster_icon->requests, request);
 
-                default:
-                    g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, _("Unknown error loading icon"));
-                    return NULL;
+    raster_icon->failure_reason = request->failure_reason;
+    if (request->window_icon != NULL) {
+        g_clear_pointer(&raster_icon->window_icon, _window_icon_unref);
+        raster_icon->window_icon = g_steal_pointer(&request->window_icon);
+        raster_icon->window_icon_size = request->size;
+        raster_icon->window_icon_scale = request->scale;
+    }
+
+    // Streams share the icon's BMP data, so it's fine if a later request
+    // replaces the cached icon before these are read.
+    GList *tasks = _xfw_pending_tasks_steal(request->tasks);
+    for (GList *l = tasks; l != NULL; l = l->next) {
+        GTask *task = G_TASK(l->data);
+        if (!g_task_return_error_if_cancelled(task)) {
+            GInputStream *is = NULL;
+            if (raster_icon->window_icon != NULL
+                && raster_icon->window_icon_size == request->size
+                && raster_icon->window_icon_scale == request->scale)
+            {
+                is = create_input_stream(raster_icon->window_icon);
             }
-        } else {
-            GInputStream *is = create_input_stream(raster_icon->window_icon);
+
             if (is != NULL) {
-                raster_icon->window_icon_scale = best_size->scale;
-                raster_icon->window_icon_size = best_size->size;
-                return is;
+                g_task_return_pointer(task, is, g_object_unref);
             } else {
-                g_clear_pointer(&raster_icon->window_icon, _window_icon_free);
-                g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, _("Unknown error loading icon"));
-                return NULL;
+                GError *error = NULL;
+                set_error_for_failure_reason(&error, request->failure_reason);
+                g_task_return_error(task, error);
             }
         }
     }
+
+    pixels_request_free(request);
+    // Dropping the last task may drop the last reference to raster_icon
+    g_list_free_full(tasks, g_object_unref);
+}
+
+static void
+pixels_request_free(PixelsRequest *request) {
+    if (request->pixels != NULL) {
+        xfce_foreign_toplevel_icon_pixels_v1_destroy(request->pixels);
+    }
+    g_clear_pointer(&request->window_icon, _window_icon_unref);
+    _xfw_pending_tasks_free(request->tasks);
+    g_free(request);
+}
+
+// Called when the window closes, or we're disposed: the compositor won't
+// answer our requests any more, so fail everyone waiting on them.
+static void
+fail_requests(XfwWlRasterIcon *raster_icon) {
+    GList *requests;
+    GError *error;
+
+    raster_icon->window_closed = TRUE;
+    if (raster_icon->requests == NULL) {
+        return;
+    }
+
+    // Completing the tasks may drop the last reference to us, and their
+    // callbacks may try to load the icon again
+    g_object_ref(raster_icon);
+    requests = g_steal_pointer(&raster_icon->requests);
+    error = g_error_new_literal(G_IO_ERROR, G_IO_ERROR_CLOSED, _("The window was closed before its icon could be loaded"));
+    for (GList *l = requests; l != NULL; l = l->next) {
+        PixelsRequest *request = l->data;
+        _xfw_pending_tasks_return_error(request->tasks, error);
+        pixels_request_free(request);
+    }
+    g_error_free(error);
+    g_list_free(requests);
+    g_object_unref(raster_icon);
+}
+
+static WindowIcon *
+xfw_wl_raster_icon_fetch(XfwWlRasterIcon *raster_icon, guint desired_size, guint desired_scale, GError **error) {
+    if (has_cached_window_icon(raster_icon, desired_size, desired_scale)) {
+        return raster_icon->window_icon;
+    } else {
+        IconSize *best_size;
+
+        if (raster_icon->window_closed) {
+            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_CLOSED, _("The window was closed before its icon could be loaded"));
+            return NULL;
+        }
+
+        best_size = choose_icon_size(raster_icon, desired_size, desired_scale, error);
+        if (best_size == NULL) {
+            return NULL;
+        }
+
+        g_clear_pointer(&raster_icon->window_icon, _window_icon_unref);
+        raster_icon->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
+
+        pixels_request_start(raster_icon, best_size);
+        wl_display_roundtrip(get_wl_display(raster_icon));
+
+        if (raster_icon->window_icon == NULL
+            || raster_icon->window_icon_size != best_size->size
+            || raster_icon->window_icon_scale != best_size->scale)
+        {
+            set_error_for_failure_reason(error, raster_icon->failure_reason);
+            return NULL;
+        } else {
+            return raster_icon->window_icon;
+        }
+    }
+}
+
+static GInputStream *
+xfw_wl_raster_icon_load(GLoadableIcon *icon,
+                        int size,
+                        char **type,
+                        GCancellable *cancellable,
+                        GError **error) {
+    XfwWlRasterIcon *raster_icon = XFW_WL_RASTER_ICON(icon);
+    guint desired_scale = get_desired_scale(raster_icon);
+    guint desired_size = size / desired_scale;
+
+    WindowIcon *window_icon = xfw_wl_raster_icon_fetch(raster_icon, desired_size, desired_scale, error);
+    if (window_icon == NULL) {
+        return NULL;
+    } else {
+        GInputStream *is = create_input_stream(window_icon);
+        if (is != NULL) {
+            return is;
+        } else {
+            g_clear_pointer(&raster_icon->window_icon, _window_icon_unref);
+            g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_FAILED, _("Unknown error loading icon"));
+            return NULL;
+        }
+    }
 }
 
 static void
@@ -313,17 +493,33 @@ xfw_wl_raster_icon_load_async(GLoadableIcon *icon,
                               GCancellable *cancellable,
                               GAsyncReadyCallback callback,
                               gpointer user_data) {
-    GInputStream *stream;
+    XfwWlRasterIcon *raster_icon = XFW_WL_RASTER_ICON(icon);
     GTask *task = g_task_new(icon, cancellable, callback, user_data);
-    gchar *type = NULL;
+    guint desired_scale = get_desired_scale(raster_icon);
+    guint desired_size = size / desired_scale;
+    GInputStream *stream;
     GError *error = NULL;
 
-    stream = xfw_wl_raster_icon_load(icon, size, &type, cancellable, &error);
-    if (stream != NULL) {
-        g_task_set_task_data(task, type, g_free);
+    g_task_set_source_tag(task, xfw_wl_raster_icon_load_async);
+
+    if (has_cached_window_icon(raster_icon, desired_size, desired_scale)
+        && (stream = create_input_stream(raster_icon->window_icon)) != NULL)
+    {
         g_task_return_pointer(task, stream, g_object_unref);
+        g_object_unref(task);
+    } else if (raster_icon->window_closed) {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_CLOSED, "%s", _("The window was closed before its icon could be loaded"));
+        g_object_unref(task);
     } else {
-        g_task_return_error(task, error);
+        IconSize *best_size = choose_icon_size(raster_icon, desired_size, desired_scale, &error);
+        if (best_size == NULL) {
+            g_task_return_error(task, error);
+            g_object_unref(task);
+        } else {
+            // Ownership of the task passes to the request
+            PixelsRequest *request = pixels_request_start(raster_icon, best_size);
+            _xfw_pending_tasks_add(request->tasks, task);
+        }
     }
 }
 
@@ -339,7 +535,7 @@ xfw_wl_raster_icon_load_finish(GLoadableIcon *icon,
     task = G_TASK(res);
 
     if (!g_task_had_error(task) && type != NULL) {
-        *type = g_strdup(g_task_get_task_data(task));
+        *type = NULL;
     }
 
     return g_task_propagate_pointer(task, error);
@@ -352,55 +548,87 @@ pixels_received(void *data,
                 uint32_t width,
                 uint32_t height,
                 uint32_t stride) {
-    XfwWlRasterIcon *raster_icon = XFW_WL_RASTER_ICON(data);
+    PixelsRequest *request = data;
 
-    size_t len = stride * height;
-    size_t packed_len = width * 4 * height;
+    size_t len = (size_t)stride * height;
 
-    if (len < packed_len) {
-        raster_icon->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
+    if (width == 0 || height == 0 || stride < width * 4 || stride % 4 != 0
+        || width > G_MAXINT || height > G_MAXINT || stride > G_MAXINT)
+    {
+        request->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
     } else {
-        void *mapping = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
-        if (mapping == MAP_FAILED) {
-            raster_icon->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
+        // Copy the pixels out right away: the file belongs to the
+        // compositor, which may truncate or reuse it, and keeping it mapped
+        // would leave us open to SIGBUS or to the pixels changing under us.
+        void *addr = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            request->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
         } else {
-            guint32 *argb32;
-            if (len == packed_len) {
-                argb32 = (guint32 *)mapping;
+            cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+            if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+                cairo_surface_destroy(surface);
+                request->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
             } else {
-                argb32 = g_malloc(packed_len);
-                for (gsize j = 0; j < height; ++j) {
-                    memcpy(((guchar *)argb32) + j * width * 4, ((guchar *)mapping) + j * stride, width * 4);
+                cairo_surface_flush(surface);
+                guchar *dest = cairo_image_surface_get_data(surface);
+                gint dest_stride = cairo_image_surface_get_stride(surface);
+                for (guint32 y = 0; y < height; ++y) {
+                    memcpy(dest + (gsize)y * dest_stride, (guchar *)addr + (gsize)y * stride, (gsize)width * 4);
                 }
+                cairo_surface_mark_dirty(surface);
+                request->window_icon = _window_icon_new_for_surface(surface);
             }
-
-            raster_icon->window_icon = _window_icon_new(argb32, width, height, TRUE);
-            if (raster_icon->window_icon == NULL) {
-                raster_icon->failure_reason = XFCE_FOREIGN_TOPLEVEL_ICON_PIXELS_V1_FAILURE_REASON_UNKNOWN;
-            }
-
-            munmap(mapping, len);
-            if (len != packed_len) {
-                g_free(argb32);
-            }
+            munmap(addr, len);
         }
     }
 
     close(fd);
+    pixels_request_complete(request);
 }
 
 static void
 pixels_failed(void *data,
               struct xfce_foreign_toplevel_icon_pixels_v1 *pixels,
               enum xfce_foreign_toplevel_icon_pixels_v1_failure_reason reason) {
-    XfwWlRasterIcon *raster_icon = XFW_WL_RASTER_ICON(data);
-    raster_icon->failure_reason = reason;
+    PixelsRequest *request = data;
+    request->failure_reason = reason;
+    pixels_request_complete(request);
 }
 
 static GInputStream *
 create_input_stream(WindowIcon *window_icon) {
-    guchar *bmp = g_memdup2(window_icon->bmp, window_icon->bmp_len);
-    return g_memory_input_stream_new_from_data(bmp, window_icon->bmp_len, g_free);
+    GBytes *bmp = _window_icon_get_bmp(window_icon);
+    if (bmp != NULL) {
+        GInputStream *is = g_memory_input_stream_new_from_bytes(bmp);
+        g_bytes_unref(bmp);
+        return is;
+    } else {
+        return NULL;
+    }
+}
+
+cairo_surface_t *
+_xfw_wl_raster_icon_get_surface(XfwWlRasterIcon *icon, gint size, gint scale) {
+    g_return_val_if_fail(XFW_IS_WL_RASTER_ICON(icon), NULL);
+
+    WindowIcon *window_icon = xfw_wl_raster_icon_fetch(icon, size, scale, NULL);
+    if (window_icon != NULL) {
+        return _window_icon_get_surface_for_size(window_icon, size, scale);
+    } else {
+        return NULL;
+    }
+}
+
+GdkPixbuf *
+_xfw_wl_raster_icon_get_pixbuf(XfwWlRasterIcon *icon, gint size, gint scale) {
+    g_return_val_if_fail(XFW_IS_WL_RASTER_ICON(icon), NULL);
+
+    WindowIcon *window_icon = xfw_wl_raster_icon_fetch(icon, size, scale, NULL);
+    if (window_icon != NULL) {
+        return _window_icon_get_pixbuf_for_size(window_icon, size, scale);
+    } else {
+        return NULL;
+    }
 }
 
 XfwWlRasterIcon *
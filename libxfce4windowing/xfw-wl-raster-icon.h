@@ -20,6 +20,8 @@
 #ifndef __XFW_WL_RASTER_ICON_H__
 #define __XFW_WL_RASTER_ICON_H__
 
+#include <cairo.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
 #include <glib-object.h>
 
 #include "xfw-window-wayland.h"
@@ -31,6 +33,9 @@ G_DECLARE_FINAL_TYPE(XfwWlRasterIcon, xfw_wl_raster_icon, XFW, WL_RASTER_ICON, G
 
 XfwWlRasterIcon *_xfw_wl_raster_icon_new(XfwWindowWayland *window);
 
+cairo_surface_t *_xfw_wl_raster_icon_get_surface(XfwWlRasterIcon *icon, gint size, gint scale);
+GdkPixbuf *_xfw_wl_raster_icon_get_pixbuf(XfwWlRasterIcon *icon, gint size, gint scale);
+
 G_END_DECLS
 
 #endif /* __XFW_WL_RASTER_ICON_H__ */
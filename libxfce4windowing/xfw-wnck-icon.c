@@ -36,12 +36,29 @@ enum {
     PROP_WNCK_OBJECT,
 };
 
+// We read at most this much of _NET_WM_ICON (in 32-bit units), so a client
+// can't make us allocate without bound.  A 512x512 icon plus the usual
+// smaller ones fits.
+#define NET_WM_ICON_PROPERTY_MAX (1024 * 1024)
+
+typedef struct {
+    gint width;
+    gint height;
+    WindowIcon *window_icon;
+} NetWmIconEntry;
+
 struct _XfwWnckIcon {
     GObject parent;
 
     GObject *wnck_object;
 
-    GList *window_icons;
+    // Everything below is filled in when the icon is created, on the main
+    // thread, and only read afterwards, since GTK may load the icon from a
+    // worker thread, where we can't talk to the X server.
+
+    // NetWmIconEntry, smallest first
+    GArray *net_wm_icons;
+    WindowIcon *wmhints_icon;
 };
 
 struct _XfwWnckIconClass {
@@ -86,7 +103,7 @@ static GInputStream *xfw_wnck_icon_load_finish(GLoadableIcon *icon,
                                                char **type,
                                                GError **error);
 
-static GList *xfw_wnck_object_get_net_wm_icon(GObject *wnck_object);
+static GArray *xfw_wnck_object_get_net_wm_icon(GObject *wnck_object);
 static WindowIcon *xfw_wnck_object_get_wmhints_icon(GObject *wnck_object);
 
 G_DEFINE_FINAL_TYPE_WITH_CODE(XfwWnckIcon,
@@ -163,7 +180,12 @@ static void
 xfw_wnck_icon_finalize(GObject *object) {
     XfwWnckIcon *icon = XFW_WNCK_ICON(object);
 
-    g_list_free_full(icon->window_icons, (GDestroyNotify)_window_icon_free);
+    if (icon->net_wm_icons != NULL) {
+        g_array_free(icon->net_wm_icons, TRUE);
+    }
+    if (icon->wmhints_icon != NULL) {
+        _window_icon_unref(icon->wmhints_icon);
+    }
 
     G_OBJECT_CLASS(xfw_wnck_icon_parent_class)->finalize(object);
 }
@@ -195,20 +217,17 @@ xfw_wnck_icon_initable_real_init(GInitable *initable,
                                  GError **error) {
     XfwWnckIcon *icon = XFW_WNCK_ICON(initable);
     GObject *wnck_object = icon->wnck_object;
-    GList *window_icons = NULL;
 
     g_return_val_if_fail(WNCK_IS_WINDOW(wnck_object) || WNCK_IS_CLASS_GROUP(wnck_object), FALSE);
 
-    window_icons = xfw_wnck_object_get_net_wm_icon(wnck_object);
-    if (G_UNLIKELY(window_icons == NULL)) {
-        WindowIcon *wmhints_icon = xfw_wnck_object_get_wmhints_icon(wnck_object);
-        if (wmhints_icon != NULL) {
-            window_icons = g_list_prepend(window_icons, wmhints_icon);
-        }
+    // A new icon is created whenever the window's icon changes, so this is
+    // the only place we need to talk to the X server.
+    icon->net_wm_icons = xfw_wnck_object_get_net_wm_icon(wnck_object);
+    if (G_UNLIKELY(icon->net_wm_icons == NULL)) {
+        icon->wmhints_icon = xfw_wnck_object_get_wmhints_icon(wnck_object);
     }
 
-    if (G_LIKELY(window_icons != NULL)) {
-        icon->window_icons = window_icons;
+    if (G_LIKELY(icon->net_wm_icons != NULL || icon->wmhints_icon != NULL)) {
         return TRUE;
     } else {
         if (error != NULL) {
@@ -253,35 +272,39 @@ xfw_wnck_icon_hash(GIcon *icon) {
     }
 }
 
-static GList *
-xfw_wnck_object_get_net_wm_icon(GObject *wnck_object) {
-    GdkDisplay *display;
-    Display *dpy;
-    Window xid;
+static void
+net_wm_icon_entry_clear(NetWmIconEntry *entry) {
+    if (entry->window_icon != NULL) {
+        _window_icon_unref(entry->window_icon);
+    }
+}
+
+static gint
+net_wm_icon_entry_compare(gconstpointer a, gconstpointer b) {
+    const NetWmIconEntry *ea = a;
+    const NetWmIconEntry *eb = b;
+    return MAX(ea->width, ea->height) - MAX(eb->width, eb->height);
+}
+
+// Reads @length 32-bit values of _NET_WM_ICON starting at @offset.  On
+// success, the returned data must be freed with XFree().
+static gulong *
+get_net_wm_icon_range(Window xid, glong offset, glong length, gulong *nitems_out, gulong *bytes_after_out) {
+    GdkDisplay *display = gdk_display_get_default();
+    Display *dpy = gdk_x11_display_get_xdisplay(display);
     gint res, err;
     Atom type = None;
     gint format = 0;
     gulong nitems = 0;
     gulong bytes_after = 0;
     gulong *data = NULL;
-    GList *window_icons = NULL;
-
-    g_return_val_if_fail(WNCK_IS_WINDOW(wnck_object) || WNCK_IS_CLASS_GROUP(wnck_object), NULL);
-
-    display = gdk_display_get_default();
-    dpy = gdk_x11_display_get_xdisplay(display);
-
-    xid = _xfw_wnck_object_get_x11_window(wnck_object);
-    if (xid == None) {
-        return NULL;
-    }
 
     xfw_windowing_error_trap_push(display);
 
     res = XGetWindowProperty(dpy,
                              xid,
                              XInternAtom(dpy, "_NET_WM_ICON", False),
-                             0, G_MAXLONG,
+                             offset, length,
                              False,
                              XA_CARDINAL,
                              &type, &format, &nitems, &bytes_after, (void *)&data);
@@ -289,40 +312,81 @@ xfw_wnck_object_get_net_wm_icon(GObject *wnck_object) {
     err = xfw_windowing_error_trap_pop(display);
 
     if (err == Success && res == Success && type == XA_CARDINAL && format == 32 && data != NULL) {
-        gulong *cur = data;
-
-        while (cur + 2 < data + nitems) {
-            WindowIcon *window_icon = NULL;
-            gint width = cur[0];
-            gint height = cur[1];
-
-            if (width <= 0 || height <= 0) {
-                g_message("Invalid _NET_WM_ICON dimensions %dx%d for icon for window %lu", width, height, xid);
-                break;
-            } else if (cur + 2 + (width * height) > data + nitems) {
-                break;
-            }
+        *nitems_out = nitems;
+        *bytes_after_out = bytes_after;
+        return data;
+    } else {
+        if (data != NULL) {
+            XFree(data);
+        }
+        return NULL;
+    }
+}
 
-            // Xlib returns format-32 properties as long[], so narrow each pixel to packed 32-bit.
-            guint32 *argb32 = g_new(guint32, width * height);
-            for (gint i = 0; i < width * height; ++i) {
-                argb32[i] = cur[2 + i];
-            }
-            window_icon = _window_icon_new(argb32, width, height, FALSE);
-            g_free(argb32);
-            if (G_LIKELY(window_icon != NULL)) {
-                window_icons = g_list_prepend(window_icons, window_icon);
-            }
+static gboolean
+net_wm_icon_dimensions_valid(Window xid, gulong width, gulong height, gulong available) {
+    if (width == 0 || height == 0 || width > G_MAXINT16 || height > G_MAXINT16) {
+        g_message("Invalid _NET_WM_ICON dimensions %lux%lu for icon for window %lu", width, height, xid);
+        return FALSE;
+    } else {
+        return width * height <= available;
+    }
+}
 
-            cur += 2 + (width * height);
-        }
+// Reads the window's _NET_WM_ICON in a single request and turns each image
+// in it into an icon.  Images cut off by NET_WM_ICON_PROPERTY_MAX are
+// dropped.
+static GArray *
+xfw_wnck_object_get_net_wm_icon(GObject *wnck_object) {
+    Window xid;
+    GArray *entries;
+    gulong nitems = 0, bytes_after = 0;
+    gulong *data;
+
+    g_return_val_if_fail(WNCK_IS_WINDOW(wnck_object) || WNCK_IS_CLASS_GROUP(wnck_object), NULL);
+
+    xid = _xfw_wnck_object_get_x11_window(wnck_object);
+    if (xid == None) {
+        return NULL;
     }
 
-    if (data != NULL) {
-        XFree(data);
+    data = get_net_wm_icon_range(xid, 0, NET_WM_ICON_PROPERTY_MAX, &nitems, &bytes_after);
+    if (data == NULL) {
+        return NULL;
+    }
+
+    entries = g_array_new(FALSE, FALSE, sizeof(NetWmIconEntry));
+    g_array_set_clear_func(entries, (GDestroyNotify)net_wm_icon_entry_clear);
+
+    const gulong *cur = data;
+    while (cur + 2 < data + nitems) {
+        gulong width = cur[0];
+        gulong height = cur[1];
+        NetWmIconEntry entry;
+
+        if (!net_wm_icon_dimensions_valid(xid, width, height, (data + nitems) - (cur + 2))) {
+            break;
+        }
+
+        entry.width = width;
+        entry.height = height;
+        entry.window_icon = _window_icon_new_from_cardinals(cur + 2, width, height);
+        if (G_LIKELY(entry.window_icon != NULL)) {
+            g_array_append_val(entries, entry);
+        }
+
+        cur += 2 + (width * height);
     }
 
-    return g_list_sort(window_icons, _window_icon_compare);
+    XFree(data);
+
+    if (entries->len == 0) {
+        g_array_free(entries, TRUE);
+        return NULL;
+    } else {
+        g_array_sort(entries, net_wm_icon_entry_compare);
+        return entries;
+    }
 }
 
 static cairo_surface_t *
@@ -454,11 +518,8 @@ xfw_wnck_object_get_wmhints_icon(GObject *wnck_object) {
             cairo_surface_t *surface = xfw_cairo_surface_from_pixmap_and_mask(hints->icon_pixmap, mask);
 
             if (surface != NULL) {
-                window_icon = _window_icon_new((guint32 *)(gpointer)cairo_image_surface_get_data(surface),
-                                               cairo_image_surface_get_width(surface),
-                                               cairo_image_surface_get_height(surface),
-                                               FALSE);
-                cairo_surface_destroy(surface);
+                // Already a premultiplied ARGB32 image surface, so we can just take it
+                window_icon = _window_icon_new_for_surface(surface);
             }
         }
     }
@@ -470,36 +531,39 @@ xfw_wnck_object_get_wmhints_icon(GObject *wnck_object) {
     return window_icon;
 }
 
+// Prefers the smallest _NET_WM_ICON entry at least @size big, or else the
+// biggest one.  Only reads what was fetched when the icon was created, so
+// this is safe to call from any thread.
+static WindowIcon *
+xfw_wnck_icon_find_window_icon(XfwWnckIcon *wnck_icon, gint size) {
+    if (G_LIKELY(wnck_icon->net_wm_icons != NULL)) {
+        GArray *entries = wnck_icon->net_wm_icons;
+
+        for (guint i = 0; i < entries->len; ++i) {
+            NetWmIconEntry *entry = &g_array_index(entries, NetWmIconEntry, i);
+            if (MAX(entry->width, entry->height) >= size) {
+                return entry->window_icon;
+            }
+        }
+        return g_array_index(entries, NetWmIconEntry, entries->len - 1).window_icon;
+    } else {
+        return wnck_icon->wmhints_icon;
+    }
+}
+
 static GInputStream *
 xfw_wnck_icon_load(GLoadableIcon *icon,
                    int size,
                    char **type,
                    GCancellable *cancellable,
                    GError **error) {
-    XfwWnckIcon *wnck_icon = XFW_WNCK_ICON(icon);
-    WindowIcon *window_icon = NULL;
-
-    if (wnck_icon->window_icons == NULL) {
-        wnck_icon->window_icons = xfw_wnck_object_get_net_wm_icon(wnck_icon->wnck_object);
-    }
-
-    if (G_LIKELY(wnck_icon->window_icons != NULL)) {
-        for (GList *l = wnck_icon->window_icons; l != NULL; l = l->next) {
-            WindowIcon *wi = l->data;
-            if (MAX(wi->width, wi->height) >= size) {
-                window_icon = wi;
-                break;
-            }
-        }
-
-        if (G_UNLIKELY(window_icon == NULL)) {
-            window_icon = g_list_last(wnck_icon->window_icons)->data;
-        }
-    }
+    WindowIcon *window_icon = xfw_wnck_icon_find_window_icon(XFW_WNCK_ICON(icon), size);
+    GBytes *bmp = window_icon != NULL ? _window_icon_get_bmp(window_icon) : NULL;
 
-    if (G_LIKELY(window_icon != NULL)) {
-        guchar *bmp = g_memdup2(window_icon->bmp, window_icon->bmp_len);
-        return g_memory_input_stream_new_from_data(bmp, window_icon->bmp_len, g_free);
+    if (G_LIKELY(bmp != NULL)) {
+        GInputStream *stream = g_memory_input_stream_new_from_bytes(bmp);
+        g_bytes_unref(bmp);
+        return stream;
     } else {
         if (error != NULL) {
             *error = g_error_new_literal(G_IO_ERROR, G_IO_ERROR_NOT_FOUND, _("Failed to find or load an icon for the window"));
@@ -546,6 +610,34 @@ xfw_wnck_icon_load_finish(GLoadableIcon *icon,
     return g_task_propagate_pointer(task, error);
 }
 
+cairo_surface_t *
+_xfw_wnck_icon_get_surface(XfwWnckIcon *icon, gint size, gint scale) {
+    WindowIcon *window_icon;
+
+    g_return_val_if_fail(XFW_IS_WNCK_ICON(icon), NULL);
+
+    window_icon = xfw_wnck_icon_find_window_icon(icon, size * scale);
+    if (G_LIKELY(window_icon != NULL)) {
+        return _window_icon_get_surface_for_size(window_icon, size, scale);
+    } else {
+        return NULL;
+    }
+}
+
+GdkPixbuf *
+_xfw_wnck_icon_get_pixbuf(XfwWnckIcon *icon, gint size, gint scale) {
+    WindowIcon *window_icon;
+
+    g_return_val_if_fail(XFW_IS_WNCK_ICON(icon), NULL);
+
+    window_icon = xfw_wnck_icon_find_window_icon(icon, size * scale);
+    if (G_LIKELY(window_icon != NULL)) {
+        return _window_icon_get_pixbuf_for_size(window_icon, size, scale);
+    } else {
+        return NULL;
+    }
+}
+
 XfwWnckIcon *
 _xfw_wnck_icon_new(GObject *wnck_object) {
     g_return_val_if_fail(WNCK_IS_WINDOW(wnck_object) || WNCK_IS_CLASS_GROUP(wnck_object), NULL);
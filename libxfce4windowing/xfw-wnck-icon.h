@@ -24,6 +24,7 @@
 #error "Only libxfce4windowing.h can be included directly"
 #endif
 
+#include <cairo.h>
 #include <glib-object.h>
 #include <libwnck/libwnck.h>
 
@@ -34,6 +35,9 @@ G_DECLARE_FINAL_TYPE(XfwWnckIcon, xfw_wnck_icon, XFW, WNCK_ICON, GObject)
 
 XfwWnckIcon *_xfw_wnck_icon_new(GObject *wnck_object);
 
+cairo_surface_t *_xfw_wnck_icon_get_surface(XfwWnckIcon *icon, gint size, gint scale);
+GdkPixbuf *_xfw_wnck_icon_get_pixbuf(XfwWnckIcon *icon, gint size, gint scale);
+
 G_END_DECLS
 
 #endif /* __XFW_WNCK_ICON_H__ */
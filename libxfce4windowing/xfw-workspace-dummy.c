@@ -214,6 +214,6 @@ _xfw_workspace_dummy_set_workspace_group(XfwWorkspaceDummy *workspace, XfwWorksp
     if (group != workspace->priv->group) {
         XfwWorkspaceGroup *previous_group = workspace->priv->group;
         workspace->priv->group = group;
-        g_signal_emit_by_name(workspace, "group-changed", previous_group);
+        g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_GROUP_CHANGED], 0, previous_group);
     }
 }
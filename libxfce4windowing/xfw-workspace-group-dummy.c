@@ -299,14 +299,14 @@ xfw_workspace_group_dummy_set_layout(XfwWorkspaceGroup *group, gint rows, gint c
 
 static void
 monitor_added(XfwScreen *screen, XfwMonitor *monitor, XfwWorkspaceGroupDummy *group) {
-    g_signal_emit_by_name(group, "monitor-added", monitor);
-    g_signal_emit_by_name(group, "monitors-changed");
+    g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_ADDED], 0, monitor);
+    g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED], 0);
 }
 
 static void
 monitor_removed(XfwScreen *screen, XfwMonitor *monitor, XfwWorkspaceGroupDummy *group) {
-    g_signal_emit_by_name(group, "monitor-removed", monitor);
-    g_signal_emit_by_name(group, "monitors-changed");
+    g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_REMOVED], 0, monitor);
+    g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED], 0);
 }
 
 void
@@ -315,7 +315,7 @@ _xfw_workspace_group_dummy_set_workspaces(XfwWorkspaceGroupDummy *group, GList *
         g_list_free(group->priv->workspaces);
     }
     group->priv->workspaces = g_list_copy(workspaces);
-    g_object_notify(G_OBJECT(group), "workspaces");
+    _xfw_workspace_group_notify(XFW_WORKSPACE_GROUP(group), WORKSPACE_GROUP_PROP_WORKSPACES);
 }
 
 void
@@ -323,7 +323,7 @@ _xfw_workspace_group_dummy_set_active_workspace(XfwWorkspaceGroupDummy *group, X
     if (workspace != group->priv->active_workspace) {
         XfwWorkspace *old_workspace = group->priv->active_workspace;
         group->priv->active_workspace = workspace;
-        g_object_notify(G_OBJECT(group), "active-workspace");
-        g_signal_emit_by_name(group, "active-workspace-changed", old_workspace);
+        _xfw_workspace_group_notify(XFW_WORKSPACE_GROUP(group), WORKSPACE_GROUP_PROP_ACTIVE_WORKSPACE);
+        g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_ACTIVE_WORKSPACE_CHANGED], 0, old_workspace);
     }
 }
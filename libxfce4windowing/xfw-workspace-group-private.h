@@ -30,6 +30,21 @@
 
 G_BEGIN_DECLS
 
+enum {
+    WORKSPACE_GROUP_SIGNAL_CAPABILITIES_CHANGED,
+    WORKSPACE_GROUP_SIGNAL_ACTIVE_WORKSPACE_CHANGED,
+    WORKSPACE_GROUP_SIGNAL_MONITOR_ADDED,
+    WORKSPACE_GROUP_SIGNAL_MONITOR_REMOVED,
+    WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED,
+    WORKSPACE_GROUP_SIGNAL_WORKSPACE_ADDED,
+    WORKSPACE_GROUP_SIGNAL_WORKSPACE_REMOVED,
+    WORKSPACE_GROUP_SIGNAL_VIEWPORTS_CHANGED,
+    N_WORKSPACE_GROUP_SIGNALS,
+};
+
+// Signal ids, indexed by WORKSPACE_GROUP_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_workspace_group_signals[N_WORKSPACE_GROUP_SIGNALS];
+
 struct _XfwWorkspaceGroupInterface {
     /*< private >*/
     GTypeInterface g_iface;
@@ -66,6 +81,9 @@ struct _XfwWorkspaceGroupInterface {
     gboolean (*set_layout)(XfwWorkspaceGroup *group, gint rows, gint columns, GError **error);
 };
 
+// Notifies a change to one of the WORKSPACE_GROUP_PROP_* properties
+void _xfw_workspace_group_notify(XfwWorkspaceGroup *group, guint prop_id);
+
 G_END_DECLS
 
 #endif /* !__XFW_WORKSPACE_GROUP_PRIVATE_H__ */
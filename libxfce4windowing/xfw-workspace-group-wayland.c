@@ -306,8 +306,7 @@ group_capabilities(void *data, struct ext_workspace_group_handle_v1 *wl_group, u
     group->priv->capabilities = new_capabilities;
     changed_mask = old_capabilities ^ new_capabilities;
     if (changed_mask != 0) {
-        g_object_notify(G_OBJECT(group), "capabilities");
-        g_signal_emit_by_name(group, "capabilities-changed", changed_mask, new_capabilities);
+        g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_CAPABILITIES_CHANGED], 0, changed_mask, new_capabilities);
     }
 }
 
@@ -323,8 +322,8 @@ group_output_enter(void *data, struct ext_workspace_group_handle_v1 *wl_group, s
             && g_list_find(group->priv->monitors, monitor) == NULL)
         {
             group->priv->monitors = g_list_append(group->priv->monitors, monitor);
-            g_signal_emit_by_name(group, "monitor-added", monitor);
-            g_signal_emit_by_name(group, "monitors-changed");
+            g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_ADDED], 0, monitor);
+            g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED], 0);
             break;
         }
     }
@@ -340,8 +339,8 @@ group_output_leave(void *data, struct ext_workspace_group_handle_v1 *wl_group, s
         XfwMonitorWayland *monitor = XFW_MONITOR_WAYLAND(l->data);
         if (_xfw_monitor_wayland_get_wl_output(monitor) == output) {
             group->priv->monitors = g_list_remove(group->priv->monitors, monitor);
-            g_signal_emit_by_name(group, "monitor-removed", monitor);
-            g_signal_emit_by_name(group, "monitors-changed");
+            g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_REMOVED], 0, monitor);
+            g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED], 0);
             break;
         }
     }
@@ -354,7 +353,7 @@ group_workspace_enter(void *data, struct ext_workspace_group_handle_v1 *wl_group
     if (g_list_find(group->priv->workspaces, workspace) == NULL) {
         group->priv->workspaces = g_list_append(group->priv->workspaces, workspace);
         _xfw_workspace_wayland_set_workspace_group(workspace, XFW_WORKSPACE_GROUP(group));
-        g_signal_emit_by_name(group, "workspace-added", workspace);
+        g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_ADDED], 0, workspace);
     }
 }
 
@@ -366,7 +365,7 @@ group_workspace_leave(void *data, struct ext_workspace_group_handle_v1 *wl_group
     if (link != NULL) {
         group->priv->workspaces = g_list_delete_link(group->priv->workspaces, link);
         _xfw_workspace_wayland_set_workspace_group(workspace, NULL);
-        g_signal_emit_by_name(group, "workspace-removed", workspace);
+        g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_REMOVED], 0, workspace);
     }
 }
 
@@ -399,7 +398,7 @@ _xfw_workspace_group_wayland_set_active_workspace(XfwWorkspaceGroupWayland *grou
     if (group->priv->active_workspace != workspace) {
         XfwWorkspace *old_workspace = group->priv->active_workspace;
         group->priv->active_workspace = workspace;
-        g_object_notify(G_OBJECT(group), "active-workspace");
-        g_signal_emit_by_name(group, "active-workspace-changed", old_workspace);
+        _xfw_workspace_group_notify(XFW_WORKSPACE_GROUP(group), WORKSPACE_GROUP_PROP_ACTIVE_WORKSPACE);
+        g_signal_emit(group, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_ACTIVE_WORKSPACE_CHANGED], 0, old_workspace);
     }
 }
@@ -54,14 +54,26 @@
 
 G_DEFINE_INTERFACE(XfwWorkspaceGroup, xfw_workspace_group, G_TYPE_OBJECT)
 
+guint _xfw_workspace_group_signals[N_WORKSPACE_GROUP_SIGNALS] = { 0 };
+static GParamSpec *workspace_group_properties[WORKSPACE_GROUP_PROP_LAST - WORKSPACE_GROUP_PROP_SCREEN] = { NULL };
+static GQuark workspaces_model_quark = 0;
+
 G_DEFINE_FLAGS_TYPE(XfwWorkspaceGroupCapabilities, xfw_workspace_group_capabilities,
                     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_GROUP_CAPABILITIES_NONE, "none"),
                     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_GROUP_CAPABILITIES_CREATE_WORKSPACE, "create-workspace"),
                     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_GROUP_CAPABILITIES_MOVE_VIEWPORT, "move-viewport"),
                     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_GROUP_CAPABILITIES_SET_LAYOUT, "set-layout"))
 
+static void
+install_property(XfwWorkspaceGroupIface *iface, guint prop_id, GParamSpec *pspec) {
+    workspace_group_properties[prop_id - WORKSPACE_GROUP_PROP_SCREEN] = pspec;
+    g_object_interface_install_property(iface, pspec);
+}
+
 static void
 xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
+    workspaces_model_quark = g_quark_from_static_string("libxfce4windowing-workspaces-model");
+
     /**
      * XfwWorkspaceGroup::capabilities-changed:
      * @group: the object which received the signal.
@@ -70,15 +82,15 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when capabilities have changed on @group.
      **/
-    g_signal_new("capabilities-changed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, capabilities_changed),
-                 NULL, NULL,
-                 xfw_marshal_VOID__FLAGS_FLAGS,
-                 G_TYPE_NONE, 2,
-                 XFW_TYPE_WORKSPACE_GROUP_CAPABILITIES,
-                 XFW_TYPE_WORKSPACE_GROUP_CAPABILITIES);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_CAPABILITIES_CHANGED] = g_signal_new("capabilities-changed",
+                                                                                             XFW_TYPE_WORKSPACE_GROUP,
+                                                                                             G_SIGNAL_RUN_LAST,
+                                                                                             G_STRUCT_OFFSET(XfwWorkspaceGroupIface, capabilities_changed),
+                                                                                             NULL, NULL,
+                                                                                             xfw_marshal_VOID__FLAGS_FLAGS,
+                                                                                             G_TYPE_NONE, 2,
+                                                                                             XFW_TYPE_WORKSPACE_GROUP_CAPABILITIES,
+                                                                                             XFW_TYPE_WORKSPACE_GROUP_CAPABILITIES);
 
     /**
      * XfwWorkspaceGroup::active-workspace-changed:
@@ -88,14 +100,14 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when the active workspace of @group changes.
      **/
-    g_signal_new("active-workspace-changed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, active_workspace_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_ACTIVE_WORKSPACE_CHANGED] = g_signal_new("active-workspace-changed",
+                                                                                                 XFW_TYPE_WORKSPACE_GROUP,
+                                                                                                 G_SIGNAL_RUN_LAST,
+                                                                                                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, active_workspace_changed),
+                                                                                                 NULL, NULL,
+                                                                                                 g_cclosure_marshal_VOID__OBJECT,
+                                                                                                 G_TYPE_NONE, 1,
+                                                                                                 XFW_TYPE_WORKSPACE);
 
     /**
      * XfwWorkspaceGroup::monitor-added:
@@ -104,14 +116,14 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @group is added to a new monitor.
      **/
-    g_signal_new("monitor-added",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitor_added),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_MONITOR);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_ADDED] = g_signal_new("monitor-added",
+                                                                                      XFW_TYPE_WORKSPACE_GROUP,
+                                                                                      G_SIGNAL_RUN_LAST,
+                                                                                      G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitor_added),
+                                                                                      NULL, NULL,
+                                                                                      g_cclosure_marshal_VOID__OBJECT,
+                                                                                      G_TYPE_NONE, 1,
+                                                                                      XFW_TYPE_MONITOR);
 
     /**
      * XfwWorkspaceGroup::monitor-removed:
@@ -120,14 +132,14 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @group is removed from a monitor.
      **/
-    g_signal_new("monitor-removed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitor_removed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_MONITOR);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITOR_REMOVED] = g_signal_new("monitor-removed",
+                                                                                        XFW_TYPE_WORKSPACE_GROUP,
+                                                                                        G_SIGNAL_RUN_LAST,
+                                                                                        G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitor_removed),
+                                                                                        NULL, NULL,
+                                                                                        g_cclosure_marshal_VOID__OBJECT,
+                                                                                        G_TYPE_NONE, 1,
+                                                                                        XFW_TYPE_MONITOR);
 
     /**
      * XfwWorkspaceGroup::monitors-changed:
@@ -135,13 +147,13 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @group moves to a new set of monitors.
      **/
-    g_signal_new("monitors-changed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitors_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_MONITORS_CHANGED] = g_signal_new("monitors-changed",
+                                                                                         XFW_TYPE_WORKSPACE_GROUP,
+                                                                                         G_SIGNAL_RUN_LAST,
+                                                                                         G_STRUCT_OFFSET(XfwWorkspaceGroupIface, monitors_changed),
+                                                                                         NULL, NULL,
+                                                                                         g_cclosure_marshal_VOID__VOID,
+                                                                                         G_TYPE_NONE, 0);
 
     /**
      * XfwWorkspaceGroup::workspace-added:
@@ -150,14 +162,14 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @workspace joins @group.
      */
-    g_signal_new("workspace-added",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, workspace_added),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_ADDED] = g_signal_new("workspace-added",
+                                                                                        XFW_TYPE_WORKSPACE_GROUP,
+                                                                                        G_SIGNAL_RUN_LAST,
+                                                                                        G_STRUCT_OFFSET(XfwWorkspaceGroupIface, workspace_added),
+                                                                                        NULL, NULL,
+                                                                                        g_cclosure_marshal_VOID__OBJECT,
+                                                                                        G_TYPE_NONE, 1,
+                                                                                        XFW_TYPE_WORKSPACE);
 
     /**
      * XfwWorkspaceGroup::workspace-removed:
@@ -166,14 +178,14 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @workspace leaves @group.
      */
-    g_signal_new("workspace-removed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, workspace_removed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_REMOVED] = g_signal_new("workspace-removed",
+                                                                                          XFW_TYPE_WORKSPACE_GROUP,
+                                                                                          G_SIGNAL_RUN_LAST,
+                                                                                          G_STRUCT_OFFSET(XfwWorkspaceGroupIface, workspace_removed),
+                                                                                          NULL, NULL,
+                                                                                          g_cclosure_marshal_VOID__OBJECT,
+                                                                                          G_TYPE_NONE, 1,
+                                                                                          XFW_TYPE_WORKSPACE);
 
     /**
      * XfwWorkspaceGroup::viewports-changed:
@@ -181,71 +193,76 @@ xfw_workspace_group_default_init(XfwWorkspaceGroupIface *iface) {
      *
      * Emitted when @group's viewport coordinates have changed.
      **/
-    g_signal_new("viewports-changed",
-                 XFW_TYPE_WORKSPACE_GROUP,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceGroupIface, viewports_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_VIEWPORTS_CHANGED] = g_signal_new("viewports-changed",
+                                                                                          XFW_TYPE_WORKSPACE_GROUP,
+                                                                                          G_SIGNAL_RUN_LAST,
+                                                                                          G_STRUCT_OFFSET(XfwWorkspaceGroupIface, viewports_changed),
+                                                                                          NULL, NULL,
+                                                                                          g_cclosure_marshal_VOID__VOID,
+                                                                                          G_TYPE_NONE, 0);
 
     /**
      * XfwWorkspaceGroup:screen:
      *
      * The #XfwScreen that owns this #XfwWorkspaceGroup.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_object("screen",
-                                                            "screen",
-                                                            "screen",
-                                                            XFW_TYPE_SCREEN,
-                                                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_GROUP_PROP_SCREEN,
+                     g_param_spec_object("screen",
+                                         "screen",
+                                         "screen",
+                                         XFW_TYPE_SCREEN,
+                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspaceGroup:workspace-manager:
      *
      * The #XfwWorkspaceManager instance that manages this #XfwWorkspaceGroup.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_object("workspace-manager",
-                                                            "workspace-manager",
-                                                            "workspace-manager",
-                                                            XFW_TYPE_WORKSPACE_MANAGER,
-                                                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_GROUP_PROP_WORKSPACE_MANAGER,
+                     g_param_spec_object("workspace-manager",
+                                         "workspace-manager",
+                                         "workspace-manager",
+                                         XFW_TYPE_WORKSPACE_MANAGER,
+                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspaceGroup:workspaces: (type GList(XfwWorkspace))
      *
      * The list of #XfwWorkspace in this #XfwWorkspaceGroup.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_pointer("workspaces",
-                                                             "workspaces",
-                                                             "workspaces",
-                                                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_GROUP_PROP_WORKSPACES,
+                     g_param_spec_pointer("workspaces",
+                                          "workspaces",
+                                          "workspaces",
+                                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspaceGroup:active-workspace:
      *
      * The active #XfwWorkspace on this #XfwWorkspaceGroup, or %NULL.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_object("active-workspace",
-                                                            "active-workspace",
-                                                            "active-workspace",
-                                                            XFW_TYPE_WORKSPACE,
-                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_GROUP_PROP_ACTIVE_WORKSPACE,
+                     g_param_spec_object("active-workspace",
+                                         "active-workspace",
+                                         "active-workspace",
+                                         XFW_TYPE_WORKSPACE,
+                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspaceGroup:monitors: (type GList(XfwMonitor))
      *
      * The list of #XfwMonitor this #XfwWorkspaceGroup is displayed on.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_pointer("monitors",
-                                                             "monitors",
-                                                             "monitors",
-                                                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_GROUP_PROP_MONITORS,
+                     g_param_spec_pointer("monitors",
+                                          "monitors",
+                                          "monitors",
+                                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -298,6 +315,57 @@ xfw_workspace_group_list_workspaces(XfwWorkspaceGroup *group) {
     return (*iface->list_workspaces)(group);
 }
 
+static void
+sync_workspaces_model(XfwWorkspaceGroup *group) {
+    GListStore *model = g_object_get_qdata(G_OBJECT(group), workspaces_model_quark);
+    _xfw_list_store_sync(model, xfw_workspace_group_list_workspaces(group));
+}
+
+static void
+workspace_added_or_removed(XfwWorkspaceGroup *group, XfwWorkspace *workspace, gpointer user_data) {
+    sync_workspaces_model(group);
+}
+
+static void
+workspaces_notified(XfwWorkspaceGroup *group, GParamSpec *pspec, gpointer user_data) {
+    sync_workspaces_model(group);
+}
+
+/**
+ * xfw_workspace_group_get_workspaces_model:
+ * @group: an #XfwWorkspaceGroup.
+ *
+ * Retrieves a #GListModel of the workspaces in @group, in the same order as
+ * #xfw_workspace_group_list_workspaces().
+ *
+ * The model is kept up to date as workspaces are added to and removed from
+ * @group, and emits #GListModel::items-changed for exactly the workspaces
+ * that changed.
+ *
+ * Return value: (not nullable) (transfer none): a #GListModel of
+ * #XfwWorkspace, owned by @group.
+ *
+ * Since: 4.21.0
+ **/
+GListModel *
+xfw_workspace_group_get_workspaces_model(XfwWorkspaceGroup *group) {
+    g_return_val_if_fail(XFW_IS_WORKSPACE_GROUP(group), NULL);
+
+    GListStore *model = g_object_get_qdata(G_OBJECT(group), workspaces_model_quark);
+    if (model == NULL) {
+        model = g_list_store_new(XFW_TYPE_WORKSPACE);
+        g_object_set_qdata_full(G_OBJECT(group), workspaces_model_quark, model, g_object_unref);
+        sync_workspaces_model(group);
+
+        // The backends update their lists before emitting either of these
+        g_signal_connect(group, "workspace-added", G_CALLBACK(workspace_added_or_removed), NULL);
+        g_signal_connect(group, "workspace-removed", G_CALLBACK(workspace_added_or_removed), NULL);
+        g_signal_connect(group, "notify::workspaces", G_CALLBACK(workspaces_notified), NULL);
+    }
+
+    return G_LIST_MODEL(model);
+}
+
 /**
  * xfw_workspace_group_get_active_workspace:
  * @group: an #XfwWorkspaceGroup.
@@ -425,6 +493,11 @@ xfw_workspace_group_set_layout(XfwWorkspaceGroup *group, gint rows, gint columns
     return (*iface->move_viewport)(group, rows, columns, error);
 }
 
+void
+_xfw_workspace_group_notify(XfwWorkspaceGroup *group, guint prop_id) {
+    g_object_notify_by_pspec(G_OBJECT(group), workspace_group_properties[prop_id - WORKSPACE_GROUP_PROP_SCREEN]);
+}
+
 void
 _xfw_workspace_group_install_properties(GObjectClass *gklass) {
     g_object_class_override_property(gklass, WORKSPACE_GROUP_PROP_SCREEN, "screen");
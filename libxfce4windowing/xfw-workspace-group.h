@@ -65,6 +65,7 @@ GType xfw_workspace_group_capabilities_get_type(void);
 XfwWorkspaceGroupCapabilities xfw_workspace_group_get_capabilities(XfwWorkspaceGroup *group);
 guint xfw_workspace_group_get_workspace_count(XfwWorkspaceGroup *group);
 GList *xfw_workspace_group_list_workspaces(XfwWorkspaceGroup *group);
+GListModel *xfw_workspace_group_get_workspaces_model(XfwWorkspaceGroup *group);
 XfwWorkspace *xfw_workspace_group_get_active_workspace(XfwWorkspaceGroup *group);
 GList *xfw_workspace_group_get_monitors(XfwWorkspaceGroup *group);
 XfwWorkspaceManager *xfw_workspace_group_get_workspace_manager(XfwWorkspaceGroup *group);
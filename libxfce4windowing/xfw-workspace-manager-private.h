@@ -28,6 +28,17 @@
 
 G_BEGIN_DECLS
 
+enum {
+    WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_CREATED,
+    WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_DESTROYED,
+    WORKSPACE_MANAGER_SIGNAL_WORKSPACE_CREATED,
+    WORKSPACE_MANAGER_SIGNAL_WORKSPACE_DESTROYED,
+    N_WORKSPACE_MANAGER_SIGNALS,
+};
+
+// Signal ids, indexed by WORKSPACE_MANAGER_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_workspace_manager_signals[N_WORKSPACE_MANAGER_SIGNALS];
+
 struct _XfwWorkspaceManagerInterface {
     /*< private >*/
     GTypeInterface g_iface;
@@ -45,7 +45,15 @@ struct _XfwWorkspaceManagerWaylandPrivate {
     struct ext_workspace_manager_v1 *handle;
     XfwScreen *screen;
     GList *groups;
+
+    // Indexed by workspace number
+    GPtrArray *workspaces_array;
+    // ext_workspace_handle_v1 -> XfwWorkspaceWayland
+    GHashTable *workspaces_by_handle;
+    // Built from workspaces_array on demand.  Callers don't own it, so a
+    // stale list is only freed when the next one is built.
     GList *workspaces;
+    gboolean workspaces_valid;
 };
 
 static void xfw_workspace_manager_wayland_manager_init(XfwWorkspaceManagerIface *iface);
@@ -101,6 +109,8 @@ xfw_workspace_manager_wayland_manager_init(XfwWorkspaceManagerIface *iface) {
 static void
 xfw_workspace_manager_wayland_init(XfwWorkspaceManagerWayland *manager) {
     manager->priv = xfw_workspace_manager_wayland_get_instance_private(manager);
+    manager->priv->workspaces_array = g_ptr_array_new_with_free_func(g_object_unref);
+    manager->priv->workspaces_by_handle = g_hash_table_new(g_direct_hash, g_direct_equal);
 }
 
 static void
@@ -154,7 +164,9 @@ xfw_workspace_manager_wayland_finalize(GObject *obj) {
     XfwWorkspaceManagerWayland *manager = XFW_WORKSPACE_MANAGER_WAYLAND(obj);
     XfwWorkspaceManagerWaylandPrivate *priv = manager->priv;
 
-    g_list_free_full(priv->workspaces, g_object_unref);
+    g_list_free(priv->workspaces);
+    g_hash_table_destroy(priv->workspaces_by_handle);
+    g_ptr_array_free(priv->workspaces_array, TRUE);
     g_list_free_full(priv->groups, g_object_unref);
 
     ext_workspace_manager_v1_destroy(priv->handle);
@@ -170,15 +182,31 @@ xfw_workspace_manager_wayland_list_workspace_groups(XfwWorkspaceManager *manager
 
 static GList *
 xfw_workspace_manager_wayland_list_workspaces(XfwWorkspaceManager *manager) {
-    XfwWorkspaceManagerWayland *wmanager = XFW_WORKSPACE_MANAGER_WAYLAND(manager);
-    return wmanager->priv->workspaces;
+    XfwWorkspaceManagerWaylandPrivate *priv = XFW_WORKSPACE_MANAGER_WAYLAND(manager)->priv;
+
+    if (!priv->workspaces_valid) {
+        GList *workspaces = NULL;
+        for (guint i = priv->workspaces_array->len; i > 0; --i) {
+            workspaces = g_list_prepend(workspaces, g_ptr_array_index(priv->workspaces_array, i - 1));
+        }
+        g_list_free(priv->workspaces);
+        priv->workspaces = workspaces;
+        priv->workspaces_valid = TRUE;
+    }
+
+    return priv->workspaces;
+}
+
+static void
+invalidate_workspaces(XfwWorkspaceManagerWayland *manager) {
+    manager->priv->workspaces_valid = FALSE;
 }
 
 static void
 group_destroyed(XfwWorkspaceGroupWayland *group, XfwWorkspaceManagerWayland *manager) {
     g_signal_handlers_disconnect_by_func(group, group_destroyed, manager);
     manager->priv->groups = g_list_remove(manager->priv->groups, group);
-    g_signal_emit_by_name(manager, "workspace-group-destroyed", group);
+    g_signal_emit(manager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_DESTROYED], 0, group);
     g_object_unref(group);
 }
 
@@ -192,29 +220,28 @@ manager_workspace_group(void *data, struct ext_workspace_manager_v1 *manager, st
                                                    NULL);
     wmanager->priv->groups = g_list_append(wmanager->priv->groups, group);
     g_signal_connect(group, "destroyed", G_CALLBACK(group_destroyed), wmanager);
-    g_signal_emit_by_name(wmanager, "workspace-group-created", group);
+    g_signal_emit(wmanager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_CREATED], 0, group);
 }
 
 static void
 workspace_destroyed(XfwWorkspace *workspace, XfwWorkspaceManagerWayland *manager) {
-    GList *cur;
+    XfwWorkspaceManagerWaylandPrivate *priv = manager->priv;
 
     g_signal_handlers_disconnect_by_data(workspace, manager);
 
-    cur = g_list_find(manager->priv->workspaces, workspace);
-    if (cur != NULL) {
-        GList *link = cur;
-        cur = cur->next;
-        manager->priv->workspaces = g_list_delete_link(manager->priv->workspaces, link);
+    g_hash_table_remove(priv->workspaces_by_handle, _xfw_workspace_wayland_get_handle(XFW_WORKSPACE_WAYLAND(workspace)));
 
-        for (; cur != NULL; cur = cur->next) {
-            XfwWorkspace *cur_workspace = XFW_WORKSPACE(cur->data);
-            guint cur_number = xfw_workspace_get_number(cur_workspace);
-            _xfw_workspace_wayland_set_number(XFW_WORKSPACE_WAYLAND(cur_workspace), cur_number - 1);
+    // A workspace's number is its index in the array
+    guint number = xfw_workspace_get_number(workspace);
+    if (number < priv->workspaces_array->len && g_ptr_array_index(priv->workspaces_array, number) == workspace) {
+        g_ptr_array_steal_index(priv->workspaces_array, number);
+        for (guint i = number; i < priv->workspaces_array->len; ++i) {
+            _xfw_workspace_wayland_set_number(XFW_WORKSPACE_WAYLAND(g_ptr_array_index(priv->workspaces_array, i)), i);
         }
+        invalidate_workspaces(manager);
     }
 
-    g_signal_emit_by_name(manager, "workspace-destroyed", workspace);
+    g_signal_emit(manager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_DESTROYED], 0, workspace);
     g_object_unref(workspace);
 }
 
@@ -225,10 +252,12 @@ manager_workspace(void *data, struct ext_workspace_manager_v1 *manager, struct e
                                                                         "handle", wl_workspace,
                                                                         NULL));
     _xfw_workspace_wayland_set_workspace_manager_handle(workspace, wmanager->priv->handle);
-    _xfw_workspace_wayland_set_number(workspace, g_list_length(wmanager->priv->workspaces));
-    wmanager->priv->workspaces = g_list_append(wmanager->priv->workspaces, workspace);
+    _xfw_workspace_wayland_set_number(workspace, wmanager->priv->workspaces_array->len);
+    g_ptr_array_add(wmanager->priv->workspaces_array, workspace);
+    g_hash_table_insert(wmanager->priv->workspaces_by_handle, wl_workspace, workspace);
+    invalidate_workspaces(wmanager);
     g_signal_connect(workspace, "destroyed", G_CALLBACK(workspace_destroyed), wmanager);
-    g_signal_emit_by_name(wmanager, "workspace-created", workspace);
+    g_signal_emit(wmanager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_CREATED], 0, workspace);
 }
 
 static void
@@ -249,11 +278,5 @@ _xfw_workspace_manager_wayland_new(XfwScreenWayland *screen, struct ext_workspac
 
 XfwWorkspace *
 _xfw_workspace_manager_wayland_workspace_for_handle(XfwWorkspaceManagerWayland *manager, struct ext_workspace_handle_v1 *ext_workspace) {
-    for (GList *l = manager->priv->workspaces; l != NULL; l = l->next) {
-        XfwWorkspaceWayland *workspace = XFW_WORKSPACE_WAYLAND(l->data);
-        if (_xfw_workspace_wayland_get_handle(workspace) == ext_workspace) {
-            return XFW_WORKSPACE(workspace);
-        }
-    }
-    return NULL;
+    return g_hash_table_lookup(manager->priv->workspaces_by_handle, ext_workspace);
 }
@@ -27,8 +27,10 @@
 #include "libxfce4windowing-private.h"
 #include "xfw-screen-private.h"
 #include "xfw-workspace-group-dummy.h"
+#include "xfw-workspace-group-private.h"
 #include "xfw-workspace-manager-private.h"
 #include "xfw-workspace-manager-x11.h"
+#include "xfw-workspace-private.h"
 #include "xfw-workspace-x11.h"
 
 struct _XfwWorkspaceManagerX11Private {
@@ -38,7 +40,8 @@ struct _XfwWorkspaceManagerX11Private {
     GList *workspaces;
     GHashTable *wnck_workspaces;
     GHashTable *pending_workspace_names;
-    guint workspace_prop_changed_timeout_id;
+    Atom workspace_prop_atoms[4];
+    guint workspace_prop_changed_idle_id;
 };
 
 static void xfw_workspace_manager_x11_manager_init(XfwWorkspaceManagerIface *iface);
@@ -58,7 +61,8 @@ static gboolean group_create_workspace(XfwWorkspaceGroup *group, const gchar *na
 static gboolean group_move_viewport(XfwWorkspaceGroup *group, gint x, gint y, GError **error);
 static gboolean group_set_layout(XfwWorkspaceGroup *group, gint rows, gint columns, GError **error);
 
-static gboolean check_workspace_properties_changed(XfwWorkspaceManager *manager);
+static GdkFilterReturn rootwin_event_filter(GdkXEvent *gxevent, GdkEvent *event, gpointer data);
+static gboolean check_workspace_properties_changed(XfwWorkspaceManagerX11 *manager);
 
 G_DEFINE_FINAL_TYPE_WITH_CODE(XfwWorkspaceManagerX11, xfw_workspace_manager_x11, G_TYPE_OBJECT,
                               G_ADD_PRIVATE(XfwWorkspaceManagerX11)
@@ -133,7 +137,29 @@ xfw_workspace_manager_x11_constructed(GObject *obj) {
 
     manager->priv->pending_workspace_names = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
 
-    manager->priv->workspace_prop_changed_timeout_id = g_timeout_add_seconds(10, (GSourceFunc)check_workspace_properties_changed, manager);
+    // Workspace geometry and layout only change when the WM updates one of
+    // these root window properties
+    GdkDisplay *display = gdk_screen_get_display(gdkscreen);
+    static const gchar *workspace_prop_names[] = {
+        "_NET_DESKTOP_GEOMETRY",
+        "_NET_DESKTOP_VIEWPORT",
+        "_NET_DESKTOP_LAYOUT",
+        "_NET_NUMBER_OF_DESKTOPS",
+    };
+    G_STATIC_ASSERT(G_N_ELEMENTS(workspace_prop_names) == G_N_ELEMENTS(priv->workspace_prop_atoms));
+    for (gsize i = 0; i < G_N_ELEMENTS(workspace_prop_names); ++i) {
+        priv->workspace_prop_atoms[i] = gdk_x11_get_xatom_by_name_for_display(display, workspace_prop_names[i]);
+    }
+
+    GdkWindow *rootwin = gdk_screen_get_root_window(gdkscreen);
+    Display *dpy = gdk_x11_display_get_xdisplay(display);
+    Window xrootwin = gdk_x11_window_get_xid(rootwin);
+    gdk_x11_display_error_trap_push(display);
+    XWindowAttributes winattrs;
+    XGetWindowAttributes(dpy, xrootwin, &winattrs);
+    XSelectInput(dpy, xrootwin, winattrs.your_event_mask | PropertyChangeMask);
+    gdk_x11_display_error_trap_pop_ignored(display);
+    gdk_window_add_filter(rootwin, rootwin_event_filter, manager);
 
     G_OBJECT_CLASS(xfw_workspace_manager_x11_parent_class)->constructed(obj);
 }
@@ -173,10 +199,13 @@ xfw_workspace_manager_x11_finalize(GObject *obj) {
     XfwWorkspaceManagerX11 *manager = XFW_WORKSPACE_MANAGER_X11(obj);
     XfwWorkspaceManagerX11Private *priv = manager->priv;
 
-    if (priv->workspace_prop_changed_timeout_id != 0) {
-        g_source_remove(priv->workspace_prop_changed_timeout_id);
+    if (priv->workspace_prop_changed_idle_id != 0) {
+        g_source_remove(priv->workspace_prop_changed_idle_id);
     }
 
+    GdkWindow *rootwin = gdk_screen_get_root_window(_xfw_screen_get_gdk_screen(priv->screen));
+    gdk_window_remove_filter(rootwin, rootwin_event_filter, manager);
+
     g_signal_handlers_disconnect_by_data(priv->wnck_screen, manager);
     g_list_free(priv->workspaces);
     g_hash_table_destroy(priv->wnck_workspaces);
@@ -211,12 +240,12 @@ active_workspace_changed(WnckScreen *screen, WnckWorkspace *previous_wnck_worksp
 
     _xfw_workspace_group_dummy_set_active_workspace(XFW_WORKSPACE_GROUP_DUMMY(group), XFW_WORKSPACE(active_workspace));
     if (previous_workspace != NULL) {
-        g_object_notify(G_OBJECT(previous_workspace), "state");
-        g_signal_emit_by_name(previous_workspace, "state-changed", XFW_WORKSPACE_STATE_ACTIVE, xfw_workspace_get_state(XFW_WORKSPACE(previous_workspace)));
+        _xfw_workspace_notify(XFW_WORKSPACE(previous_workspace), WORKSPACE_PROP_STATE);
+        g_signal_emit(previous_workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_STATE_CHANGED], 0, XFW_WORKSPACE_STATE_ACTIVE, xfw_workspace_get_state(XFW_WORKSPACE(previous_workspace)));
     }
 
-    g_object_notify(G_OBJECT(active_workspace), "state");
-    g_signal_emit_by_name(active_workspace, "state-changed", XFW_WORKSPACE_STATE_ACTIVE, xfw_workspace_get_state(XFW_WORKSPACE(active_workspace)));
+    _xfw_workspace_notify(XFW_WORKSPACE(active_workspace), WORKSPACE_PROP_STATE);
+    g_signal_emit(active_workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_STATE_CHANGED], 0, XFW_WORKSPACE_STATE_ACTIVE, xfw_workspace_get_state(XFW_WORKSPACE(active_workspace)));
 }
 
 static void
@@ -238,9 +267,9 @@ workspace_created(WnckScreen *screen, WnckWorkspace *wnck_workspace, XfwWorkspac
     g_object_freeze_notify(G_OBJECT(manager->priv->groups->data));
     _xfw_workspace_group_dummy_set_workspaces(XFW_WORKSPACE_GROUP_DUMMY(manager->priv->groups->data), manager->priv->workspaces);
     _xfw_workspace_x11_set_workspace_group(workspace, XFW_WORKSPACE_GROUP(manager->priv->groups->data));
-    g_signal_emit_by_name(manager, "workspace-created", workspace);
+    g_signal_emit(manager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_CREATED], 0, workspace);
     g_object_thaw_notify(G_OBJECT(manager->priv->groups->data));
-    g_signal_emit_by_name(manager->priv->groups->data, "workspace-added", workspace);
+    g_signal_emit(manager->priv->groups->data, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_ADDED], 0, workspace);
 }
 
 static void
@@ -259,8 +288,8 @@ workspace_destroyed(WnckScreen *screen, WnckWorkspace *wnck_workspace, XfwWorksp
         manager->priv->workspaces = g_list_remove(manager->priv->workspaces, workspace);
 
         _xfw_workspace_group_dummy_set_workspaces(XFW_WORKSPACE_GROUP_DUMMY(manager->priv->groups->data), manager->priv->workspaces);
-        g_signal_emit_by_name(manager->priv->groups->data, "workspace-removed", workspace);
-        g_signal_emit_by_name(manager, "workspace-destroyed", workspace);
+        g_signal_emit(manager->priv->groups->data, _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_WORKSPACE_REMOVED], 0, workspace);
+        g_signal_emit(manager, _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_DESTROYED], 0, workspace);
 
         g_object_unref(workspace);
     }
@@ -268,7 +297,7 @@ workspace_destroyed(WnckScreen *screen, WnckWorkspace *wnck_workspace, XfwWorksp
 
 static void
 viewports_changed(WnckScreen *screen, XfwWorkspaceManagerX11 *manager) {
-    g_signal_emit_by_name(XFW_WORKSPACE_GROUP(manager->priv->groups->data), "viewports-changed");
+    g_signal_emit(XFW_WORKSPACE_GROUP(manager->priv->groups->data), _xfw_workspace_group_signals[WORKSPACE_GROUP_SIGNAL_VIEWPORTS_CHANGED], 0);
 }
 
 static gboolean
@@ -302,13 +331,39 @@ group_set_layout(XfwWorkspaceGroup *group, gint rows, gint columns, GError **err
     return TRUE;
 }
 
+static GdkFilterReturn
+rootwin_event_filter(GdkXEvent *gxevent, GdkEvent *event, gpointer data) {
+    XfwWorkspaceManagerX11 *manager = XFW_WORKSPACE_MANAGER_X11(data);
+    XfwWorkspaceManagerX11Private *priv = manager->priv;
+    XEvent *xevent = (XEvent *)gxevent;
+
+    if (xevent->type == PropertyNotify && priv->workspace_prop_changed_idle_id == 0) {
+        for (gsize i = 0; i < G_N_ELEMENTS(priv->workspace_prop_atoms); ++i) {
+            if (xevent->xproperty.atom == priv->workspace_prop_atoms[i]) {
+                // libwnck picks up the new values in an idle of its own, so
+                // check after it has done so, and only once for a burst of
+                // property changes
+                priv->workspace_prop_changed_idle_id = g_idle_add_full(G_PRIORITY_LOW,
+                                                                       (GSourceFunc)check_workspace_properties_changed,
+                                                                       manager,
+                                                                       NULL);
+                break;
+            }
+        }
+    }
+
+    return GDK_FILTER_CONTINUE;
+}
+
 static gboolean
-check_workspace_properties_changed(XfwWorkspaceManager *manager) {
-    for (GList *l = xfw_workspace_manager_list_workspaces(manager); l != NULL; l = l->next) {
+check_workspace_properties_changed(XfwWorkspaceManagerX11 *manager) {
+    manager->priv->workspace_prop_changed_idle_id = 0;
+
+    for (GList *l = manager->priv->workspaces; l != NULL; l = l->next) {
         _xfw_workspace_x11_check_properties_changed(XFW_WORKSPACE_X11(l->data));
     }
 
-    return TRUE;
+    return G_SOURCE_REMOVE;
 }
 
 XfwWorkspaceManager *
@@ -43,6 +43,8 @@
 
 G_DEFINE_INTERFACE(XfwWorkspaceManager, xfw_workspace_manager, G_TYPE_OBJECT)
 
+guint _xfw_workspace_manager_signals[N_WORKSPACE_MANAGER_SIGNALS] = { 0 };
+
 static void
 xfw_workspace_manager_default_init(XfwWorkspaceManagerIface *iface) {
     /**
@@ -52,14 +54,14 @@ xfw_workspace_manager_default_init(XfwWorkspaceManagerIface *iface) {
      *
      * Emitted when a new workspace group is craeted.
      **/
-    g_signal_new("workspace-group-created",
-                 XFW_TYPE_WORKSPACE_MANAGER,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_group_created),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE_GROUP);
+    _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_CREATED] = g_signal_new("workspace-group-created",
+                                                                                                    XFW_TYPE_WORKSPACE_MANAGER,
+                                                                                                    G_SIGNAL_RUN_LAST,
+                                                                                                    G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_group_created),
+                                                                                                    NULL, NULL,
+                                                                                                    g_cclosure_marshal_VOID__OBJECT,
+                                                                                                    G_TYPE_NONE, 1,
+                                                                                                    XFW_TYPE_WORKSPACE_GROUP);
 
     /**
      * XfwWorkspaceManager::workspace-group-destroyed:
@@ -68,14 +70,14 @@ xfw_workspace_manager_default_init(XfwWorkspaceManagerIface *iface) {
      *
      * Emitted when a workspace group is destroyed.
      **/
-    g_signal_new("workspace-group-destroyed",
-                 XFW_TYPE_WORKSPACE_MANAGER,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_group_created),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE_GROUP);
+    _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_GROUP_DESTROYED] = g_signal_new("workspace-group-destroyed",
+                                                                                                      XFW_TYPE_WORKSPACE_MANAGER,
+                                                                                                      G_SIGNAL_RUN_LAST,
+                                                                                                      G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_group_created),
+                                                                                                      NULL, NULL,
+                                                                                                      g_cclosure_marshal_VOID__OBJECT,
+                                                                                                      G_TYPE_NONE, 1,
+                                                                                                      XFW_TYPE_WORKSPACE_GROUP);
 
 
     /**
@@ -85,14 +87,14 @@ xfw_workspace_manager_default_init(XfwWorkspaceManagerIface *iface) {
      *
      * Emitted when a new workspace is created.
      **/
-    g_signal_new("workspace-created",
-                 XFW_TYPE_WORKSPACE_MANAGER,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_created),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE);
+    _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_CREATED] = g_signal_new("workspace-created",
+                                                                                              XFW_TYPE_WORKSPACE_MANAGER,
+                                                                                              G_SIGNAL_RUN_LAST,
+                                                                                              G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_created),
+                                                                                              NULL, NULL,
+                                                                                              g_cclosure_marshal_VOID__OBJECT,
+                                                                                              G_TYPE_NONE, 1,
+                                                                                              XFW_TYPE_WORKSPACE);
 
     /**
      * XfwWorkspaceManager::workspace-destroyed:
@@ -101,14 +103,14 @@ xfw_workspace_manager_default_init(XfwWorkspaceManagerIface *iface) {
      *
      * Emitted when a workspace is destroyed.
      **/
-    g_signal_new("workspace-destroyed",
-                 XFW_TYPE_WORKSPACE_MANAGER,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_destroyed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE);
+    _xfw_workspace_manager_signals[WORKSPACE_MANAGER_SIGNAL_WORKSPACE_DESTROYED] = g_signal_new("workspace-destroyed",
+                                                                                                XFW_TYPE_WORKSPACE_MANAGER,
+                                                                                                G_SIGNAL_RUN_LAST,
+                                                                                                G_STRUCT_OFFSET(XfwWorkspaceManagerIface, workspace_destroyed),
+                                                                                                NULL, NULL,
+                                                                                                g_cclosure_marshal_VOID__OBJECT,
+                                                                                                G_TYPE_NONE, 1,
+                                                                                                XFW_TYPE_WORKSPACE);
 
     /**
      * XfwWorkspaceManager:screen:
@@ -28,6 +28,18 @@
 
 G_BEGIN_DECLS
 
+enum {
+    WORKSPACE_SIGNAL_NAME_CHANGED,
+    WORKSPACE_SIGNAL_CAPABILITIES_CHANGED,
+    WORKSPACE_SIGNAL_STATE_CHANGED,
+    WORKSPACE_SIGNAL_GROUP_CHANGED,
+    WORKSPACE_SIGNAL_WINDOW_ADDED,
+    WORKSPACE_SIGNAL_WINDOW_REMOVED,
+    N_WORKSPACE_SIGNALS,
+};
+
+// Signal ids, indexed by WORKSPACE_SIGNAL_*, for emitting without a name lookup
+extern guint _xfw_workspace_signals[N_WORKSPACE_SIGNALS];
 
 struct _XfwWorkspaceInterface {
     /*< private >*/
@@ -59,6 +71,9 @@ struct _XfwWorkspaceInterface {
     gboolean (*assign_to_workspace_group)(XfwWorkspace *workspace, XfwWorkspaceGroup *group, GError **error);
 };
 
+// Notifies a change to one of the WORKSPACE_PROP_* properties
+void _xfw_workspace_notify(XfwWorkspace *workspace, guint prop_id);
+
 G_END_DECLS
 
 #endif /* !__XFW_WORKSPACE_PRIVATE_H__ */
@@ -379,14 +379,14 @@ workspace_id(void *data, struct ext_workspace_handle_v1 *wl_workspace, const cha
     XfwWorkspaceWayland *workspace = XFW_WORKSPACE_WAYLAND(data);
     g_free(workspace->priv->id);
     workspace->priv->id = g_strdup(id);
-    g_object_notify(G_OBJECT(workspace), "id");
+    _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_ID);
 }
 
 static void
 workspace_name(void *data, struct ext_workspace_handle_v1 *wl_workspace, const char *name) {
     XfwWorkspaceWayland *workspace = XFW_WORKSPACE_WAYLAND(data);
     g_object_set(workspace, "name", name, NULL);
-    g_signal_emit_by_name(workspace, "name-changed");
+    g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_NAME_CHANGED], 0);
 }
 
 static void
@@ -399,11 +399,11 @@ workspace_coordinates(void *data, struct ext_workspace_handle_v1 *wl_workspace,
 
     if (coordinates->size >= 1 && (int32_t)array_start[0] != workspace->priv->column) {
         workspace->priv->column = array_start[0];
-        g_object_notify(G_OBJECT(workspace), "layout-column");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_LAYOUT_COLUMN);
     }
     if (coordinates->size >= 2 && (int32_t)array_start[1] != workspace->priv->row) {
         workspace->priv->row = array_start[1];
-        g_object_notify(G_OBJECT(workspace), "layout-row");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_LAYOUT_ROW);
     }
 
     g_object_thaw_notify(G_OBJECT(workspace));
@@ -434,8 +434,8 @@ workspace_state(void *data, struct ext_workspace_handle_v1 *wl_workspace, uint32
 
     workspace->priv->state = new_state;
     changed_mask = old_state ^ new_state;
-    g_object_notify(G_OBJECT(workspace), "state");
-    g_signal_emit_by_name(workspace, "state-changed", changed_mask, new_state);
+    _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_STATE);
+    g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_STATE_CHANGED], 0, changed_mask, new_state);
     if (workspace->priv->group != NULL && (changed_mask & XFW_WORKSPACE_STATE_ACTIVE) != 0) {
         if ((new_state & XFW_WORKSPACE_STATE_ACTIVE) != 0) {
             _xfw_workspace_group_wayland_set_active_workspace(XFW_WORKSPACE_GROUP_WAYLAND(workspace->priv->group), XFW_WORKSPACE(workspace));
@@ -476,8 +476,8 @@ workspace_capabilities(void *data, struct ext_workspace_handle_v1 *wl_workspace,
 
     workspace->priv->capabilities = new_capabilities;
     changed_mask = old_capabilities ^ new_capabilities;
-    g_object_notify(G_OBJECT(workspace), "capabilities");
-    g_signal_emit_by_name(workspace, "capabilities-changed", changed_mask, new_capabilities);
+    _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_CAPABILITIES);
+    g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_CAPABILITIES_CHANGED], 0, changed_mask, new_capabilities);
 }
 
 static void
@@ -506,7 +506,7 @@ group_monitors_changed(XfwWorkspaceGroup *group, XfwWorkspaceWayland *workspace)
 
     if (!gdk_rectangle_equal(&new_geom, &workspace->priv->geometry)) {
         workspace->priv->geometry = new_geom;
-        g_object_notify(G_OBJECT(workspace), "geometry");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_GEOMETRY);
     }
 }
 
@@ -519,7 +519,7 @@ void
 _xfw_workspace_wayland_set_number(XfwWorkspaceWayland *workspace, guint number) {
     if (number != workspace->priv->number) {
         workspace->priv->number = number;
-        g_object_notify(G_OBJECT(workspace), "number");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_NUMBER);
     }
 }
 
@@ -544,7 +544,7 @@ _xfw_workspace_wayland_set_workspace_group(XfwWorkspaceWayland *workspace, XfwWo
             }
         }
 
-        g_signal_emit_by_name(workspace, "group-changed", previous_group);
+        g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_GROUP_CHANGED], 0, previous_group);
     }
 }
 
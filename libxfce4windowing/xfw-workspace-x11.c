@@ -365,8 +365,8 @@ xfw_workspace_x11_assign_to_workspace_group(XfwWorkspace *workspace, XfwWorkspac
 
 static void
 name_changed(WnckWorkspace *wnck_workspace, XfwWorkspaceX11 *workspace) {
-    g_object_notify(G_OBJECT(workspace), "name");
-    g_signal_emit_by_name(workspace, "name-changed");
+    _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_NAME);
+    g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_NAME_CHANGED], 0);
 }
 
 WnckWorkspace *
@@ -379,7 +379,7 @@ _xfw_workspace_x11_set_workspace_group(XfwWorkspaceX11 *workspace, XfwWorkspaceG
     if (group != workspace->priv->group) {
         XfwWorkspaceGroup *previous_group = workspace->priv->group;
         workspace->priv->group = group;
-        g_signal_emit_by_name(workspace, "group-changed", previous_group);
+        g_signal_emit(workspace, _xfw_workspace_signals[WORKSPACE_SIGNAL_GROUP_CHANGED], 0, previous_group);
     }
 }
 
@@ -395,14 +395,14 @@ _xfw_workspace_x11_check_properties_changed(XfwWorkspaceX11 *workspace) {
     gint new_layout_column = xfw_workspace_x11_get_layout_column(XFW_WORKSPACE(workspace));
 
     if (!gdk_rectangle_equal(&old_geometry, new_geometry)) {
-        g_object_notify(G_OBJECT(workspace), "geometry");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_GEOMETRY);
     }
 
     if (old_layout_row != new_layout_row) {
-        g_object_notify(G_OBJECT(workspace), "layout-row");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_LAYOUT_ROW);
     }
 
     if (old_layout_column != new_layout_column) {
-        g_object_notify(G_OBJECT(workspace), "layout-column");
+        _xfw_workspace_notify(XFW_WORKSPACE(workspace), WORKSPACE_PROP_LAYOUT_COLUMN);
     }
 }
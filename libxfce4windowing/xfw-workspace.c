@@ -45,6 +45,7 @@
 
 #include "libxfce4windowing-private.h"
 #include "xfw-marshal.h"
+#include "xfw-window-index.h"
 #include "xfw-window.h"
 #include "xfw-workspace-group.h"
 #include "xfw-workspace-private.h"
@@ -52,6 +53,9 @@
 
 G_DEFINE_INTERFACE(XfwWorkspace, xfw_workspace, G_TYPE_OBJECT)
 
+guint _xfw_workspace_signals[N_WORKSPACE_SIGNALS] = { 0 };
+static GParamSpec *workspace_properties[WORKSPACE_PROP_LAST - WORKSPACE_PROP_GROUP] = { NULL };
+
 G_DEFINE_FLAGS_TYPE(
     XfwWorkspaceState, xfw_workspace_state,
     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_STATE_NONE, "none"),
@@ -66,6 +70,12 @@ G_DEFINE_FLAGS_TYPE(
     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_CAPABILITIES_ACTIVATE, "activate"),
     G_DEFINE_ENUM_VALUE(XFW_WORKSPACE_CAPABILITIES_REMOVE, "remove"))
 
+static void
+install_property(XfwWorkspaceIface *iface, guint prop_id, GParamSpec *pspec) {
+    workspace_properties[prop_id - WORKSPACE_PROP_GROUP] = pspec;
+    g_object_interface_install_property(iface, pspec);
+}
+
 static void
 xfw_workspace_default_init(XfwWorkspaceIface *iface) {
     /**
@@ -74,13 +84,13 @@ xfw_workspace_default_init(XfwWorkspaceIface *iface) {
      *
      * Emitted when @workspace's name changes.
      **/
-    g_signal_new("name-changed",
-                 XFW_TYPE_WORKSPACE,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceIface, name_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__VOID,
-                 G_TYPE_NONE, 0);
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_NAME_CHANGED] = g_signal_new("name-changed",
+                                                                         XFW_TYPE_WORKSPACE,
+                                                                         G_SIGNAL_RUN_LAST,
+                                                                         G_STRUCT_OFFSET(XfwWorkspaceIface, name_changed),
+                                                                         NULL, NULL,
+                                                                         g_cclosure_marshal_VOID__VOID,
+                                                                         G_TYPE_NONE, 0);
 
     /**
      * XfwWorkspace::capabilities-changed:
@@ -90,15 +100,15 @@ xfw_workspace_default_init(XfwWorkspaceIface *iface) {
      *
      * Emitted when @workspace's capabilities change.
      **/
-    g_signal_new("capabilities-changed",
-                 XFW_TYPE_WORKSPACE,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceIface, capabilities_changed),
-                 NULL, NULL,
-                 xfw_marshal_VOID__FLAGS_FLAGS,
-                 G_TYPE_NONE, 2,
-                 XFW_TYPE_WORKSPACE_CAPABILITIES,
-                 XFW_TYPE_WORKSPACE_CAPABILITIES);
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_CAPABILITIES_CHANGED] = g_signal_new("capabilities-changed",
+                                                                                 XFW_TYPE_WORKSPACE,
+                                                                                 G_SIGNAL_RUN_LAST,
+                                                                                 G_STRUCT_OFFSET(XfwWorkspaceIface, capabilities_changed),
+                                                                                 NULL, NULL,
+                                                                                 xfw_marshal_VOID__FLAGS_FLAGS,
+                                                                                 G_TYPE_NONE, 2,
+                                                                                 XFW_TYPE_WORKSPACE_CAPABILITIES,
+                                                                                 XFW_TYPE_WORKSPACE_CAPABILITIES);
 
     /**
      * XfwWorkspace::state-changed:
@@ -108,15 +118,15 @@ xfw_workspace_default_init(XfwWorkspaceIface *iface) {
      *
      * Emitted when @workspace's state changes.
      **/
-    g_signal_new("state-changed",
-                 XFW_TYPE_WORKSPACE,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceIface, state_changed),
-                 NULL, NULL,
-                 xfw_marshal_VOID__FLAGS_FLAGS,
-                 G_TYPE_NONE, 2,
-                 XFW_TYPE_WORKSPACE_STATE,
-                 XFW_TYPE_WORKSPACE_STATE);
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_STATE_CHANGED] = g_signal_new("state-changed",
+                                                                          XFW_TYPE_WORKSPACE,
+                                                                          G_SIGNAL_RUN_LAST,
+                                                                          G_STRUCT_OFFSET(XfwWorkspaceIface, state_changed),
+                                                                          NULL, NULL,
+                                                                          xfw_marshal_VOID__FLAGS_FLAGS,
+                                                                          G_TYPE_NONE, 2,
+                                                                          XFW_TYPE_WORKSPACE_STATE,
+                                                                          XFW_TYPE_WORKSPACE_STATE);
 
     /**
      * XfwWorkspace::group-changed:
@@ -125,112 +135,157 @@ xfw_workspace_default_init(XfwWorkspaceIface *iface) {
      *
      * Emitted when @workspace is assigned to an #XfwWorkspaceGroup.
      **/
-    g_signal_new("group-changed",
-                 XFW_TYPE_WORKSPACE,
-                 G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(XfwWorkspaceIface, group_changed),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__OBJECT,
-                 G_TYPE_NONE, 1,
-                 XFW_TYPE_WORKSPACE_GROUP);
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_GROUP_CHANGED] = g_signal_new("group-changed",
+                                                                          XFW_TYPE_WORKSPACE,
+                                                                          G_SIGNAL_RUN_LAST,
+                                                                          G_STRUCT_OFFSET(XfwWorkspaceIface, group_changed),
+                                                                          NULL, NULL,
+                                                                          g_cclosure_marshal_VOID__OBJECT,
+                                                                          G_TYPE_NONE, 1,
+                                                                          XFW_TYPE_WORKSPACE_GROUP);
+
+    /**
+     * XfwWorkspace::window-added:
+     * @workspace: the object which received the signal.
+     * @window: the #XfwWindow that is now on @workspace.
+     *
+     * Emitted when @window opens on @workspace, or is moved to @workspace
+     * from another workspace.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_WINDOW_ADDED] = g_signal_new("window-added",
+                                                                         XFW_TYPE_WORKSPACE,
+                                                                         G_SIGNAL_RUN_LAST,
+                                                                         0,
+                                                                         NULL, NULL,
+                                                                         g_cclosure_marshal_VOID__OBJECT,
+                                                                         G_TYPE_NONE, 1,
+                                                                         XFW_TYPE_WINDOW);
+
+    /**
+     * XfwWorkspace::window-removed:
+     * @workspace: the object which received the signal.
+     * @window: the #XfwWindow that is no longer on @workspace.
+     *
+     * Emitted when @window is closed, or is moved away from @workspace.
+     *
+     * Since: 4.21.0
+     **/
+    _xfw_workspace_signals[WORKSPACE_SIGNAL_WINDOW_REMOVED] = g_signal_new("window-removed",
+                                                                           XFW_TYPE_WORKSPACE,
+                                                                           G_SIGNAL_RUN_LAST,
+                                                                           0,
+                                                                           NULL, NULL,
+                                                                           g_cclosure_marshal_VOID__OBJECT,
+                                                                           G_TYPE_NONE, 1,
+                                                                           XFW_TYPE_WINDOW);
 
     /**
      * XfwWorkspace:group:
      *
      * The #XfwWorkspaceGroup that this workspace is a member of, if any.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_object("group",
-                                                            "group",
-                                                            "group",
-                                                            XFW_TYPE_WORKSPACE_GROUP,
-                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_GROUP,
+                     g_param_spec_object("group",
+                                         "group",
+                                         "group",
+                                         XFW_TYPE_WORKSPACE_GROUP,
+                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:id:
      *
      * The opaque ID of this workspace.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_string("id",
-                                                            "id",
-                                                            "id",
-                                                            "",
-                                                            G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_ID,
+                     g_param_spec_string("id",
+                                         "id",
+                                         "id",
+                                         "",
+                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:name:
      *
      * The human-readable name of this workspace.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_string("name",
-                                                            "name",
-                                                            "name",
-                                                            "",
-                                                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_NAME,
+                     g_param_spec_string("name",
+                                         "name",
+                                         "name",
+                                         "",
+                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:capabilities:
      *
      * The #XfwWorkspaceCapabilities bitfield for this workspace.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_flags("capabilities",
-                                                           "capabilities",
-                                                           "capabilities",
-                                                           XFW_TYPE_WORKSPACE_CAPABILITIES,
-                                                           XFW_WORKSPACE_CAPABILITIES_NONE,
-                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_CAPABILITIES,
+                     g_param_spec_flags("capabilities",
+                                        "capabilities",
+                                        "capabilities",
+                                        XFW_TYPE_WORKSPACE_CAPABILITIES,
+                                        XFW_WORKSPACE_CAPABILITIES_NONE,
+                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:state:
      *
      * The #XfwWorkspaceState bitfield for this workspace.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_flags("state",
-                                                           "state",
-                                                           "state",
-                                                           XFW_TYPE_WORKSPACE_STATE,
-                                                           XFW_WORKSPACE_STATE_NONE,
-                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_STATE,
+                     g_param_spec_flags("state",
+                                        "state",
+                                        "state",
+                                        XFW_TYPE_WORKSPACE_STATE,
+                                        XFW_WORKSPACE_STATE_NONE,
+                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:number:
      *
      * The ordinal number of this workspace.
      **/
-    g_object_interface_install_property(iface,
-                                        g_param_spec_uint("number",
-                                                          "number",
-                                                          "number",
-                                                          0, UINT_MAX, 0,
-                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_NUMBER,
+                     g_param_spec_uint("number",
+                                       "number",
+                                       "number",
+                                       0, UINT_MAX, 0,
+                                       G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:layout-row:
      *
      * The x-coordinate of the workspace on a 2D grid.
      */
-    g_object_interface_install_property(iface,
-                                        g_param_spec_int("layout-row",
-                                                         "layout-row",
-                                                         "layout-row",
-                                                         -1, G_MAXINT, -1,
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_LAYOUT_ROW,
+                     g_param_spec_int("layout-row",
+                                      "layout-row",
+                                      "layout-row",
+                                      -1, G_MAXINT, -1,
+                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:layout-column:
      *
      * The y-coordinate of the workspace on a 2D grid.
      */
-    g_object_interface_install_property(iface,
-                                        g_param_spec_int("layout-column",
-                                                         "layout-column",
-                                                         "layout-column",
-                                                         -1, G_MAXINT, -1,
-                                                         G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_LAYOUT_COLUMN,
+                     g_param_spec_int("layout-column",
+                                      "layout-column",
+                                      "layout-column",
+                                      -1, G_MAXINT, -1,
+                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     /**
      * XfwWorkspace:geometry:
@@ -240,12 +295,13 @@ xfw_workspace_default_init(XfwWorkspaceIface *iface) {
      *
      * Since: 4.20.6
      */
-    g_object_interface_install_property(iface,
-                                        g_param_spec_boxed("geometry",
-                                                           "geometry",
-                                                           "geometry",
-                                                           GDK_TYPE_RECTANGLE,
-                                                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+    install_property(iface,
+                     WORKSPACE_PROP_GEOMETRY,
+                     g_param_spec_boxed("geometry",
+                                        "geometry",
+                                        "geometry",
+                                        GDK_TYPE_RECTANGLE,
+                                        G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -502,6 +558,38 @@ xfw_workspace_assign_to_workspace_group(XfwWorkspace *workspace, XfwWorkspaceGro
     return (*iface->assign_to_workspace_group)(workspace, group, error);
 }
 
+/**
+ * xfw_workspace_list_windows:
+ * @workspace: an #XfwWorkspace.
+ *
+ * Lists the windows on @workspace, as returned by
+ * #xfw_window_get_workspace().  Windows that are pinned, and so are not
+ * placed on any single workspace, are not included.
+ *
+ * The list is kept up to date as windows open, close, and move between
+ * workspaces, so this is much cheaper than filtering the result of
+ * #xfw_screen_get_windows() for every workspace.  Connect to
+ * #XfwWorkspace::window-added and #XfwWorkspace::window-removed to find out
+ * when it changes.  The windows are not in stacking order.
+ *
+ * Return value: (nullable) (element-type XfwWindow) (transfer none): the list
+ * of #XfwWindow on @workspace, or %NULL if there are none.  The list and its
+ * contents are owned by @workspace, and the list is only valid until the
+ * next time a window is added to or removed from @workspace.
+ *
+ * Since: 4.21.0
+ **/
+GList *
+xfw_workspace_list_windows(XfwWorkspace *workspace) {
+    g_return_val_if_fail(XFW_IS_WORKSPACE(workspace), NULL);
+    return _xfw_window_index_list_windows(workspace);
+}
+
+void
+_xfw_workspace_notify(XfwWorkspace *workspace, guint prop_id) {
+    g_object_notify_by_pspec(G_OBJECT(workspace), workspace_properties[prop_id - WORKSPACE_PROP_GROUP]);
+}
+
 void
 _xfw_workspace_install_properties(GObjectClass *gklass) {
     g_object_class_override_property(gklass, WORKSPACE_PROP_GROUP, "group");
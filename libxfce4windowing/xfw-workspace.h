@@ -99,6 +99,8 @@ gboolean xfw_workspace_remove(XfwWorkspace *workspace, GError **error);
 
 gboolean xfw_workspace_assign_to_workspace_group(XfwWorkspace *workspace, XfwWorkspaceGroup *group, GError **error);
 
+GList *xfw_workspace_list_windows(XfwWorkspace *workspace);
+
 G_END_DECLS
 
 #endif /* !__XFW_WORKSPACE_H__ */
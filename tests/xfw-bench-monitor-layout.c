@@ -0,0 +1,259 @@
+// Times the logical-to-physical monitor layout solver used on Wayland
+// against a straightforward per-monitor implementation (the segment-merging
+// algorithm the solver replaced), on synthetic layouts, and checks that both
+// agree.  No compositor is needed.
+
+#include <glib.h>
+
+#include "libxfce4windowing/xfw-monitor-layout.h"
+
+static gint n_iterations = 200;
+
+static const GOptionEntry option_entries[] = {
+    { "iterations", 'i', 0, G_OPTION_ARG_INT, &n_iterations, "Number of times to solve each layout", "N" },
+    { NULL },
+};
+
+typedef struct {
+    gint start;
+    gint end;
+    guint scale;
+} Segment;
+
+static void
+merge_segment(GArray *segments, Segment *segment) {
+    for (guint i = 0; i < segments->len; ++i) {
+        const Segment *s = &g_array_index(segments, Segment, i);
+        if (segment->start < s->start) {
+            // Insert the part before 's', and carry on with whatever sticks
+            // out past its end.
+            Segment before = *segment;
+            before.end = MIN(segment->end, s->start);
+            g_array_insert_val(segments, i, before);
+            ++i;
+            s = &g_array_index(segments, Segment, i);
+            if (segment->end <= s->end) {
+                return;
+            }
+            segment->start = s->end;
+        } else if (segment->start < s->end) {
+            if (segment->end <= s->end) {
+                return;
+            } else {
+                segment->start = s->end;
+            }
+        }
+    }
+    g_array_append_val(segments, *segment);
+}
+
+static gboolean
+sum_segments(GArray *segments, gint end, gint *physical) {
+    gint last = 0;
+    *physical = 0;
+    for (guint i = 0; i < segments->len; ++i) {
+        const Segment *s = &g_array_index(segments, Segment, i);
+        if (s->start != last) {
+            return FALSE;
+        }
+        last = s->end;
+        *physical += (s->end - s->start) * s->scale;
+    }
+    return last == end;
+}
+
+static void
+reference_solve(XfwMonitorLayoutEntry *entries, guint n) {
+    GArray *x_segments = g_array_new(FALSE, FALSE, sizeof(Segment));
+    GArray *y_segments = g_array_new(FALSE, FALSE, sizeof(Segment));
+
+    for (guint i = 0; i < n; ++i) {
+        XfwMonitorLayoutEntry *e = &entries[i];
+        g_array_set_size(x_segments, 0);
+        g_array_set_size(y_segments, 0);
+
+        for (guint j = 0; j < n; ++j) {
+            const XfwMonitorLayoutEntry *a = &entries[j];
+            if (j == i) {
+                continue;
+            }
+            if (a->logical_x < e->logical_x) {
+                Segment segment = {
+                    .start = a->logical_x,
+                    .end = MIN(a->logical_x + a->logical_width, e->logical_x),
+                    .scale = a->scale,
+                };
+                merge_segment(x_segments, &segment);
+            }
+            if (a->logical_y < e->logical_y) {
+                Segment segment = {
+                    .start = a->logical_y,
+                    .end = MIN(a->logical_y + a->logical_height, e->logical_y),
+                    .scale = a->scale,
+                };
+                merge_segment(y_segments, &segment);
+            }
+        }
+
+        e->solved = sum_segments(x_segments, e->logical_x, &e->physical_x)
+                    && sum_segments(y_segments, e->logical_y, &e->physical_y);
+    }
+
+    g_array_free(x_segments, TRUE);
+    g_array_free(y_segments, TRUE);
+}
+
+// A video wall: @columns x @rows panels of 1920x1080 device pixels, with
+// every other column at scale 2.
+static XfwMonitorLayoutEntry *
+make_video_wall(guint columns, guint rows) {
+    XfwMonitorLayoutEntry *entries = g_new0(XfwMonitorLayoutEntry, columns * rows);
+    gint x = 0;
+    for (guint c = 0; c < columns; ++c) {
+        guint scale = c % 2 == 0 ? 1 : 2;
+        gint width = 1920 / scale;
+        gint height = 1080 / scale;
+        for (guint r = 0; r < rows; ++r) {
+            XfwMonitorLayoutEntry *e = &entries[r * columns + c];
+            e->logical_x = x;
+            e->logical_y = r * height;
+            e->logical_width = width;
+            e->logical_height = height;
+            e->scale = scale;
+        }
+        x += width;
+    }
+    return entries;
+}
+
+// A single row of @n monitors with random scales and sizes, listed in a
+// random order.
+static XfwMonitorLayoutEntry *
+make_random_row(GRand *rand, guint n) {
+    XfwMonitorLayoutEntry *entries = g_new0(XfwMonitorLayoutEntry, n);
+    gint x = 0;
+    for (guint i = 0; i < n; ++i) {
+        guint scale = g_rand_int_range(rand, 1, 4);
+        entries[i].logical_x = x;
+        entries[i].logical_y = 0;
+        entries[i].logical_width = g_rand_int_range(rand, 640, 3841) / scale;
+        entries[i].logical_height = g_rand_int_range(rand, 480, 2161) / scale;
+        entries[i].scale = scale;
+        x += entries[i].logical_width;
+    }
+    for (guint i = n - 1; i > 0; --i) {
+        guint j = g_rand_int_range(rand, 0, i + 1);
+        XfwMonitorLayoutEntry tmp = entries[i];
+        entries[i] = entries[j];
+        entries[j] = tmp;
+    }
+    return entries;
+}
+
+// @n monitors scattered with random overlaps, to exercise which monitor
+// takes precedence where they overlap.
+static XfwMonitorLayoutEntry *
+make_random_overlapping(GRand *rand, guint n) {
+    XfwMonitorLayoutEntry *entries = g_new0(XfwMonitorLayoutEntry, n);
+    for (guint i = 0; i < n; ++i) {
+        guint scale = g_rand_int_range(rand, 1, 4);
+        entries[i].logical_x = i == 0 ? 0 : g_rand_int_range(rand, 0, 8000);
+        entries[i].logical_y = i == 0 ? 0 : g_rand_int_range(rand, 0, 4000);
+        entries[i].logical_width = g_rand_int_range(rand, 640, 3841) / scale;
+        entries[i].logical_height = g_rand_int_range(rand, 480, 2161) / scale;
+        entries[i].scale = scale;
+    }
+    return entries;
+}
+
+static gboolean
+run_layout(const gchar *name, XfwMonitorLayoutEntry *layout, guint n) {
+    XfwMonitorLayoutEntry *expected = g_memdup2(layout, sizeof(*layout) * n);
+    XfwMonitorLayoutEntry *actual = g_memdup2(layout, sizeof(*layout) * n);
+    gboolean ok = TRUE;
+
+    reference_solve(expected, n);
+    _xfw_monitor_layout_solve(actual, n);
+    for (guint i = 0; i < n; ++i) {
+        if (expected[i].solved != actual[i].solved
+            || (expected[i].solved
+                && (expected[i].physical_x != actual[i].physical_x || expected[i].physical_y != actual[i].physical_y)))
+        {
+            g_printerr("%s: monitor %u: expected %s+%d+%d, got %s+%d+%d\n",
+                       name, i,
+                       expected[i].solved ? "solved" : "unsolved", expected[i].physical_x, expected[i].physical_y,
+                       actual[i].solved ? "solved" : "unsolved", actual[i].physical_x, actual[i].physical_y);
+            ok = FALSE;
+        }
+    }
+
+    gint64 start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        reference_solve(expected, n);
+    }
+    gint64 reference_usec = g_get_monotonic_time() - start;
+
+    start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        _xfw_monitor_layout_solve(actual, n);
+    }
+    gint64 sweep_usec = g_get_monotonic_time() - start;
+
+    g_print("%-20s %3u outputs: per-monitor %9.1f us, sweep %7.1f us\n",
+            name, n,
+            (gdouble)reference_usec / n_iterations,
+            (gdouble)sweep_usec / n_iterations);
+
+    g_free(expected);
+    g_free(actual);
+    return ok;
+}
+
+int
+main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *ctx = g_option_context_new(NULL);
+    g_option_context_add_main_entries(ctx, option_entries, NULL);
+    if (!g_option_context_parse(ctx, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+
+    gboolean ok = TRUE;
+    GRand *rand = g_rand_new_with_seed(42);
+
+    static const guint walls[][2] = {
+        { 4, 4 },
+        { 8, 4 },
+        { 8, 8 },
+    };
+    for (gsize i = 0; i < G_N_ELEMENTS(walls); ++i) {
+        gchar *name = g_strdup_printf("video wall %ux%u", walls[i][0], walls[i][1]);
+        XfwMonitorLayoutEntry *layout = make_video_wall(walls[i][0], walls[i][1]);
+        ok &= run_layout(name, layout, walls[i][0] * walls[i][1]);
+        g_free(layout);
+        g_free(name);
+    }
+
+    static const guint rows[] = { 16, 32, 64 };
+    for (gsize i = 0; i < G_N_ELEMENTS(rows); ++i) {
+        XfwMonitorLayoutEntry *layout = make_random_row(rand, rows[i]);
+        ok &= run_layout("shuffled row", layout, rows[i]);
+
+        // Move one monitor far away to leave a gap in the row
+        layout[rows[i] / 2].logical_x += 100000;
+        ok &= run_layout("row with a gap", layout, rows[i]);
+        g_free(layout);
+
+        layout = make_random_overlapping(rand, rows[i]);
+        ok &= run_layout("overlapping", layout, rows[i]);
+        g_free(layout);
+    }
+
+    g_rand_free(rand);
+
+    return ok ? 0 : 1;
+}
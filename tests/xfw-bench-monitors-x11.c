@@ -0,0 +1,160 @@
+// Compares the cost of querying XRandR outputs one synchronous request at a
+// time through Xlib (three round trips per output) with sending all the
+// requests up front through xcb (two round trips in total), the way
+// xfw-monitor-x11.c enumerates monitors.
+//
+// Xvfb only exposes a single output, so pass --outputs to query the
+// available outputs repeatedly and simulate a larger setup, e.g.:
+//
+//   xvfb-run -s '-screen 0 7680x2160x24' ./xfw-bench-monitors-x11 --outputs 6
+//
+// The difference grows with the latency of the connection to the X server,
+// so it's also worth running over a forwarded or remote display.
+
+#include <X11/Xlib-xcb.h>
+#include <X11/Xlib.h>
+#include <X11/extensions/Xrandr.h>
+#include <glib.h>
+#include <stdlib.h>
+#include <xcb/randr.h>
+
+static gint n_iterations = 200;
+static gint n_outputs = 0;
+
+static const GOptionEntry option_entries[] = {
+    { "iterations", 'i', 0, G_OPTION_ARG_INT, &n_iterations, "Number of enumerations to time", "N" },
+    { "outputs", 'o', 0, G_OPTION_ARG_INT, &n_outputs, "Number of outputs to query per enumeration (default: all connected)", "N" },
+    { NULL },
+};
+
+static void
+enumerate_xlib(Display *dpy, XRRScreenResources *resources, RROutput *outputs, gint noutputs, Atom edid_atom) {
+    for (gint i = 0; i < noutputs; ++i) {
+        XRROutputInfo *oinfo = XRRGetOutputInfo(dpy, resources, outputs[i]);
+        if (oinfo != NULL) {
+            if (oinfo->crtc != None) {
+                XRRCrtcInfo *crtc = XRRGetCrtcInfo(dpy, resources, oinfo->crtc);
+                if (crtc != NULL) {
+                    XRRFreeCrtcInfo(crtc);
+                }
+            }
+            XRRFreeOutputInfo(oinfo);
+        }
+
+        Atom actual_type = None;
+        int actual_format = 0;
+        unsigned long nbytes = 0;
+        unsigned long bytes_left = 0;
+        unsigned char *edid_data = NULL;
+        XRRGetOutputProperty(dpy, outputs[i], edid_atom, 0, 256, False, False, AnyPropertyType,
+                             &actual_type, &actual_format, &nbytes, &bytes_left, &edid_data);
+        if (edid_data != NULL) {
+            XFree(edid_data);
+        }
+    }
+}
+
+static void
+enumerate_xcb(xcb_connection_t *conn, XRRScreenResources *resources, RROutput *outputs, gint noutputs, Atom edid_atom) {
+    xcb_randr_get_output_info_cookie_t *oinfo_cookies = g_new0(xcb_randr_get_output_info_cookie_t, noutputs);
+    xcb_randr_get_output_property_cookie_t *edid_cookies = g_new0(xcb_randr_get_output_property_cookie_t, noutputs);
+    xcb_randr_get_crtc_info_cookie_t *crtc_cookies = g_new0(xcb_randr_get_crtc_info_cookie_t, noutputs);
+    gboolean *have_crtc = g_new0(gboolean, noutputs);
+
+    for (gint i = 0; i < noutputs; ++i) {
+        oinfo_cookies[i] = xcb_randr_get_output_info(conn, outputs[i], resources->configTimestamp);
+        edid_cookies[i] = xcb_randr_get_output_property(conn, outputs[i], edid_atom, XCB_GET_PROPERTY_TYPE_ANY, 0, 256, FALSE, FALSE);
+    }
+    xcb_flush(conn);
+
+    for (gint i = 0; i < noutputs; ++i) {
+        xcb_randr_get_output_info_reply_t *oinfo = xcb_randr_get_output_info_reply(conn, oinfo_cookies[i], NULL);
+        if (oinfo != NULL && oinfo->crtc != XCB_NONE) {
+            crtc_cookies[i] = xcb_randr_get_crtc_info(conn, oinfo->crtc, resources->configTimestamp);
+            have_crtc[i] = TRUE;
+        }
+        free(oinfo);
+    }
+    xcb_flush(conn);
+
+    for (gint i = 0; i < noutputs; ++i) {
+        if (have_crtc[i]) {
+            free(xcb_randr_get_crtc_info_reply(conn, crtc_cookies[i], NULL));
+        }
+        free(xcb_randr_get_output_property_reply(conn, edid_cookies[i], NULL));
+    }
+
+    g_free(oinfo_cookies);
+    g_free(edid_cookies);
+    g_free(crtc_cookies);
+    g_free(have_crtc);
+}
+
+int
+main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *ctx = g_option_context_new(NULL);
+    g_option_context_add_main_entries(ctx, option_entries, NULL);
+    if (!g_option_context_parse(ctx, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+
+    Display *dpy = XOpenDisplay(NULL);
+    if (dpy == NULL) {
+        g_printerr("Unable to open display\n");
+        return 1;
+    }
+
+    int evbase, errbase;
+    if (!XRRQueryExtension(dpy, &evbase, &errbase)) {
+        g_printerr("XRandR not available\n");
+        XCloseDisplay(dpy);
+        return 1;
+    }
+
+    Window root = XDefaultRootWindow(dpy);
+    XRRScreenResources *resources = XRRGetScreenResourcesCurrent(dpy, root);
+    if (resources == NULL || resources->noutput == 0) {
+        g_printerr("No XRandR outputs found\n");
+        XCloseDisplay(dpy);
+        return 1;
+    }
+
+    if (n_outputs <= 0) {
+        n_outputs = resources->noutput;
+    }
+    RROutput *outputs = g_new(RROutput, n_outputs);
+    for (gint i = 0; i < n_outputs; ++i) {
+        outputs[i] = resources->outputs[i % resources->noutput];
+    }
+
+    Atom edid_atom = XInternAtom(dpy, RR_PROPERTY_RANDR_EDID, False);
+    xcb_connection_t *conn = XGetXCBConnection(dpy);
+
+    g_print("Querying %d outputs (%d distinct), %d iterations\n", n_outputs, resources->noutput, n_iterations);
+
+    gint64 start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        enumerate_xlib(dpy, resources, outputs, n_outputs, edid_atom);
+    }
+    gint64 xlib_usec = g_get_monotonic_time() - start;
+
+    start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        enumerate_xcb(conn, resources, outputs, n_outputs, edid_atom);
+    }
+    gint64 xcb_usec = g_get_monotonic_time() - start;
+
+    g_print("Xlib, sequential: %8.1f us/enumeration\n", (gdouble)xlib_usec / n_iterations);
+    g_print("xcb, batched:     %8.1f us/enumeration\n", (gdouble)xcb_usec / n_iterations);
+
+    g_free(outputs);
+    XRRFreeScreenResources(resources);
+    XCloseDisplay(dpy);
+
+    return 0;
+}
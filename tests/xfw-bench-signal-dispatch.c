@@ -0,0 +1,173 @@
+// Times the per-event cost of the two ways of telling listeners that a
+// window changed: emitting a signal by name and notifying a property by name
+// (which look up the signal and the GParamSpec on every call), versus
+// emitting by signal id and notifying with the GParamSpec, the way the
+// backends do it.  The events go through a real XfwWindow on a real
+// XfwScreen, so the library's own emission hooks and change tracking are
+// part of what gets timed; only the backends are replaced, by subclasses
+// that never talk to a display server.
+
+#include <libxfce4windowing/libxfce4windowing.h>
+
+#include "libxfce4windowing/xfw-screen-private.h"
+#include "libxfce4windowing/xfw-window-private.h"
+
+static gint n_iterations = 1000000;
+
+static const GOptionEntry option_entries[] = {
+    { "iterations", 'i', 0, G_OPTION_ARG_INT, &n_iterations, "Number of events to dispatch per run", "N" },
+    { NULL },
+};
+
+#define BENCH_TYPE_SCREEN (bench_screen_get_type())
+G_DECLARE_FINAL_TYPE(BenchScreen, bench_screen, BENCH, SCREEN, XfwScreen)
+
+struct _BenchScreen {
+    XfwScreen parent;
+};
+
+G_DEFINE_FINAL_TYPE(BenchScreen, bench_screen, XFW_TYPE_SCREEN)
+
+static void
+bench_screen_class_init(BenchScreenClass *klass) {}
+
+static void
+bench_screen_init(BenchScreen *screen) {}
+
+#define BENCH_TYPE_WINDOW (bench_window_get_type())
+G_DECLARE_FINAL_TYPE(BenchWindow, bench_window, BENCH, WINDOW, XfwWindow)
+
+struct _BenchWindow {
+    XfwWindow parent;
+};
+
+G_DEFINE_FINAL_TYPE(BenchWindow, bench_window, XFW_TYPE_WINDOW)
+
+static void
+bench_window_class_init(BenchWindowClass *klass) {}
+
+static void
+bench_window_init(BenchWindow *window) {}
+
+static void
+name_changed(XfwWindow *window, guint *count) {
+    ++*count;
+}
+
+static void
+state_changed(XfwWindow *window, XfwWindowState changed_mask, XfwWindowState new_state, guint *count) {
+    ++*count;
+}
+
+static void
+notified(XfwWindow *window, GParamSpec *pspec, guint *count) {
+    ++*count;
+}
+
+static void
+changes_committed(XfwScreen *screen, GPtrArray *changes, guint *n_batches) {
+    ++*n_batches;
+}
+
+static gint64
+run_by_name(XfwWindow *window) {
+    gint64 start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        g_signal_emit_by_name(window, "name-changed");
+        g_signal_emit_by_name(window, "state-changed", XFW_WINDOW_STATE_MINIMIZED, (XfwWindowState)(i & XFW_WINDOW_STATE_MINIMIZED));
+        g_object_notify(G_OBJECT(window), "name");
+        g_object_notify(G_OBJECT(window), "state");
+    }
+    return g_get_monotonic_time() - start;
+}
+
+static gint64
+run_by_id(XfwWindow *window) {
+    guint name_changed_id = g_signal_lookup("name-changed", XFW_TYPE_WINDOW);
+    guint state_changed_id = g_signal_lookup("state-changed", XFW_TYPE_WINDOW);
+    GParamSpec *name_pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(window), "name");
+    GParamSpec *state_pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(window), "state");
+
+    gint64 start = g_get_monotonic_time();
+    for (gint i = 0; i < n_iterations; ++i) {
+        g_signal_emit(window, name_changed_id, 0);
+        g_signal_emit(window, state_changed_id, 0, XFW_WINDOW_STATE_MINIMIZED, (XfwWindowState)(i & XFW_WINDOW_STATE_MINIMIZED));
+        g_object_notify_by_pspec(G_OBJECT(window), name_pspec);
+        g_object_notify_by_pspec(G_OBJECT(window), state_pspec);
+    }
+    return g_get_monotonic_time() - start;
+}
+
+// Delivers the batch the screen queued up for changes-committed, if any
+static void
+flush_changes(void) {
+    while (g_main_context_iteration(NULL, FALSE)) {}
+}
+
+int
+main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *ctx = g_option_context_new(NULL);
+    g_option_context_add_main_entries(ctx, option_entries, NULL);
+    if (!g_option_context_parse(ctx, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+
+    XfwScreen *screen = g_object_new(BENCH_TYPE_SCREEN, NULL);
+    XfwWindow *window = g_object_new(BENCH_TYPE_WINDOW, "screen", screen, NULL);
+    gboolean ok = TRUE;
+
+    // First with nothing listening (the common case for most signals in a
+    // panel plugin), then with a handler on every signal and notification,
+    // and on the screen's batched changes.
+    for (gint with_handlers = 0; with_handlers < 2; ++with_handlers) {
+        guint expected = with_handlers ? (guint)n_iterations * 4 : 0;
+        guint expected_batches = with_handlers ? 1 : 0;
+        guint count = 0;
+        guint n_batches = 0;
+        if (with_handlers) {
+            g_signal_connect(window, "name-changed", G_CALLBACK(name_changed), &count);
+            g_signal_connect(window, "state-changed", G_CALLBACK(state_changed), &count);
+            g_signal_connect(window, "notify::name", G_CALLBACK(notified), &count);
+            g_signal_connect(window, "notify::state", G_CALLBACK(notified), &count);
+            g_signal_connect(screen, "changes-committed", G_CALLBACK(changes_committed), &n_batches);
+        }
+
+        gint64 by_name_usec = run_by_name(window);
+        flush_changes();
+        if (count != expected || n_batches != expected_batches) {
+            g_printerr("handlers ran %u times and %u batches were committed by name, expected %u and %u\n",
+                       count, n_batches, expected, expected_batches);
+            ok = FALSE;
+        }
+
+        count = 0;
+        n_batches = 0;
+        gint64 by_id_usec = run_by_id(window);
+        flush_changes();
+        if (count != expected || n_batches != expected_batches) {
+            g_printerr("handlers ran %u times and %u batches were committed by id, expected %u and %u\n",
+                       count, n_batches, expected, expected_batches);
+            ok = FALSE;
+        }
+
+        g_print("%-15s by name %7.1f ns/event, by id %7.1f ns/event\n",
+                with_handlers ? "with handlers:" : "no handlers:",
+                by_name_usec * 1000.0 / (n_iterations * 4.0),
+                by_id_usec * 1000.0 / (n_iterations * 4.0));
+
+        if (with_handlers) {
+            g_signal_handlers_disconnect_by_data(window, &count);
+            g_signal_handlers_disconnect_by_data(screen, &n_batches);
+        }
+    }
+
+    g_object_unref(window);
+    g_object_unref(screen);
+
+    return ok ? 0 : 1;
+}
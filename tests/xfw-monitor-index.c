@@ -0,0 +1,149 @@
+// Checks that the screen's monitor index answers point and rectangle
+// queries with the monitors' current positions, including after a monitor
+// has been moved without the monitor list itself changing.  The index is
+// compiled on its own against the stand-in XfwMonitor below, which only
+// provides what the index uses, so no display server is needed.
+
+#include <gdk/gdk.h>
+
+#include "libxfce4windowing/xfw-monitor-index.h"
+#include "libxfce4windowing/xfw-monitor-private.h"
+
+typedef struct {
+    GdkRectangle physical_geometry;
+    guint *geometry_generation;
+} XfwMonitorPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(XfwMonitor, xfw_monitor, G_TYPE_OBJECT)
+
+static void
+xfw_monitor_finalize(GObject *object) {
+    XfwMonitorPrivate *priv = xfw_monitor_get_instance_private(XFW_MONITOR(object));
+    if (priv->geometry_generation != NULL) {
+        g_rc_box_release(priv->geometry_generation);
+    }
+    G_OBJECT_CLASS(xfw_monitor_parent_class)->finalize(object);
+}
+
+static void
+xfw_monitor_class_init(XfwMonitorClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = xfw_monitor_finalize;
+}
+
+static void
+xfw_monitor_init(XfwMonitor *monitor) {}
+
+void
+xfw_monitor_get_physical_geometry(XfwMonitor *monitor, GdkRectangle *physical_geometry) {
+    XfwMonitorPrivate *priv = xfw_monitor_get_instance_private(monitor);
+    *physical_geometry = priv->physical_geometry;
+}
+
+void
+_xfw_monitor_set_physical_geometry(XfwMonitor *monitor, GdkRectangle *physical_geometry) {
+    XfwMonitorPrivate *priv = xfw_monitor_get_instance_private(monitor);
+    if (!gdk_rectangle_equal(&priv->physical_geometry, physical_geometry)) {
+        priv->physical_geometry = *physical_geometry;
+        if (priv->geometry_generation != NULL) {
+            (*priv->geometry_generation)++;
+        }
+    }
+}
+
+void
+_xfw_monitor_set_geometry_generation(XfwMonitor *monitor, guint *generation) {
+    XfwMonitorPrivate *priv = xfw_monitor_get_instance_private(monitor);
+    if (priv->geometry_generation != generation) {
+        if (priv->geometry_generation != NULL) {
+            g_rc_box_release(priv->geometry_generation);
+        }
+        priv->geometry_generation = generation != NULL ? g_rc_box_acquire(generation) : NULL;
+    }
+}
+
+static XfwMonitor *
+new_monitor(gint x, gint y, gint width, gint height) {
+    XfwMonitor *monitor = g_object_new(xfw_monitor_get_type(), NULL);
+    GdkRectangle geometry = { x, y, width, height };
+    _xfw_monitor_set_physical_geometry(monitor, &geometry);
+    return monitor;
+}
+
+static void
+move_monitor(XfwMonitor *monitor, gint x, gint y) {
+    GdkRectangle geometry;
+    xfw_monitor_get_physical_geometry(monitor, &geometry);
+    geometry.x = x;
+    geometry.y = y;
+    _xfw_monitor_set_physical_geometry(monitor, &geometry);
+}
+
+static void
+test_queries(void) {
+    XfwMonitor *left = new_monitor(0, 0, 1920, 1080);
+    XfwMonitor *right = new_monitor(1920, 0, 2560, 1440);
+    GList *monitors = g_list_append(g_list_append(NULL, left), right);
+    XfwMonitorIndex *index = _xfw_monitor_index_new();
+    GdkRectangle rect = { 1900, 100, 40, 40 };
+
+    _xfw_monitor_index_set_monitors(index, monitors);
+
+    g_assert_true(_xfw_monitor_index_at_point(index, 100, 100) == left);
+    g_assert_true(_xfw_monitor_index_at_point(index, 2000, 100) == right);
+    g_assert_null(_xfw_monitor_index_at_point(index, 5000, 100));
+
+    GList *hits = _xfw_monitor_index_for_rect(index, &rect);
+    g_assert_cmpuint(g_list_length(hits), ==, 2);
+    g_assert_true(hits->data == left);
+    g_assert_true(hits->next->data == right);
+    g_list_free(hits);
+
+    _xfw_monitor_index_free(index);
+    g_list_free_full(monitors, g_object_unref);
+}
+
+// The monitors move without the list handed to the index changing
+static void
+test_moved_monitors(void) {
+    XfwMonitor *left = new_monitor(0, 0, 1920, 1080);
+    XfwMonitor *right = new_monitor(1920, 0, 2560, 1440);
+    GList *monitors = g_list_append(g_list_append(NULL, left), right);
+    XfwMonitorIndex *index = _xfw_monitor_index_new();
+    GdkRectangle rect = { 1900, 100, 40, 40 };
+
+    _xfw_monitor_index_set_monitors(index, monitors);
+    g_assert_true(_xfw_monitor_index_at_point(index, 100, 100) == left);
+
+    // Swap the monitors around
+    move_monitor(right, 0, 0);
+    move_monitor(left, 2560, 0);
+
+    g_assert_true(_xfw_monitor_index_at_point(index, 100, 100) == right);
+    g_assert_true(_xfw_monitor_index_at_point(index, 2000, 100) == right);
+    g_assert_true(_xfw_monitor_index_at_point(index, 2600, 100) == left);
+    g_assert_true(_xfw_monitor_index_at_point(index, 4400, 100) == left);
+    g_assert_null(_xfw_monitor_index_at_point(index, 4500, 100));
+
+    GList *hits = _xfw_monitor_index_for_rect(index, &rect);
+    g_assert_cmpuint(g_list_length(hits), ==, 1);
+    g_assert_true(hits->data == right);
+    g_list_free(hits);
+
+    // Moving a monitor below the other one
+    move_monitor(left, 0, 1440);
+    g_assert_true(_xfw_monitor_index_at_point(index, 100, 1500) == left);
+    g_assert_null(_xfw_monitor_index_at_point(index, 2600, 100));
+
+    _xfw_monitor_index_free(index);
+    g_list_free_full(monitors, g_object_unref);
+}
+
+int
+main(int argc, char **argv) {
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/monitor-index/queries", test_queries);
+    g_test_add_func("/monitor-index/moved-monitors", test_moved_monitors);
+
+    return g_test_run();
+}
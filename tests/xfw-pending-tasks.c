@@ -0,0 +1,156 @@
+// Checks that icon loads waiting on a compositor reply always complete:
+// with the reply, when the operation they wait on is torn down before the
+// reply arrives, and when they're cancelled.  Uses plain GTasks, so no
+// compositor is needed.
+
+#include <gio/gio.h>
+
+#include "libxfce4windowing/xfw-pending-tasks.h"
+
+typedef struct {
+    gboolean completed;
+    gint value;
+    GError *error;
+} Result;
+
+static void
+task_done(GObject *source, GAsyncResult *res, gpointer data) {
+    Result *result = data;
+    result->completed = TRUE;
+    result->value = GPOINTER_TO_INT(g_task_propagate_pointer(G_TASK(res), &result->error));
+}
+
+static GTask *
+new_task(GCancellable *cancellable, Result *result) {
+    return g_task_new(NULL, cancellable, task_done, result);
+}
+
+static void
+run_main_loop(void) {
+    while (g_main_context_iteration(NULL, FALSE)) {}
+}
+
+static void
+result_clear(Result *result) {
+    g_clear_error(&result->error);
+    result->completed = FALSE;
+    result->value = 0;
+}
+
+static void
+test_reply(void) {
+    XfwPendingTasks *pending = _xfw_pending_tasks_new();
+    Result first = { 0 }, second = { 0 };
+
+    _xfw_pending_tasks_add(pending, new_task(NULL, &first));
+    _xfw_pending_tasks_add(pending, new_task(NULL, &second));
+    g_assert_cmpuint(_xfw_pending_tasks_get_n_tasks(pending), ==, 2);
+
+    GList *tasks = _xfw_pending_tasks_steal(pending);
+    g_assert_cmpuint(g_list_length(tasks), ==, 2);
+    g_assert_cmpuint(_xfw_pending_tasks_get_n_tasks(pending), ==, 0);
+    for (GList *l = tasks; l != NULL; l = l->next) {
+        g_task_return_pointer(G_TASK(l->data), GINT_TO_POINTER(42), NULL);
+    }
+    g_list_free_full(tasks, g_object_unref);
+    run_main_loop();
+
+    g_assert_true(first.completed);
+    g_assert_no_error(first.error);
+    g_assert_cmpint(first.value, ==, 42);
+    g_assert_true(second.completed);
+    g_assert_no_error(second.error);
+    g_assert_cmpint(second.value, ==, 42);
+
+    _xfw_pending_tasks_free(pending);
+    result_clear(&first);
+    result_clear(&second);
+}
+
+// The window goes away (or the request is destroyed) before the compositor
+// has replied
+static void
+test_destroy_before_reply(void) {
+    XfwPendingTasks *pending = _xfw_pending_tasks_new();
+    GCancellable *cancellable = g_cancellable_new();
+    Result first = { 0 }, second = { 0 }, third = { 0 };
+    GError *error = g_error_new_literal(G_IO_ERROR, G_IO_ERROR_CLOSED, "closed");
+
+    _xfw_pending_tasks_add(pending, new_task(NULL, &first));
+    _xfw_pending_tasks_add(pending, new_task(cancellable, &second));
+    _xfw_pending_tasks_return_error(pending, error);
+    run_main_loop();
+
+    g_assert_true(first.completed);
+    g_assert_error(first.error, G_IO_ERROR, G_IO_ERROR_CLOSED);
+    g_assert_true(second.completed);
+    g_assert_error(second.error, G_IO_ERROR, G_IO_ERROR_CLOSED);
+    g_assert_cmpuint(_xfw_pending_tasks_get_n_tasks(pending), ==, 0);
+
+    // Cancelling afterwards mustn't complete it a second time
+    g_cancellable_cancel(cancellable);
+    run_main_loop();
+
+    // Freeing with tasks still waiting completes them too
+    _xfw_pending_tasks_add(pending, new_task(NULL, &third));
+    _xfw_pending_tasks_free(pending);
+    run_main_loop();
+    g_assert_true(third.completed);
+    g_assert_error(third.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+
+    g_error_free(error);
+    g_object_unref(cancellable);
+    result_clear(&first);
+    result_clear(&second);
+    result_clear(&third);
+}
+
+static void
+test_cancel(void) {
+    XfwPendingTasks *pending = _xfw_pending_tasks_new();
+    GCancellable *cancellable = g_cancellable_new();
+    GCancellable *already_cancelled = g_cancellable_new();
+    Result cancelled = { 0 }, waiting = { 0 }, early = { 0 };
+
+    g_cancellable_cancel(already_cancelled);
+
+    _xfw_pending_tasks_add(pending, new_task(cancellable, &cancelled));
+    _xfw_pending_tasks_add(pending, new_task(NULL, &waiting));
+    _xfw_pending_tasks_add(pending, new_task(already_cancelled, &early));
+
+    g_cancellable_cancel(cancellable);
+    run_main_loop();
+
+    g_assert_true(cancelled.completed);
+    g_assert_error(cancelled.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+    g_assert_true(early.completed);
+    g_assert_error(early.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+    g_assert_false(waiting.completed);
+    g_assert_cmpuint(_xfw_pending_tasks_get_n_tasks(pending), ==, 1);
+
+    GList *tasks = _xfw_pending_tasks_steal(pending);
+    g_assert_cmpuint(g_list_length(tasks), ==, 1);
+    g_task_return_pointer(G_TASK(tasks->data), GINT_TO_POINTER(7), NULL);
+    g_list_free_full(tasks, g_object_unref);
+    run_main_loop();
+    g_assert_true(waiting.completed);
+    g_assert_cmpint(waiting.value, ==, 7);
+
+    _xfw_pending_tasks_free(pending);
+    g_object_unref(cancellable);
+    g_object_unref(already_cancelled);
+    result_clear(&cancelled);
+    result_clear(&waiting);
+    result_clear(&early);
+}
+
+int
+main(int argc, char **argv) {
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/pending-tasks/reply", test_reply);
+    g_test_add_func("/pending-tasks/destroy-before-reply", test_destroy_before_reply);
+    g_test_add_func("/pending-tasks/cancel", test_cancel);
+
+    return g_test_run();
+}
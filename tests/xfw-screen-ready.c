@@ -0,0 +1,167 @@
+// Checks xfw_screen_get_default_async(): the screen it hands back is ready
+// and is the same one xfw_screen_get_default() returns, whether the screen
+// became ready before or after the call, and cancelling the call finishes it
+// with G_IO_ERROR_CANCELLED.  Also checks that the "ready" property agrees
+// with xfw_screen_is_ready().
+//
+// In /screen/ready-after-call the async call comes first, so it usually has
+// to wait for the screen to become ready; in /screen/ready-before-call the
+// blocking xfw_screen_get_default() comes first and waits instead.  Each
+// runs in its own process, so it gets a fresh default screen.  Needs a
+// running X11 or Wayland session.
+
+#include <gtk/gtk.h>
+
+#include "libxfce4windowing/libxfce4windowing.h"
+
+#define TIMEOUT_SECONDS 10
+
+typedef struct {
+    gboolean completed;
+    XfwScreen *screen;
+    GError *error;
+} Result;
+
+static gboolean timed_out = FALSE;
+
+static void
+get_default_done(GObject *source, GAsyncResult *res, gpointer data) {
+    Result *result = data;
+    result->completed = TRUE;
+    result->screen = xfw_screen_get_default_finish(res, &result->error);
+}
+
+static gboolean
+timeout(gpointer data) {
+    timed_out = TRUE;
+    return G_SOURCE_REMOVE;
+}
+
+static void
+wait_for(Result *result) {
+    guint timeout_id = g_timeout_add_seconds(TIMEOUT_SECONDS, timeout, NULL);
+    while (!result->completed && !timed_out) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    if (!timed_out) {
+        g_source_remove(timeout_id);
+    }
+    g_assert_true(result->completed);
+}
+
+static void
+result_clear(Result *result) {
+    g_clear_object(&result->screen);
+    g_clear_error(&result->error);
+    result->completed = FALSE;
+}
+
+static void
+check_ready(XfwScreen *screen) {
+    gboolean ready = FALSE;
+    g_object_get(screen, "ready", &ready, NULL);
+    g_assert_true(ready);
+    g_assert_true(xfw_screen_is_ready(screen));
+}
+
+static void
+check_get_default_async(XfwScreen *expected) {
+    Result result = { 0 };
+
+    xfw_screen_get_default_async(NULL, get_default_done, &result);
+    // Never completes from inside the call, even when already ready
+    g_assert_false(result.completed);
+    wait_for(&result);
+
+    g_assert_no_error(result.error);
+    g_assert_true(XFW_IS_SCREEN(result.screen));
+    check_ready(result.screen);
+    g_assert_true(result.screen == expected);
+
+    result_clear(&result);
+}
+
+static void
+check_cancelled(void) {
+    GCancellable *cancellable = g_cancellable_new();
+    Result result = { 0 };
+
+    g_cancellable_cancel(cancellable);
+    xfw_screen_get_default_async(cancellable, get_default_done, &result);
+    wait_for(&result);
+
+    g_assert_null(result.screen);
+    g_assert_error(result.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+
+    result_clear(&result);
+    g_object_unref(cancellable);
+}
+
+// Nothing has asked for the screen yet, so the calls usually have to wait for
+// it to become ready
+static void
+test_ready_after_call(void) {
+    if (!g_test_subprocess()) {
+        g_test_trap_subprocess(NULL, 0, G_TEST_SUBPROCESS_DEFAULT);
+        g_test_trap_assert_passed();
+        return;
+    }
+
+    Result result = { 0 }, cancelled = { 0 };
+    GCancellable *cancellable = g_cancellable_new();
+
+    xfw_screen_get_default_async(NULL, get_default_done, &result);
+    // Cancelled while (probably) still waiting for the screen
+    xfw_screen_get_default_async(cancellable, get_default_done, &cancelled);
+    g_cancellable_cancel(cancellable);
+
+    wait_for(&result);
+    wait_for(&cancelled);
+
+    g_assert_no_error(result.error);
+    g_assert_true(XFW_IS_SCREEN(result.screen));
+    g_assert_null(cancelled.screen);
+    g_assert_error(cancelled.error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+
+    check_ready(result.screen);
+
+    // Already ready, so this mustn't block, and has to agree
+    XfwScreen *screen = xfw_screen_get_default();
+    g_assert_true(screen == result.screen);
+    g_object_unref(screen);
+
+    check_get_default_async(result.screen);
+    check_cancelled();
+
+    result_clear(&result);
+    result_clear(&cancelled);
+    g_object_unref(cancellable);
+}
+
+static void
+test_ready_before_call(void) {
+    if (!g_test_subprocess()) {
+        g_test_trap_subprocess(NULL, 0, G_TEST_SUBPROCESS_DEFAULT);
+        g_test_trap_assert_passed();
+        return;
+    }
+
+    // Blocks until the screen is ready
+    XfwScreen *screen = xfw_screen_get_default();
+    check_ready(screen);
+
+    check_get_default_async(screen);
+    check_cancelled();
+
+    g_object_unref(screen);
+}
+
+int
+main(int argc, char **argv) {
+    gtk_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/screen/ready-after-call", test_ready_after_call);
+    g_test_add_func("/screen/ready-before-call", test_ready_before_call);
+
+    return g_test_run();
+}
@@ -0,0 +1,135 @@
+// Runs the show-desktop bookkeeping used on Wayland through the ways the
+// compositor can answer (or not answer) our minimize requests, and checks
+// that we never end up watching windows we didn't minimize.  Windows are
+// just opaque pointers here, so no compositor is needed.
+
+#include <glib.h>
+
+#include "libxfce4windowing/xfw-show-desktop.h"
+
+#define WINDOW(n) GINT_TO_POINTER(n)
+
+static XfwShowDesktop *
+show_three(void) {
+    XfwShowDesktop *show_desktop = _xfw_show_desktop_new();
+    GList *windows = NULL;
+    windows = g_list_prepend(windows, WINDOW(3));
+    windows = g_list_prepend(windows, WINDOW(2));
+    windows = g_list_prepend(windows, WINDOW(1));
+    _xfw_show_desktop_show(show_desktop, windows, WINDOW(2));
+    g_list_free(windows);
+    return show_desktop;
+}
+
+// Show and restore before the compositor acknowledges anything
+static void
+test_no_acknowledgements(void) {
+    XfwShowDesktop *show_desktop = show_three();
+    gpointer reactivate = NULL;
+
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_SHOWN);
+
+    GList *to_unminimize = _xfw_show_desktop_restore(show_desktop);
+    g_assert_null(to_unminimize);
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(1)));
+
+    // Late acknowledgement, or the user minimizing the window by hand: not
+    // ours to undo
+    g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(1), TRUE, &reactivate));
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(1)));
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+
+    // And toggling again starts from scratch
+    _xfw_show_desktop_free(show_desktop);
+    show_desktop = show_three();
+    g_assert_null(_xfw_show_desktop_restore(show_desktop));
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+
+    _xfw_show_desktop_free(show_desktop);
+}
+
+// Only some of the windows get minimized before we restore
+static void
+test_partial_acknowledgements(void) {
+    XfwShowDesktop *show_desktop = show_three();
+    gpointer reactivate = NULL;
+
+    g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(1), TRUE, &reactivate));
+
+    GList *to_unminimize = _xfw_show_desktop_restore(show_desktop);
+    g_assert_cmpuint(g_list_length(to_unminimize), ==, 1);
+    g_assert_true(to_unminimize->data == WINDOW(1));
+    g_list_free(to_unminimize);
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_RESTORING);
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(2)));
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(3)));
+
+    // A window we never minimized changing state doesn't concern us
+    g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(3), TRUE, &reactivate));
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(3)));
+
+    // The previously active window was never minimized, so there's nothing
+    // to reactivate
+    g_assert_true(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(1), FALSE, &reactivate));
+    g_assert_null(reactivate);
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+
+    _xfw_show_desktop_free(show_desktop);
+}
+
+static void
+test_full_round_trip(void) {
+    XfwShowDesktop *show_desktop = show_three();
+    gpointer reactivate = NULL;
+
+    for (gint i = 1; i <= 3; ++i) {
+        g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(i), TRUE, &reactivate));
+    }
+
+    GList *to_unminimize = _xfw_show_desktop_restore(show_desktop);
+    g_assert_cmpuint(g_list_length(to_unminimize), ==, 3);
+    g_list_free(to_unminimize);
+
+    g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(1), FALSE, &reactivate));
+    g_assert_false(_xfw_show_desktop_window_closed(show_desktop, WINDOW(3)));
+    g_assert_true(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(2), FALSE, &reactivate));
+    g_assert_true(reactivate == WINDOW(2));
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+
+    _xfw_show_desktop_free(show_desktop);
+}
+
+// The user unminimizes every window by hand while the desktop is shown
+static void
+test_user_unminimizes(void) {
+    XfwShowDesktop *show_desktop = show_three();
+    gpointer reactivate = NULL;
+
+    for (gint i = 1; i <= 3; ++i) {
+        g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(i), TRUE, &reactivate));
+    }
+    g_assert_false(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(1), FALSE, &reactivate));
+    g_assert_false(_xfw_show_desktop_is_tracking(show_desktop, WINDOW(1)));
+    g_assert_false(_xfw_show_desktop_window_closed(show_desktop, WINDOW(2)));
+    g_assert_true(_xfw_show_desktop_window_state_changed(show_desktop, WINDOW(3), FALSE, &reactivate));
+    g_assert_null(reactivate);
+    g_assert_cmpint(_xfw_show_desktop_get_stage(show_desktop), ==, XFW_SHOW_DESKTOP_IDLE);
+
+    // Nothing left to restore
+    g_assert_null(_xfw_show_desktop_restore(show_desktop));
+
+    _xfw_show_desktop_free(show_desktop);
+}
+
+int
+main(int argc, char **argv) {
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/show-desktop/no-acknowledgements", test_no_acknowledgements);
+    g_test_add_func("/show-desktop/partial-acknowledgements", test_partial_acknowledgements);
+    g_test_add_func("/show-desktop/full-round-trip", test_full_round_trip);
+    g_test_add_func("/show-desktop/user-unminimizes", test_user_unminimizes);
+
+    return g_test_run();
+}
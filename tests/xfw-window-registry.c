@@ -0,0 +1,163 @@
+// Checks the orders the window registry hands back to the screen backends:
+// most recently added first for the window list, whether or not windows
+// have been removed from the middle of it, and bottom to top for the
+// stacking order, with new windows placed where the backend asked.  The
+// handles are just opaque pointers, so no display server is needed.
+
+#include <libxfce4windowing/libxfce4windowing.h>
+
+#include "libxfce4windowing/xfw-window-registry.h"
+
+#define HANDLE(n) GINT_TO_POINTER(n)
+
+#define TEST_TYPE_WINDOW (test_window_get_type())
+G_DECLARE_FINAL_TYPE(TestWindow, test_window, TEST, WINDOW, XfwWindow)
+
+struct _TestWindow {
+    XfwWindow parent;
+};
+
+G_DEFINE_FINAL_TYPE(TestWindow, test_window, XFW_TYPE_WINDOW)
+
+static void
+test_window_class_init(TestWindowClass *klass) {}
+
+static void
+test_window_init(TestWindow *window) {}
+
+// Compares @list against the windows registered for @handles, in order
+static gboolean
+list_matches(XfwWindowRegistry *registry, GList *list, const gint *handles, guint n_handles) {
+    guint i = 0;
+
+    for (GList *l = list; l != NULL; l = l->next, ++i) {
+        if (i >= n_handles || l->data != _xfw_window_registry_lookup(registry, HANDLE(handles[i]))) {
+            return FALSE;
+        }
+    }
+    return i == n_handles;
+}
+
+#define assert_order(registry, list, ...) \
+    G_STMT_START { \
+        const gint expected[] = { __VA_ARGS__ }; \
+        g_assert_true(list_matches((registry), (list), expected, G_N_ELEMENTS(expected))); \
+    } \
+    G_STMT_END
+
+static XfwWindowRegistry *
+registry_with_windows(guint n_windows, gboolean on_top) {
+    XfwWindowRegistry *registry = _xfw_window_registry_new();
+
+    for (guint i = 1; i <= n_windows; ++i) {
+        if (on_top) {
+            _xfw_window_registry_add(registry, HANDLE(i), g_object_new(TEST_TYPE_WINDOW, NULL));
+        } else {
+            _xfw_window_registry_add_at_bottom(registry, HANDLE(i), g_object_new(TEST_TYPE_WINDOW, NULL));
+        }
+    }
+    return registry;
+}
+
+static void
+remove_window(XfwWindowRegistry *registry, gint handle) {
+    XfwWindow *window = _xfw_window_registry_remove(registry, HANDLE(handle));
+    g_assert_nonnull(window);
+    g_object_unref(window);
+}
+
+static void
+test_removal_keeps_order(void) {
+    XfwWindowRegistry *registry = registry_with_windows(5, TRUE);
+
+    assert_order(registry, _xfw_window_registry_get_windows(registry), 5, 4, 3, 2, 1);
+
+    remove_window(registry, 2);
+    assert_order(registry, _xfw_window_registry_get_windows(registry), 5, 4, 3, 1);
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 1, 3, 4, 5);
+
+    remove_window(registry, 5);
+    _xfw_window_registry_add(registry, HANDLE(6), g_object_new(TEST_TYPE_WINDOW, NULL));
+    remove_window(registry, 1);
+    assert_order(registry, _xfw_window_registry_get_windows(registry), 6, 4, 3);
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 3, 4, 6);
+    g_assert_cmpint(_xfw_window_registry_get_stacking_index(registry, _xfw_window_registry_lookup(registry, HANDLE(6))), ==, 2);
+
+    _xfw_window_registry_free(registry);
+}
+
+// The Wayland backend has no stacking information, and has always listed
+// the newest window first
+static void
+test_add_at_bottom(void) {
+    XfwWindowRegistry *registry = registry_with_windows(3, FALSE);
+
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 3, 2, 1);
+    assert_order(registry, _xfw_window_registry_get_windows(registry), 3, 2, 1);
+
+    remove_window(registry, 3);
+    _xfw_window_registry_add_at_bottom(registry, HANDLE(4), g_object_new(TEST_TYPE_WINDOW, NULL));
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 4, 2, 1);
+
+    _xfw_window_registry_free(registry);
+}
+
+static void
+test_set_stacking(void) {
+    XfwWindowRegistry *registry = registry_with_windows(3, TRUE);
+    GList *handles = NULL;
+
+    handles = g_list_append(handles, HANDLE(2));
+    handles = g_list_append(handles, HANDLE(7));
+    handles = g_list_append(handles, HANDLE(3));
+    g_assert_true(_xfw_window_registry_set_stacking(registry, handles));
+    g_list_free(handles);
+
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 2, 3);
+    g_assert_cmpint(_xfw_window_registry_get_stacking_index(registry, _xfw_window_registry_lookup(registry, HANDLE(1))), ==, -1);
+
+    // Setting the same order again keeps the list that was handed out
+    GList *stacked = _xfw_window_registry_get_windows_stacked(registry);
+    handles = g_list_append(NULL, HANDLE(2));
+    handles = g_list_append(handles, HANDLE(3));
+    g_assert_false(_xfw_window_registry_set_stacking(registry, handles));
+    g_assert_true(_xfw_window_registry_get_windows_stacked(registry) == stacked);
+
+    handles = g_list_reverse(handles);
+    g_assert_true(_xfw_window_registry_set_stacking(registry, handles));
+    g_list_free(handles);
+    assert_order(registry, _xfw_window_registry_get_windows_stacked(registry), 3, 2);
+
+    _xfw_window_registry_free(registry);
+}
+
+// The window list is updated in place, so a list returned by the getter
+// keeps up with windows further down it being removed, and new windows go
+// in front of it
+static void
+test_window_list_updated_in_place(void) {
+    XfwWindowRegistry *registry = registry_with_windows(3, TRUE);
+    GList *windows = _xfw_window_registry_get_windows(registry);
+
+    remove_window(registry, 2);
+    g_assert_true(_xfw_window_registry_get_windows(registry) == windows);
+    assert_order(registry, windows, 3, 1);
+
+    _xfw_window_registry_add(registry, HANDLE(4), g_object_new(TEST_TYPE_WINDOW, NULL));
+    g_assert_true(_xfw_window_registry_get_windows(registry)->next == windows);
+    assert_order(registry, _xfw_window_registry_get_windows(registry), 4, 3, 1);
+
+    _xfw_window_registry_free(registry);
+}
+
+int
+main(int argc, char **argv) {
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/window-registry/removal-keeps-order", test_removal_keeps_order);
+    g_test_add_func("/window-registry/add-at-bottom", test_add_at_bottom);
+    g_test_add_func("/window-registry/set-stacking", test_set_stacking);
+    g_test_add_func("/window-registry/window-list-updated-in-place", test_window_list_updated_in_place);
+
+    return g_test_run();
+}